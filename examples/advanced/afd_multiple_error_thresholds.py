@@ -15,3 +15,8 @@ print(f'[{", ".join(map(str, pyro.get_fds()))}]')
 pyro.execute(error=0.3)
 print(f'[{", ".join(map(str, pyro.get_fds()))}]')
 # [[2] -> 1, [0] -> 2, [2] -> 0, [2] -> 3, [0] -> 1, [3] -> 2, [3] -> 1, [1] -> 2, [3] -> 0, [0] -> 3, [4] -> 1, [1] -> 0, [1] -> 3, [4] -> 2, [4] -> 3, [2] -> 4, [3] -> 4, [0] -> 4, [1] -> 4]
+# The same results can be obtained in a single run: the FDs for the additional
+# thresholds are collected along with the ones for the main error threshold.
+pyro.execute(error=0.0, error_thresholds=[0.1, 0.2, 0.3])
+for threshold, fds in pyro.get_fds_per_threshold().items():
+    print(f'{threshold}: [{", ".join(map(str, fds))}]')
@@ -3,6 +3,7 @@
 #include <cassert>
 
 #include "config/exceptions.h"
+#include "config/time_limit/option.h"
 
 namespace algos {
 
@@ -21,15 +22,37 @@ void Algorithm::ClearOptions() noexcept {
     opt_parents_.clear();
 }
 
+void Algorithm::MakeCommonExecuteOptsAvailable() {
+    if (possible_options_.contains(config::kTimeLimitSecondsOpt.GetName())) {
+        MakeOptionsAvailable({config::kTimeLimitSecondsOpt.GetName()});
+    }
+}
+
 void Algorithm::ExecutePrepare() {
     data_loaded_ = true;
     ClearOptions();
     MakeExecuteOptsAvailable();
+    MakeCommonExecuteOptsAvailable();
 }
 
 Algorithm::Algorithm(std::vector<std::string_view> phase_names)
     : progress_(std::move(phase_names)) {}
 
+void Algorithm::RegisterTimeLimitOption() {
+    RegisterOption(config::kTimeLimitSecondsOpt(&time_limit_seconds_));
+}
+
+bool Algorithm::IsStopRequested() const noexcept {
+    return stop_requested_ ||
+           (time_limit_seconds_ != 0 && std::chrono::steady_clock::now() >= deadline_);
+}
+
+bool Algorithm::ShouldStop() noexcept {
+    if (!IsStopRequested()) return false;
+    stopped_early_ = true;
+    return true;
+}
+
 void Algorithm::ExcludeOptions(std::string_view parent_option) noexcept {
     auto it = opt_parents_.find(parent_option);
     if (it == opt_parents_.end()) return;
@@ -74,6 +97,9 @@ unsigned long long Algorithm::Execute() {
     if (!GetNeededOptions().empty())
         throw std::logic_error("All options need to be set before execution.");
     progress_.ResetProgress();
+    stop_requested_ = false;
+    stopped_early_ = false;
+    deadline_ = std::chrono::steady_clock::now() + std::chrono::seconds(time_limit_seconds_);
     ResetState();
     auto time_ms = ExecuteInternal();
     for (auto const& opt_name : available_options_) {
@@ -81,6 +107,7 @@ unsigned long long Algorithm::Execute() {
     }
     ClearOptions();
     MakeExecuteOptsAvailable();
+    MakeCommonExecuteOptsAvailable();
     return time_ms;
 }
 
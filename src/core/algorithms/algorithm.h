@@ -1,6 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <filesystem>
+#include <functional>
 #include <string_view>
 #include <typeindex>
 #include <unordered_map>
@@ -12,8 +15,10 @@
 
 #include "config/ioption.h"
 #include "config/option.h"
+#include "config/time_limit/type.h"
 #include "model/table/idataset_stream.h"
 #include "parser/csv_parser/csv_parser.h"
+#include "util/primitive_collection.h"
 #include "util/progress.h"
 
 namespace algos {
@@ -29,6 +34,11 @@ private:
     std::unordered_map<std::string_view, std::vector<std::string_view>> opt_parents_;
 
     bool data_loaded_ = false;
+    config::TimeLimitSecondsType time_limit_seconds_ = 0;
+    std::chrono::steady_clock::time_point deadline_;
+    std::atomic<bool> stop_requested_ = false;
+    // Set once the algorithm has aborted at one of its checkpoints.
+    std::atomic<bool> stopped_early_ = false;
 
     // Clear the necessary fields for Execute to run repeatedly with different
     // configuration parameters on the same dataset.
@@ -36,6 +46,8 @@ private:
 
     void ExcludeOptions(std::string_view parent_option) noexcept;
     void ClearOptions() noexcept;
+    // Makes the execute options of the base class available
+    void MakeCommonExecuteOptsAvailable();
     virtual void LoadDataInternal() = 0;
     virtual unsigned long long ExecuteInternal() = 0;
 
@@ -52,6 +64,33 @@ protected:
         progress_.ToNextProgressPhase();
     }
 
+    /* Passes every instance registered in the collection to the consumer as soon as it is found.
+     * Once the consumer returns false, the stop of the execution is requested and no more
+     * instances are passed to it.
+     */
+    template <typename T>
+    void SetPrimitiveConsumer(util::PrimitiveCollection<T>& collection,
+                              std::function<bool(T const&)> consumer) {
+        if (!consumer) {
+            collection.SetConsumer(nullptr);
+            return;
+        }
+        collection.SetConsumer([this, consumer = std::move(consumer)](T const& primitive) {
+            if (!IsStopRequested() && !consumer(primitive)) RequestStop();
+        });
+    }
+
+    /* Checkpoint of the execution: true if the stop was requested or the time limit is exceeded.
+     * The result is reported incomplete then, so call it only where the algorithm aborts if it
+     * returns true.
+     */
+    bool ShouldStop() noexcept;
+
+    /* Makes the algorithm accept the time_limit execute option. Call it only if the algorithm
+     * checks ShouldStop() during the execution, the other algorithms reject the option.
+     */
+    void RegisterTimeLimitOption();
+
     void MakeOptionsAvailable(std::vector<std::string_view> const& option_names);
 
     template <typename T>
@@ -89,6 +128,25 @@ public:
 
     unsigned long long Execute();
 
+    /* Asks the running execution to finish early, may be called from any thread. The algorithm
+     * stops at its next checkpoint and keeps the results found so far. Every Execute() call
+     * starts with the request cleared.
+     */
+    void RequestStop() noexcept {
+        stop_requested_ = true;
+    }
+
+    // True if RequestStop was called or the time limit of the execution is exceeded.
+    bool IsStopRequested() const noexcept;
+
+    /* Whether the last execution was stopped early, by RequestStop or by the time_limit option.
+     * The results found until then are kept, but some results may be missing. An execution that
+     * was done before it checked the request is complete.
+     */
+    bool IsResultIncomplete() const noexcept {
+        return stopped_early_;
+    }
+
     void SetOption(std::string_view option_name, boost::any const& value = {});
 
     [[nodiscard]] std::unordered_set<std::string_view> GetNeededOptions() const;
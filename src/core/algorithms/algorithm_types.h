@@ -8,9 +8,10 @@ namespace algos {
 
 using AlgorithmTypes =
         std::tuple<Depminer, DFD, FastFDs, FDep, FdMine, Pyro, Tane, PFDTane, FUN, hyfd::HyFD, Aid,
-                   Apriori, metric::MetricVerifier, DataStats, fd_verifier::FDVerifier, HyUCC,
-                   PyroUCC, cfd::FDFirstAlgorithm, ACAlgorithm, UCCVerifier, Faida, Spider, Mind,
-                   Fastod, GfdValidation, EGfdValidation, NaiveGfdValidation, order::Order,
+                   Apriori, metric::MetricVerifier, DataStats, fd_verifier::FDVerifier,
+                   fd_verifier::BatchFDVerifier, fd_verifier::AfdErrorCalculator, HyUCC, PyroUCC,
+                   cfd::FDFirstAlgorithm, ACAlgorithm, UCCVerifier, BatchUCCVerifier, Faida, Spider,
+                   Mind, Fastod, GfdValidation, EGfdValidation, NaiveGfdValidation, order::Order,
                    dd::Split>;
 
 // clang-format off
@@ -43,8 +44,10 @@ BETTER_ENUM(AlgorithmType, char,
 /* Statistic algorithms */
     stats,
 
-/* FD verifier algorithm */
+/* FD verifier algorithms */
     fd_verifier,
+    batch_fd_verifier,
+    afd_error_calculator,
 
 /* Unique Column Combination mining algorithms */
     hyucc,
@@ -56,8 +59,9 @@ BETTER_ENUM(AlgorithmType, char,
 /* Algebraic constraints mining algorithm*/
     ac,
 
-/* UCC verifier algorithm */
+/* UCC verifier algorithms */
     ucc_verifier,
+    batch_ucc_verifier,
 
 /* Inclusion dependency mining algorithms */
     faida,
@@ -30,6 +30,7 @@ void FDFirstAlgorithm::RegisterOptions() {
     RegisterOption(Option{&min_conf_, kCfdMinimumConfidence, kDCfdMinimumConfidence, 0.0});
     RegisterOption(Option{&max_lhs_, kCfdMaximumLhs, kDCfdMaximumLhs, 0u});
     RegisterOption(Option{&substrategy_, kCfdSubstrategy, kDCfdSubstrategy, default_val});
+    RegisterTimeLimitOption();
 }
 
 void FDFirstAlgorithm::ResetStateCFD() {
@@ -223,6 +224,7 @@ FDFirstAlgorithm::ExpandMiningFd(MinerNode<PartitionTIdList> const& inode, int i
 void FDFirstAlgorithm::FdsFirstDFS(Itemset const& prefix, PIdListMiners const& items,
                                    Substrategy ss) {
     for (int ix = static_cast<int>(items.size()) - 1; ix >= 0; ix--) {
+        if (ShouldStop()) return;
         MinerNode<PartitionTIdList> const& inode = items[ix];
         Itemset const iset = Join(prefix, inode.item);
         auto const insect = ConstructIntersection(iset, inode.candidates);
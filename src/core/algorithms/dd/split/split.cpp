@@ -36,6 +36,7 @@ void Split::RegisterOptions() {
     RegisterOption(Option{&difference_table_, kDifferenceTable, kDDifferenceTable, default_table});
     RegisterOption(Option{&num_rows_, kNumRows, kDNumRows, 0U});
     RegisterOption(Option{&num_columns_, kNumColumns, kDNUmColumns, 0U});
+    RegisterTimeLimitOption();
 }
 
 void Split::MakeExecuteOptsAvailable() {
@@ -118,7 +119,7 @@ unsigned Split::ReduceDDs(auto const& start_time) {
     std::vector<DF> search, dfs_y;
     std::list<DD> reduced;
 
-    for (model::ColumnIndex index = 0; index < num_columns_; index++) {
+    for (model::ColumnIndex index = 0; index < num_columns_ && !ShouldStop(); index++) {
         std::vector<model::ColumnIndex> indices;
         for (model::ColumnIndex j = 0; j < num_columns_; j++) {
             if (j != index) indices.emplace_back(j);
@@ -135,6 +136,7 @@ unsigned Split::ReduceDDs(auto const& start_time) {
         LOG(DEBUG) << "Number of verifications for each df in rhs:";
 
         for (auto& df_y : dfs_y) {
+            if (ShouldStop()) break;
             unsigned cnt = 0;
             if (df_y[index] != min_max_dif_[index]) {
                 switch (reduce_method_) {
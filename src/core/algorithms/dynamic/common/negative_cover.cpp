@@ -0,0 +1,81 @@
+#include "algorithms/dynamic/common/negative_cover.h"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+
+#include "util/custom_hashes.h"
+
+namespace algos::dyn {
+
+bool NegativeCover::HasSuperset(Vertical const& column_combination) const {
+    return !entries_.ForEachSuperset(column_combination,
+                                     [](Vertical const&, auto const&) { return false; });
+}
+
+bool NegativeCover::Add(Vertical const& column_combination, RowPair const& rows) {
+    if (HasSuperset(column_combination)) return false;
+
+    std::vector<Vertical> subsets;
+    entries_.ForEachSubset(column_combination, [&subsets](Vertical const& subset, auto const&) {
+        subsets.push_back(subset);
+        return true;
+    });
+    for (Vertical const& subset : subsets) {
+        entries_.Remove(subset);
+    }
+    entries_.Associate(column_combination, std::make_shared<RowPair>(rows));
+    return true;
+}
+
+bool NegativeCover::RemoveRows(std::unordered_set<size_t> const& removed_rows,
+                               FindRows const& find_rows) {
+    if (removed_rows.empty()) return false;
+
+    std::vector<Vertical> affected;
+    entries_.ForEachEntry([&](Vertical const& column_combination, auto const& rows) {
+        if (removed_rows.contains(rows->first) || removed_rows.contains(rows->second)) {
+            affected.push_back(column_combination);
+        }
+        return true;
+    });
+    if (affected.empty()) return false;
+
+    for (Vertical const& column_combination : affected) {
+        entries_.Remove(column_combination);
+    }
+    std::sort(affected.begin(), affected.end(),
+              [](Vertical const& a, Vertical const& b) { return a.GetArity() > b.GetArity(); });
+
+    // a subset of an entry is visited before its own subsets, so the first subsets that have a
+    // pair are the maximal ones, the ones below them are covered and not searched
+    std::deque<Vertical> queue(affected.begin(), affected.end());
+    std::unordered_set<Vertical> visited(affected.begin(), affected.end());
+    while (!queue.empty()) {
+        Vertical const column_combination = std::move(queue.front());
+        queue.pop_front();
+        if (HasSuperset(column_combination)) continue;
+        if (std::optional<RowPair> rows = find_rows(column_combination)) {
+            Add(column_combination, *rows);
+            continue;
+        }
+        column_combination.ForEachColumnIndex([&](size_t column) {
+            Vertical subset = column_combination.Without(*schema_->GetColumn(column));
+            if (visited.insert(subset).second) queue.push_back(std::move(subset));
+        });
+    }
+    return true;
+}
+
+std::vector<boost::dynamic_bitset<>> NegativeCover::GetColumnIndicesLargestFirst() const {
+    std::vector<boost::dynamic_bitset<>> column_indices;
+    entries_.ForEachEntry([&column_indices](Vertical const& column_combination, auto const&) {
+        column_indices.push_back(column_combination.GetColumnIndices());
+        return true;
+    });
+    std::sort(column_indices.begin(), column_indices.end(),
+              [](auto const& a, auto const& b) { return a.count() > b.count(); });
+    return column_indices;
+}
+
+}  // namespace algos::dyn
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "model/table/relational_schema.h"
+#include "model/table/vertical.h"
+#include "model/table/vertical_set_trie.h"
+
+namespace algos::dyn {
+
+using RowPair = std::pair<size_t, size_t>;
+
+/* Maximal column combinations on which some pair of rows agrees, each with such a pair. DynUCC
+ * keeps its non-UCCs in one, DynFD keeps the non-FD LHSs of every RHS in one per RHS, there the
+ * pair has to differ on the RHS as well. */
+class NegativeCover {
+public:
+    /* Finds a pair of rows agreeing on the column combination in the current table */
+    using FindRows = std::function<std::optional<RowPair>(Vertical const&)>;
+
+private:
+    RelationalSchema const* schema_;
+    model::VerticalSetTrie<RowPair> entries_;
+
+    bool HasSuperset(Vertical const& column_combination) const;
+
+public:
+    explicit NegativeCover(RelationalSchema const* schema) : schema_(schema), entries_(schema) {}
+
+    /* Adds the column combination unless a superset of it is in the cover, the subsets of it
+     * leave the cover. Returns whether it was added. */
+    bool Add(Vertical const& column_combination, RowPair const& rows);
+
+    /* Revalidates the column combinations whose pair lost a row with find_rows. The ones that
+     * have no pair anymore are replaced by their maximal subsets that have one. Returns whether
+     * the cover has changed. */
+    bool RemoveRows(std::unordered_set<size_t> const& removed_rows, FindRows const& find_rows);
+
+    /* Larger ones first, as HyFD and HyUCC specialize their trees */
+    std::vector<boost::dynamic_bitset<>> GetColumnIndicesLargestFirst() const;
+};
+
+}  // namespace algos::dyn
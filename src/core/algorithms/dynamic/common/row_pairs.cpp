@@ -0,0 +1,58 @@
+#include "algorithms/dynamic/common/row_pairs.h"
+
+#include <unordered_map>
+
+namespace algos::dyn {
+
+std::optional<RowPair> FindAgreeingRows(boost::dynamic_bitset<> const& columns,
+                                        model::DynamicTableData const& table,
+                                        ColumnPLIs const& column_plis, bool is_null_equal_null,
+                                        std::function<bool(size_t, size_t)> const& is_wanted) {
+    // the column splitting the table into the most clusters leaves the least rows to group
+    size_t pivot = columns.find_first();
+    for (size_t column = columns.find_next(pivot); column != boost::dynamic_bitset<>::npos;
+         column = columns.find_next(column)) {
+        if (column_plis[column]->GetNumCluster() > column_plis[pivot]->GetNumCluster()) {
+            pivot = column;
+        }
+    }
+    boost::dynamic_bitset<> rest = columns;
+    rest.reset(pivot);
+
+    // the rows of a cluster of the pivot are grouped by their values of the other columns
+    std::unordered_map<std::vector<int>, int, model::ClusterValueHash> first_rows;
+    std::vector<int> key;
+    for (model::DynPLI::Cluster const& cluster : column_plis[pivot]->GetClusters()) {
+        if (cluster.size() < 2) continue;
+        if (!is_null_equal_null && table.IsNull(cluster.front(), pivot)) continue;
+        first_rows.clear();
+        for (int row : cluster) {
+            key.clear();
+            bool has_null = false;
+            for (size_t column = rest.find_first(); column != boost::dynamic_bitset<>::npos;
+                 column = rest.find_next(column)) {
+                has_null |= table.IsNull(row, column);
+                key.push_back(table.GetValueId(row, column));
+            }
+            if (has_null && !is_null_equal_null) continue;
+            auto [it, is_new] = first_rows.try_emplace(key, row);
+            if (!is_new && (is_wanted == nullptr || is_wanted(it->second, row))) {
+                return RowPair(it->second, row);
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+void ForEachNeighbourPair(ColumnPLIs const& column_plis,
+                          std::function<void(RowPair const&)> const& on_pair) {
+    for (auto const& column_pli : column_plis) {
+        for (model::DynPLI::Cluster const& cluster : column_pli->GetClusters()) {
+            for (size_t i = 1; i < cluster.size(); ++i) {
+                on_pair({cluster[i - 1], cluster[i]});
+            }
+        }
+    }
+}
+
+}  // namespace algos::dyn
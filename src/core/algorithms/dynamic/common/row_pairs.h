@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "algorithms/dynamic/common/negative_cover.h"
+#include "model/table/dynamic_position_list_index.h"
+#include "model/table/dynamic_table_data.h"
+
+namespace algos::dyn {
+
+using ColumnPLIs = std::vector<std::unique_ptr<model::DynPLI>>;
+
+/* Finds two rows agreeing on the nonempty set of columns for which is_wanted holds, any two if
+ * it is null. Unless is_null_equal_null, a row with a null in one of the columns agrees with no
+ * other row. */
+std::optional<RowPair> FindAgreeingRows(
+        boost::dynamic_bitset<> const& columns, model::DynamicTableData const& table,
+        ColumnPLIs const& column_plis, bool is_null_equal_null,
+        std::function<bool(size_t, size_t)> const& is_wanted = nullptr);
+
+/* Calls on_pair for the neighbouring rows of every cluster of the column PLIs. Such rows agree at
+ * least on the column of the cluster, they are a cheap sample of the agree sets of the table. */
+void ForEachNeighbourPair(ColumnPLIs const& column_plis,
+                          std::function<void(RowPair const&)> const& on_pair);
+
+}  // namespace algos::dyn
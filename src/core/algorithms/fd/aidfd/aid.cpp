@@ -1,16 +1,37 @@
 #include "aid.h"
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <string>
+#include <unordered_map>
+
+#include <boost/container_hash/hash.hpp>
+
+#include "config/deduplicate_rows/option.h"
 #include "config/tabular_data/input_table/option.h"
+#include "config/thread_number/option.h"
+#include "util/row_deduplication.h"
+#include "util/work_stealing_pool.h"
 
 namespace algos {
 
 Aid::Aid() : FDAlgorithm({kDefaultPhaseName}) {
     RegisterOptions();
-    MakeOptionsAvailable({config::kTableOpt.GetName()});
+    MakeOptionsAvailable({config::kTableOpt.GetName(), config::kDeduplicateRowsOpt.GetName()});
 }
 
 void Aid::RegisterOptions() {
     RegisterOption(config::kTableOpt(&input_table_));
+    // the tuples are deduplicated on load, so the threads option is needed at that stage then
+    RegisterOption(config::kDeduplicateRowsOpt(&deduplicate_rows_)
+                           .SetConditionalOpts({{[](bool deduplicate) { return deduplicate; },
+                                                 {config::kThreadNumberOpt.GetName()}}}));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+}
+
+void Aid::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
 }
 
 void Aid::LoadDataInternal() {
@@ -26,27 +47,63 @@ void Aid::LoadDataInternal() {
         schema_->AppendColumn(column_name);
     }
 
+    std::vector<std::unordered_map<std::string, ValueId>> dictionaries(number_of_attributes_);
     while (input_table_->HasNextRow()) {
         std::vector<std::string> const& next_line = input_table_->GetNextRow();
         if (next_line.empty()) {
             break;
         }
 
-        tuples_.emplace_back(std::vector<size_t>(number_of_attributes_));
         for (size_t i = 0; i < number_of_attributes_; ++i) {
-            tuples_.back()[i] = std::hash<std::string>{}(next_line[i]);
+            std::unordered_map<std::string, ValueId>& dictionary = dictionaries[i];
+            if (dictionary.size() == std::numeric_limits<ValueId>::max()) {
+                throw std::runtime_error("Too many distinct values in column " +
+                                         schema_->GetColumn(i)->GetName());
+            }
+            auto [it, _] = dictionary.try_emplace(next_line[i], dictionary.size());
+            tuples_.push_back(it->second);
         }
     }
-    number_of_tuples_ = tuples_.size();
+    number_of_tuples_ = tuples_.size() / number_of_attributes_;
+    if (deduplicate_rows_) {
+        CollapseDuplicateTuples();
+    }
+    tuples_.shrink_to_fit();
     constant_columns_ = boost::dynamic_bitset<>(number_of_attributes_);
 }
 
+void Aid::CollapseDuplicateTuples() {
+    auto const hash = [this](size_t tuple_num) {
+        ValueId const* tuple = GetTuple(tuple_num);
+        return boost::hash_range(tuple, tuple + number_of_attributes_);
+    };
+    auto const equal = [this](size_t first, size_t second) {
+        return std::equal(GetTuple(first), GetTuple(first) + number_of_attributes_,
+                          GetTuple(second));
+    };
+    std::vector<size_t> const kept_tuples =
+            util::DeduplicateRows(number_of_tuples_, hash, equal, threads_num_).kept_rows;
+
+    // kept tuples are in ascending order, so every one is moved to the same place or before it
+    for (size_t i = 0; i < kept_tuples.size(); ++i) {
+        if (kept_tuples[i] == i) continue;
+        ValueId const* tuple = GetTuple(kept_tuples[i]);
+        std::copy(tuple, tuple + number_of_attributes_,
+                  tuples_.begin() + i * number_of_attributes_);
+    }
+    number_of_tuples_ = kept_tuples.size();
+    tuples_.resize(number_of_tuples_ * number_of_attributes_);
+}
+
 void Aid::ResetStateFd() {
-    clusters_.assign(number_of_attributes_, std::unordered_map<size_t, Cluster>{});
+    clusters_.assign(number_of_attributes_, std::vector<Cluster>{});
     indices_in_clusters_.assign(number_of_attributes_, std::vector<size_t>(number_of_tuples_));
     constant_columns_.reset();
     prev_ratios_.assign(kWindowSize, 1.0);
     sum_ = double{kWindowSize};
+    for (NegCoverShard& shard : neg_cover_) {
+        shard.agree_sets.clear();
+    }
 }
 
 unsigned long long Aid::ExecuteInternal() {
@@ -70,13 +127,12 @@ void Aid::BuildClusters() {
     }
 
     for (size_t attr_num = 0; attr_num < number_of_attributes_; ++attr_num) {
-        std::unordered_map<size_t, Cluster>& column_values = clusters_[attr_num];
-        bool is_constant = true;
-        size_t first_value = tuples_[0][attr_num];
+        std::vector<Cluster>& column_values = clusters_[attr_num];
         for (size_t tuple_num = 0; tuple_num < number_of_tuples_; ++tuple_num) {
-            size_t entry_value = tuples_[tuple_num][attr_num];
-            if (entry_value != first_value) {
-                is_constant = false;
+            ValueId entry_value = GetTuple(tuple_num)[attr_num];
+            // Value ids are assigned in the order of the first occurrence
+            if (entry_value == column_values.size()) {
+                column_values.emplace_back();
             }
 
             Cluster& cluster = column_values[entry_value];
@@ -84,7 +140,7 @@ void Aid::BuildClusters() {
             indices_in_clusters_[attr_num][tuple_num] = cluster.size() - 1;
         }
 
-        if (is_constant) {
+        if (column_values.size() == 1) {
             constant_columns_[attr_num] = true;
         }
     }
@@ -103,14 +159,41 @@ bool Aid::IsNegativeCoverGrowthSmall(size_t iteration_num, double curr_ratio) {
     return false;
 }
 
+size_t Aid::GetNegativeCoverSize() const {
+    size_t size = 0;
+    for (NegCoverShard const& shard : neg_cover_) {
+        size += shard.agree_sets.size();
+    }
+    return size;
+}
+
 void Aid::CreateNegativeCover() {
+    /* Tuples are split into disjoint ranges sampled by separate tasks. The same tuple pairs are
+     * sampled on every iteration regardless of the number of threads, so the stopping rule,
+     * which is evaluated on the merged negative cover after each iteration, and hence the
+     * result do not depend on it.
+     */
+    size_t const tasks_num =
+            std::min<size_t>(threads_num_ * 4, number_of_tuples_ / kMinTuplesPerTask + 1);
+    std::unique_ptr<util::WorkStealingPool> pool;
+    if (threads_num_ > 1 && tasks_num > 1) {
+        pool = std::make_unique<util::WorkStealingPool>(threads_num_);
+    }
+
     size_t prev_neg_cover_size = 0;
     for (size_t index = 1;; ++index) {
-        for (size_t tuple_num = 0; tuple_num < number_of_tuples_; ++tuple_num) {
-            HandleTuple(tuple_num, index);
+        if (pool == nullptr) {
+            HandleTuples(0, number_of_tuples_, index);
+        } else {
+            for (size_t task = 0; task < tasks_num; ++task) {
+                size_t const begin = number_of_tuples_ * task / tasks_num;
+                size_t const end = number_of_tuples_ * (task + 1) / tasks_num;
+                pool->Submit([this, begin, end, index]() { HandleTuples(begin, end, index); });
+            }
+            pool->Wait();
         }
 
-        size_t curr_neg_cover_size = neg_cover_.size();
+        size_t curr_neg_cover_size = GetNegativeCoverSize();
         double curr_ratio;
         if (prev_neg_cover_size == 0) {
             curr_ratio = (curr_neg_cover_size == 0) ? 0.0 : 1.0;
@@ -127,25 +210,60 @@ void Aid::CreateNegativeCover() {
     }
 }
 
-void Aid::HandleTuple(size_t tuple_num, size_t iteration_num) {
+void Aid::HandleTuples(size_t begin, size_t end, size_t iteration_num) {
+    /* Sampled agree sets are buffered per shard, so that a shard is locked once per batch
+     * instead of once per agree set
+     */
+    std::array<std::vector<AgreeSet>, kNegCoverShardsNum> sampled;
+    size_t sampled_num = 0;
+    auto flush = [this, &sampled, &sampled_num]() {
+        for (size_t shard_num = 0; shard_num < kNegCoverShardsNum; ++shard_num) {
+            std::vector<AgreeSet>& shard_sampled = sampled[shard_num];
+            if (shard_sampled.empty()) continue;
+            NegCoverShard& shard = neg_cover_[shard_num];
+            std::scoped_lock lock(shard.mutex);
+            shard.agree_sets.insert(std::make_move_iterator(shard_sampled.begin()),
+                                    std::make_move_iterator(shard_sampled.end()));
+            shard_sampled.clear();
+        }
+        sampled_num = 0;
+    };
+
+    for (size_t tuple_num = begin; tuple_num < end; ++tuple_num) {
+        sampled_num += HandleTuple(tuple_num, iteration_num, sampled);
+        if (sampled_num >= kMaxBufferedAgreeSets) {
+            flush();
+        }
+    }
+    flush();
+}
+
+size_t Aid::HandleTuple(size_t tuple_num, size_t iteration_num,
+                        std::array<std::vector<AgreeSet>, kNegCoverShardsNum>& sampled) const {
+    size_t sampled_num = 0;
+    ValueId const* tuple = GetTuple(tuple_num);
     for (size_t attr_num = 0; attr_num < number_of_attributes_; ++attr_num) {
-        size_t value = tuples_[tuple_num][attr_num];
-        Cluster const& cluster = clusters_[attr_num].at(value);
+        Cluster const& cluster = clusters_[attr_num][tuple[attr_num]];
         size_t index_in_cluster = indices_in_clusters_[attr_num][tuple_num];
         if (iteration_num <= index_in_cluster) {
             size_t another_index_in_cluster =
                     GenerateSecondClusterIndex(index_in_cluster, iteration_num);
             size_t another_tuple_num = cluster[another_index_in_cluster];
-            auto tuples_agree_set = BuildAgreeSet(tuple_num, another_tuple_num);
-            neg_cover_.insert(tuples_agree_set);
+            AgreeSet tuples_agree_set = BuildAgreeSet(tuple_num, another_tuple_num);
+            size_t const shard_num = std::hash<AgreeSet>{}(tuples_agree_set) % kNegCoverShardsNum;
+            sampled[shard_num].push_back(std::move(tuples_agree_set));
+            ++sampled_num;
         }
     }
+    return sampled_num;
 }
 
-boost::dynamic_bitset<> Aid::BuildAgreeSet(size_t t1, size_t t2) {
-    boost::dynamic_bitset<> equal_attr(number_of_attributes_);
+Aid::AgreeSet Aid::BuildAgreeSet(size_t t1, size_t t2) const {
+    ValueId const* first = GetTuple(t1);
+    ValueId const* second = GetTuple(t2);
+    AgreeSet equal_attr(number_of_attributes_);
     for (size_t attr_num = 0; attr_num < number_of_attributes_; ++attr_num) {
-        if (tuples_[t1][attr_num] == tuples_[t2][attr_num]) {
+        if (first[attr_num] == second[attr_num]) {
             equal_attr.set(attr_num);
         }
     }
@@ -198,7 +316,11 @@ void Aid::InvertNegativeCover() {
     HandleConstantColumns(attributes);
 
     std::vector<boost::dynamic_bitset<>> neg_cover_vector;
-    neg_cover_vector.insert(neg_cover_vector.end(), neg_cover_.begin(), neg_cover_.end());
+    neg_cover_vector.reserve(GetNegativeCoverSize());
+    for (NegCoverShard& shard : neg_cover_) {
+        neg_cover_vector.insert(neg_cover_vector.end(), shard.agree_sets.begin(),
+                                shard.agree_sets.end());
+    }
     auto comp_by_card = [](boost::dynamic_bitset<> const& lhs, boost::dynamic_bitset<> const& rhs) {
         return lhs.count() > rhs.count();
     };
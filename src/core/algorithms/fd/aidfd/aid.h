@@ -1,12 +1,17 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <memory>
-#include <unordered_map>
+#include <mutex>
 #include <unordered_set>
+#include <vector>
 
 #include <boost/dynamic_bitset.hpp>
 
+#include "config/deduplicate_rows/type.h"
 #include "config/tabular_data/input_table_type.h"
+#include "config/thread_number/type.h"
 #include "fd/fd_algorithm.h"
 #include "model/table/column.h"
 #include "model/table/relational_schema.h"
@@ -18,45 +23,72 @@ namespace algos {
 class Aid : public FDAlgorithm {
 private:
     using Cluster = std::vector<size_t>;
+    // Dictionary-encoded value of a cell, values are numbered within a column from 0
+    using ValueId = std::uint32_t;
+    using AgreeSet = boost::dynamic_bitset<>;
+
+    // Part of the negative cover, agree sets are distributed among shards by hash
+    struct NegCoverShard {
+        std::mutex mutex;
+        std::unordered_set<AgreeSet> agree_sets;
+    };
 
     config::InputTable input_table_;
+    config::ThreadNumType threads_num_;
+    // duplicate tuples agree on every attribute, so they do not add to the negative cover
+    config::DeduplicateRowsType deduplicate_rows_;
 
     std::unique_ptr<RelationalSchema> schema_{};
-    std::vector<std::vector<size_t>> tuples_;
+    // Row-major matrix number_of_tuples_ x number_of_attributes_ of value ids
+    std::vector<ValueId> tuples_;
 
     size_t number_of_attributes_{};
     size_t number_of_tuples_{};
 
-    std::unordered_set<boost::dynamic_bitset<>> neg_cover_{};
+    constexpr static size_t kNegCoverShardsNum = 64;
+    std::array<NegCoverShard, kNegCoverShardsNum> neg_cover_{};
 
     constexpr static double const kGrowthThreshold = 0.01;
     constexpr static size_t const kWindowSize = 10;
     constexpr static size_t const kPrime = 10619863;
+    // Minimal number of tuples sampled by a single task in one iteration
+    constexpr static size_t const kMinTuplesPerTask = 256;
+    // Number of sampled agree sets a task keeps before adding them to the negative cover
+    constexpr static size_t const kMaxBufferedAgreeSets = 4096;
 
     std::vector<double> prev_ratios_;
     double sum_{};
 
-    std::vector<std::unordered_map<size_t, Cluster>> clusters_;
+    // clusters_[attr_num][value] is the list of tuples with `value` in `attr_num` column
+    std::vector<std::vector<Cluster>> clusters_;
     std::vector<std::vector<size_t>> indices_in_clusters_;
 
     boost::dynamic_bitset<> constant_columns_;
 
     void RegisterOptions();
+    void MakeExecuteOptsAvailableFDInternal() final;
 
     void ResetStateFd() final;
 
     void LoadDataInternal() final;
     unsigned long long ExecuteInternal() final;
 
+    void CollapseDuplicateTuples();
     void BuildClusters();
     void CreateNegativeCover();
     void InvertNegativeCover();
 
-    void HandleTuple(size_t tuple_num, size_t index);
+    // Samples agree sets of tuples from [begin, end) on `iteration_num` iteration and adds them
+    // to the negative cover
+    void HandleTuples(size_t begin, size_t end, size_t iteration_num);
+    // Returns the number of agree sets added to `sampled`
+    size_t HandleTuple(size_t tuple_num, size_t iteration_num,
+                       std::array<std::vector<AgreeSet>, kNegCoverShardsNum>& sampled) const;
     void HandleInvalidFd(boost::dynamic_bitset<> const& neg_cover_el, SearchTree& pos_cover_tree,
                          size_t rhs);
     size_t GenerateSecondClusterIndex(size_t index_in_cluster, size_t iteration_num) const;
     bool IsNegativeCoverGrowthSmall(size_t iteration_num, double curr_ratio);
+    size_t GetNegativeCoverSize() const;
 
     void HandleConstantColumns(boost::dynamic_bitset<>& attributes);
     void RegisterFDs(size_t rhs, std::vector<boost::dynamic_bitset<>> const& list_of_lhs);
@@ -66,7 +98,11 @@ private:
     std::vector<size_t> GetAttributesSortedByFrequency(
             std::vector<boost::dynamic_bitset<>> const& neg_cover_vector) const;
 
-    boost::dynamic_bitset<> BuildAgreeSet(size_t t1, size_t t2);
+    ValueId const* GetTuple(size_t tuple_num) const {
+        return tuples_.data() + tuple_num * number_of_attributes_;
+    }
+
+    AgreeSet BuildAgreeSet(size_t t1, size_t t2) const;
 
 public:
     Aid();
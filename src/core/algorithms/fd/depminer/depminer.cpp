@@ -6,6 +6,7 @@
 
 #include <easylogging++.h>
 
+#include "config/thread_number/option.h"
 #include "model/table/agree_set_factory.h"
 #include "model/table/relational_schema.h"
 
@@ -13,7 +14,18 @@ namespace algos {
 
 Depminer::Depminer(std::optional<ColumnLayoutRelationDataManager> relation_manager)
     : PliBasedFDAlgorithm({"AgreeSets generation", "Finding CMAXSets", "Finding LHS"},
-                          relation_manager) {}
+                          relation_manager) {
+    RegisterOptions();
+}
+
+void Depminer::RegisterOptions() {
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    RegisterTimeLimitOption();
+}
+
+void Depminer::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+}
 
 using boost::dynamic_bitset, std::make_shared, std::shared_ptr, std::setw, std::vector, std::list,
         std::dynamic_pointer_cast;
@@ -26,8 +38,8 @@ unsigned long long Depminer::ExecuteInternal() {
     progress_step_ = kTotalProgressPercent / schema_->GetNumColumns();
 
     // Agree sets
-    model::AgreeSetFactory const agree_set_factory =
-            model::AgreeSetFactory(relation_.get(), model::AgreeSetFactory::Configuration(), this);
+    model::AgreeSetFactory const agree_set_factory = model::AgreeSetFactory(
+            relation_.get(), model::AgreeSetFactory::Configuration(threads_num_), this);
     auto const agree_sets = agree_set_factory.GenAgreeSets();
     ToNextProgressPhase();
 
@@ -124,7 +136,7 @@ void Depminer::LhsForColumn(std::unique_ptr<Column> const& column,
     }
 
     // 4
-    while (!level.empty()) {
+    while (!level.empty() && !ShouldStop()) {
         std::unordered_set<Vertical> level_copy = level;
         // 5
         for (auto const& l : level) {
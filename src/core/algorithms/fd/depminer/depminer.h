@@ -2,6 +2,7 @@
 
 #include "algorithms/fd/depminer/cmax_set.h"
 #include "algorithms/fd/pli_based_fd_algorithm.h"
+#include "config/thread_number/type.h"
 
 namespace algos {
 
@@ -18,6 +19,10 @@ private:
 
     double progress_step_ = 0;
     RelationalSchema const* schema_ = nullptr;
+    config::ThreadNumType threads_num_;
+
+    void RegisterOptions();
+    void MakeExecuteOptsAvailableFDInternal() final;
 
     void ResetStateFd() final {}
 
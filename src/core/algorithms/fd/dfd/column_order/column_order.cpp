@@ -25,7 +25,7 @@ std::vector<int> ColumnOrder::GetOrderHighDistinctCount(Vertical const& columns)
 
     int current_order_index = 0;
     for (int column_index : order_) {
-        if (columns.GetColumnIndices()[column_index]) {
+        if (columns.Contains(column_index)) {
             order_for_columns[current_order_index++] = column_index;
         }
     }
@@ -39,7 +39,7 @@ std::vector<int> ColumnOrder::GetOrderLowDistinctCount(Vertical const& columns)
     assert(!order_.empty());
     int current_order_index = 0;
     for (int i = this->order_.size() - 1; i >= 0; --i) {
-        if (columns.GetColumnIndices()[order_[i]]) {
+        if (columns.Contains(order_[i])) {
             order_for_columns[current_order_index++] = this->order_[i];
         }
     }
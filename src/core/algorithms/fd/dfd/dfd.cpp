@@ -1,9 +1,12 @@
 #include "dfd.h"
 
+#include <atomic>
+
 #include <boost/asio.hpp>
 #include <easylogging++.h>
 
 #include "config/max_lhs/option.h"
+#include "config/mem_limit/option.h"
 #include "config/thread_number/option.h"
 #include "lattice_traversal/lattice_traversal.h"
 #include "model/table/column_layout_relation_data.h"
@@ -19,10 +22,12 @@ DFD::DFD(std::optional<ColumnLayoutRelationDataManager> relation_manager)
 
 void DFD::RegisterOptions() {
     RegisterOption(config::kThreadNumberOpt(&number_of_threads_));
+    RegisterOption(config::kMemLimitMbOpt(&mem_limit_mb_));
+    RegisterTimeLimitOption();
 }
 
 void DFD::MakeExecuteOptsAvailableFDInternal() {
-    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName(), config::kMemLimitMbOpt.GetName()});
 }
 
 void DFD::ResetStateFd() {
@@ -31,7 +36,8 @@ void DFD::ResetStateFd() {
 
 unsigned long long DFD::ExecuteInternal() {
     auto partition_storage = std::make_unique<PartitionStorage>(
-            relation_.get(), CachingMethod::kAllCaching, CacheEvictionMethod::kMedainUsage);
+            relation_.get(), CachingMethod::kAllCaching, CacheEvictionMethod::kMedainUsage,
+            static_cast<size_t>(mem_limit_mb_) * 1024 * 1024);
     RelationalSchema const* const schema = relation_->GetSchema();
 
     auto start_time = std::chrono::system_clock::now();
@@ -51,32 +57,46 @@ unsigned long long DFD::ExecuteInternal() {
     double progress_step = 100.0 / schema->GetNumColumns();
     boost::asio::thread_pool search_space_pool(number_of_threads_);
 
+    /* Workers that have no right-hand side left to take help the traversals that are still
+     * running, so the slowest right-hand side does not bound the execution time alone
+     */
+    size_t const num_columns = schema->GetNumColumns();
+    WorkerBudget worker_budget(number_of_threads_ > num_columns ? number_of_threads_ - num_columns
+                                                                : 0);
+    std::atomic<size_t> pending_rhss = num_columns;
+
     for (auto& rhs : schema->GetColumns()) {
-        boost::asio::post(
-                search_space_pool, [this, &rhs, schema, progress_step, &partition_storage]() {
-                    ColumnData const& rhs_data = relation_->GetColumnData(rhs->GetIndex());
-                    model::PositionListIndex const* const rhs_pli = rhs_data.GetPositionListIndex();
-
-                    /* if all the rows have the same value, then we register FD with empty LHS
-                     * if we have minimal FD like []->RHS, it is impossible to find smaller FD with
-                     * this RHS, so we register it and move to the next RHS
-                     * */
-                    if (rhs_pli->GetNepAsLong() == relation_->GetNumTuplePairs()) {
-                        RegisterFd(*(schema->empty_vertical_), *rhs);
-                        AddProgress(progress_step);
-                        return;
-                    }
-
-                    auto search_space = LatticeTraversal(rhs.get(), relation_.get(),
-                                                         unique_columns_, partition_storage.get());
-                    auto const minimal_deps = search_space.FindLHSs();
-
-                    for (auto const& minimal_dependency_lhs : minimal_deps) {
-                        RegisterFd(minimal_dependency_lhs, *rhs);
-                    }
-                    AddProgress(progress_step);
-                    LOG(INFO) << static_cast<int>(GetProgress().second);
-                });
+        boost::asio::post(search_space_pool, [this, &rhs, schema, progress_step,
+                                              &partition_storage, &worker_budget,
+                                              &pending_rhss]() {
+            --pending_rhss;
+            ColumnData const& rhs_data = relation_->GetColumnData(rhs->GetIndex());
+            model::PositionListIndex const* const rhs_pli = rhs_data.GetPositionListIndex();
+
+            /* if all the rows have the same value, then we register FD with empty LHS
+             * if we have minimal FD like []->RHS, it is impossible to find smaller FD with
+             * this RHS, so we register it and move to the next RHS
+             * */
+            if (rhs_pli->GetNepAsLong() == relation_->GetNumTuplePairs()) {
+                RegisterFd(*(schema->empty_vertical_), *rhs);
+            } else if (!ShouldStop()) {
+                // the right-hand sides not taken before the stop request are skipped
+                auto search_space = LatticeTraversal(rhs.get(), relation_.get(), unique_columns_,
+                                                     partition_storage.get(), &worker_budget);
+                auto const minimal_deps = search_space.FindLHSs();
+
+                for (auto const& minimal_dependency_lhs : minimal_deps) {
+                    RegisterFd(minimal_dependency_lhs, *rhs);
+                }
+            }
+            AddProgress(progress_step);
+            LOG(INFO) << static_cast<int>(GetProgress().second);
+
+            // all right-hand sides are taken, this worker would stay idle otherwise
+            if (pending_rhss == 0) {
+                worker_budget.Release(1);
+            }
+        });
     }
 
     search_space_pool.join();
@@ -87,6 +107,7 @@ unsigned long long DFD::ExecuteInternal() {
     long long apriori_millis = elapsed_milliseconds.count();
 
     LOG(INFO) << "> FD COUNT: " << fd_collection_.Size();
+    LOG(INFO) << "> PLI CACHE EVICTIONS: " << partition_storage->GetEvictionsNum();
     LOG(INFO) << "> HASH: " << PliBasedFDAlgorithm::Fletcher16();
 
     return apriori_millis;
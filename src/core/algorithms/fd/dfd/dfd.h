@@ -4,6 +4,7 @@
 #include <stack>
 
 #include "algorithms/fd/pli_based_fd_algorithm.h"
+#include "config/mem_limit/type.h"
 #include "config/thread_number/type.h"
 #include "model/table/vertical.h"
 #include "partition_storage/partition_storage.h"
@@ -15,6 +16,8 @@ private:
     std::vector<Vertical> unique_columns_;
 
     config::ThreadNumType number_of_threads_;
+    // Budget of the PLI cache, the least used PLIs are evicted when it is exceeded
+    config::MemLimitMBType mem_limit_mb_;
 
     void MakeExecuteOptsAvailableFDInternal() final;
     void RegisterOptions();
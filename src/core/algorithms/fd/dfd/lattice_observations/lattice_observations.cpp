@@ -8,13 +8,12 @@ NodeCategory LatticeObservations::UpdateDependencyCategory(Vertical const& node)
         return new_category;
     }
 
-    auto column_indices = node.GetColumnIndicesRef();  // copy indices
     bool has_unchecked_subset = false;
 
-    for (size_t index = column_indices.find_first(); index < column_indices.size();
-         index = column_indices.find_next(index)) {
-        column_indices[index] = false;  // remove one column
-        auto const subset_node_iter = this->find(Vertical(node.GetSchema(), column_indices));
+    for (size_t index = node.FindFirst(); index != boost::dynamic_bitset<>::npos;
+         index = node.FindNext(index)) {
+        // remove one column
+        auto const subset_node_iter = this->find(node.Without(*node.GetSchema()->GetColumn(index)));
 
         if (subset_node_iter == this->end()) {
             // if we found unchecked subset of this node
@@ -29,8 +28,6 @@ NodeCategory LatticeObservations::UpdateDependencyCategory(Vertical const& node)
                 return new_category;
             }
         }
-
-        column_indices[index] = true;  // restore removed column
     }
     new_category = has_unchecked_subset ? NodeCategory::kCandidateMinimalDependency
                                         : NodeCategory::kMinimalDependency;
@@ -40,16 +37,15 @@ NodeCategory LatticeObservations::UpdateDependencyCategory(Vertical const& node)
 
 NodeCategory LatticeObservations::UpdateNonDependencyCategory(Vertical const& node,
                                                               unsigned int rhs_index) {
-    auto column_indices = node.GetColumnIndicesRef();
-    column_indices[rhs_index] = true;
-    column_indices.flip();
+    RelationalSchema const* schema = node.GetSchema();
+    Vertical const complement = node.Union(*schema->GetColumn(rhs_index)).Invert();
 
     NodeCategory new_category;
     bool has_unchecked_superset = false;
 
-    for (size_t index = column_indices.find_first(); index < column_indices.size();
-         index = column_indices.find_next(index)) {
-        auto const superset_node_iter = this->find(node.Union(*node.GetSchema()->GetColumn(index)));
+    for (size_t index = complement.FindFirst(); index != boost::dynamic_bitset<>::npos;
+         index = complement.FindNext(index)) {
+        auto const superset_node_iter = this->find(node.Union(*schema->GetColumn(index)));
 
         if (superset_node_iter == this->end()) {
             // if we found unchecked superset of this node
@@ -1,13 +1,19 @@
 #include "lattice_traversal.h"
 
+#include <memory>
 #include <random>
+#include <system_error>
+#include <thread>
+
+#include <easylogging++.h>
 
 #include "model/table/position_list_index.h"
 
 LatticeTraversal::LatticeTraversal(Column const* const rhs,
                                    ColumnLayoutRelationData const* const relation,
                                    std::vector<Vertical> const& unique_verticals,
-                                   PartitionStorage* const partition_storage)
+                                   PartitionStorage* const partition_storage,
+                                   WorkerBudget* const worker_budget)
     : rhs_(rhs),
       dependencies_map_(relation->GetSchema()),
       non_dependencies_map_(relation->GetSchema()),
@@ -15,6 +21,21 @@ LatticeTraversal::LatticeTraversal(Column const* const rhs,
       unique_columns_(unique_verticals),
       relation_(relation),
       partition_storage_(partition_storage),
+      worker_budget_(worker_budget),
+      gen_(rd_()) {}
+
+LatticeTraversal::LatticeTraversal(LatticeTraversal const& other)
+    : rhs_(other.rhs_),
+      minimal_deps_(other.minimal_deps_),
+      maximal_non_deps_(other.maximal_non_deps_),
+      dependencies_map_(other.dependencies_map_),
+      non_dependencies_map_(other.non_dependencies_map_),
+      observations_(other.observations_),
+      column_order_(other.column_order_),
+      unique_columns_(other.unique_columns_),
+      relation_(other.relation_),
+      partition_storage_(other.partition_storage_),
+      worker_budget_(other.worker_budget_),
       gen_(rd_()) {}
 
 std::unordered_set<Vertical> LatticeTraversal::FindLHSs() {
@@ -42,72 +63,129 @@ std::unordered_set<Vertical> LatticeTraversal::FindLHSs() {
     }
 
     do {
-        while (!seeds.empty()) {
-            Vertical node;
-            if (!seeds.empty()) {
-                node = std::move(seeds.top());
-                seeds.pop();
-            } else {
-                node = *schema->empty_vertical_;
-            }
+        WalkSeeds(std::move(seeds));
+        seeds = GenerateNextSeeds(rhs_);
+    } while (!seeds.empty());
 
-            do {
-                auto const node_observation_iter = observations_.find(node);
+    return minimal_deps_;
+}
 
-                if (node_observation_iter != observations_.end()) {
-                    NodeCategory& node_category = node_observation_iter->second;
+void LatticeTraversal::WalkSeeds(std::stack<Vertical> seeds) {
+    unsigned const helpers_num = worker_budget_ == nullptr || seeds.size() < 2
+                                         ? 0
+                                         : worker_budget_->Acquire(seeds.size() - 1);
+    if (helpers_num == 0) {
+        Walk(std::move(seeds));
+        return;
+    }
 
-                    if (node_category == NodeCategory::kCandidateMinimalDependency) {
-                        node_category = observations_.UpdateDependencyCategory(node);
-                        if (node_category == NodeCategory::kMinimalDependency) {
-                            minimal_deps_.insert(node);
-                        }
-                    } else if (node_category == NodeCategory::kCandidateMaximalNonDependency) {
-                        node_category =
-                                observations_.UpdateNonDependencyCategory(node, rhs_->GetIndex());
-                        if (node_category == NodeCategory::kMaximalNonDependency) {
-                            maximal_non_deps_.insert(node);
-                        }
+    /* Every helper walks its share of the seeds starting from the current state. All categories
+     * it finds are facts about the relation, so they are merged afterwards, and the next seeds
+     * are generated from the merged state just as if a single walker found everything.
+     */
+    std::vector<std::stack<Vertical>> shares(helpers_num + 1);
+    for (std::size_t i = 0; !seeds.empty(); ++i) {
+        shares[i % shares.size()].push(std::move(seeds.top()));
+        seeds.pop();
+    }
+    std::vector<std::unique_ptr<LatticeTraversal>> helpers;
+    helpers.reserve(helpers_num);
+    for (unsigned i = 0; i < helpers_num; ++i) {
+        helpers.push_back(std::unique_ptr<LatticeTraversal>(new LatticeTraversal(*this)));
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(helpers_num);
+    for (unsigned i = 0; i < helpers_num; ++i) {
+        try {
+            threads.emplace_back([&helpers, &shares, i]() {
+                helpers[i]->Walk(std::move(shares[i + 1]));
+            });
+        } catch (std::system_error const& e) {
+            LOG(WARNING) << "Could not create a thread to walk DFD seeds: " << e.what();
+            helpers[i]->Walk(std::move(shares[i + 1]));
+        }
+    }
+    Walk(std::move(shares[0]));
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    worker_budget_->Release(helpers_num);
+
+    for (auto const& helper : helpers) {
+        MergeFindings(*helper);
+    }
+}
+
+void LatticeTraversal::MergeFindings(LatticeTraversal const& other) {
+    for (auto const& [node, category] : other.observations_) {
+        if (category == NodeCategory::kCandidateMinimalDependency ||
+            category == NodeCategory::kCandidateMaximalNonDependency) {
+            continue;
+        }
+        auto [it, inserted] = observations_.try_emplace(node, category);
+        if (!inserted && observations_.IsCandidate(node)) {
+            it->second = category;
+        }
+    }
+    for (Vertical const& dependency : other.minimal_deps_) {
+        if (minimal_deps_.insert(dependency).second) {
+            dependencies_map_.AddNewDependency(dependency);
+        }
+    }
+    for (Vertical const& non_dependency : other.maximal_non_deps_) {
+        if (maximal_non_deps_.insert(non_dependency).second) {
+            non_dependencies_map_.AddNewNonDependency(non_dependency);
+        }
+    }
+}
+
+void LatticeTraversal::Walk(std::stack<Vertical> seeds) {
+    while (!seeds.empty()) {
+        Vertical node = std::move(seeds.top());
+        seeds.pop();
+
+        do {
+            auto const node_observation_iter = observations_.find(node);
+
+            if (node_observation_iter != observations_.end()) {
+                NodeCategory& node_category = node_observation_iter->second;
+
+                if (node_category == NodeCategory::kCandidateMinimalDependency) {
+                    node_category = observations_.UpdateDependencyCategory(node);
+                    if (node_category == NodeCategory::kMinimalDependency) {
+                        minimal_deps_.insert(node);
                     }
-                } else if (!InferCategory(node, rhs_->GetIndex())) {
-                    // if we were not able to infer category, we calculate the partitions
-                    auto node_pli = partition_storage_->GetOrCreateFor(node);
-                    auto node_pli_pointer =
-                            std::holds_alternative<model::PositionListIndex*>(node_pli)
-                                    ? std::get<model::PositionListIndex*>(node_pli)
-                                    : std::get<std::unique_ptr<model::PositionListIndex>>(node_pli)
-                                              .get();
-                    auto intersected_pli = partition_storage_->GetOrCreateFor(node.Union(*rhs_));
-                    auto intersected_pli_pointer =
-                            std::holds_alternative<model::PositionListIndex*>(intersected_pli)
-                                    ? std::get<model::PositionListIndex*>(intersected_pli)
-                                    : std::get<std::unique_ptr<model::PositionListIndex>>(
-                                              intersected_pli)
-                                              .get();
-
-                    if (node_pli_pointer->GetNepAsLong() ==
-                        intersected_pli_pointer->GetNepAsLong()) {
-                        observations_.UpdateDependencyCategory(node);
-                        if (observations_[node] == NodeCategory::kMinimalDependency) {
-                            minimal_deps_.insert(node);
-                        }
-                        dependencies_map_.AddNewDependency(node);
-                    } else {
-                        observations_.UpdateNonDependencyCategory(node, rhs_->GetIndex());
-                        if (observations_[node] == NodeCategory::kMaximalNonDependency) {
-                            maximal_non_deps_.insert(node);
-                        }
-                        non_dependencies_map_.AddNewNonDependency(node);
+                } else if (node_category == NodeCategory::kCandidateMaximalNonDependency) {
+                    node_category =
+                            observations_.UpdateNonDependencyCategory(node, rhs_->GetIndex());
+                    if (node_category == NodeCategory::kMaximalNonDependency) {
+                        maximal_non_deps_.insert(node);
                     }
                 }
+            } else if (!InferCategory(node, rhs_->GetIndex())) {
+                // if we were not able to infer category, we calculate the partitions
+                auto const node_pli = partition_storage_->GetOrCreateFor(node);
+                auto const intersected_pli = partition_storage_->GetOrCreateFor(node.Union(*rhs_));
+
+                if (node_pli->GetNepAsLong() == intersected_pli->GetNepAsLong()) {
+                    observations_.UpdateDependencyCategory(node);
+                    if (observations_[node] == NodeCategory::kMinimalDependency) {
+                        minimal_deps_.insert(node);
+                    }
+                    dependencies_map_.AddNewDependency(node);
+                } else {
+                    observations_.UpdateNonDependencyCategory(node, rhs_->GetIndex());
+                    if (observations_[node] == NodeCategory::kMaximalNonDependency) {
+                        maximal_non_deps_.insert(node);
+                    }
+                    non_dependencies_map_.AddNewNonDependency(node);
+                }
+            }
 
-                node = PickNextNode(node, rhs_->GetIndex());
-            } while (node != *node.GetSchema()->empty_vertical_);
-        }
-        seeds = GenerateNextSeeds(rhs_);
-    } while (!seeds.empty());
-
-    return minimal_deps_;
+            node = PickNextNode(node, rhs_->GetIndex());
+        } while (node != *node.GetSchema()->empty_vertical_);
+    }
 }
 
 bool LatticeTraversal::InferCategory(Vertical const& node, unsigned int rhs_index) {
@@ -202,7 +280,7 @@ std::stack<Vertical> LatticeTraversal::GenerateNextSeeds(Column const* const cur
     std::unordered_set<Vertical> new_seeds;
 
     for (auto const& non_dep : maximal_non_deps_) {
-        auto complement_indices = non_dep.GetColumnIndicesRef();
+        auto complement_indices = non_dep.GetColumnIndices();
         complement_indices[current_rhs->GetIndex()] = true;
         complement_indices.flip();
 
@@ -219,14 +297,14 @@ std::stack<Vertical> LatticeTraversal::GenerateNextSeeds(Column const* const cur
             }
         } else {
             for (auto const& dependency : seeds) {
-                auto new_combination = dependency.GetColumnIndicesRef();
+                auto new_combination = dependency.GetColumnIndices();
 
                 for (size_t column_index = complement_indices.find_first();
                      column_index < complement_indices.size();
                      column_index = complement_indices.find_next(column_index)) {
                     new_combination[column_index] = true;
                     new_seeds.emplace(relation_->GetSchema(), new_combination);
-                    new_combination[column_index] = dependency.GetColumnIndicesRef()[column_index];
+                    new_combination[column_index] = dependency.Contains(column_index);
                 }
             }
 
@@ -8,6 +8,7 @@
 #include "../partition_storage/partition_storage.h"
 #include "../pruning_maps/dependencies_map.h"
 #include "../pruning_maps/non_dependencies_map.h"
+#include "../worker_budget.h"
 #include "model/table/vertical.h"
 
 class LatticeTraversal {
@@ -25,10 +26,21 @@ private:
     std::vector<Vertical> const& unique_columns_;
     ColumnLayoutRelationData const* const relation_;
     PartitionStorage* const partition_storage_;
+    WorkerBudget* const worker_budget_;
 
     std::random_device rd_;
     std::mt19937 gen_;
 
+    // Makes a traversal that continues from the state of `other`, used to walk seeds in parallel
+    LatticeTraversal(LatticeTraversal const& other);
+
+    // Walks the lattice from every seed
+    void Walk(std::stack<Vertical> seeds);
+    // Walks the lattice from every seed, with idle workers if there are any
+    void WalkSeeds(std::stack<Vertical> seeds);
+    // Adds the categories found by `other`, all of them hold for the relation
+    void MergeFindings(LatticeTraversal const& other);
+
     bool InferCategory(Vertical const& node, unsigned int rhs_index);
     Vertical PickNextNode(Vertical const& node, unsigned int rhs_index);
     std::stack<Vertical> GenerateNextSeeds(Column const* const current_rhs);
@@ -41,7 +53,8 @@ private:
 public:
     LatticeTraversal(Column const* const rhs, ColumnLayoutRelationData const* const relation,
                      std::vector<Vertical> const& unique_verticals,
-                     PartitionStorage* const partition_storage);
+                     PartitionStorage* const partition_storage,
+                     WorkerBudget* const worker_budget = nullptr);
 
     std::unordered_set<Vertical> FindLHSs();
 };
@@ -1,23 +1,38 @@
 #include "partition_storage.h"
 
+#include <exception>
+
 #include <boost/format.hpp>
 #include <boost/optional.hpp>
 #include <easylogging++.h>
 
 #include "model/table/vertical_map.h"
 
-model::PositionListIndex* PartitionStorage::Get(Vertical const& vertical) {
-    return index_->Get(vertical).get();
+namespace {
+std::size_t GetMemoryUsage(model::PositionListIndex const& pli) {
+    using Cluster = model::PositionListIndex::Cluster;
+    std::size_t bytes = sizeof(pli);
+    for (Cluster const& cluster : pli.GetIndex()) {
+        bytes += sizeof(Cluster) + cluster.capacity() * sizeof(Cluster::value_type);
+    }
+    return bytes;
+}
+}  // namespace
+
+PartitionStorage::PliPtr PartitionStorage::Get(Vertical const& vertical) const {
+    return index_->Get(vertical);
 }
 
 PartitionStorage::PartitionStorage(ColumnLayoutRelationData* relation_data,
                                    CachingMethod caching_method,
-                                   CacheEvictionMethod eviction_method)
+                                   CacheEvictionMethod eviction_method,
+                                   std::size_t max_memory_bytes)
     : relation_data_(relation_data),
       index_(std::make_unique<model::BlockingVerticalMap<model::PositionListIndex>>(
               relation_data->GetSchema())),
       caching_method_(caching_method),
-      eviction_method_(eviction_method) {
+      eviction_method_(eviction_method),
+      max_memory_bytes_(max_memory_bytes) {
     for (auto& column_ptr : relation_data->GetSchema()->GetColumns()) {
         index_->Put(static_cast<Vertical>(*column_ptr),
                     relation_data->GetColumnData(column_ptr->GetIndex()).GetPliOwnership());
@@ -26,29 +41,73 @@ PartitionStorage::PartitionStorage(ColumnLayoutRelationData* relation_data,
 
 PartitionStorage::~PartitionStorage() {}
 
-// obtains or calculates a PositionListIndex using cache
-std::variant<model::PositionListIndex*, std::unique_ptr<model::PositionListIndex>>
-PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
-    std::scoped_lock lock(getting_pli_mutex_);
+void PartitionStorage::CountUsage(Vertical const& vertical) {
+    // single column PLIs are never evicted, there is no need to count their usages
+    if (vertical.GetArity() <= 1) return;
+    UsageShard& shard = usage_shards_[std::hash<Vertical>()(vertical) % kUsageShardsNum];
+    std::scoped_lock lock(shard.mutex);
+    ++shard.counters[vertical];
+}
+
+PartitionStorage::PliPtr PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
     LOG(DEBUG) << boost::format{"PLI for %1% requested: "} % vertical.ToString();
 
     // is PLI already cached?
-    model::PositionListIndex* pli = Get(vertical);
-    if (pli != nullptr) {
-        pli->IncFreq();
+    if (PliPtr pli = Get(vertical); pli != nullptr) {
+        CountUsage(vertical);
         LOG(DEBUG) << boost::format{"Served from PLI cache."};
-        // addToUsageCounter
         return pli;
     }
+
+    std::promise<PliPtr> promise;
+    {
+        std::unique_lock lock(in_flight_mutex_);
+        // the PLI might have been computed and cached by another thread after the lookup above
+        if (PliPtr pli = Get(vertical); pli != nullptr) {
+            lock.unlock();
+            CountUsage(vertical);
+            return pli;
+        }
+        if (auto it = in_flight_.find(vertical); it != in_flight_.end()) {
+            std::shared_future<PliPtr> result = it->second;
+            lock.unlock();
+            CountUsage(vertical);
+            LOG(DEBUG) << boost::format{"Waiting for the PLI computed by another thread."};
+            return result.get();
+        }
+        in_flight_.emplace(vertical, promise.get_future().share());
+    }
+
+    PliPtr pli;
+    try {
+        pli = Compute(vertical);
+    } catch (...) {
+        {
+            std::scoped_lock lock(in_flight_mutex_);
+            in_flight_.erase(vertical);
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+    {
+        // the PLI is already cached, so the requests that miss it here will find it in the cache
+        std::scoped_lock lock(in_flight_mutex_);
+        in_flight_.erase(vertical);
+    }
+    promise.set_value(pli);
+
+    EvictIfNeeded();
+    return pli;
+}
+
+PartitionStorage::PliPtr PartitionStorage::Compute(Vertical const& vertical) {
     // look for cached PLIs to construct the requested one
     auto subset_entries = index_->GetSubsetEntries(vertical);
     boost::optional<PositionListIndexRank> smallest_pli_rank;
     std::vector<PositionListIndexRank> ranks;
     ranks.reserve(subset_entries.size());
     for (auto& [sub_vertical, sub_pli_ptr] : subset_entries) {
-        PositionListIndexRank pli_rank(
-                &sub_vertical, std::const_pointer_cast<model::PositionListIndex>(sub_pli_ptr),
-                sub_vertical.GetArity());
+        PositionListIndexRank pli_rank(&sub_vertical, sub_pli_ptr, sub_vertical.GetArity());
         ranks.push_back(pli_rank);
         if (!smallest_pli_rank || smallest_pli_rank->pli_->GetSize() > pli_rank.pli_->GetSize() ||
             (smallest_pli_rank->pli_->GetSize() == pli_rank.pli_->GetSize() &&
@@ -62,7 +121,7 @@ PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
     boost::dynamic_bitset<> cover(relation_data_->GetNumColumns());
     boost::dynamic_bitset<> cover_tester(relation_data_->GetNumColumns());
     if (smallest_pli_rank) {
-        smallest_pli_rank->pli_->IncFreq();
+        CountUsage(*smallest_pli_rank->vertical_);
         operands.push_back(*smallest_pli_rank);
         cover |= smallest_pli_rank->vertical_->GetColumnIndices();
 
@@ -88,7 +147,7 @@ PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
             }
 
             if (best_rank) {
-                best_rank->pli_->IncFreq();
+                CountUsage(*best_rank->vertical_);
                 operands.push_back(*best_rank);
                 cover |= best_rank->vertical_->GetColumnIndices();
             }
@@ -102,7 +161,6 @@ PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
             vertical_columns.push_back(std::make_unique<Vertical>(static_cast<Vertical>(*column)));
             auto column_pli = index_->Get(**vertical_columns.rbegin());
             operands.emplace_back(vertical_columns.rbegin()->get(), column_pli, 1);
-            column_pli->IncFreq();
         }
     }
     // sort operands by ascending order
@@ -116,46 +174,71 @@ PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
     }
 
     // Intersect and cache
-    std::variant<model::PositionListIndex*, std::unique_ptr<model::PositionListIndex>>
-            variant_intersection_pli;
+    PliPtr intersection_pli;
     if (operands.size() >= 4) {
-        PositionListIndexRank base_pli_rank = operands[0];
-        auto intersection_pli = base_pli_rank.pli_->ProbeAll(
-                vertical.Without(*base_pli_rank.vertical_), *relation_data_);
-        variant_intersection_pli = CachingProcess(vertical, std::move(intersection_pli));
+        PositionListIndexRank const& base_pli_rank = operands[0];
+        intersection_pli = base_pli_rank.pli_->ProbeAll(vertical.Without(*base_pli_rank.vertical_),
+                                                        *relation_data_);
+        CachingProcess(vertical, intersection_pli);
     } else {
         Vertical current_vertical = *operands.begin()->vertical_;
-        variant_intersection_pli = operands.begin()->pli_.get();
+        intersection_pli = operands.begin()->pli_;
 
         for (size_t i = 1; i < operands.size(); i++) {
             current_vertical = current_vertical.Union(*operands[i].vertical_);
-            variant_intersection_pli =
-                    std::holds_alternative<model::PositionListIndex*>(variant_intersection_pli)
-                            ? std::get<model::PositionListIndex*>(variant_intersection_pli)
-                                      ->Intersect(operands[i].pli_.get())
-                            : std::get<std::unique_ptr<model::PositionListIndex>>(
-                                      variant_intersection_pli)
-                                      ->Intersect(operands[i].pli_.get());
-            variant_intersection_pli = CachingProcess(
-                    current_vertical, std::move(std::get<std::unique_ptr<model::PositionListIndex>>(
-                                              variant_intersection_pli)));
+            intersection_pli = intersection_pli->Intersect(operands[i].pli_.get());
+            CachingProcess(current_vertical, intersection_pli);
         }
     }
 
     LOG(DEBUG) << boost::format{"Calculated from %1% sub-PLIs (saved %2% intersections)."} %
                           operands.size() % (vertical.GetArity() - operands.size());
 
-    return variant_intersection_pli;
+    return intersection_pli;
 }
 
 size_t PartitionStorage::Size() const {
     return index_->GetSize();
 }
 
-std::variant<model::PositionListIndex*, std::unique_ptr<model::PositionListIndex>>
-PartitionStorage::CachingProcess(Vertical const& vertical,
-                                 std::unique_ptr<model::PositionListIndex> pli) {
-    auto pli_pointer = pli.get();
-    index_->Put(vertical, std::move(pli));
-    return pli_pointer;
+void PartitionStorage::CachingProcess(Vertical const& vertical, PliPtr pli) {
+    std::size_t const pli_bytes = GetMemoryUsage(*pli);
+    // counted before the PLI can be evicted, so the eviction never subtracts uncounted bytes
+    cached_bytes_ += pli_bytes;
+    if (index_->Put(vertical, std::const_pointer_cast<model::PositionListIndex>(std::move(pli))) !=
+        nullptr) {
+        cached_bytes_ -= pli_bytes;
+    }
+}
+
+void PartitionStorage::EvictIfNeeded() {
+    if (eviction_method_ != CacheEvictionMethod::kMedainUsage ||
+        cached_bytes_ <= max_memory_bytes_) {
+        return;
+    }
+    // a single thread evicts at a time, the others go on and may exceed the budget meanwhile
+    std::unique_lock eviction_lock(eviction_mutex_, std::try_to_lock);
+    if (!eviction_lock.owns_lock() || cached_bytes_ <= max_memory_bytes_) {
+        return;
+    }
+
+    std::unordered_map<Vertical, unsigned int> usage_counter;
+    for (UsageShard& shard : usage_shards_) {
+        std::scoped_lock lock(shard.mutex);
+        usage_counter.merge(shard.counters);
+        shard.counters.clear();
+    }
+    using Entry = model::VerticalMap<model::PositionListIndex>::Entry;
+    std::vector<Entry> const evicted = index_->Shrink(
+            usage_counter, [](Entry const& entry) { return entry.first.GetArity() > 1; });
+
+    std::size_t evicted_bytes = 0;
+    for (Entry const& entry : evicted) {
+        evicted_bytes += GetMemoryUsage(*entry.second);
+    }
+    // the other threads keep caching meanwhile, so only the evicted amount is subtracted
+    std::size_t const cached_bytes = cached_bytes_.fetch_sub(evicted_bytes) - evicted_bytes;
+    LOG(DEBUG) << boost::format{"PLI cache shrunk by %1% to %2% bytes."} % evicted_bytes %
+                          cached_bytes;
+    ++evictions_num_;
 }
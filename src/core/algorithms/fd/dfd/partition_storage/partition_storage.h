@@ -1,50 +1,88 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <limits>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
 
 #include "cache_eviction_method.h"
 #include "caching_method.h"
 #include "model/table/column_layout_relation_data.h"
 #include "model/table/vertical_map.h"
 
+/* PLI cache shared by the lattice traversals of all right-hand sides.
+ * Lookups of the cached PLIs take no lock, they run concurrently with each other and with the
+ * modifications of the underlying BlockingVerticalMap, which are serialized. A missing PLI is
+ * computed by a single thread, other threads requesting the same PLI wait for that result instead
+ * of computing it once more.
+ * With CacheEvictionMethod::kMedainUsage, when the estimated size of the cached PLIs exceeds the
+ * memory budget, the PLIs that have been used at most as often as the median since the previous
+ * eviction are evicted. Single column PLIs are never evicted.
+ */
 class PartitionStorage {
+public:
+    using PliPtr = std::shared_ptr<model::PositionListIndex const>;
+
 private:
     class PositionListIndexRank {
     public:
         Vertical const* vertical_;
-        std::shared_ptr<model::PositionListIndex> pli_;
+        PliPtr pli_;
         int added_arity_;
 
-        PositionListIndexRank(Vertical const* vertical,
-                              std::shared_ptr<model::PositionListIndex> pli, int initial_arity)
-            : vertical_(vertical), pli_(pli), added_arity_(initial_arity) {}
+        PositionListIndexRank(Vertical const* vertical, PliPtr pli, int initial_arity)
+            : vertical_(vertical), pli_(std::move(pli)), added_arity_(initial_arity) {}
+    };
+
+    struct UsageShard {
+        std::mutex mutex;
+        std::unordered_map<Vertical, unsigned int> counters;
     };
 
+    static constexpr std::size_t kUsageShardsNum = 64;
+
     ColumnLayoutRelationData* relation_data_;
     std::unique_ptr<model::VerticalMap<model::PositionListIndex>> index_;
 
-    int saved_intersections_ = 0;
+    // PLIs that are being computed at the moment
+    std::mutex in_flight_mutex_;
+    std::unordered_map<Vertical, std::shared_future<PliPtr>> in_flight_;
 
-    mutable std::mutex getting_pli_mutex_;
+    // Usage counters since the last eviction, sharded to reduce contention
+    std::array<UsageShard, kUsageShardsNum> usage_shards_;
 
     CachingMethod caching_method_;
     CacheEvictionMethod eviction_method_;
-    double caching_method_value_;
 
-    double median_inverted_entropy_;
+    std::size_t const max_memory_bytes_;
+    // Estimated size of the cached multi-column PLIs
+    std::atomic<std::size_t> cached_bytes_ = 0;
+    std::mutex eviction_mutex_;
+    std::atomic<std::size_t> evictions_num_ = 0;
 
-    std::variant<model::PositionListIndex*, std::unique_ptr<model::PositionListIndex>>
-    CachingProcess(Vertical const& vertical, std::unique_ptr<model::PositionListIndex> pli);
+    void CountUsage(Vertical const& vertical);
+    PliPtr Compute(Vertical const& vertical);
+    void CachingProcess(Vertical const& vertical, PliPtr pli);
+    void EvictIfNeeded();
 
 public:
     PartitionStorage(ColumnLayoutRelationData* relation_data, CachingMethod caching_method,
-                     CacheEvictionMethod eviction_method);
+                     CacheEvictionMethod eviction_method,
+                     std::size_t max_memory_bytes = std::numeric_limits<std::size_t>::max());
 
-    model::PositionListIndex* Get(Vertical const& vertical);
-    std::variant<model::PositionListIndex*, std::unique_ptr<model::PositionListIndex>>
-    GetOrCreateFor(Vertical const& vertical);
+    PliPtr Get(Vertical const& vertical) const;
+    // obtains or calculates a PositionListIndex using cache, thread-safe
+    PliPtr GetOrCreateFor(Vertical const& vertical);
 
     size_t Size() const;
 
+    std::size_t GetEvictionsNum() const {
+        return evictions_num_;
+    }
+
     virtual ~PartitionStorage();
 };
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+
+/* Counts the worker threads that have no right-hand side left to process.
+ * A lattice traversal borrows them to walk its seeds in parallel, so that a single expensive
+ * right-hand side does not keep the other workers idle till the end of the execution.
+ */
+class WorkerBudget {
+private:
+    std::atomic<unsigned> idle_workers_;
+
+public:
+    explicit WorkerBudget(unsigned idle_workers = 0) : idle_workers_(idle_workers) {}
+
+    // Returns the number of borrowed workers, at most `max_workers`
+    unsigned Acquire(unsigned max_workers) {
+        unsigned idle = idle_workers_.load();
+        unsigned taken;
+        do {
+            taken = std::min(idle, max_workers);
+            if (taken == 0) return 0;
+        } while (!idle_workers_.compare_exchange_weak(idle, idle - taken));
+        return taken;
+    }
+
+    void Release(unsigned workers) {
+        idle_workers_ += workers;
+    }
+};
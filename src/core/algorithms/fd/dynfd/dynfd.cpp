@@ -0,0 +1,298 @@
+#include "algorithms/fd/dynfd/dynfd.h"
+
+#include <chrono>
+#include <numeric>
+#include <unordered_set>
+
+#include "config/equal_nulls/option.h"
+#include "config/names_and_descriptions.h"
+#include "config/option_using.h"
+#include "config/tabular_data/crud_operations/operations.h"
+#include "config/tabular_data/input_table/option.h"
+#include "config/thread_number/option.h"
+#include "util/parallel_for.h"
+
+namespace algos::dynfd {
+
+DynFD::DynFD() : FDAlgorithm({kDefaultPhaseName}) {
+    RegisterOptions();
+    MakeOptionsAvailable({config::kTableOpt.GetName(), config::kEqualNullsOpt.GetName(),
+                          config::kThreadNumberOpt.GetName()});
+}
+
+void DynFD::RegisterOptions() {
+    DESBORDANTE_OPTION_USING;
+
+    auto check_inserts = [this](config::InputTable const& insert_batch) {
+        table_data_->CheckInsertBatch(insert_batch);
+    };
+    auto check_deletes = [this](std::unordered_set<size_t> const& delete_batch) {
+        table_data_->CheckDeleteBatch(delete_batch);
+    };
+    auto check_updates = [this](config::InputTable const& update_batch) {
+        table_data_->CheckUpdateBatch(update_batch);
+    };
+
+    RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(config::kEqualNullsOpt(&is_null_equal_null_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    RegisterOption(
+            config::kInsertStatementsOpt(&insert_statements_table_).SetValueCheck(check_inserts));
+    RegisterOption(
+            config::kDeleteStatementsOpt(&delete_statement_indices_).SetValueCheck(check_deletes));
+    RegisterOption(
+            config::kUpdateStatementsOpt(&update_statements_table_).SetValueCheck(check_updates));
+}
+
+void DynFD::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable(kCrudOptions);
+}
+
+void DynFD::LoadDataInternal() {
+    size_t const num_columns = input_table_->GetNumberOfColumns();
+    schema_ = std::make_unique<RelationalSchema>(input_table_->GetRelationName());
+    for (size_t i = 0; i < num_columns; ++i) {
+        schema_->AppendColumn(input_table_->GetColumnName(i));
+    }
+    schema_->Init();
+
+    table_data_ = std::make_unique<model::DynamicTableData>(*input_table_);
+    input_table_->Reset();
+
+    column_plis_.clear();
+    for (size_t column = 0; column < num_columns; ++column) {
+        std::vector<model::DynPLI::ClusterValue> column_values;
+        column_values.reserve(table_data_->GetNumRowsTotal());
+        for (size_t row = 0; row < table_data_->GetNumRowsTotal(); ++row) {
+            column_values.push_back({table_data_->GetValueId(row, column)});
+        }
+        column_plis_.push_back(model::DynPLI::CreateFor(column_values));
+    }
+
+    // every table is an insert into the empty one, on which every FD with an empty LHS holds
+    positive_cover_ = std::make_shared<hyfd::fd_tree::FDTree>(num_columns);
+    inductor_ = std::make_unique<hyfd::Inductor>(positive_cover_);
+    negative_covers_.clear();
+    for (size_t column = 0; column < num_columns; ++column) {
+        negative_covers_.push_back(std::make_unique<dyn::NegativeCover>(schema_.get()));
+    }
+    SampleNonFDs();
+    ValidatePositiveCover(nullptr);
+}
+
+unsigned long long DynFD::ExecuteInternal() {
+    auto start_time = std::chrono::system_clock::now();
+
+    // the PLIs and the negative covers find the rows by their values, so the updated rows leave
+    // them before they change
+    std::unordered_set<size_t> removed_rows{delete_statement_indices_};
+    for (size_t row : table_data_->GetUpdatedRowIndices(update_statements_table_)) {
+        removed_rows.insert(row);
+    }
+
+    size_t const first_inserted_row = table_data_->GetNumRowsTotal();
+    std::vector<size_t> changed_rows = table_data_->Update(
+            insert_statements_table_, update_statements_table_, delete_statement_indices_);
+    if (insert_statements_table_ != nullptr) insert_statements_table_->Reset();
+    if (update_statements_table_ != nullptr) update_statements_table_->Reset();
+    for (size_t row = first_inserted_row; row < table_data_->GetNumRowsTotal(); ++row) {
+        changed_rows.push_back(row);
+    }
+
+    RemoveRows(removed_rows);
+    InsertRows(changed_rows);
+    RegisterFDs();
+
+    auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now() - start_time);
+    return elapsed_milliseconds.count();
+}
+
+boost::dynamic_bitset<> DynFD::GetAgreeSet(RowPair const& rows) const {
+    boost::dynamic_bitset<> agree_set(schema_->GetNumColumns());
+    for (size_t column = 0; column < agree_set.size(); ++column) {
+        agree_set[column] = AreEqual(rows.first, rows.second, column);
+    }
+    return agree_set;
+}
+
+std::optional<DynFD::RowPair> DynFD::FindViolationInTable(boost::dynamic_bitset<> const& lhs,
+                                                          size_t rhs) const {
+    if (lhs.none()) {
+        std::optional<size_t> first_row;
+        for (model::DynPLI::Cluster const& cluster : column_plis_[rhs]->GetClusters()) {
+            if (cluster.empty()) continue;
+            if (first_row.has_value()) return RowPair(*first_row, cluster.front());
+            // unless nulls are equal, two nulls differ
+            if (cluster.size() > 1 && !AreEqual(cluster[0], cluster[1], rhs)) {
+                return RowPair(cluster[0], cluster[1]);
+            }
+            first_row = cluster.front();
+        }
+        return std::nullopt;
+    }
+    return dyn::FindAgreeingRows(lhs, *table_data_, column_plis_, is_null_equal_null_,
+                                 [this, rhs](size_t first_row, size_t second_row) {
+                                     return !AreEqual(first_row, second_row, rhs);
+                                 });
+}
+
+std::optional<DynFD::RowPair> DynFD::FindViolation(boost::dynamic_bitset<> const& lhs, size_t rhs,
+                                                   std::vector<size_t> const* changed_rows) const {
+    if (changed_rows == nullptr) return FindViolationInTable(lhs, rhs);
+
+    if (lhs.none()) {
+        // any row differing from a changed one on the RHS violates the FD
+        size_t const changed_row = changed_rows->front();
+        for (model::DynPLI::Cluster const& cluster : column_plis_[rhs]->GetClusters()) {
+            // the rows of a cluster are equal to each other, unless they are nulls
+            for (int row : cluster) {
+                if (static_cast<size_t>(row) == changed_row) continue;
+                if (!AreEqual(row, changed_row, rhs)) return RowPair(changed_row, row);
+                break;
+            }
+        }
+        return std::nullopt;
+    }
+
+    size_t rows_visited = 0;
+    for (size_t row : *changed_rows) {
+        // the rows agreeing with the changed one on the LHS are in each of its clusters
+        model::DynPLI::Cluster const* smallest_cluster = nullptr;
+        for (size_t column = lhs.find_first(); column != boost::dynamic_bitset<>::npos;
+             column = lhs.find_next(column)) {
+            model::DynPLI const& column_pli = *column_plis_[column];
+            model::DynPLI::Cluster const& cluster =
+                    column_pli.GetCluster(column_pli.GetProbingTable()[row]);
+            if (smallest_cluster == nullptr || cluster.size() < smallest_cluster->size()) {
+                smallest_cluster = &cluster;
+            }
+        }
+        rows_visited += smallest_cluster->size();
+        if (rows_visited > table_data_->GetNumRowsActual()) {
+            // the changed rows share too many rows with the others, one pass is cheaper
+            return FindViolationInTable(lhs, rhs);
+        }
+        for (int other_row : *smallest_cluster) {
+            if (static_cast<size_t>(other_row) == row || AreEqual(other_row, row, rhs)) continue;
+            bool agree = true;
+            for (size_t column = lhs.find_first(); agree && column != boost::dynamic_bitset<>::npos;
+                 column = lhs.find_next(column)) {
+                agree = AreEqual(other_row, row, column);
+            }
+            if (agree) return RowPair(row, other_row);
+        }
+    }
+    return std::nullopt;
+}
+
+void DynFD::AddNonFD(boost::dynamic_bitset<> const& lhs, size_t rhs, RowPair const& rows) {
+    // the positive cover has no LHS below a known non-FD, so it only changes for a new one
+    if (negative_covers_[rhs]->Add(schema_->GetVertical(lhs), rows)) {
+        inductor_->SpecializeTreeForNonFd(lhs, rhs);
+    }
+}
+
+void DynFD::AddNonFDsOf(RowPair const& rows) {
+    boost::dynamic_bitset<> const agree_set = GetAgreeSet(rows);
+    for (size_t rhs = 0; rhs < agree_set.size(); ++rhs) {
+        if (!agree_set.test(rhs)) AddNonFD(agree_set, rhs, rows);
+    }
+}
+
+void DynFD::SampleNonFDs() {
+    // the sampled non-FDs save validations of the candidates that would have failed anyway
+    dyn::ForEachNeighbourPair(column_plis_, [this](RowPair const& rows) { AddNonFDsOf(rows); });
+}
+
+void DynFD::ValidatePositiveCover(std::vector<size_t> const* changed_rows) {
+    // a specialization of an invalid FD lies one level above it, so the levels are validated
+    // bottom-up and the FDs below the current level are known to hold
+    for (size_t level = 0; level < schema_->GetNumColumns(); ++level) {
+        std::vector<RawFD> fds;
+        for (auto const& [vertex, lhs] : positive_cover_->GetLevel(level)) {
+            boost::dynamic_bitset<> const rhss = vertex->GetFDs();
+            for (size_t rhs = rhss.find_first(); rhs != boost::dynamic_bitset<>::npos;
+                 rhs = rhss.find_next(rhs)) {
+                fds.emplace_back(lhs, rhs);
+            }
+        }
+
+        std::vector<std::optional<RowPair>> violations(fds.size());
+        std::vector<size_t> fd_indices(fds.size());
+        std::iota(fd_indices.begin(), fd_indices.end(), 0);
+        util::ParallelForeach(fd_indices.begin(), fd_indices.end(), threads_num_, [&](size_t i) {
+            violations[i] = FindViolation(fds[i].lhs_, fds[i].rhs_, changed_rows);
+        });
+        for (std::optional<RowPair> const& violation : violations) {
+            if (violation.has_value()) AddNonFDsOf(*violation);
+        }
+    }
+}
+
+void DynFD::RemoveRows(std::unordered_set<size_t> const& removed_rows) {
+    if (removed_rows.empty()) return;
+
+    std::vector<std::pair<std::optional<size_t>, model::DynPLI::ClusterValue>> no_inserts;
+    for (auto& column_pli : column_plis_) {
+        column_pli->UpdateWith(no_inserts, removed_rows);
+    }
+
+    std::vector<size_t> changed_rhss;
+    for (size_t rhs = 0; rhs < schema_->GetNumColumns(); ++rhs) {
+        // the other non-FDs are still violated by their row pairs
+        auto const find_violation = [this, rhs](Vertical const& lhs) {
+            return FindViolationInTable(lhs.GetColumnIndices(), rhs);
+        };
+        if (negative_covers_[rhs]->RemoveRows(removed_rows, find_violation)) {
+            changed_rhss.push_back(rhs);
+        }
+    }
+    InducePositiveCover(changed_rhss);
+}
+
+void DynFD::InducePositiveCover(std::vector<size_t> const& rhss) {
+    if (rhss.empty()) return;
+
+    size_t const num_columns = schema_->GetNumColumns();
+    boost::dynamic_bitset<> is_induced(num_columns);
+    for (size_t rhs : rhss) {
+        is_induced.set(rhs);
+    }
+    for (RawFD const& fd : positive_cover_->FillFDs()) {
+        if (is_induced.test(fd.rhs_)) positive_cover_->Remove(fd.lhs_, fd.rhs_);
+    }
+
+    boost::dynamic_bitset<> const empty_lhs(num_columns);
+    for (size_t rhs : rhss) {
+        positive_cover_->AddFD(empty_lhs, rhs);
+        // larger non-FDs remove more candidates at once
+        for (boost::dynamic_bitset<> const& lhs :
+             negative_covers_[rhs]->GetColumnIndicesLargestFirst()) {
+            inductor_->SpecializeTreeForNonFd(lhs, rhs);
+        }
+    }
+}
+
+void DynFD::InsertRows(std::vector<size_t> const& changed_rows) {
+    if (changed_rows.empty()) return;
+
+    for (size_t column = 0; column < schema_->GetNumColumns(); ++column) {
+        std::vector<std::pair<std::optional<size_t>, model::DynPLI::ClusterValue>> inserts;
+        inserts.reserve(changed_rows.size());
+        for (size_t row : changed_rows) {
+            inserts.emplace_back(row, model::DynPLI::ClusterValue{
+                                              table_data_->GetValueId(row, column)});
+        }
+        column_plis_[column]->UpdateWith(inserts, {});
+    }
+    ValidatePositiveCover(&changed_rows);
+}
+
+void DynFD::RegisterFDs() {
+    for (RawFD const& fd : positive_cover_->FillFDs()) {
+        RegisterFd(schema_->GetVertical(fd.lhs_), *schema_->GetColumn(fd.rhs_));
+    }
+}
+
+}  // namespace algos::dynfd
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "algorithms/dynamic/common/negative_cover.h"
+#include "algorithms/dynamic/common/row_pairs.h"
+#include "algorithms/fd/fd_algorithm.h"
+#include "algorithms/fd/hyfd/inductor.h"
+#include "algorithms/fd/hyfd/model/fd_tree.h"
+#include "config/equal_nulls/type.h"
+#include "config/tabular_data/input_table_type.h"
+#include "config/thread_number/type.h"
+#include "model/table/dynamic_position_list_index.h"
+#include "model/table/dynamic_table_data.h"
+#include "model/table/relational_schema.h"
+
+namespace algos::dynfd {
+
+/**
+ * Incremental FD discovery: keeps the minimal FD cover of a table current while the table is
+ * changed by batches of inserts, updates and deletes, passed through the CRUD options of every
+ * Execute() call, like DynamicFDVerifier takes them.
+ *
+ * Along with the positive cover (an FD prefix tree, as in HyFD) the algorithm keeps, for every
+ * RHS, the negative cover: the maximal non-FD LHSs, each with a pair of rows violating it.
+ * - Inserted rows can only invalidate FDs. Every FD of the cover held before the batch, so it is
+ *   validated only against the inserted rows, the rows sharing an LHS value with them are found
+ *   through the per-column dynamic PLIs. The agree set of a violating pair is a new non-FD that
+ *   specializes the cover locally, the specializations are validated level by level.
+ * - Deleted rows can only turn non-FDs into FDs. Only the non-FDs whose violating pair lost a
+ *   row are revalidated, the ones that now hold are replaced by their maximal non-FD subsets and
+ *   the positive cover of the RHS is induced again from its negative cover.
+ * An update is a delete of the old row and an insert of the new one under the same row index.
+ *
+ * The approach follows DynFD: Philipp Schirmer, Thorsten Papenbrock, Sebastian Kruse, Felix
+ * Naumann, Dennis Hempfing, Torben Mayer, and Daniel Neuschäfer-Rube. 2019. DynFD: Functional
+ * Dependency Discovery in Dynamic Datasets. In Proceedings of the 22nd International Conference on
+ * Extending Database Technology (EDBT 2019).
+ */
+class DynFD : public FDAlgorithm {
+private:
+    using RowPair = dyn::RowPair;
+
+    config::InputTable input_table_;
+    config::InputTable insert_statements_table_ = nullptr;
+    config::InputTable update_statements_table_ = nullptr;
+    std::unordered_set<size_t> delete_statement_indices_;
+    config::ThreadNumType threads_num_;
+    config::EqNullsType is_null_equal_null_;
+
+    std::unique_ptr<RelationalSchema> schema_;
+    std::unique_ptr<model::DynamicTableData> table_data_;
+    dyn::ColumnPLIs column_plis_;
+
+    std::shared_ptr<hyfd::fd_tree::FDTree> positive_cover_;
+    std::unique_ptr<hyfd::Inductor> inductor_;
+    // maximal non-FD LHSs of every RHS with a pair of rows violating them
+    std::vector<std::unique_ptr<dyn::NegativeCover>> negative_covers_;
+
+    void RegisterOptions();
+    void MakeExecuteOptsAvailableFDInternal() final;
+    void LoadDataInternal() final;
+    unsigned long long ExecuteInternal() final;
+
+    void ResetStateFd() final {}
+
+    // the dictionary gives the empty cells one id, so nulls are told apart only by the option
+    bool AreEqual(size_t first_row, size_t second_row, size_t column) const {
+        return table_data_->GetValueId(first_row, column) ==
+                       table_data_->GetValueId(second_row, column) &&
+               (is_null_equal_null_ || !table_data_->IsNull(first_row, column));
+    }
+
+    boost::dynamic_bitset<> GetAgreeSet(RowPair const& rows) const;
+
+    /* Finds a pair of rows violating lhs -> rhs. If changed_rows is not null, the FD is known to
+     * hold on the other rows and one row of the pair is taken from changed_rows. */
+    std::optional<RowPair> FindViolation(boost::dynamic_bitset<> const& lhs, size_t rhs,
+                                         std::vector<size_t> const* changed_rows) const;
+    std::optional<RowPair> FindViolationInTable(boost::dynamic_bitset<> const& lhs,
+                                                size_t rhs) const;
+
+    void AddNonFD(boost::dynamic_bitset<> const& lhs, size_t rhs, RowPair const& rows);
+    void AddNonFDsOf(RowPair const& rows);
+    void SampleNonFDs();
+    void ValidatePositiveCover(std::vector<size_t> const* changed_rows);
+    void RemoveRows(std::unordered_set<size_t> const& removed_rows);
+    void InducePositiveCover(std::vector<size_t> const& rhss);
+    void InsertRows(std::vector<size_t> const& changed_rows);
+    void RegisterFDs();
+
+public:
+    DynFD();
+};
+
+}  // namespace algos::dynfd
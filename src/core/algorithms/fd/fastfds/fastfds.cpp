@@ -1,23 +1,25 @@
 #include "fastfds.h"
 
 #include <algorithm>
-#include <mutex>
-#include <thread>
+#include <bitset>
+#include <cassert>
+#include <chrono>
+#include <iterator>
 
 #include <boost/asio/post.hpp>
 #include <boost/asio/thread_pool.hpp>
 #include <boost/dynamic_bitset.hpp>
-#include <boost/thread.hpp>
 #include <easylogging++.h>
 
+#include "algorithms/fd/fastfds/set_trie.h"
 #include "config/max_lhs/option.h"
 #include "config/thread_number/option.h"
 #include "model/table/agree_set_factory.h"
-#include "util/parallel_for.h"
+#include "util/bitset_utils.h"
 
 namespace algos {
 
-using std::vector, std::set;
+using std::vector;
 
 FastFDs::FastFDs(std::optional<ColumnLayoutRelationDataManager> relation_manager)
     : PliBasedFDAlgorithm({"Agree sets generation", "Finding minimal covers"}, relation_manager) {
@@ -26,23 +28,29 @@ FastFDs::FastFDs(std::optional<ColumnLayoutRelationDataManager> relation_manager
 
 void FastFDs::RegisterOptions() {
     RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    RegisterTimeLimitOption();
 }
 
 void FastFDs::MakeExecuteOptsAvailableFDInternal() {
     MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
 }
 
-void FastFDs::ResetStateFd() {
-    diff_sets_.clear();
-}
-
 unsigned long long FastFDs::ExecuteInternal() {
     schema_ = relation_->GetSchema();
     percent_per_col_ = kTotalProgressPercent / schema_->GetNumColumns();
 
+    size_t const num_columns = schema_->GetNumColumns();
+    if (num_columns <= 64) return Discover<std::bitset<64>>();
+    if (num_columns <= 128) return Discover<std::bitset<128>>();
+    if (num_columns <= 256) return Discover<std::bitset<256>>();
+    return Discover<boost::dynamic_bitset<>>();
+}
+
+template <typename DiffSet>
+unsigned long long FastFDs::Discover() {
     auto start_time = std::chrono::system_clock::now();
 
-    GenDiffSets();
+    vector<DiffSet> const diff_sets = GenDiffSets<DiffSet>();
     SetProgress(kTotalProgressPercent);
     ToNextProgressPhase();
 
@@ -50,41 +58,44 @@ unsigned long long FastFDs::ExecuteInternal() {
             std::chrono::system_clock::now() - start_time);
     LOG(INFO) << "TIME TO DIFF SETS GENERATION: " << elapsed_mills_to_gen_diff_sets.count();
 
-    if (diff_sets_.size() == 1 && diff_sets_.back() == *schema_->empty_vertical_) {
+    if (diff_sets.size() == 1 && diff_sets.back().none()) {
         auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
                 std::chrono::system_clock::now() - start_time);
         return elapsed_milliseconds.count();
     }
 
-    auto task = [this](std::unique_ptr<Column> const& column) {
-        if (ColumnContainsOnlyEqualValues(*column)) {
+    auto task = [this, &diff_sets](model::ColumnIndex column) {
+        if (ShouldStop()) return;
+        if (ColumnContainsOnlyEqualValues(column)) {
             LOG(DEBUG) << "Registered FD: " << schema_->empty_vertical_->ToString() << "->"
-                       << column->ToString();
-            RegisterFd(Vertical(), *column);
+                       << schema_->GetColumn(column)->ToString();
+            RegisterFd(Vertical(), *schema_->GetColumn(column));
             return;
         }
 
-        vector<DiffSet> diff_sets_mod = GetDiffSetsMod(*column);
+        vector<DiffSet> diff_sets_mod = GetDiffSetsMod(diff_sets, column);
         assert(!diff_sets_mod.empty());
-        if (!(diff_sets_mod.size() == 1 && diff_sets_mod.back() == *schema_->empty_vertical_)) {
-            set<Column, OrderingComparator> init_ordering = GetInitOrdering(diff_sets_mod, *column);
-            FindCovers(*column, diff_sets_mod, diff_sets_mod, *schema_->empty_vertical_,
-                       init_ordering);
+        if (!(diff_sets_mod.size() == 1 && diff_sets_mod.back().none())) {
+            Ordering init_ordering = GetInitOrdering(diff_sets_mod, column);
+            DiffSet const empty_path =
+                    util::BitsetTraits<DiffSet>::Create(schema_->GetNumColumns());
+            FindCovers(column, diff_sets_mod, diff_sets_mod, empty_path, 0, init_ordering);
         } else {
             AddProgress(percent_per_col_);
         }
     };
 
+    model::ColumnIndex const num_columns = schema_->GetNumColumns();
     if (threads_num_ > 1) {
         boost::asio::thread_pool pool(threads_num_);
 
-        for (std::unique_ptr<Column> const& column : schema_->GetColumns()) {
-            boost::asio::post(pool, [&column, task]() { return task(column); });
+        for (model::ColumnIndex column = 0; column != num_columns; ++column) {
+            boost::asio::post(pool, [column, &task]() { return task(column); });
         }
 
         pool.join();
     } else {
-        for (std::unique_ptr<Column> const& column : schema_->GetColumns()) {
+        for (model::ColumnIndex column = 0; column != num_columns; ++column) {
             task(column);
         }
     }
@@ -97,17 +108,18 @@ unsigned long long FastFDs::ExecuteInternal() {
     return elapsed_milliseconds.count();
 }
 
-bool FastFDs::ColumnContainsOnlyEqualValues(Column const& column) const {
-    auto pli = relation_->GetColumnData(column.GetIndex()).GetPositionListIndex();
+bool FastFDs::ColumnContainsOnlyEqualValues(model::ColumnIndex column) const {
+    auto pli = relation_->GetColumnData(column).GetPositionListIndex();
     bool column_contains_only_equal_values = pli->IsConstant();
 
     return column_contains_only_equal_values;
 }
 
-void FastFDs::FindCovers(Column const& attribute, vector<DiffSet> const& diff_sets_mod,
-                         vector<DiffSet> const& cur_diff_sets, Vertical const& path,
-                         set<Column, OrderingComparator> const& ordering) {
-    if (path.GetArity() > max_lhs_) {
+template <typename DiffSet>
+void FastFDs::FindCovers(model::ColumnIndex attribute, vector<DiffSet> const& diff_sets_mod,
+                         vector<DiffSet> const& cur_diff_sets, DiffSet const& path,
+                         unsigned path_arity, Ordering const& ordering) {
+    if (path_arity > max_lhs_) {
         return;
     }
 
@@ -117,155 +129,151 @@ void FastFDs::FindCovers(Column const& attribute, vector<DiffSet> const& diff_se
 
     if (cur_diff_sets.empty()) {
         if (CoverMinimal(path, diff_sets_mod)) {
-            LOG(DEBUG) << "Registered FD: " << path.ToString() << "->" << attribute.ToString();
-            RegisterFd(path, attribute);
+            Vertical lhs = schema_->GetVertical(
+                    util::BitsetTraits<DiffSet>::ToDynamic(path, schema_->GetNumColumns()));
+            Column const& rhs = *schema_->GetColumn(attribute);
+            LOG(DEBUG) << "Registered FD: " << lhs.ToString() << "->" << rhs.ToString();
+            RegisterFd(std::move(lhs), rhs);
             return;
         }
         return;  // wasted effort, non-minimal result
     }
 
-    for (Column const& column : ordering) {
+    for (model::ColumnIndex column : ordering) {
         vector<DiffSet> next_diff_sets;
         for (DiffSet const& diff_set : cur_diff_sets) {
-            if (!diff_set.Contains(column)) {
+            if (!diff_set.test(column)) {
                 next_diff_sets.push_back(diff_set);
             }
         }
 
         auto next_ordering = GetNextOrdering(next_diff_sets, column, ordering);
-        FindCovers(attribute, diff_sets_mod, next_diff_sets, path.Union(column), next_ordering);
+        DiffSet next_path = path;
+        next_path.set(column);
+        FindCovers(attribute, diff_sets_mod, next_diff_sets, next_path, path_arity + 1,
+                   next_ordering);
 
         // First FindCovers call, calculate progress
-        if (path.GetArity() == 0) {
+        if (path_arity == 0) {
             AddProgress(percent_per_col_ / ordering.size());
         }
     }
 }
 
-bool FastFDs::IsCover(Vertical const& candidate, vector<Vertical> const& sets) const {
-    bool covers = true;
-
-    for (Vertical const& set : sets) {
-        if (!set.Intersects(candidate)) {
-            covers = false;
-            break;
-        }
-    }
-
-    return covers;
+template <typename DiffSet>
+bool FastFDs::IsCover(DiffSet const& candidate, vector<DiffSet> const& sets) const {
+    return std::all_of(sets.begin(), sets.end(), [&candidate](DiffSet const& set) {
+        return util::BitsetTraits<DiffSet>::Intersects(set, candidate);
+    });
 }
 
-bool FastFDs::CoverMinimal(Vertical const& cover, vector<DiffSet> const& diff_sets_mod) const {
-    for (Column const* column : cover.GetColumns()) {
-        Vertical subset = cover.Without(*column);
-        bool subset_covers = IsCover(subset, diff_sets_mod);
-        if (subset_covers) {
-            return false;  // cover is not minimal
+template <typename DiffSet>
+bool FastFDs::CoverMinimal(DiffSet const& cover, vector<DiffSet> const& diff_sets_mod) const {
+    bool is_minimal = true;
+    DiffSet subset = cover;
+    util::BitsetTraits<DiffSet>::ForEach(cover, [&](size_t column) {
+        if (!is_minimal) return;
+        subset.reset(column);
+        if (IsCover(subset, diff_sets_mod)) {
+            is_minimal = false;  // cover is not minimal
         }
-    }
-    return true;  // cover is minimal
+        subset.set(column);
+    });
+    return is_minimal;
 }
 
-bool FastFDs::OrderingComp(vector<DiffSet> const& diff_sets, Column const& l_col,
-                           Column const& r_col) const {
-    unsigned cov_l = 0;
-    unsigned cov_r = 0;
-
+template <typename DiffSet>
+FastFDs::Ordering FastFDs::MakeOrdering(vector<DiffSet> const& diff_sets,
+                                        vector<model::ColumnIndex> columns,
+                                        bool skip_uncovered) const {
+    // Number of sets in `diff_sets` each column belongs to, counted in a single pass
+    vector<unsigned> coverage(schema_->GetNumColumns(), 0);
     for (DiffSet const& diff_set : diff_sets) {
-        if (diff_set.Contains(l_col)) {
-            ++cov_l;
-        }
-        if (diff_set.Contains(r_col)) {
-            ++cov_r;
-        }
+        util::BitsetTraits<DiffSet>::ForEach(diff_set,
+                                             [&coverage](size_t column) { ++coverage[column]; });
     }
 
-    if (cov_l != cov_r) {
-        return cov_l > cov_r;
+    if (skip_uncovered) {
+        columns.erase(std::remove_if(columns.begin(), columns.end(),
+                                     [&coverage](model::ColumnIndex column) {
+                                         return coverage[column] == 0;
+                                     }),
+                      columns.end());
     }
-
-    return l_col > r_col;
+    std::sort(columns.begin(), columns.end(),
+              [&coverage](model::ColumnIndex l_col, model::ColumnIndex r_col) {
+                  if (coverage[l_col] != coverage[r_col]) {
+                      return coverage[l_col] > coverage[r_col];
+                  }
+                  return l_col < r_col;
+              });
+    return columns;
 }
 
-set<Column, FastFDs::OrderingComparator> FastFDs::GetInitOrdering(vector<DiffSet> const& diff_sets,
-                                                                  Column const& attribute) const {
-    auto ordering_comp = [&diff_sets, this](Column const& l_col, Column const& r_col) {
-        return OrderingComp(diff_sets, l_col, r_col);
-    };
-    set<Column, OrderingComparator> ordering(ordering_comp);
-
-    for (auto const& col : schema_->GetColumns()) {
-        if (*col != attribute) {
-            ordering.insert(*col);
+template <typename DiffSet>
+FastFDs::Ordering FastFDs::GetInitOrdering(vector<DiffSet> const& diff_sets,
+                                           model::ColumnIndex attribute) const {
+    vector<model::ColumnIndex> columns;
+    columns.reserve(schema_->GetNumColumns() - 1);
+    for (model::ColumnIndex column = 0; column != schema_->GetNumColumns(); ++column) {
+        if (column != attribute) {
+            columns.push_back(column);
         }
     }
 
-    return ordering;
+    return MakeOrdering(diff_sets, std::move(columns), false);
 }
 
-set<Column, FastFDs::OrderingComparator> FastFDs::GetNextOrdering(
-        vector<DiffSet> const& diff_sets, Column const& attribute,
-        set<Column, OrderingComparator> const& cur_ordering) const {
-    auto ordering_comp = [&diff_sets, this](Column const& l_col, Column const& r_col) {
-        return OrderingComp(diff_sets, l_col, r_col);
-    };
-    set<Column, OrderingComparator> ordering(ordering_comp);
-    // columns that are contained in at least one diff set
-    std::unordered_set<Column> diff_sets_cols;
-
-    for (DiffSet const& diff_set : diff_sets) {
-        for (Column const* const col : diff_set.GetColumns()) {
-            diff_sets_cols.insert(*col);
-        }
-    }
-
-    auto p = cur_ordering.find(attribute);
+template <typename DiffSet>
+FastFDs::Ordering FastFDs::GetNextOrdering(vector<DiffSet> const& diff_sets,
+                                           model::ColumnIndex attribute,
+                                           Ordering const& cur_ordering) const {
+    auto p = std::find(cur_ordering.begin(), cur_ordering.end(), attribute);
     assert(p != cur_ordering.end());
-    for (++p; p != cur_ordering.end(); ++p) {
-        if (diff_sets_cols.find(*p) != diff_sets_cols.end()) {
-            ordering.insert(*p);
-        }
-    }
-    return ordering;
+
+    // only columns that are contained in at least one diff set
+    return MakeOrdering(diff_sets, vector<model::ColumnIndex>(std::next(p), cur_ordering.end()),
+                        true);
 }
 
 /* Metanome uses thread pool here. No need for it because main loop over columns in
  * execute() is parallelized, this approach should be much better.
  */
-vector<FastFDs::DiffSet> FastFDs::GetDiffSetsMod(Column const& col) const {
+template <typename DiffSet>
+vector<DiffSet> FastFDs::GetDiffSetsMod(vector<DiffSet> const& diff_sets,
+                                        model::ColumnIndex col) const {
     vector<DiffSet> diff_sets_mod;
+    fastfds::SetTrie<DiffSet> min_diff_sets;
 
-    /* diff_sets_ is sorted, before adding next diff_set to
-     * diff_sets_mod need to check if diff_sets_mod contains
+    /* diff_sets is sorted by cardinality, so before adding next diff_set to
+     * diff_sets_mod it is enough to check if diff_sets_mod contains
      * a subset of diff_set, that means that diff_set
-     * is not minimal.
+     * is not minimal. The subset query is answered by the set-trie.
      */
-    for (DiffSet const& diff_set : diff_sets_) {
-        if (diff_set.Contains(col)) {
-            bool is_miminal = true;
-
-            for (DiffSet const& min_diff_set : diff_sets_mod) {
-                if (diff_set.Contains(min_diff_set)) {
-                    is_miminal = false;
-                    break;
-                }
-            }
-
-            if (is_miminal) {
-                diff_sets_mod.push_back(diff_set.Without(col));
+    for (DiffSet const& diff_set : diff_sets) {
+        if (diff_set.test(col)) {
+            DiffSet diff_set_mod = diff_set;
+            diff_set_mod.reset(col);
+            if (!min_diff_sets.ContainsSubsetOf(diff_set_mod)) {
+                min_diff_sets.Insert(diff_set_mod);
+                diff_sets_mod.push_back(std::move(diff_set_mod));
             }
         }
     }
 
-    LOG(DEBUG) << "Compute minimal difference sets modulo " << col.ToString() << ":";
+    LOG(DEBUG) << "Compute minimal difference sets modulo " << schema_->GetColumn(col)->ToString()
+               << ":";
     for (auto& item : diff_sets_mod) {
-        LOG(DEBUG) << item.ToString();
+        LOG(DEBUG) << schema_->GetVertical(util::BitsetTraits<DiffSet>::ToDynamic(
+                                                   item, schema_->GetNumColumns()))
+                              .ToString();
     }
 
     return diff_sets_mod;
 }
 
-void FastFDs::GenDiffSets() {
+template <typename DiffSet>
+vector<DiffSet> FastFDs::GenDiffSets() {
     model::AgreeSetFactory::Configuration c;
     c.threads_num = threads_num_;
     if (threads_num_ > 1) {
@@ -281,29 +289,27 @@ void FastFDs::GenDiffSets() {
     }
 
     // Complement agree sets to get difference sets
-    diff_sets_.reserve(agree_sets.size());
-    if (threads_num_ > 1) {
-        std::mutex m;
-        auto const task = [&m, this](model::AgreeSet const& as) {
-            DiffSet diff_set = as.Invert();
-            std::lock_guard lock(m);
-            diff_sets_.push_back(std::move(diff_set));
-        };
-
-        util::ParallelForeach(agree_sets.begin(), agree_sets.end(), threads_num_, task);
-    } else {
-        for (model::AgreeSet const& agree_set : agree_sets) {
-            diff_sets_.push_back(agree_set.Invert());
-        }
+    vector<DiffSet> diff_sets;
+    diff_sets.reserve(agree_sets.size());
+    for (model::AgreeSet const& agree_set : agree_sets) {
+        diff_sets.push_back(
+                util::BitsetTraits<DiffSet>::FromDynamic(~agree_set.GetColumnIndices()));
     }
 
-    // sort diff_sets_, it will be used further to find minimal difference sets modulo column
-    std::sort(diff_sets_.begin(), diff_sets_.end());
+    /* sort diff_sets by cardinality, a subset always precedes its supersets then.
+     * It will be used further to find minimal difference sets modulo column
+     */
+    std::sort(diff_sets.begin(), diff_sets.end(),
+              [](DiffSet const& lhs, DiffSet const& rhs) { return lhs.count() < rhs.count(); });
 
     LOG(DEBUG) << "Compute difference sets:";
-    for (auto const& diff_set : diff_sets_) {
-        LOG(DEBUG) << diff_set.ToString();
+    for (auto const& diff_set : diff_sets) {
+        LOG(DEBUG) << schema_->GetVertical(util::BitsetTraits<DiffSet>::ToDynamic(
+                                                   diff_set, schema_->GetNumColumns()))
+                              .ToString();
     }
+
+    return diff_sets;
 }
 
 }  // namespace algos
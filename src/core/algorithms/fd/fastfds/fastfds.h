@@ -1,74 +1,84 @@
 #pragma once
 
-#include <functional>
-#include <set>
-
-#include <boost/thread/mutex.hpp>
+#include <vector>
 
 #include "algorithms/fd/pli_based_fd_algorithm.h"
 #include "config/thread_number/type.h"
+#include "model/table/column_index.h"
 #include "model/table/column_layout_relation_data.h"
 #include "model/table/vertical.h"
 
 namespace algos {
 
+/* Difference sets and paths of the search are represented by the narrowest bitset that fits the
+ * relation: std::bitset<64/128/256> for relations of up to 256 columns (no allocations, word-wise
+ * operations) and boost::dynamic_bitset<> for wider ones. See util::BitsetTraits.
+ */
 class FastFDs : public PliBasedFDAlgorithm {
 public:
     FastFDs(std::optional<ColumnLayoutRelationDataManager> relation_manager = std::nullopt);
 
 private:
-    using OrderingComparator = std::function<bool(Column const&, Column const&)>;
-    using DiffSet = Vertical;
+    /* Columns ordered by the number of covered difference sets (descending),
+     * ties are resolved by the column index (ascending)
+     */
+    using Ordering = std::vector<model::ColumnIndex>;
 
     void RegisterOptions();
     void MakeExecuteOptsAvailableFDInternal() final;
 
-    void ResetStateFd() final;
+    void ResetStateFd() final {}
     unsigned long long ExecuteInternal() final;
 
+    template <typename DiffSet>
+    unsigned long long Discover();
+
     // Computes all difference sets of `relation_` by complementing agree sets
-    void GenDiffSets();
+    template <typename DiffSet>
+    std::vector<DiffSet> GenDiffSets();
 
     /* Computes minimal difference sets
      * of `relation_` modulo `col`
      */
-    std::vector<DiffSet> GetDiffSetsMod(Column const& col) const;
+    template <typename DiffSet>
+    std::vector<DiffSet> GetDiffSetsMod(std::vector<DiffSet> const& diff_sets,
+                                        model::ColumnIndex col) const;
     /* Returns initial ordering,
      * the total ordering of { schema_->GetColumns() \ `attribute` } according to `diff_sets`
      */
-    std::set<Column, OrderingComparator> GetInitOrdering(std::vector<DiffSet> const& diff_sets,
-                                                         Column const& attribute) const;
+    template <typename DiffSet>
+    Ordering GetInitOrdering(std::vector<DiffSet> const& diff_sets,
+                             model::ColumnIndex attribute) const;
     /* Returns next ordering,
      * the total ordering of { B in schema_->GetColumns() | B > `attribute` (in `cur_ordering`) }
      * according to `diff_sets`
      */
-    std::set<Column, OrderingComparator> GetNextOrdering(
-            std::vector<DiffSet> const& diff_sets, Column const& attribute,
-            std::set<Column, OrderingComparator> const& cur_ordering) const;
-    void FindCovers(Column const& attribute, std::vector<DiffSet> const& diff_sets_mod,
-                    std::vector<DiffSet> const& cur_diff_sets, Vertical const& path,
-                    std::set<Column, OrderingComparator> const& ordering);
+    template <typename DiffSet>
+    Ordering GetNextOrdering(std::vector<DiffSet> const& diff_sets, model::ColumnIndex attribute,
+                             Ordering const& cur_ordering) const;
+    /* Returns `columns` sorted by the number of sets in `diff_sets` they belong to, the columns
+     * that do not belong to any set are skipped if `skip_uncovered` is true
+     */
+    template <typename DiffSet>
+    Ordering MakeOrdering(std::vector<DiffSet> const& diff_sets,
+                          std::vector<model::ColumnIndex> columns, bool skip_uncovered) const;
+    template <typename DiffSet>
+    void FindCovers(model::ColumnIndex attribute, std::vector<DiffSet> const& diff_sets_mod,
+                    std::vector<DiffSet> const& cur_diff_sets, DiffSet const& path,
+                    unsigned path_arity, Ordering const& ordering);
     /* Returns true if `cover` is the minimal cover of `diff_sets_mod`,
      * false otherwise
      */
-    bool CoverMinimal(Vertical const& cover, std::vector<DiffSet> const& diff_sets_mod) const;
+    template <typename DiffSet>
+    bool CoverMinimal(DiffSet const& cover, std::vector<DiffSet> const& diff_sets_mod) const;
     /* Returns true if `candidate` covers `sets`,
      * false otherwise
      */
-    bool IsCover(Vertical const& candidate, std::vector<Vertical> const& sets) const;
-    /* Returns true if `l_col` > `r_col`,
-     * false otherwise.
-     * `l_col` > `r_col` iff
-     * `l_col` covers more sets in `diff_sets` than `r_col` or
-     * `l_col` and `r_col` cover the same number of sets but
-     * `l_col` index less than `r_col` index
-     */
-    bool OrderingComp(std::vector<DiffSet> const& diff_sets, Column const& l_col,
-                      Column const& r_col) const;
-    bool ColumnContainsOnlyEqualValues(Column const& column) const;
+    template <typename DiffSet>
+    bool IsCover(DiffSet const& candidate, std::vector<DiffSet> const& sets) const;
+    bool ColumnContainsOnlyEqualValues(model::ColumnIndex column) const;
 
     RelationalSchema const* schema_;
-    std::vector<DiffSet> diff_sets_;
     config::ThreadNumType threads_num_;
     double percent_per_col_;
 };
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "util/bitset_utils.h"
+
+namespace algos::fastfds {
+
+/* Prefix tree over sets of attributes (attributes of a set are visited in ascending order).
+ * Answers "does the trie contain a subset of the given set" by descending only into children
+ * whose attribute belongs to the queried set, instead of comparing with every stored set.
+ */
+template <typename Bitset>
+class SetTrie {
+private:
+    using Traits = util::BitsetTraits<Bitset>;
+
+    struct Node {
+        std::vector<std::pair<std::size_t, std::unique_ptr<Node>>> children;
+        bool is_set_end = false;
+    };
+
+    Node root_;
+
+    static bool ContainsSubsetOf(Node const& node, Bitset const& set) {
+        if (node.is_set_end) return true;
+        for (auto const& [attribute, child] : node.children) {
+            if (set.test(attribute) && ContainsSubsetOf(*child, set)) return true;
+        }
+        return false;
+    }
+
+public:
+    void Insert(Bitset const& set) {
+        Node* node = &root_;
+        Traits::ForEach(set, [&node](std::size_t attribute) {
+            auto it = node->children.begin();
+            while (it != node->children.end() && it->first != attribute) ++it;
+            if (it == node->children.end()) {
+                node->children.emplace_back(attribute, std::make_unique<Node>());
+                it = std::prev(node->children.end());
+            }
+            node = it->second.get();
+        });
+        node->is_set_end = true;
+    }
+
+    // Returns true if the trie contains a subset (not necessarily proper) of `set`
+    bool ContainsSubsetOf(Bitset const& set) const {
+        return ContainsSubsetOf(root_, set);
+    }
+};
+
+}  // namespace algos::fastfds
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filesystem>
+#include <functional>
 #include <list>
 #include <mutex>
 
@@ -66,6 +67,14 @@ public:
         return fd_collection_.AsList();
     }
 
+    /* Passes every FD to the consumer as soon as it is registered, possibly from a worker thread
+     * of the algorithm, but never concurrently. Returning false stops the execution early, see
+     * RequestStop. The FDs are collected in FdList() as well. nullptr removes the consumer.
+     */
+    void SetFdConsumer(std::function<bool(FD const&)> consumer) {
+        SetPrimitiveConsumer(fd_collection_, std::move(consumer));
+    }
+
     /* возвращает набор ФЗ в виде JSON-а. По сути, это просто представление фиксированного формата
      * для сравнения результатов разных алгоритмов. JSON - на всякий случай, если потом, например,
      * понадобится загрузить список в питон и как-нибудь его поанализировать
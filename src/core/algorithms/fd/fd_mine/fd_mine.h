@@ -1,42 +1,27 @@
 #pragma once
 
-#include <filesystem>
-#include <set>
-
-#include <boost/dynamic_bitset.hpp>
-#include <boost/unordered_map.hpp>
-
 #include "algorithms/fd/pli_based_fd_algorithm.h"
+#include "config/thread_number/type.h"
 #include "model/table/column_layout_relation_data.h"
-#include "model/table/position_list_index.h"
 #include "model/table/vertical.h"
 
 namespace algos {
 
+/* Column sets are represented by std::bitset<64/128/256> for relations of up to 256 columns and
+ * by boost::dynamic_bitset<> for wider ones, see fd_mine::Miner.
+ */
 class FdMine : public PliBasedFDAlgorithm {
 private:
     RelationalSchema const* schema_;
+    config::ThreadNumType threads_num_;
+
+    void RegisterOptions();
+    void MakeExecuteOptsAvailableFDInternal() final;
+
+    template <typename ColumnSet>
+    void Mine();
 
-    std::set<boost::dynamic_bitset<>> candidate_set_;
-    boost::unordered_map<boost::dynamic_bitset<>, std::unordered_set<boost::dynamic_bitset<>>>
-            eq_set_;
-    boost::unordered_map<boost::dynamic_bitset<>, boost::dynamic_bitset<>> fd_set_;
-    boost::unordered_map<boost::dynamic_bitset<>, boost::dynamic_bitset<>> final_fd_set_;
-    std::set<boost::dynamic_bitset<>> key_set_;
-    boost::unordered_map<boost::dynamic_bitset<>, boost::dynamic_bitset<>> closure_;
-    boost::unordered_map<boost::dynamic_bitset<>, std::shared_ptr<model::PositionListIndex const>>
-            plis_;
-    boost::dynamic_bitset<> relation_indices_;
-
-    void ComputeNonTrivialClosure(boost::dynamic_bitset<> const& xi);
-    void ObtainFDandKey(boost::dynamic_bitset<> const& xi);
-    void ObtainEqSet();
-    void PruneCandidates();
-    void GenerateNextLevelCandidates();
-    void Reconstruct();
-    void Display();
-
-    void ResetStateFd() final;
+    void ResetStateFd() final {}
     unsigned long long ExecuteInternal() override;
 
 public:
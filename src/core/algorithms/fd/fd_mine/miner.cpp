@@ -0,0 +1,339 @@
+#include "miner.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cassert>
+#include <numeric>
+#include <queue>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "util/parallel_for.h"
+
+namespace algos::fd_mine {
+
+template <typename ColumnSet>
+Miner<ColumnSet>::Miner(ColumnLayoutRelationData const& relation, unsigned threads_num)
+    : relation_(relation),
+      num_columns_(relation.GetNumColumns()),
+      threads_num_(threads_num),
+      relation_indices_(Traits::Create(num_columns_)) {}
+
+template <typename ColumnSet>
+template <typename F>
+void Miner<ColumnSet>::ParallelFor(std::size_t size, F f) const {
+    std::vector<std::size_t> indices(size);
+    std::iota(indices.begin(), indices.end(), 0);
+    util::ParallelForeach(indices.begin(), indices.end(), threads_num_, f);
+}
+
+template <typename ColumnSet>
+void Miner<ColumnSet>::Mine(FdConsumer const& register_fds,
+                            std::function<bool()> const& is_stopped) {
+    // 1
+    for (model::ColumnIndex column_index = 0; column_index < num_columns_; column_index++) {
+        ColumnSet tmp = Traits::Create(num_columns_);
+        tmp.set(column_index);
+        relation_indices_.set(column_index);
+        candidate_set_.push_back(std::move(tmp));
+    }
+
+    // 2
+    while (!candidate_set_.empty()) {
+        if (is_stopped()) {
+            for (auto const& [lhs, closure] : fd_set_) {
+                register_fds(lhs, closure);
+            }
+            return;
+        }
+        // Elements of closure_ may move on insertion, so pointers are taken after all insertions
+        for (ColumnSet const& candidate : candidate_set_) {
+            closure_.try_emplace(candidate, Traits::Create(num_columns_));
+        }
+        std::vector<ColumnSet*> closures;
+        closures.reserve(candidate_set_.size());
+        for (ColumnSet const& candidate : candidate_set_) {
+            closures.push_back(&closure_.find(candidate)->second);
+        }
+
+        std::vector<std::vector<std::pair<ColumnSet, PliPtr>>> new_plis(candidate_set_.size());
+        ParallelFor(candidate_set_.size(), [this, &closures, &new_plis](std::size_t i) {
+            new_plis[i] = ComputeNonTrivialClosure(candidate_set_[i], *closures[i]);
+        });
+        for (auto& candidate_plis : new_plis) {
+            for (auto& [column_set, pli] : candidate_plis) {
+                plis_.try_emplace(column_set, std::move(pli));
+            }
+        }
+
+        for (ColumnSet const& candidate : candidate_set_) {
+            ObtainFDandKey(candidate);
+        }
+        ObtainEqSet();
+        PruneCandidates();
+        GenerateNextLevelCandidates();
+    }
+
+    // 3
+    Reconstruct();
+    for (auto const& [lhs, rhs] : final_fd_set_) {
+        register_fds(lhs, rhs);
+    }
+}
+
+template <typename ColumnSet>
+std::vector<std::pair<ColumnSet, typename Miner<ColumnSet>::PliPtr>>
+Miner<ColumnSet>::ComputeNonTrivialClosure(ColumnSet const& xi, ColumnSet& closure) const {
+    std::vector<std::pair<ColumnSet, PliPtr>> new_plis;
+    bool const is_single_column = xi.count() == 1;
+    model::PositionListIndex const* xi_pli = is_single_column
+                                                     ? GetColumnPli(Traits::FindFirst(xi))
+                                                     : plis_.find(xi)->second.get();
+
+    ColumnSet const candidates_y = Difference(Difference(relation_indices_, xi), closure);
+    Traits::ForEach(candidates_y, [&](std::size_t column_index) {
+        ColumnSet candidate_xy = xi;
+        candidate_xy.set(column_index);
+
+        model::PositionListIndex const* xy_pli;
+        if (auto it = plis_.find(candidate_xy); !is_single_column && it != plis_.end()) {
+            xy_pli = it->second.get();
+        } else {
+            PliPtr pli = xi_pli->Intersect(GetColumnPli(column_index));
+            xy_pli = pli.get();
+            new_plis.emplace_back(std::move(candidate_xy), std::move(pli));
+        }
+
+        if (xi_pli->GetNumCluster() == xy_pli->GetNumCluster()) {
+            closure.set(column_index);
+        }
+    });
+    return new_plis;
+}
+
+template <typename ColumnSet>
+void Miner<ColumnSet>::ObtainFDandKey(ColumnSet const& xi) {
+    ColumnSet const& closure = GetClosure(xi);
+    fd_set_[xi] = closure;
+    if (relation_indices_ == (xi | closure)) {
+        key_set_.insert(xi);
+    }
+}
+
+template <typename ColumnSet>
+void Miner<ColumnSet>::ObtainEqSet() {
+    std::vector<std::vector<ColumnSet>> equivalent_lhss(candidate_set_.size());
+    ParallelFor(candidate_set_.size(), [this, &equivalent_lhss](std::size_t i) {
+        ColumnSet const& candidate = candidate_set_[i];
+        ColumnSet const& candidate_closure = GetClosure(candidate);
+        for (auto const& [lhs, closure] : fd_set_) {
+            auto common_atrs = candidate & lhs;
+            if (Traits::IsSubset(Difference(candidate, common_atrs), closure) &&
+                Traits::IsSubset(Difference(lhs, common_atrs), candidate_closure)) {
+                if (lhs != candidate) {
+                    equivalent_lhss[i].push_back(lhs);
+                }
+            }
+        }
+    });
+
+    for (std::size_t i = 0; i < candidate_set_.size(); ++i) {
+        ColumnSet const& candidate = candidate_set_[i];
+        for (ColumnSet const& lhs : equivalent_lhss[i]) {
+            eq_set_[lhs].insert(candidate);
+            eq_set_[candidate].insert(lhs);
+        }
+    }
+}
+
+template <typename ColumnSet>
+void Miner<ColumnSet>::PruneCandidates() {
+    // Candidates are pruned in order, a pruned candidate does not prune the following ones
+    Set remaining;
+    remaining.reserve(candidate_set_.size());
+    for (ColumnSet const& candidate : candidate_set_) {
+        remaining.insert(candidate);
+    }
+
+    std::vector<ColumnSet> pruned_candidate_set;
+    for (ColumnSet const& xi : candidate_set_) {
+        bool found = false;
+        if (auto it = eq_set_.find(xi); it != eq_set_.end()) {
+            found = std::any_of(it->second.begin(), it->second.end(),
+                                [&remaining](ColumnSet const& xj) { return remaining.count(xj); });
+        }
+
+        if (found || key_set_.count(xi)) {
+            remaining.erase(xi);
+            continue;
+        }
+        pruned_candidate_set.push_back(xi);
+    }
+    candidate_set_ = std::move(pruned_candidate_set);
+}
+
+template <typename ColumnSet>
+void Miner<ColumnSet>::GenerateNextLevelCandidates() {
+    struct Join {
+        std::size_t i;
+        std::size_t j;
+        ColumnSet candidate_ij;
+    };
+    std::vector<Join> joins;
+
+    for (std::size_t i = 0; i < candidate_set_.size(); i++) {
+        ColumnSet const& candidate_i = candidate_set_[i];
+
+        for (std::size_t j = i + 1; j < candidate_set_.size(); j++) {
+            ColumnSet const& candidate_j = candidate_set_[j];
+
+            // apriori-gen
+            bool similar = true;
+            std::size_t set_bits = 0;
+
+            assert(candidate_i.count() != 0);
+            for (std::size_t k = 0; set_bits < candidate_i.count() - 1; k++) {
+                if (candidate_i[k] == candidate_j[k]) {
+                    if (candidate_i[k]) {
+                        set_bits++;
+                    }
+                } else {
+                    similar = false;
+                    break;
+                }
+            }
+            //
+
+            if (similar && !Traits::IsSubset(candidate_j, fd_set_.find(candidate_i)->second) &&
+                !Traits::IsSubset(candidate_i, fd_set_.find(candidate_j)->second)) {
+                joins.push_back({i, j, candidate_i | candidate_j});
+            }
+        }
+    }
+
+    /* PLIs of the most of the new candidates have been computed along with closures of the
+     * current level, only the missing ones are computed here
+     */
+    std::vector<std::size_t> missing_plis;
+    Set scheduled;
+    for (std::size_t join = 0; join < joins.size(); ++join) {
+        ColumnSet const& candidate_ij = joins[join].candidate_ij;
+        if (plis_.find(candidate_ij) == plis_.end() && scheduled.insert(candidate_ij).second) {
+            missing_plis.push_back(join);
+        }
+    }
+    std::vector<PliPtr> new_plis(missing_plis.size());
+    ParallelFor(missing_plis.size(), [this, &joins, &missing_plis, &new_plis](std::size_t k) {
+        Join const& join = joins[missing_plis[k]];
+        ColumnSet const& candidate_i = candidate_set_[join.i];
+        ColumnSet const& candidate_j = candidate_set_[join.j];
+        if (candidate_i.count() == 1) {
+            new_plis[k] = GetColumnPli(Traits::FindFirst(candidate_i))
+                                  ->Intersect(GetColumnPli(Traits::FindFirst(candidate_j)));
+        } else {
+            new_plis[k] = plis_.find(candidate_i)->second->Intersect(
+                    plis_.find(candidate_j)->second.get());
+        }
+    });
+    for (std::size_t k = 0; k < missing_plis.size(); ++k) {
+        plis_.try_emplace(joins[missing_plis[k]].candidate_ij, std::move(new_plis[k]));
+    }
+
+    Set next_level;
+    std::vector<ColumnSet> next_candidate_set;
+    for (Join& join : joins) {
+        auto closure_ij = GetClosure(candidate_set_[join.i]) | GetClosure(candidate_set_[join.j]);
+        if (relation_indices_ == (join.candidate_ij | closure_ij)) {
+            key_set_.insert(join.candidate_ij);
+        } else if (next_level.insert(join.candidate_ij).second) {
+            next_candidate_set.push_back(std::move(join.candidate_ij));
+        }
+    }
+
+    std::sort(next_candidate_set.begin(), next_candidate_set.end(), Traits::Less);
+    candidate_set_ = std::move(next_candidate_set);
+}
+
+template <typename ColumnSet>
+std::pair<typename Miner<ColumnSet>::Set, ColumnSet> Miner<ColumnSet>::ReconstructFd(
+        ColumnSet const& lhs, ColumnSet const& rhs) const {
+    std::queue<ColumnSet> queue;
+    Set observed;
+
+    observed.insert(lhs);
+    auto rhs_copy = rhs;
+    queue.push(lhs);
+
+    for (auto const& [eq, eqset] : eq_set_) {
+        if (Traits::IsSubset(eq, rhs_copy)) {
+            for (auto const& eq_rhs : eqset) {
+                rhs_copy |= eq_rhs;
+            }
+        }
+    }
+    bool rhs_will_not_change = false;
+
+    while (!queue.empty()) {
+        ColumnSet current_lhs = std::move(queue.front());
+        queue.pop();
+        std::size_t rhs_count = rhs_copy.count();
+        for (auto const& [eq, eqset] : eq_set_) {
+            if (!rhs_will_not_change && Traits::IsSubset(eq, rhs_copy)) {
+                for (auto const& eq_rhs : eqset) {
+                    rhs_copy |= eq_rhs;
+                }
+            }
+
+            if (Traits::IsSubset(eq, current_lhs)) {
+                ColumnSet const generated_lhs_tmp = Difference(current_lhs, eq);
+                for (auto const& new_eq : eqset) {
+                    ColumnSet generated_lhs = generated_lhs_tmp | new_eq;
+                    if (observed.insert(generated_lhs).second) {
+                        queue.push(std::move(generated_lhs));
+                    }
+                }
+            }
+        }
+        if (rhs_count == rhs_copy.count()) {
+            rhs_will_not_change = true;
+        }
+    }
+
+    return {std::move(observed), std::move(rhs_copy)};
+}
+
+template <typename ColumnSet>
+void Miner<ColumnSet>::Reconstruct() {
+    std::vector<typename Map<ColumnSet>::value_type const*> fds;
+    fds.reserve(fd_set_.size());
+    for (auto const& fd : fd_set_) {
+        fds.push_back(&fd);
+    }
+
+    // FDs are reconstructed in blocks to limit the memory taken by the intermediate results
+    std::size_t const block_size = 1024 * threads_num_;
+    for (std::size_t block_begin = 0; block_begin < fds.size(); block_begin += block_size) {
+        std::size_t const block_end = std::min(fds.size(), block_begin + block_size);
+        std::vector<std::pair<Set, ColumnSet>> reconstructed(block_end - block_begin);
+        ParallelFor(reconstructed.size(), [this, &fds, &reconstructed, block_begin](std::size_t i) {
+            auto const& [lhs, rhs] = *fds[block_begin + i];
+            reconstructed[i] = ReconstructFd(lhs, rhs);
+        });
+
+        for (auto const& [observed, rhs] : reconstructed) {
+            for (ColumnSet const& lhs : observed) {
+                auto [it, inserted] = final_fd_set_.try_emplace(lhs, rhs);
+                if (!inserted) {
+                    it->second |= rhs;
+                }
+            }
+        }
+    }
+}
+
+template class Miner<std::bitset<64>>;
+template class Miner<std::bitset<128>>;
+template class Miner<std::bitset<256>>;
+template class Miner<boost::dynamic_bitset<>>;
+
+}  // namespace algos::fd_mine
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <hash_set2.hpp>
+#include <hash_table8.hpp>
+
+#include "model/table/column_index.h"
+#include "model/table/column_layout_relation_data.h"
+#include "model/table/position_list_index.h"
+#include "util/bitset_utils.h"
+
+namespace algos::fd_mine {
+
+/* Level-wise part of FD_Mine for column sets of type ColumnSet, which is either
+ * std::bitset<64/128/256> or boost::dynamic_bitset<> (see util::BitsetTraits).
+ * Closures and PLIs of the candidates of a level are computed on `threads_num` threads,
+ * the shared state is updated afterwards by the calling thread only.
+ */
+template <typename ColumnSet>
+class Miner {
+public:
+    // Called for every discovered left-hand side with the set of attributes it determines,
+    // the set may contain the left-hand side attributes
+    using FdConsumer = std::function<void(ColumnSet const& lhs, ColumnSet const& rhs)>;
+
+    Miner(ColumnLayoutRelationData const& relation, unsigned threads_num);
+
+    // Once is_stopped returns true, the remaining levels are skipped and every column set whose
+    // closure is known is registered with it, the LHSs equivalent to it are not derived then
+    void Mine(FdConsumer const& register_fds, std::function<bool()> const& is_stopped);
+
+private:
+    using Traits = util::BitsetTraits<ColumnSet>;
+    using PliPtr = std::shared_ptr<model::PositionListIndex const>;
+    template <typename T>
+    using Map = emhash8::HashMap<ColumnSet, T>;
+    using Set = emhash2::HashSet<ColumnSet>;
+
+    ColumnLayoutRelationData const& relation_;
+    model::ColumnIndex const num_columns_;
+    unsigned const threads_num_;
+
+    // Sorted in the ascending order of column sets, see Traits::Less
+    std::vector<ColumnSet> candidate_set_;
+    Map<Set> eq_set_;
+    Map<ColumnSet> fd_set_;
+    Map<ColumnSet> final_fd_set_;
+    Set key_set_;
+    Map<ColumnSet> closure_;
+    Map<PliPtr> plis_;
+    ColumnSet relation_indices_;
+
+    ColumnSet Difference(ColumnSet const& lhs, ColumnSet const& rhs) const {
+        return lhs & ~rhs;
+    }
+
+    model::PositionListIndex const* GetColumnPli(model::ColumnIndex column) const {
+        return relation_.GetColumnData(column).GetPositionListIndex();
+    }
+
+    ColumnSet const& GetClosure(ColumnSet const& xi) const {
+        return closure_.find(xi)->second;
+    }
+
+    // Calls f(i) for i in [0, size) on `threads_num_` threads
+    template <typename F>
+    void ParallelFor(std::size_t size, F f) const;
+
+    // Returns the PLIs computed for new column sets
+    std::vector<std::pair<ColumnSet, PliPtr>> ComputeNonTrivialClosure(ColumnSet const& xi,
+                                                                       ColumnSet& closure) const;
+    void ObtainFDandKey(ColumnSet const& xi);
+    void ObtainEqSet();
+    void PruneCandidates();
+    void GenerateNextLevelCandidates();
+    // Returns left-hand sides equivalent to `lhs` and their common closure
+    std::pair<Set, ColumnSet> ReconstructFd(ColumnSet const& lhs, ColumnSet const& rhs) const;
+    void Reconstruct();
+};
+
+}  // namespace algos::fd_mine
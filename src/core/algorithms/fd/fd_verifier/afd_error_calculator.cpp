@@ -0,0 +1,212 @@
+#include "algorithms/fd/fd_verifier/afd_error_calculator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include <easylogging++.h>
+
+#include "algorithms/fd/pfdtane/pfdtane.h"
+#include "algorithms/fd/tane/tane.h"
+#include "config/deduplicate_rows/option.h"
+#include "config/equal_nulls/option.h"
+#include "config/exceptions.h"
+#include "config/indices/validate_index.h"
+#include "config/names_and_descriptions.h"
+#include "config/option_using.h"
+#include "config/tabular_data/input_table/option.h"
+#include "config/thread_number/option.h"
+#include "util/parallel_for.h"
+
+namespace algos::fd_verifier {
+
+AfdErrorCalculator::AfdErrorCalculator() : Algorithm({}) {
+    RegisterOptions();
+    MakeOptionsAvailable({config::kTableOpt.GetName(), config::kEqualNullsOpt.GetName(),
+                          config::kDeduplicateRowsOpt.GetName()});
+}
+
+void AfdErrorCalculator::RegisterOptions() {
+    DESBORDANTE_OPTION_USING;
+
+    auto normalize_fds = [](config::FdsIndicesType& fds) {
+        auto normalize = [](config::IndicesType& indices) {
+            std::sort(indices.begin(), indices.end());
+            indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+        };
+        for (auto& [lhs, rhs] : fds) {
+            normalize(lhs);
+            normalize(rhs);
+        }
+    };
+    auto check_fds = [this](config::FdsIndicesType const& fds) {
+        size_t const num_columns = relation_->GetSchema()->GetNumColumns();
+        for (auto const& [lhs, rhs] : fds) {
+            if (lhs.empty() || rhs.empty()) {
+                throw config::ConfigurationError("Indices cannot be empty");
+            }
+            config::ValidateIndex(lhs.back(), num_columns);
+            config::ValidateIndex(rhs.back(), num_columns);
+        }
+    };
+
+    RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(config::kEqualNullsOpt(&is_null_equal_null_));
+    // the rows are deduplicated on load, so the threads option is needed at that stage then
+    RegisterOption(config::kDeduplicateRowsOpt(&deduplicate_rows_)
+                           .SetConditionalOpts({{[](bool deduplicate) { return deduplicate; },
+                                                 {config::kThreadNumberOpt.GetName()}}}));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    RegisterOption(Option{&fds_, kFdsIndices, kDFdsIndices}
+                           .SetNormalizeFunc(normalize_fds)
+                           .SetValueCheck(check_fds));
+}
+
+void AfdErrorCalculator::MakeExecuteOptsAvailable() {
+    using namespace config::names;
+
+    MakeOptionsAvailable({kFdsIndices, config::kThreadNumberOpt.GetName()});
+}
+
+void AfdErrorCalculator::LoadDataInternal() {
+    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_, is_null_equal_null_,
+                                                     deduplicate_rows_,
+                                                     deduplicate_rows_ ? threads_num_ : 1);
+    if (relation_->GetColumnData().empty()) {
+        throw std::runtime_error("Got an empty dataset: FD error calculation is meaningless.");
+    }
+    ResetPLICache();
+}
+
+/* Leaves only the column PLIs in the cache */
+void AfdErrorCalculator::ResetPLICache() {
+    RelationalSchema const* schema = relation_->GetSchema();
+    pli_cache_ = std::make_unique<model::BlockingVerticalMap<model::PLI>>(schema);
+    for (auto const& column : schema->GetColumns()) {
+        pli_cache_->Put(Vertical(*column),
+                        relation_->GetColumnData(column->GetIndex()).GetPliOwnership());
+    }
+    cached_tuple_indices_ = 0;
+}
+
+unsigned long long AfdErrorCalculator::ExecuteInternal() {
+    auto start_time = std::chrono::system_clock::now();
+
+    CalculatePLIs(PlanIntersections());
+    CalculateErrors();
+    if (cached_tuple_indices_ > kMaxCachedColumnPLIs * relation_->GetNumRows()) {
+        LOG(DEBUG) << "Dropping " << pli_cache_->GetSize() - relation_->GetNumColumns()
+                   << " cached intersections holding " << cached_tuple_indices_
+                   << " tuple indices";
+        ResetPLICache();
+    }
+
+    auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now() - start_time);
+    return elapsed_milliseconds.count();
+}
+
+Vertical AfdErrorCalculator::GetVertical(config::IndicesType const& indices) const {
+    RelationalSchema const* schema = relation_->GetSchema();
+    return schema->GetVertical(schema->IndicesToBitset(indices));
+}
+
+std::vector<AfdErrorCalculator::IntersectionLevel> AfdErrorCalculator::PlanIntersections() const {
+    RelationalSchema const* schema = relation_->GetSchema();
+
+    std::vector<size_t> lhs_frequencies(schema->GetNumColumns(), 0);
+    for (auto const& [lhs, rhs] : fds_) {
+        for (model::ColumnIndex column : lhs) {
+            ++lhs_frequencies[column];
+        }
+    }
+    auto const more_shared = [&lhs_frequencies](model::ColumnIndex first,
+                                                model::ColumnIndex second) {
+        if (lhs_frequencies[first] != lhs_frequencies[second]) {
+            return lhs_frequencies[first] > lhs_frequencies[second];
+        }
+        return first < second;
+    };
+
+    // levels[i] holds the column sets of arity i + 2
+    std::vector<IntersectionLevel> levels;
+    /* Plans the prefixes of the ordered columns, from the longest one down to the first prefix
+     * that is already cached or planned, the shorter ones are available then too */
+    auto const plan_prefixes = [&](std::vector<model::ColumnIndex> const& columns) {
+        std::vector<Vertical> prefixes{Vertical(*schema->GetColumn(columns.front()))};
+        for (size_t i = 1; i < columns.size(); ++i) {
+            prefixes.push_back(prefixes.back().Union(*schema->GetColumn(columns[i])));
+        }
+        if (levels.size() < columns.size() - 1) levels.resize(columns.size() - 1);
+        for (size_t i = columns.size() - 1; i > 0; --i) {
+            IntersectionLevel& level = levels[i - 1];
+            if (level.contains(prefixes[i]) || pli_cache_->Get(prefixes[i]) != nullptr) break;
+            level.emplace(prefixes[i], Intersection{prefixes[i - 1], columns[i]});
+        }
+    };
+
+    for (auto const& [lhs, rhs] : fds_) {
+        std::vector<model::ColumnIndex> columns = lhs;
+        std::sort(columns.begin(), columns.end(), more_shared);
+        plan_prefixes(columns);
+        // the joint set extends the LHS, so it is intersected from the PLI of the LHS
+        size_t const lhs_size = columns.size();
+        std::copy_if(rhs.begin(), rhs.end(), std::back_inserter(columns),
+                     [&lhs](model::ColumnIndex column) {
+                         return !std::binary_search(lhs.begin(), lhs.end(), column);
+                     });
+        std::sort(columns.begin() + lhs_size, columns.end(), more_shared);
+        plan_prefixes(columns);
+    }
+    return levels;
+}
+
+void AfdErrorCalculator::CalculatePLIs(std::vector<IntersectionLevel> const& plan) {
+    size_t num_intersections = 0;
+    std::atomic<size_t> new_tuple_indices = 0;
+    for (IntersectionLevel const& level : plan) {
+        std::vector<std::pair<Vertical, Intersection>> const intersections(level.begin(),
+                                                                           level.end());
+        util::ParallelForeach(
+                intersections.begin(), intersections.end(), threads_num_,
+                [this, &new_tuple_indices](auto const& planned) {
+                    auto const& [columns, intersection] = planned;
+                    std::shared_ptr<model::PLI const> operand_pli =
+                            pli_cache_->Get(intersection.operand);
+                    assert(operand_pli != nullptr);
+                    std::shared_ptr<model::PLI> pli = operand_pli->Intersect(
+                            relation_->GetColumnData(intersection.column).GetPositionListIndex());
+                    new_tuple_indices += pli->GetSize();
+                    pli_cache_->Put(columns, std::move(pli));
+                });
+        num_intersections += intersections.size();
+    }
+    cached_tuple_indices_ += new_tuple_indices;
+    LOG(DEBUG) << "Intersected " << num_intersections << " column sets, "
+               << pli_cache_->GetSize() << " PLIs are cached";
+}
+
+void AfdErrorCalculator::CalculateErrors() {
+    errors_.resize(fds_.size());
+    std::vector<size_t> fd_indices(fds_.size());
+    std::iota(fd_indices.begin(), fd_indices.end(), 0);
+    util::ParallelForeach(fd_indices.begin(), fd_indices.end(), threads_num_, [this](size_t i) {
+        auto const& [lhs, rhs] = fds_[i];
+        Vertical const lhs_vertical = GetVertical(lhs);
+        std::shared_ptr<model::PLI const> lhs_pli = pli_cache_->Get(lhs_vertical);
+        std::shared_ptr<model::PLI const> joint_pli =
+                pli_cache_->Get(lhs_vertical.Union(GetVertical(rhs)));
+        assert(lhs_pli != nullptr && joint_pli != nullptr);
+        model::PLI const* x_pli = lhs_pli.get();
+        model::PLI const* xa_pli = joint_pli.get();
+        ColumnLayoutRelationData const* relation = relation_.get();
+        errors_[i] = {Tane::CalculateFdError(x_pli, xa_pli, relation),
+                      PFDTane::CalculateFdError(x_pli, xa_pli, +ErrorMeasure::per_tuple, relation),
+                      PFDTane::CalculateFdError(x_pli, xa_pli, +ErrorMeasure::per_value, relation)};
+    });
+}
+
+}  // namespace algos::fd_verifier
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cassert>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "algorithms/algorithm.h"
+#include "config/deduplicate_rows/type.h"
+#include "config/equal_nulls/type.h"
+#include "config/error/type.h"
+#include "config/indices/type.h"
+#include "config/tabular_data/input_table_type.h"
+#include "config/thread_number/type.h"
+#include "model/table/column_layout_relation_data.h"
+#include "model/table/vertical_map.h"
+
+namespace algos::fd_verifier {
+
+/* Approximate FD error measures of one candidate */
+struct AfdErrors {
+    /* Share of the tuple pairs violating the FD, as Tane::CalculateFdError calculates it. Equal to
+     * the error FDVerifier reports */
+    config::ErrorType g1;
+    /* Minimal share of the tuples to remove for the FD to hold, PFDTane's per_tuple error */
+    config::ErrorType g3;
+    /* PFDTane's per_value error */
+    config::ErrorType per_value;
+};
+
+/* Calculates the error measures of a batch of arbitrary FD candidates over one table. The PLI of
+ * a candidate's LHS X and of X united with its RHS are needed. Before the batch is processed, the
+ * columns of every set are ordered by how many LHSs of the batch contain them, so LHSs with common
+ * columns get common prefixes, and every prefix is intersected once, level by level in parallel.
+ * The PLIs are kept between executions: a batch over the same table intersects only the column
+ * sets that no previous batch needed. Once the cached intersections hold more tuple indices than
+ * kMaxCachedColumnPLIs column PLIs would, they are dropped after the execution, so the cache does
+ * not outgrow the table however many batches are processed. With deduplicate_rows the PLIs are
+ * built over the distinct rows only, the errors are the same since the rows are weighted by their
+ * multiplicities. */
+class AfdErrorCalculator : public Algorithm {
+private:
+    struct Intersection {
+        Vertical operand;
+        model::ColumnIndex column;
+    };
+    // column sets of the same arity to be calculated, with the way to calculate each of them
+    using IntersectionLevel = std::unordered_map<Vertical, Intersection>;
+
+    // bound of the cached intersections, in the number of column PLIs of the table they may hold
+    static constexpr size_t kMaxCachedColumnPLIs = 64;
+
+    config::InputTable input_table_;
+
+    config::FdsIndicesType fds_;
+    config::EqNullsType is_null_equal_null_;
+    config::DeduplicateRowsType deduplicate_rows_;
+    config::ThreadNumType threads_num_;
+
+    std::shared_ptr<ColumnLayoutRelationData> relation_;
+    std::unique_ptr<model::VerticalMap<model::PLI>> pli_cache_;
+    // number of tuple indices in the cached PLIs of the column sets of at least two columns
+    size_t cached_tuple_indices_ = 0;
+    std::vector<AfdErrors> errors_;
+
+    void RegisterOptions();
+    void ResetPLICache();
+    Vertical GetVertical(config::IndicesType const& indices) const;
+    std::vector<IntersectionLevel> PlanIntersections() const;
+    void CalculatePLIs(std::vector<IntersectionLevel> const& plan);
+    void CalculateErrors();
+
+    void ResetState() final {
+        errors_.clear();
+    }
+
+protected:
+    void LoadDataInternal() override;
+    void MakeExecuteOptsAvailable() override;
+    unsigned long long ExecuteInternal() override;
+
+public:
+    size_t GetNumFDs() const {
+        return errors_.size();
+    }
+
+    /* Errors of the fd_index-th FD of the option, in the order the FDs were given */
+    AfdErrors const& GetErrors(size_t fd_index) const {
+        assert(fd_index < errors_.size());
+        return errors_[fd_index];
+    }
+
+    std::vector<AfdErrors> const& GetErrors() const {
+        return errors_;
+    }
+
+    /* Number of column sets whose PLIs are cached for the next executions */
+    size_t GetNumCachedPLIs() const {
+        return pli_cache_ == nullptr ? 0 : pli_cache_->GetSize();
+    }
+
+    AfdErrorCalculator();
+};
+
+}  // namespace algos::fd_verifier
@@ -0,0 +1,198 @@
+#include "algorithms/fd/fd_verifier/batch_fd_verifier.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include <easylogging++.h>
+
+#include "config/equal_nulls/option.h"
+#include "config/exceptions.h"
+#include "config/indices/validate_index.h"
+#include "config/names_and_descriptions.h"
+#include "config/option_using.h"
+#include "config/tabular_data/input_table/option.h"
+#include "config/thread_number/option.h"
+#include "util/parallel_for.h"
+
+namespace algos::fd_verifier {
+
+BatchFDVerifier::BatchFDVerifier() : Algorithm({}) {
+    RegisterOptions();
+    MakeOptionsAvailable({config::kTableOpt.GetName(), config::kEqualNullsOpt.GetName()});
+}
+
+void BatchFDVerifier::RegisterOptions() {
+    DESBORDANTE_OPTION_USING;
+
+    auto normalize_fds = [](config::FdsIndicesType& fds) {
+        auto normalize = [](config::IndicesType& indices) {
+            std::sort(indices.begin(), indices.end());
+            indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+        };
+        for (auto& [lhs, rhs] : fds) {
+            normalize(lhs);
+            normalize(rhs);
+        }
+    };
+    auto check_fds = [this](config::FdsIndicesType const& fds) {
+        size_t const num_columns = relation_->GetSchema()->GetNumColumns();
+        for (auto const& [lhs, rhs] : fds) {
+            if (lhs.empty() || rhs.empty()) {
+                throw config::ConfigurationError("Indices cannot be empty");
+            }
+            config::ValidateIndex(lhs.back(), num_columns);
+            config::ValidateIndex(rhs.back(), num_columns);
+        }
+    };
+
+    RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(config::kEqualNullsOpt(&is_null_equal_null_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    RegisterOption(Option{&fds_, kFdsIndices, kDFdsIndices}
+                           .SetNormalizeFunc(normalize_fds)
+                           .SetValueCheck(check_fds));
+}
+
+void BatchFDVerifier::MakeExecuteOptsAvailable() {
+    using namespace config::names;
+
+    MakeOptionsAvailable({kFdsIndices, config::kThreadNumberOpt.GetName()});
+}
+
+void BatchFDVerifier::LoadDataInternal() {
+    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    input_table_->Reset();
+    if (relation_->GetColumnData().empty()) {
+        throw std::runtime_error("Got an empty dataset: FD verifying is meaningless.");
+    }
+    typed_relation_ =
+            model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+}
+
+unsigned long long BatchFDVerifier::ExecuteInternal() {
+    auto start_time = std::chrono::system_clock::now();
+
+    pli_cache_ = std::make_unique<model::BlockingVerticalMap<model::PLI>>(relation_->GetSchema());
+    stats_calculators_.reserve(fds_.size());
+    for (auto const& [lhs, rhs] : fds_) {
+        stats_calculators_.emplace_back(relation_, typed_relation_, lhs, rhs);
+    }
+
+    CalculatePLIs();
+    VerifyFDs();
+
+    auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now() - start_time);
+    return elapsed_milliseconds.count();
+}
+
+Vertical BatchFDVerifier::GetVertical(config::IndicesType const& indices) const {
+    RelationalSchema const* schema = relation_->GetSchema();
+    return schema->GetVertical(schema->IndicesToBitset(indices));
+}
+
+void BatchFDVerifier::CalculatePLIs() {
+    RelationalSchema const* schema = relation_->GetSchema();
+
+    // levels[i] maps every needed column set of arity i + 2 to its greatest column
+    std::vector<std::unordered_map<Vertical, model::ColumnIndex>> levels;
+    std::unordered_set<model::ColumnIndex> single_columns;
+    auto add_prefixes = [&](config::IndicesType const& indices) {
+        single_columns.insert(indices.front());
+        Vertical prefix(*schema->GetColumn(indices.front()));
+        for (size_t i = 1; i < indices.size(); ++i) {
+            prefix = prefix.Union(*schema->GetColumn(indices[i]));
+            if (levels.size() < i) levels.resize(i);
+            levels[i - 1].emplace(prefix, indices[i]);
+        }
+    };
+    for (auto const& [lhs, rhs] : fds_) {
+        add_prefixes(lhs);
+        add_prefixes(rhs);
+    }
+
+    for (model::ColumnIndex column : single_columns) {
+        pli_cache_->Put(Vertical(*schema->GetColumn(column)),
+                        relation_->GetColumnData(column).GetPliOwnership());
+    }
+    for (auto const& level : levels) {
+        std::vector<std::pair<Vertical, model::ColumnIndex>> const level_sets(level.begin(),
+                                                                              level.end());
+        util::ParallelForeach(
+                level_sets.begin(), level_sets.end(), threads_num_, [&](auto const& level_set) {
+                    auto const& [columns, last_column] = level_set;
+                    Column const& column = *schema->GetColumn(last_column);
+                    std::shared_ptr<model::PLI const> prefix_pli =
+                            pli_cache_->Get(columns.Without(column));
+                    assert(prefix_pli != nullptr);
+                    std::shared_ptr<model::PLI> pli = prefix_pli->Intersect(
+                            relation_->GetColumnData(last_column).GetPositionListIndex());
+                    pli_cache_->Put(columns, std::move(pli));
+                });
+    }
+    LOG(DEBUG) << "Calculated PLIs of " << pli_cache_->GetSize() << " column sets";
+}
+
+void BatchFDVerifier::VerifyFDs() {
+    // FDs with the same RHS share its probing table
+    std::unordered_map<Vertical, std::shared_ptr<std::vector<int> const>> probing_tables;
+    for (auto const& [lhs, rhs] : fds_) {
+        probing_tables.emplace(GetVertical(rhs), nullptr);
+    }
+    std::vector<Vertical> rhss;
+    rhss.reserve(probing_tables.size());
+    for (auto const& [rhs, probing_table] : probing_tables) {
+        rhss.push_back(rhs);
+    }
+    util::ParallelForeach(rhss.begin(), rhss.end(), threads_num_, [&](Vertical const& rhs) {
+        // the map is not rehashed, so the values are written concurrently
+        probing_tables.find(rhs)->second = pli_cache_->Get(rhs)->CalculateAndGetProbingTable();
+    });
+
+    std::vector<size_t> fd_indices(fds_.size());
+    std::iota(fd_indices.begin(), fd_indices.end(), 0);
+    util::ParallelForeach(fd_indices.begin(), fd_indices.end(), threads_num_, [&](size_t i) {
+        auto const& [lhs, rhs] = fds_[i];
+        std::shared_ptr<model::PLI const> lhs_pli = pli_cache_->Get(GetVertical(lhs));
+        stats_calculators_[i].CalculateStatistics(lhs_pli, *probing_tables.at(GetVertical(rhs)),
+                                                  false);
+    });
+}
+
+std::vector<size_t> BatchFDVerifier::GetViolatedFDIndices() const {
+    std::vector<size_t> violated;
+    for (size_t i = 0; i < stats_calculators_.size(); ++i) {
+        if (!stats_calculators_[i].FDHolds()) violated.push_back(i);
+    }
+    return violated;
+}
+
+StatsCalculator const& BatchFDVerifier::GetStatisticsWithHighlights(size_t fd_index) {
+    assert(fd_index < stats_calculators_.size());
+    StatsCalculator& stats_calculator = stats_calculators_[fd_index];
+    if (!stats_calculator.HighlightsCalculated()) {
+        auto const& [lhs, rhs] = fds_[fd_index];
+        std::shared_ptr<model::PLI const> lhs_pli = pli_cache_->Get(GetVertical(lhs));
+        std::shared_ptr<model::PLI const> rhs_pli = pli_cache_->Get(GetVertical(rhs));
+        stats_calculator.ResetState();
+        stats_calculator.CalculateStatistics(lhs_pli, rhs_pli.get());
+    }
+    return stats_calculator;
+}
+
+std::vector<Highlight> const& BatchFDVerifier::GetHighlights(size_t fd_index) {
+    return GetStatisticsWithHighlights(fd_index).GetHighlights();
+}
+
+std::vector<Highlight> BatchFDVerifier::GetHighlights(size_t fd_index, size_t offset,
+                                                      size_t limit) {
+    return GetStatisticsWithHighlights(fd_index).GetHighlights(offset, limit);
+}
+
+}  // namespace algos::fd_verifier
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+#include "algorithms/algorithm.h"
+#include "algorithms/fd/fd_verifier/stats_calculator.h"
+#include "config/equal_nulls/type.h"
+#include "config/indices/type.h"
+#include "config/tabular_data/input_table_type.h"
+#include "config/thread_number/type.h"
+#include "model/table/vertical_map.h"
+
+namespace algos::fd_verifier {
+
+/* Verifies many FDs over one table at once. PLIs of the column sets are computed level by level
+ * from the PLIs of their prefixes, so FDs with a common LHS prefix share the intersections, and
+ * the FDs are then checked in parallel. Only the statistics are calculated during the execution,
+ * highlights of an FD are calculated once they are requested. */
+class BatchFDVerifier : public Algorithm {
+private:
+    config::InputTable input_table_;
+
+    config::FdsIndicesType fds_;
+    config::EqNullsType is_null_equal_null_;
+    config::ThreadNumType threads_num_;
+
+    std::shared_ptr<ColumnLayoutRelationData> relation_;
+    std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation_;
+    // PLIs of the LHSs, the RHSs and all their prefixes
+    std::unique_ptr<model::VerticalMap<model::PLI>> pli_cache_;
+    std::vector<StatsCalculator> stats_calculators_;
+
+    void RegisterOptions();
+    Vertical GetVertical(config::IndicesType const& indices) const;
+    void CalculatePLIs();
+    void VerifyFDs();
+    StatsCalculator const& GetStatisticsWithHighlights(size_t fd_index);
+
+    void ResetState() final {
+        pli_cache_.reset();
+        stats_calculators_.clear();
+    }
+
+protected:
+    void LoadDataInternal() override;
+    void MakeExecuteOptsAvailable() override;
+    unsigned long long ExecuteInternal() override;
+
+public:
+    size_t GetNumFDs() const {
+        return stats_calculators_.size();
+    }
+
+    /* Statistics of the fd_index-th FD of the option, in the order the FDs were given */
+    StatsCalculator const& GetStatistics(size_t fd_index) const {
+        assert(fd_index < stats_calculators_.size());
+        return stats_calculators_[fd_index];
+    }
+
+    bool FDHolds(size_t fd_index) const {
+        return GetStatistics(fd_index).FDHolds();
+    }
+
+    size_t GetNumErrorClusters(size_t fd_index) const {
+        return GetStatistics(fd_index).GetNumErrorClusters();
+    }
+
+    size_t GetNumErrorRows(size_t fd_index) const {
+        return GetStatistics(fd_index).GetNumErrorRows();
+    }
+
+    long double GetError(size_t fd_index) const {
+        return GetStatistics(fd_index).GetError();
+    }
+
+    /* Indices of the FDs that do not hold */
+    std::vector<size_t> GetViolatedFDIndices() const;
+
+    /* Calculates the highlights of the FD on the first request, sorted by proportion descending
+     * like FDVerifier does. Not thread-safe. */
+    std::vector<Highlight> const& GetHighlights(size_t fd_index);
+
+    /* Same as above, but only the highlights from offset to offset + limit are sorted and
+     * returned */
+    std::vector<Highlight> GetHighlights(size_t fd_index, size_t offset, size_t limit);
+
+    BatchFDVerifier();
+};
+
+}  // namespace algos::fd_verifier
@@ -27,64 +27,14 @@ void DynamicFDVerifier::RegisterOptions() {
 
     auto get_schema_cols = [this]() { return input_table_->GetNumberOfColumns(); };
 
-    auto check_inserts = [this](config::InputTable insert_batch) {
-        if (insert_batch == nullptr || !insert_batch->HasNextRow()) {
-            return;
-        }
-        if (insert_batch->GetNumberOfColumns() != input_table_->GetNumberOfColumns()) {
-            throw config::ConfigurationError(
-                    "Schema mismatch: insert statements must have the same number of columns as "
-                    "the input table");
-        }
-        for (size_t i = 0; i < input_table_->GetNumberOfColumns(); ++i) {
-            if (insert_batch->GetColumnName(i) != input_table_->GetColumnName(i)) {
-                throw config::ConfigurationError(
-                        "Schema mismatch: insert statements' column names must match the input "
-                        "table");
-            }
-        }
+    auto check_inserts = [this](config::InputTable const& insert_batch) {
+        table_data_->CheckInsertBatch(insert_batch);
     };
-
     auto check_deletes = [this](std::unordered_set<size_t> const& delete_batch) {
-        if (delete_batch.empty()) {
-            return;
-        }
-        for (size_t id : delete_batch) {
-            if (!table_data_->IsRowIndexValid(id)) {
-                throw config::ConfigurationError("Attempt to delete a non-existing row");
-            }
-        }
+        table_data_->CheckDeleteBatch(delete_batch);
     };
-
-    auto check_updates = [this](config::InputTable update_batch) {
-        if (update_batch == nullptr || !update_batch->HasNextRow()) {
-            return;
-        }
-        if (update_batch->GetNumberOfColumns() != input_table_->GetNumberOfColumns() + 1) {
-            throw config::ConfigurationError(
-                    "Schema mismatch: update statements must have the number of columns one more "
-                    "than the input table");
-        }
-        for (size_t i = 0; i < input_table_->GetNumberOfColumns(); ++i) {
-            if (update_batch->GetColumnName(i + 1) != input_table_->GetColumnName(i)) {
-                throw config::ConfigurationError(
-                        "Schema mismatch: update statements column names, except of first one, "
-                        "must match the input table");
-            }
-        }
-        std::unordered_set<size_t> rows_to_update;
-        while (update_batch->HasNextRow()) {
-            auto row = update_batch->GetNextRow();
-            size_t id = std::stoull(row.front());
-            if (!table_data_->IsRowIndexValid(id)) {
-                throw config::ConfigurationError("Attempt to update a non-existing row");
-            }
-            if (rows_to_update.contains(id)) {
-                throw config::ConfigurationError("Update statements have duplicates");
-            }
-            rows_to_update.emplace(id);
-        }
-        update_batch->Reset();
+    auto check_updates = [this](config::InputTable const& update_batch) {
+        table_data_->CheckUpdateBatch(update_batch);
     };
 
     RegisterOption(config::kTableOpt(&input_table_));
@@ -104,9 +54,9 @@ void DynamicFDVerifier::MakeExecuteOptsAvailable() {
 }
 
 void DynamicFDVerifier::LoadDataInternal() {
-    CreateFD();
-    input_table_->Reset();
     table_data_ = std::make_shared<model::DynamicTableData>(*input_table_);
+    input_table_->Reset();
+    CreateFD();
     stats_calculator_ =
             std::make_unique<DynamicStatsCalculator>(table_data_, lhs_indices_, rhs_indices_);
     VerifyFD();
@@ -115,42 +65,26 @@ void DynamicFDVerifier::LoadDataInternal() {
 
 unsigned long long DynamicFDVerifier::ExecuteInternal() {
     auto start_time = std::chrono::system_clock::now();
-    std::vector<std::pair<std::optional<size_t>, std::vector<int>>> lhs_inserts{}, rhs_inserts{};
+    size_t const first_inserted_row = table_data_->GetNumRowsTotal();
+    std::vector<size_t> const updated_rows = table_data_->Update(
+            insert_statements_table_, update_statements_table_, delete_statement_indices_);
+    if (insert_statements_table_ != nullptr) insert_statements_table_->Reset();
+    if (update_statements_table_ != nullptr) update_statements_table_->Reset();
+
+    // the whole batch is applied to each PLI at once, an update replaces the row under its id
+    std::vector<std::pair<std::optional<size_t>, std::vector<int>>> lhs_inserts, rhs_inserts;
     std::unordered_set<size_t> deletes_and_updates_indices{delete_statement_indices_};
-    if (insert_statements_table_ != nullptr) {
-        while (insert_statements_table_->HasNextRow()) {
-            std::vector<std::string> row = insert_statements_table_->GetNextRow();
-            if (row.size() != input_table_->GetNumberOfColumns()) {
-                LOG(WARNING) << "Received row with size " << row.size() << ", but expected "
-                             << input_table_->GetNumberOfColumns();
-                continue;
-            }
-            lhs_inserts.emplace_back(std::nullopt, ParseRowForPLI(row.begin(), lhs_indices_));
-            rhs_inserts.emplace_back(std::nullopt, ParseRowForPLI(row.begin(), rhs_indices_));
-        }
-        insert_statements_table_->Reset();
+    for (size_t row : updated_rows) {
+        lhs_inserts.emplace_back(row, GetPLIKey(row, lhs_indices_));
+        rhs_inserts.emplace_back(row, GetPLIKey(row, rhs_indices_));
+        deletes_and_updates_indices.insert(row);
     }
-    if (update_statements_table_ != nullptr) {
-        while (update_statements_table_->HasNextRow()) {
-            std::vector<std::string> row = update_statements_table_->GetNextRow();
-            if (row.size() != input_table_->GetNumberOfColumns() + 1) {
-                LOG(WARNING) << "Received row with size " << row.size() << ", but expected "
-                             << input_table_->GetNumberOfColumns() + 1;
-                continue;
-            }
-            size_t row_id = std::stoull(row.front());
-            lhs_inserts.emplace_back(row_id, ParseRowForPLI(row.begin() + 1, lhs_indices_));
-            rhs_inserts.emplace_back(row_id, ParseRowForPLI(row.begin() + 1, rhs_indices_));
-            deletes_and_updates_indices.emplace(row_id);
-        }
-        update_statements_table_->Reset();
+    for (size_t row = first_inserted_row; row < table_data_->GetNumRowsTotal(); ++row) {
+        lhs_inserts.emplace_back(std::nullopt, GetPLIKey(row, lhs_indices_));
+        rhs_inserts.emplace_back(std::nullopt, GetPLIKey(row, rhs_indices_));
     }
-
     lhs_pli_->UpdateWith(lhs_inserts, deletes_and_updates_indices);
-    rhs_pli_->UpdateWith(rhs_inserts, std::move(deletes_and_updates_indices));
-
-    table_data_->Update(insert_statements_table_, update_statements_table_,
-                        delete_statement_indices_);
+    rhs_pli_->UpdateWith(rhs_inserts, deletes_and_updates_indices);
 
     VerifyFD();
     SortHighlightsByProportionDescending();
@@ -171,38 +105,24 @@ void DynamicFDVerifier::VerifyFD() const {
 }
 
 void DynamicFDVerifier::CreateFD() {
-    size_t const num_columns = input_table_->GetNumberOfColumns();
     std::vector<std::vector<int>> lhs_rows, rhs_rows;
-    std::vector<std::string> row;
-
-    while (input_table_->HasNextRow()) {
-        row = input_table_->GetNextRow();
-        if (row.size() != num_columns) {
-            continue;
-        }
-        lhs_rows.emplace_back(ParseRowForPLI(row.begin(), lhs_indices_));
-        rhs_rows.emplace_back(ParseRowForPLI(row.begin(), rhs_indices_));
+    lhs_rows.reserve(table_data_->GetNumRowsTotal());
+    rhs_rows.reserve(table_data_->GetNumRowsTotal());
+    for (size_t row = 0; row < table_data_->GetNumRowsTotal(); ++row) {
+        lhs_rows.push_back(GetPLIKey(row, lhs_indices_));
+        rhs_rows.push_back(GetPLIKey(row, rhs_indices_));
     }
 
     lhs_pli_ = model::DynPLI::CreateFor(lhs_rows);
     rhs_pli_ = model::DynPLI::CreateFor(rhs_rows);
 }
 
-std::vector<int> DynamicFDVerifier::ParseRowForPLI(
-        model::IDatasetStream::Row::iterator const& row_begin,
-        std::vector<unsigned int> const& indices) {
-    std::vector<int> result{};
+std::vector<int> DynamicFDVerifier::GetPLIKey(size_t row,
+                                              std::vector<unsigned int> const& indices) const {
+    std::vector<int> result;
+    result.reserve(indices.size());
     for (size_t index : indices) {
-        std::string const& field = *(row_begin + index);
-        if (field.empty()) {
-            result.emplace_back(kNullValueId);
-        } else {
-            auto [iter, is_value_new] = value_dictionary_.try_emplace(field, next_value_id_);
-            if (is_value_new) {
-                next_value_id_++;
-            }
-            result.emplace_back(iter->second);
-        }
+        result.push_back(table_data_->GetValueId(row, index));
     }
     return result;
 }
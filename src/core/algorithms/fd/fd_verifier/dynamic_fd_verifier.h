@@ -33,15 +33,10 @@ private:
     std::shared_ptr<model::DynamicTableData> table_data_;
     std::shared_ptr<DynamicStatsCalculator> stats_calculator_;
 
-    std::unordered_map<std::string, int> value_dictionary_{};
-    int next_value_id_ = 1;
-    static constexpr int kNullValueId = -1;
-
     void VerifyFD() const;
     void CreateFD();
 
-    inline std::vector<int> ParseRowForPLI(model::IDatasetStream::Row::iterator const& row_begin,
-                                           std::vector<unsigned int> const& indices);
+    std::vector<int> GetPLIKey(size_t row, std::vector<unsigned int> const& indices) const;
     void RegisterOptions();
 
     void ResetState() final {
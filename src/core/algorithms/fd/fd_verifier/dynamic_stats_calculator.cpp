@@ -11,13 +11,13 @@ namespace algos::fd_verifier {
 
 void DynamicStatsCalculator::CalculateStatistics(model::DynPLI const* lhs_pli,
                                                  model::DynPLI const* rhs_pli) {
-    model::DynPLI::ClusterCollection const& lhs_clusters = lhs_pli->GetClusters();
-    std::shared_ptr<std::vector<int> const> pt_shared = rhs_pli->GetCachedProbingTable();
-    std::vector<int> const& rhs_pt = *pt_shared;
+    std::vector<model::DynPLI::Cluster> const& lhs_clusters = lhs_pli->GetClusters();
+    std::vector<int> const& rhs_pt = rhs_pli->GetProbingTable();
     size_t num_tuples_conflicting_on_rhs = 0;
 
-    for (auto const& [_, cluster] : lhs_clusters) {
-        if (cluster.size() == 1) continue;
+    for (model::DynPLI::Cluster const& cluster : lhs_clusters) {
+        // empty clusters are the slots freed by deletes
+        if (cluster.size() < 2) continue;
         Frequencies frequencies = model::DynPLI::CreateFrequencies(cluster, rhs_pt);
         size_t num_distinct_rhs_values = CalculateNumDistinctRhsValues(frequencies, cluster.size());
         if (num_distinct_rhs_values == 1) continue;
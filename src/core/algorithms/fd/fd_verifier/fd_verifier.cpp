@@ -52,7 +52,6 @@ unsigned long long FDVerifier::ExecuteInternal() {
                                                           rhs_indices_);
 
     VerifyFD();
-    SortHighlightsByProportionDescending();
     stats_calculator_->PrintStatistics();
 
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -69,7 +68,7 @@ void FDVerifier::VerifyFD() const {
         return;
     }
 
-    stats_calculator_->CalculateStatistics(lhs_pli.get(), rhs_pli.get());
+    stats_calculator_->CalculateStatistics(lhs_pli, rhs_pli.get());
 }
 
 std::shared_ptr<model::PLI const> FDVerifier::CalculatePLI(
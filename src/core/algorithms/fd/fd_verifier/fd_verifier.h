@@ -73,6 +73,24 @@ public:
         return stats_calculator_->GetHighlights();
     }
 
+    /* Returns the highlights from offset to offset + limit, only they are sorted */
+    std::vector<Highlight> GetHighlights(size_t offset, size_t limit) const {
+        assert(stats_calculator_);
+        return stats_calculator_->GetHighlights(offset, limit);
+    }
+
+    /* Returns the LHS value of the highlighted cluster */
+    std::string GetHighlightLhsValue(Highlight const& highlight) const {
+        assert(stats_calculator_);
+        return stats_calculator_->GetLhsStringValue(highlight);
+    }
+
+    /* Returns the RHS values of the highlighted cluster rows */
+    std::vector<std::string> GetHighlightRhsValues(Highlight const& highlight) const {
+        assert(stats_calculator_);
+        return stats_calculator_->GetRhsStringValues(highlight);
+    }
+
     void SortHighlightsByProportionAscending() const;
     void SortHighlightsByProportionDescending() const;
     void SortHighlightsByNumAscending() const;
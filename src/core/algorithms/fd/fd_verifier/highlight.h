@@ -1,21 +1,24 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
+#include <utility>
 
 #include "model/table/position_list_index.h"
 
 namespace algos::fd_verifier {
 
 /* FDVerifier Highlight represents a cluster that violate the FD and provides the information about
- * that cluster */
+ * that cluster. The cluster is shared with the PLI it belongs to, so highlights are cheap to create
+ * and copy */
 class Highlight {
 private:
-    model::PLI::Cluster cluster_;    /* cluster that violate the FD */
+    std::shared_ptr<model::PLI::Cluster const> cluster_; /* cluster that violate the FD */
     size_t num_distinct_rhs_values_; /* number of different RHS values within a cluster */
     double most_frequent_rhs_value_proportion_; /* proportion of most frequent RHS value */
 public:
     model::PLI::Cluster const& GetCluster() const {
-        return cluster_;
+        return *cluster_;
     }
 
     size_t GetNumDistinctRhsValues() const {
@@ -26,12 +29,18 @@ public:
         return most_frequent_rhs_value_proportion_;
     }
 
-    Highlight(model::PLI::Cluster const& cluster, size_t num_distinct_rhs_values,
+    Highlight(std::shared_ptr<model::PLI::Cluster const> cluster, size_t num_distinct_rhs_values,
               size_t num_most_frequent_rhs_value)
-        : cluster_(cluster),
+        : cluster_(std::move(cluster)),
           num_distinct_rhs_values_(num_distinct_rhs_values),
           most_frequent_rhs_value_proportion_((double)num_most_frequent_rhs_value /
-                                              cluster.size()) {}
+                                              cluster_->size()) {}
+
+    /* Copies a cluster of a PLI that may change after the highlight is created */
+    Highlight(model::PLI::Cluster const& cluster, size_t num_distinct_rhs_values,
+              size_t num_most_frequent_rhs_value)
+        : Highlight(std::make_shared<model::PLI::Cluster const>(cluster), num_distinct_rhs_values,
+                    num_most_frequent_rhs_value) {}
 };
 
 }  // namespace algos::fd_verifier
@@ -7,6 +7,8 @@
 
 #include <easylogging++.h>
 
+#include "util/sorted_page.h"
+
 namespace {
 
 model::CompareResult CompareTypesInCol(model::TypedColumnData const& col,
@@ -58,15 +60,22 @@ void StatsCalculator::PrintStatistics() const {
     }
 }
 
-void StatsCalculator::CalculateStatistics(model::PLI const* lhs_pli, model::PLI const* rhs_pli) {
-    std::deque<model::PLI::Cluster> const& lhs_clusters = lhs_pli->GetIndex();
+void StatsCalculator::CalculateStatistics(std::shared_ptr<model::PLI const> const& lhs_pli,
+                                          model::PLI const* rhs_pli) {
     std::shared_ptr<model::PLI::Cluster const> pt_shared = rhs_pli->CalculateAndGetProbingTable();
-    model::PLI::Cluster const& pt = *pt_shared.get();
+    CalculateStatistics(lhs_pli, *pt_shared);
+    assert(!highlights_.empty());
+}
+
+void StatsCalculator::CalculateStatistics(std::shared_ptr<model::PLI const> const& lhs_pli,
+                                          std::vector<int> const& rhs_probing_table,
+                                          bool calculate_highlights) {
+    std::deque<model::PLI::Cluster> const& lhs_clusters = lhs_pli->GetIndex();
     size_t num_tuples_conflicting_on_rhs = 0.;
 
     for (auto& cluster : lhs_clusters) {
         std::unordered_map<ClusterIndex, unsigned> frequencies =
-                model::PLI::CreateFrequencies(cluster, pt);
+                model::PLI::CreateFrequencies(cluster, rhs_probing_table);
         size_t num_distinct_rhs_values = CalculateNumDistinctRhsValues(frequencies, cluster.size());
         if (num_distinct_rhs_values == 1) {
             continue;
@@ -74,10 +83,15 @@ void StatsCalculator::CalculateStatistics(model::PLI const* lhs_pli, model::PLI
         num_tuples_conflicting_on_rhs +=
                 CalculateNumTuplesConflictingOnRhsInCluster(frequencies, cluster.size());
         num_error_rows_ += cluster.size();
-        highlights_.emplace_back(std::move(cluster), num_distinct_rhs_values,
-                                 CalculateNumMostFrequentRhsValue(frequencies));
+        ++num_error_clusters_;
+        if (calculate_highlights) {
+            // the highlight shares the ownership of the whole PLI
+            highlights_.emplace_back(std::shared_ptr<model::PLI::Cluster const>(lhs_pli, &cluster),
+                                     num_distinct_rhs_values,
+                                     CalculateNumMostFrequentRhsValue(frequencies));
+        }
     }
-    assert(!highlights_.empty());
+    highlights_sorted_ = false;
 
     size_t num_rows = relation_->GetNumRows();
     error_ = (double)num_tuples_conflicting_on_rhs / (num_rows * num_rows - num_rows);
@@ -113,30 +127,48 @@ size_t StatsCalculator::CalculateNumDistinctRhsValues(
 }
 
 void StatsCalculator::VisualizeHighlights() const {
-    for (auto const& highlight : highlights_) {
-        LOG(DEBUG) << "- LHS value: " << GetLhsStringValue(highlight.GetCluster()[0])
+    for (auto const& highlight : GetHighlights(0, util::kNumVisualizedHighlights)) {
+        LOG(DEBUG) << "- LHS value: " << GetLhsStringValue(highlight)
                    << ", Size: " << highlight.GetCluster().size()
                    << ", Number of different RHS values: " << highlight.GetNumDistinctRhsValues()
                    << ", Proportion of most frequent RHS value: "
                    << highlight.GetMostFrequentRhsValueProportion();
         if (rhs_indices_.size() == 1) {
-            for (auto index : highlight.GetCluster()) {
-                LOG(DEBUG) << GetStringValueByIndex(index, rhs_indices_[0]);
+            for (std::string const& value : GetRhsStringValues(highlight)) {
+                LOG(DEBUG) << value;
             }
         }
     }
+    if (highlights_.size() > util::kNumVisualizedHighlights) {
+        LOG(DEBUG) << "... and " << highlights_.size() - util::kNumVisualizedHighlights
+                   << " more highlights";
+    }
+}
+
+std::string StatsCalculator::GetLhsStringValue(Highlight const& highlight) const {
+    return GetStringValue(lhs_indices_, highlight.GetCluster()[0]);
 }
 
-std::string StatsCalculator::GetLhsStringValue(ClusterIndex row_index) const {
+std::vector<std::string> StatsCalculator::GetRhsStringValues(Highlight const& highlight) const {
+    std::vector<std::string> values;
+    values.reserve(highlight.GetCluster().size());
+    for (ClusterIndex row_index : highlight.GetCluster()) {
+        values.push_back(GetStringValue(rhs_indices_, row_index));
+    }
+    return values;
+}
+
+std::string StatsCalculator::GetStringValue(config::IndicesType const& indices,
+                                            ClusterIndex row_index) const {
     std::string value;
-    for (size_t j = 0; j < lhs_indices_.size(); ++j) {
-        value += GetStringValueByIndex(row_index, lhs_indices_[j]);
-        if (j == lhs_indices_.size() - 1) {
+    for (size_t j = 0; j < indices.size(); ++j) {
+        value += GetStringValueByIndex(row_index, indices[j]);
+        if (j == indices.size() - 1) {
             break;
         }
         value += ", ";
     }
-    if (lhs_indices_.size() > 1) {
+    if (indices.size() > 1) {
         value.insert(0, "(");
         value.push_back(')');
     }
@@ -160,8 +192,30 @@ model::CompareResult StatsCalculator::CompareTypedValues(ClusterIndex i1, Cluste
     return model::CompareResult::kEqual;
 }
 
+std::vector<Highlight> const& StatsCalculator::GetHighlights() const {
+    if (!highlights_sorted_) {
+        std::stable_sort(highlights_.begin(), highlights_.end(), highlights_order_);
+        highlights_sorted_ = true;
+    }
+    return highlights_;
+}
+
+std::vector<Highlight> StatsCalculator::GetHighlights(size_t offset, size_t limit) const {
+    if (highlights_sorted_) {
+        if (offset >= highlights_.size()) {
+            return {};
+        }
+        auto page_begin = highlights_.begin() + offset;
+        return {page_begin, page_begin + std::min(limit, highlights_.size() - offset)};
+    }
+    // ties are broken by the current positions, as the stable sort of GetHighlights does
+    return util::GetSortedPage(highlights_, highlights_order_, offset, limit);
+}
+
 void StatsCalculator::SortHighlights(HighlightCompareFunction const& compare) {
-    std::sort(highlights_.begin(), highlights_.end(), compare);
+    highlights_order_ = compare;
+    std::stable_sort(highlights_.begin(), highlights_.end(), highlights_order_);
+    highlights_sorted_ = true;
 }
 
 auto StatsCalculator::CompareHighlightsByProportionAscending() -> HighlightCompareFunction {
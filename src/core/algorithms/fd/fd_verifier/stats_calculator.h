@@ -22,12 +22,18 @@ private:
     config::IndicesType lhs_indices_;
     config::IndicesType rhs_indices_;
 
+    size_t num_error_clusters_ = 0;
     size_t num_error_rows_ = 0;
     long double error_ = 0;
-    std::vector<Highlight> highlights_;
+    /* Highlights are sorted by proportion descending only when all of them are requested or
+     * SortHighlights is called, pages are selected without sorting the rest */
+    mutable std::vector<Highlight> highlights_;
+    mutable bool highlights_sorted_ = false;
+    std::function<bool(Highlight const& h1, Highlight const& h2)> highlights_order_ =
+            CompareHighlightsByProportionDescending();
 
     void VisualizeHighlights() const;
-    std::string GetLhsStringValue(ClusterIndex row_index) const;
+    std::string GetStringValue(config::IndicesType const& indices, ClusterIndex row_index) const;
     std::string GetStringValueByIndex(ClusterIndex row_index, ClusterIndex col_index) const;
 
     static size_t CalculateNumDistinctRhsValues(
@@ -44,22 +50,37 @@ private:
 public:
     using HighlightCompareFunction = std::function<bool(Highlight const& h1, Highlight const& h2)>;
 
-    void CalculateStatistics(model::PLI const* lhs_pli, model::PLI const* rhs_pli);
+    /* Highlights share the clusters of lhs_pli instead of copying them */
+    void CalculateStatistics(std::shared_ptr<model::PLI const> const& lhs_pli,
+                             model::PLI const* rhs_pli);
+
+    /* Same as above for an already built probing table of the RHS. Without highlights only the
+     * counters and the error are calculated. */
+    void CalculateStatistics(std::shared_ptr<model::PLI const> const& lhs_pli,
+                             std::vector<int> const& rhs_probing_table,
+                             bool calculate_highlights = true);
 
     void PrintStatistics() const;
 
     void ResetState() {
         highlights_.clear();
+        highlights_sorted_ = false;
+        num_error_clusters_ = 0;
         num_error_rows_ = 0;
         error_ = 0;
     }
 
     bool FDHolds() const {
-        return highlights_.empty();
+        return num_error_clusters_ == 0;
     }
 
     size_t GetNumErrorClusters() const {
-        return highlights_.size();
+        return num_error_clusters_;
+    }
+
+    /* False if the statistics were calculated without highlights for a violated FD */
+    bool HighlightsCalculated() const {
+        return highlights_.size() == num_error_clusters_;
     }
 
     size_t GetNumErrorRows() const {
@@ -70,9 +91,17 @@ public:
         return error_;
     }
 
-    std::vector<Highlight> const& GetHighlights() const {
-        return highlights_;
-    }
+    /* All highlights in the order of the last SortHighlights call */
+    std::vector<Highlight> const& GetHighlights() const;
+
+    /* Highlights from offset to offset + limit in the order of the last SortHighlights call, the
+     * same ones GetHighlights would return at these positions */
+    std::vector<Highlight> GetHighlights(size_t offset, size_t limit) const;
+
+    /* LHS value of the cluster and the RHS values of its rows, are meant for the highlights of a
+     * returned page */
+    std::string GetLhsStringValue(Highlight const& highlight) const;
+    std::vector<std::string> GetRhsStringValues(Highlight const& highlight) const;
 
     void SortHighlights(HighlightCompareFunction const& compare);
 
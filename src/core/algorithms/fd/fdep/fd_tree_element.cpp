@@ -1,33 +1,49 @@
 #include "fd_tree_element.h"
 
+#include <cassert>
+
 #include "boost/dynamic_bitset.hpp"
 
-FDTreeElement::FDTreeElement(size_t max_attribute_number)
-    : max_attribute_number_(max_attribute_number) {
+template <typename Bitset>
+FDTreeElement<Bitset>::FDTreeElement(size_t max_attribute_number)
+    : rhs_attributes_(Traits::Create(max_attribute_number + 1)),
+      max_attribute_number_(max_attribute_number),
+      is_fd_(Traits::Create(max_attribute_number + 1)) {
     children_.resize(max_attribute_number);
 }
 
-bool FDTreeElement::CheckFd(size_t index) const {
+template <typename Bitset>
+Bitset FDTreeElement<Bitset>::CreateAttributeSet() const {
+    return Traits::Create(max_attribute_number_ + 1);
+}
+
+template <typename Bitset>
+bool FDTreeElement<Bitset>::CheckFd(size_t index) const {
     return this->is_fd_[index];
 }
 
-FDTreeElement* FDTreeElement::GetChild(size_t index) const {
+template <typename Bitset>
+FDTreeElement<Bitset>* FDTreeElement<Bitset>::GetChild(size_t index) const {
     return this->children_[index].get();
 }
 
-void FDTreeElement::AddRhsAttribute(size_t index) {
+template <typename Bitset>
+void FDTreeElement<Bitset>::AddRhsAttribute(size_t index) {
     this->rhs_attributes_.set(index);
 }
 
-std::bitset<FDTreeElement::kMaxAttrNum> const& FDTreeElement::GetRhsAttributes() const {
+template <typename Bitset>
+Bitset const& FDTreeElement<Bitset>::GetRhsAttributes() const {
     return this->rhs_attributes_;
 }
 
-void FDTreeElement::MarkAsLast(size_t index) {
+template <typename Bitset>
+void FDTreeElement<Bitset>::MarkAsLast(size_t index) {
     this->is_fd_.set(index);
 }
 
-bool FDTreeElement::IsFinalNode(size_t attr_num) const {
+template <typename Bitset>
+bool FDTreeElement<Bitset>::IsFinalNode(size_t attr_num) const {
     if (!this->rhs_attributes_[attr_num]) {
         return false;
     }
@@ -39,14 +55,15 @@ bool FDTreeElement::IsFinalNode(size_t attr_num) const {
     return true;
 }
 
-bool FDTreeElement::ContainsGeneralization(std::bitset<kMaxAttrNum> const& lhs, size_t attr_num,
-                                           size_t current_attr) const {
+template <typename Bitset>
+bool FDTreeElement<Bitset>::ContainsGeneralization(Bitset const& lhs, size_t attr_num,
+                                                   size_t current_attr) const {
     if (this->is_fd_[attr_num - 1]) {
         return true;
     }
 
-    size_t next_set_attr = lhs._Find_next(current_attr);
-    if (next_set_attr == kMaxAttrNum) {
+    size_t next_set_attr = Traits::FindNext(lhs, current_attr);
+    if (next_set_attr == Traits::kNpos) {
         return false;
     }
     bool found = false;
@@ -62,17 +79,17 @@ bool FDTreeElement::ContainsGeneralization(std::bitset<kMaxAttrNum> const& lhs,
     return this->ContainsGeneralization(lhs, attr_num, next_set_attr);
 }
 
-bool FDTreeElement::GetGeneralizationAndDelete(std::bitset<kMaxAttrNum> const& lhs, size_t attr_num,
-                                               size_t current_attr,
-                                               std::bitset<kMaxAttrNum>& spec_lhs) {
+template <typename Bitset>
+bool FDTreeElement<Bitset>::GetGeneralizationAndDelete(Bitset const& lhs, size_t attr_num,
+                                                       size_t current_attr, Bitset& spec_lhs) {
     if (this->is_fd_[attr_num - 1]) {
         this->is_fd_.reset(attr_num - 1);
         this->rhs_attributes_.reset(attr_num);
         return true;
     }
 
-    size_t next_set_attr = lhs._Find_next(current_attr);
-    if (next_set_attr == kMaxAttrNum) {
+    size_t next_set_attr = Traits::FindNext(lhs, current_attr);
+    if (next_set_attr == Traits::kNpos) {
         return false;
     }
 
@@ -95,18 +112,18 @@ bool FDTreeElement::GetGeneralizationAndDelete(std::bitset<kMaxAttrNum> const& l
     return found;
 }
 
-bool FDTreeElement::GetSpecialization(std::bitset<kMaxAttrNum> const& lhs, size_t attr_num,
-                                      size_t current_attr,
-                                      std::bitset<kMaxAttrNum>& spec_lhs_out) const {
+template <typename Bitset>
+bool FDTreeElement<Bitset>::GetSpecialization(Bitset const& lhs, size_t attr_num,
+                                              size_t current_attr, Bitset& spec_lhs_out) const {
     if (!this->rhs_attributes_[attr_num]) {
         return false;
     }
 
     bool found = false;
     size_t attr = (current_attr > 1 ? current_attr : 1);
-    size_t next_set_attr = lhs._Find_next(current_attr);
+    size_t next_set_attr = Traits::FindNext(lhs, current_attr);
 
-    if (next_set_attr == kMaxAttrNum) {
+    if (next_set_attr == Traits::kNpos) {
         while (!found && attr <= this->max_attribute_number_) {
             if (this->children_[attr - 1] &&
                 this->children_[attr - 1]->GetRhsAttributes()[attr_num]) {
@@ -139,7 +156,8 @@ bool FDTreeElement::GetSpecialization(std::bitset<kMaxAttrNum> const& lhs, size_
     return found;
 }
 
-void FDTreeElement::AddMostGeneralDependencies() {
+template <typename Bitset>
+void FDTreeElement<Bitset>::AddMostGeneralDependencies() {
     for (size_t i = 1; i <= this->max_attribute_number_; ++i) {
         this->rhs_attributes_.set(i);
     }
@@ -149,11 +167,12 @@ void FDTreeElement::AddMostGeneralDependencies() {
     }
 }
 
-void FDTreeElement::AddFunctionalDependency(std::bitset<kMaxAttrNum> const& lhs, size_t attr_num) {
+template <typename Bitset>
+void FDTreeElement<Bitset>::AddFunctionalDependency(Bitset const& lhs, size_t attr_num) {
     FDTreeElement* current_node = this;
     this->AddRhsAttribute(attr_num);
 
-    for (size_t i = lhs._Find_first(); i != kMaxAttrNum; i = lhs._Find_next(i)) {
+    for (size_t i = Traits::FindFirst(lhs); i != Traits::kNpos; i = Traits::FindNext(lhs, i)) {
         if (current_node->children_[i - 1] == nullptr) {
             current_node->children_[i - 1] =
                     std::make_unique<FDTreeElement>(this->max_attribute_number_);
@@ -166,8 +185,9 @@ void FDTreeElement::AddFunctionalDependency(std::bitset<kMaxAttrNum> const& lhs,
     current_node->MarkAsLast(attr_num - 1);
 }
 
-void FDTreeElement::FilterSpecializations() {
-    std::bitset<kMaxAttrNum> active_path;
+template <typename Bitset>
+void FDTreeElement<Bitset>::FilterSpecializations() {
+    Bitset active_path = CreateAttributeSet();
     auto filtered_tree = std::make_unique<FDTreeElement>(this->max_attribute_number_);
 
     this->FilterSpecializationsHelper(*filtered_tree, active_path);
@@ -176,8 +196,9 @@ void FDTreeElement::FilterSpecializations() {
     this->is_fd_ = filtered_tree->is_fd_;
 }
 
-void FDTreeElement::FilterSpecializationsHelper(FDTreeElement& filtered_tree,
-                                                std::bitset<kMaxAttrNum>& active_path) {
+template <typename Bitset>
+void FDTreeElement<Bitset>::FilterSpecializationsHelper(FDTreeElement& filtered_tree,
+                                                        Bitset& active_path) {
     for (size_t attr = 1; attr <= this->max_attribute_number_; ++attr) {
         if (this->children_[attr - 1]) {
             active_path.set(attr);
@@ -187,7 +208,7 @@ void FDTreeElement::FilterSpecializationsHelper(FDTreeElement& filtered_tree,
     }
 
     for (size_t attr = 1; attr <= this->max_attribute_number_; ++attr) {
-        std::bitset<kMaxAttrNum> spec_lhs_out;
+        Bitset spec_lhs_out = CreateAttributeSet();
         if (this->is_fd_[attr - 1] &&
             !filtered_tree.GetSpecialization(active_path, attr, 0, spec_lhs_out)) {
             filtered_tree.AddFunctionalDependency(active_path, attr);
@@ -195,17 +216,43 @@ void FDTreeElement::FilterSpecializationsHelper(FDTreeElement& filtered_tree,
     }
 }
 
-void FDTreeElement::PrintDep(std::string const& file_name,
-                             std::vector<std::string>& column_names) const {
+template <typename Bitset>
+void FDTreeElement<Bitset>::Merge(FDTreeElement const& other) {
+    assert(other.max_attribute_number_ == this->max_attribute_number_);
+    Bitset active_path = CreateAttributeSet();
+    this->MergeHelper(other, active_path);
+}
+
+template <typename Bitset>
+void FDTreeElement<Bitset>::MergeHelper(FDTreeElement const& other_subtree, Bitset& active_path) {
+    for (size_t attr = 1; attr <= this->max_attribute_number_; ++attr) {
+        if (other_subtree.is_fd_[attr - 1]) {
+            this->AddFunctionalDependency(active_path, attr);
+        }
+    }
+
+    for (size_t attr = 1; attr <= this->max_attribute_number_; ++attr) {
+        if (other_subtree.children_[attr - 1]) {
+            active_path.set(attr);
+            this->MergeHelper(*other_subtree.children_[attr - 1], active_path);
+            active_path.reset(attr);
+        }
+    }
+}
+
+template <typename Bitset>
+void FDTreeElement<Bitset>::PrintDep(std::string const& file_name,
+                                     std::vector<std::string>& column_names) const {
     std::ofstream file;
     file.open(file_name);
-    std::bitset<kMaxAttrNum> active_path;
+    Bitset active_path = CreateAttributeSet();
     PrintDependencies(active_path, file, column_names);
     file.close();
 }
 
-void FDTreeElement::PrintDependencies(std::bitset<kMaxAttrNum>& active_path, std::ofstream& file,
-                                      std::vector<std::string>& column_names) const {
+template <typename Bitset>
+void FDTreeElement<Bitset>::PrintDependencies(Bitset& active_path, std::ofstream& file,
+                                              std::vector<std::string>& column_names) const {
     std::string column_id;
     if (std::isdigit(column_names[0][0])) {
         column_id = "column";
@@ -215,8 +262,8 @@ void FDTreeElement::PrintDependencies(std::bitset<kMaxAttrNum>& active_path, std
         if (this->is_fd_[attr - 1]) {
             out = "{";
 
-            for (size_t i = active_path._Find_first(); i != kMaxAttrNum;
-                 i = active_path._Find_next(i)) {
+            for (size_t i = Traits::FindFirst(active_path); i != Traits::kNpos;
+                 i = Traits::FindNext(active_path, i)) {
                 if (!column_id.empty())
                     out += column_id + std::to_string(std::stoi(column_names[i - 1]) + 1) + ",";
                 else
@@ -243,23 +290,26 @@ void FDTreeElement::PrintDependencies(std::bitset<kMaxAttrNum>& active_path, std
     }
 }
 
-void FDTreeElement::FillFdCollection(RelationalSchema const& scheme, std::list<FD>& fd_collection,
-                                     unsigned int max_lhs) const {
-    std::bitset<kMaxAttrNum> active_path;
+template <typename Bitset>
+void FDTreeElement<Bitset>::FillFdCollection(RelationalSchema const& scheme,
+                                             std::list<FD>& fd_collection,
+                                             unsigned int max_lhs) const {
+    Bitset active_path = CreateAttributeSet();
     this->TransformTreeFdCollection(active_path, fd_collection, scheme, max_lhs);
 }
 
-void FDTreeElement::TransformTreeFdCollection(std::bitset<kMaxAttrNum>& active_path,
-                                              std::list<FD>& fd_collection,
-                                              RelationalSchema const& scheme,
-                                              unsigned int max_lhs) const {
+template <typename Bitset>
+void FDTreeElement<Bitset>::TransformTreeFdCollection(Bitset& active_path,
+                                                      std::list<FD>& fd_collection,
+                                                      RelationalSchema const& scheme,
+                                                      unsigned int max_lhs) const {
     if (active_path.count() > max_lhs) return;
 
     for (size_t attr = 1; attr <= this->max_attribute_number_; ++attr) {
         if (this->is_fd_[attr - 1]) {
             boost::dynamic_bitset<> lhs_bitset(this->max_attribute_number_);
-            for (size_t i = active_path._Find_first(); i != kMaxAttrNum;
-                 i = active_path._Find_next(i)) {
+            for (size_t i = Traits::FindFirst(active_path); i != Traits::kNpos;
+                 i = Traits::FindNext(active_path, i)) {
                 lhs_bitset.set(i - 1);
             }
             Vertical lhs(&scheme, lhs_bitset);
@@ -277,3 +327,8 @@ void FDTreeElement::TransformTreeFdCollection(std::bitset<kMaxAttrNum>& active_p
         }
     }
 }
+
+template class FDTreeElement<std::bitset<64>>;
+template class FDTreeElement<std::bitset<128>>;
+template class FDTreeElement<std::bitset<256>>;
+template class FDTreeElement<boost::dynamic_bitset<>>;
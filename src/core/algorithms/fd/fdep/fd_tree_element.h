@@ -9,35 +9,47 @@
 #include <fstream>
 #include <string>
 
+#include <boost/dynamic_bitset.hpp>
+
 #include "algorithms/fd/fd.h"
 #include "model/table/relational_schema.h"
+#include "util/bitset_utils.h"
 
+/* Attributes are numbered from 1, so a relation with n columns needs a bitset of n + 1 bits.
+ * Bitset is either std::bitset<64/128/256> or boost::dynamic_bitset<> (any number of columns),
+ * FDep picks the narrowest one that fits the relation.
+ */
+template <typename Bitset>
 class FDTreeElement {
 public:
-    // The maximum number of columns in the dataset. Using in std::bitset template.
-    static constexpr int kMaxAttrNum = 256;
     explicit FDTreeElement(size_t max_attribute_number);
 
     FDTreeElement(FDTreeElement const&) = delete;
     FDTreeElement& operator=(FDTreeElement const&) = delete;
 
+    // Empty attribute set of the width suitable for the tree
+    [[nodiscard]] Bitset CreateAttributeSet() const;
+
     void AddMostGeneralDependencies();
 
     // Using in cover-trees as post filtration of functional dependencies with redundant left-hand
     // side.
     void FilterSpecializations();
 
+    // Adding all dependencies of `other` to this tree, `other` must have the same width.
+    void Merge(FDTreeElement const& other);
+
     [[nodiscard]] bool CheckFd(size_t index) const;
 
     [[nodiscard]] FDTreeElement* GetChild(size_t index) const;
 
-    void AddFunctionalDependency(std::bitset<kMaxAttrNum> const& lhs, size_t attr_num);
+    void AddFunctionalDependency(Bitset const& lhs, size_t attr_num);
 
     // Searching for generalization of functional dependency in cover-trees.
-    bool GetGeneralizationAndDelete(std::bitset<kMaxAttrNum> const& lhs, size_t attr_num,
-                                    size_t current_attr, std::bitset<kMaxAttrNum>& spec_lhs);
+    bool GetGeneralizationAndDelete(Bitset const& lhs, size_t attr_num, size_t current_attr,
+                                    Bitset& spec_lhs);
 
-    [[nodiscard]] bool ContainsGeneralization(std::bitset<kMaxAttrNum> const& lhs, size_t attr_num,
+    [[nodiscard]] bool ContainsGeneralization(Bitset const& lhs, size_t attr_num,
                                               size_t current_attr) const;
 
     // Printing found dependencies in output file.
@@ -47,14 +59,16 @@ public:
                           unsigned int max_lhs = std::numeric_limits<unsigned int>::max()) const;
 
 private:
+    using Traits = util::BitsetTraits<Bitset>;
+
     std::vector<std::unique_ptr<FDTreeElement>> children_;
-    std::bitset<kMaxAttrNum> rhs_attributes_;
+    Bitset rhs_attributes_;
     size_t max_attribute_number_;
-    std::bitset<kMaxAttrNum> is_fd_;
+    Bitset is_fd_;
 
     void AddRhsAttribute(size_t index);
 
-    [[nodiscard]] std::bitset<kMaxAttrNum> const& GetRhsAttributes() const;
+    [[nodiscard]] Bitset const& GetRhsAttributes() const;
 
     void MarkAsLast(size_t index);
 
@@ -62,18 +76,19 @@ private:
     [[nodiscard]] bool IsFinalNode(size_t attr_num) const;
 
     // Searching for specialization of functional dependency in cover-trees.
-    bool GetSpecialization(std::bitset<kMaxAttrNum> const& lhs, size_t attr_num,
-                           size_t current_attr, std::bitset<kMaxAttrNum>& spec_lhs_out) const;
+    bool GetSpecialization(Bitset const& lhs, size_t attr_num, size_t current_attr,
+                           Bitset& spec_lhs_out) const;
+
+    void FilterSpecializationsHelper(FDTreeElement& filtered_tree, Bitset& active_path);
 
-    void FilterSpecializationsHelper(FDTreeElement& filtered_tree,
-                                     std::bitset<kMaxAttrNum>& active_path);
+    // Helper function for Merge.
+    void MergeHelper(FDTreeElement const& other_subtree, Bitset& active_path);
 
     // Helper function for PrintDep.
-    void PrintDependencies(std::bitset<kMaxAttrNum>& active_path, std::ofstream& file,
+    void PrintDependencies(Bitset& active_path, std::ofstream& file,
                            std::vector<std::string>& column_names) const;
 
     void TransformTreeFdCollection(
-            std::bitset<kMaxAttrNum>& active_path, std::list<FD>& fd_collection,
-            RelationalSchema const& scheme,
+            Bitset& active_path, std::list<FD>& fd_collection, RelationalSchema const& scheme,
             unsigned int max_lhs = std::numeric_limits<unsigned int>::max()) const;
 };
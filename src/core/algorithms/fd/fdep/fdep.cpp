@@ -1,10 +1,24 @@
 #include "algorithms/fd/fdep/fdep.h"
 
+#include <algorithm>
+#include <atomic>
+#include <bitset>
 #include <chrono>
+#include <functional>
+#include <list>
+#include <system_error>
+#include <thread>
 
+#include <boost/container_hash/hash.hpp>
+#include <boost/dynamic_bitset.hpp>
+#include <easylogging++.h>
+
+#include "config/deduplicate_rows/option.h"
 #include "config/equal_nulls/option.h"
 #include "config/tabular_data/input_table/option.h"
+#include "config/thread_number/option.h"
 #include "model/table/column_layout_relation_data.h"
+#include "util/row_deduplication.h"
 
 // #ifndef PRINT_FDS
 // #define PRINT_FDS
@@ -14,11 +28,20 @@ namespace algos {
 
 FDep::FDep() : FDAlgorithm({kDefaultPhaseName}) {
     RegisterOptions();
-    MakeOptionsAvailable({config::kTableOpt.GetName()});
+    MakeOptionsAvailable({config::kTableOpt.GetName(), config::kDeduplicateRowsOpt.GetName()});
 }
 
 void FDep::RegisterOptions() {
     RegisterOption(config::kTableOpt(&input_table_));
+    // the rows are deduplicated on load, so the threads option is needed at that stage then
+    RegisterOption(config::kDeduplicateRowsOpt(&deduplicate_rows_)
+                           .SetConditionalOpts({{[](bool deduplicate) { return deduplicate; },
+                                                 {config::kThreadNumberOpt.GetName()}}}));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+}
+
+void FDep::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
 }
 
 void FDep::LoadDataInternal() {
@@ -44,91 +67,185 @@ void FDep::LoadDataInternal() {
             tuples_.back()[i] = std::hash<std::string>{}(next_line[i]);
         }
     }
+
+    if (deduplicate_rows_) {
+        std::vector<size_t> const kept_tuples =
+                util::DeduplicateRows(
+                        tuples_.size(),
+                        [this](size_t tuple_num) {
+                            return boost::hash_range(tuples_[tuple_num].begin(),
+                                                     tuples_[tuple_num].end());
+                        },
+                        [this](size_t first, size_t second) {
+                            return tuples_[first] == tuples_[second];
+                        },
+                        threads_num_)
+                        .kept_rows;
+        for (size_t i = 0; i < kept_tuples.size(); ++i) {
+            if (kept_tuples[i] != i) tuples_[i] = std::move(tuples_[kept_tuples[i]]);
+        }
+        tuples_.resize(kept_tuples.size());
+    }
 }
 
 void FDep::ResetStateFd() {
-    // Consider creating them here instead.
-    neg_cover_tree_.reset();
-    pos_cover_tree_.reset();
+    // Cover trees are local to ExecuteInternal(), nothing to reset.
 }
 
 unsigned long long FDep::ExecuteInternal() {
     auto start_time = std::chrono::system_clock::now();
 
-    BuildNegativeCover();
+    // Attributes are numbered from 1 in the cover trees
+    size_t const bitset_size = number_attributes_ + 1;
+    if (bitset_size <= 64) {
+        Discover<std::bitset<64>>();
+    } else if (bitset_size <= 128) {
+        Discover<std::bitset<128>>();
+    } else if (bitset_size <= 256) {
+        Discover<std::bitset<256>>();
+    } else {
+        Discover<boost::dynamic_bitset<>>();
+    }
 
-    this->tuples_.shrink_to_fit();
+    auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now() - start_time);
+
+    return elapsed_milliseconds.count();
+}
 
-    this->pos_cover_tree_ = std::make_unique<FDTreeElement>(this->number_attributes_);
-    this->pos_cover_tree_->AddMostGeneralDependencies();
+template <typename Bitset>
+void FDep::Discover() {
+    std::unique_ptr<FDTreeElement<Bitset>> neg_cover_tree = BuildNegativeCover<Bitset>();
 
-    std::bitset<FDTreeElement::kMaxAttrNum> active_path;
-    CalculatePositiveCover(*this->neg_cover_tree_, active_path);
+    this->tuples_.shrink_to_fit();
 
-    pos_cover_tree_->FillFdCollection(*this->schema_, FdList(), max_lhs_);
+    auto pos_cover_tree = std::make_unique<FDTreeElement<Bitset>>(this->number_attributes_);
+    pos_cover_tree->AddMostGeneralDependencies();
 
-    auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now() - start_time);
+    Bitset active_path = pos_cover_tree->CreateAttributeSet();
+    CalculatePositiveCover(*neg_cover_tree, active_path, *pos_cover_tree);
+
+    std::list<FD> fds;
+    pos_cover_tree->FillFdCollection(*this->schema_, fds, max_lhs_);
+    for (FD& fd : fds) {
+        RegisterFd(std::move(fd));
+    }
 
 #ifdef PRINT_FDS
-    pos_cover_tree_->printDep("recent_call_result.txt", this->column_names_);
+    pos_cover_tree->PrintDep("recent_call_result.txt", this->column_names_);
 #endif
-
-    return elapsed_milliseconds.count();
 }
 
-void FDep::BuildNegativeCover() {
-    this->neg_cover_tree_ = std::make_unique<FDTreeElement>(this->number_attributes_);
-    for (auto i = this->tuples_.begin(); i != this->tuples_.end(); ++i) {
-        for (auto j = i + 1; j != this->tuples_.end(); ++j) AddViolatedFDs(*i, *j);
+template <typename Bitset>
+std::unique_ptr<FDTreeElement<Bitset>> FDep::BuildNegativeCover() const {
+    using Tree = FDTreeElement<Bitset>;
+    size_t const tuples_num = this->tuples_.size();
+    size_t const threads_num = std::min(static_cast<size_t>(threads_num_), tuples_num);
+
+    if (threads_num <= 1) {
+        auto neg_cover_tree = std::make_unique<Tree>(this->number_attributes_);
+        for (auto i = this->tuples_.begin(); i != this->tuples_.end(); ++i) {
+            for (auto j = i + 1; j != this->tuples_.end(); ++j) {
+                AddViolatedFDs(*i, *j, *neg_cover_tree);
+            }
+        }
+        neg_cover_tree->FilterSpecializations();
+        return neg_cover_tree;
+    }
+
+    /* Tuples are handed out one by one, a thread compares the tuple with all of the following
+     * ones. Per-thread covers are filtered before merging, since only maximal violated
+     * dependencies are kept anyway.
+     */
+    std::vector<std::unique_ptr<Tree>> threads_trees(threads_num);
+    std::atomic<size_t> next_tuple = 0;
+    auto const work = [this, &next_tuple, tuples_num](std::unique_ptr<Tree>& tree) {
+        tree = std::make_unique<Tree>(this->number_attributes_);
+        for (size_t i = next_tuple++; i < tuples_num; i = next_tuple++) {
+            for (size_t j = i + 1; j != tuples_num; ++j) {
+                AddViolatedFDs(this->tuples_[i], this->tuples_[j], *tree);
+            }
+        }
+        tree->FilterSpecializations();
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threads_num - 1);
+    for (size_t i = 1; i < threads_num; ++i) {
+        try {
+            threads.emplace_back(work, std::ref(threads_trees[i]));
+        } catch (std::system_error const& e) {
+            /* The remaining tuples are processed by the threads that have been created */
+            LOG(WARNING) << "Created " << threads.size() << " threads to build negative cover. "
+                         << "Could not create new thread: " << e.what();
+            break;
+        }
+    }
+    work(threads_trees.front());
+    for (auto& thread : threads) {
+        thread.join();
     }
 
-    this->neg_cover_tree_->FilterSpecializations();
+    std::unique_ptr<Tree> neg_cover_tree = std::move(threads_trees.front());
+    for (auto it = std::next(threads_trees.begin()); it != threads_trees.end(); ++it) {
+        if (*it != nullptr) neg_cover_tree->Merge(**it);
+    }
+    neg_cover_tree->FilterSpecializations();
+    return neg_cover_tree;
 }
 
-void FDep::AddViolatedFDs(std::vector<size_t> const& t1, std::vector<size_t> const& t2) {
-    std::bitset<FDTreeElement::kMaxAttrNum> equal_attr((2 << this->number_attributes_) - 1);
-    equal_attr.reset(0);
-    std::bitset<FDTreeElement::kMaxAttrNum> diff_attr;
+template <typename Bitset>
+void FDep::AddViolatedFDs(std::vector<size_t> const& t1, std::vector<size_t> const& t2,
+                          FDTreeElement<Bitset>& neg_cover_tree) const {
+    using Traits = util::BitsetTraits<Bitset>;
+    Bitset equal_attr = neg_cover_tree.CreateAttributeSet();
+    Bitset diff_attr = neg_cover_tree.CreateAttributeSet();
 
     for (size_t attr = 0; attr < this->number_attributes_; ++attr) {
-        diff_attr[attr + 1] = (t1[attr] != t2[attr]);
+        if (t1[attr] != t2[attr]) {
+            diff_attr.set(attr + 1);
+        } else {
+            equal_attr.set(attr + 1);
+        }
     }
 
-    equal_attr &= (~diff_attr);
-    for (size_t attr = diff_attr._Find_first(); attr != FDTreeElement::kMaxAttrNum;
-         attr = diff_attr._Find_next(attr)) {
-        this->neg_cover_tree_->AddFunctionalDependency(equal_attr, attr);
+    for (size_t attr = Traits::FindFirst(diff_attr); attr != Traits::kNpos;
+         attr = Traits::FindNext(diff_attr, attr)) {
+        neg_cover_tree.AddFunctionalDependency(equal_attr, attr);
     }
 }
 
-void FDep::CalculatePositiveCover(FDTreeElement const& neg_cover_subtree,
-                                  std::bitset<FDTreeElement::kMaxAttrNum>& active_path) {
+template <typename Bitset>
+void FDep::CalculatePositiveCover(FDTreeElement<Bitset> const& neg_cover_subtree,
+                                  Bitset& active_path,
+                                  FDTreeElement<Bitset>& pos_cover_tree) const {
     for (size_t attr = 1; attr <= this->number_attributes_; ++attr) {
         if (neg_cover_subtree.CheckFd(attr - 1)) {
-            this->SpecializePositiveCover(active_path, attr);
+            this->SpecializePositiveCover(active_path, attr, pos_cover_tree);
         }
     }
 
     for (size_t attr = 1; attr <= this->number_attributes_; ++attr) {
         if (neg_cover_subtree.GetChild(attr - 1)) {
             active_path.set(attr);
-            this->CalculatePositiveCover(*neg_cover_subtree.GetChild(attr - 1), active_path);
+            this->CalculatePositiveCover(*neg_cover_subtree.GetChild(attr - 1), active_path,
+                                         pos_cover_tree);
             active_path.reset(attr);
         }
     }
 }
 
-void FDep::SpecializePositiveCover(std::bitset<FDTreeElement::kMaxAttrNum> const& lhs,
-                                   size_t const& a) {
-    std::bitset<FDTreeElement::kMaxAttrNum> spec_lhs;
+template <typename Bitset>
+void FDep::SpecializePositiveCover(Bitset const& lhs, size_t const& a,
+                                   FDTreeElement<Bitset>& pos_cover_tree) const {
+    Bitset spec_lhs = pos_cover_tree.CreateAttributeSet();
 
-    while (this->pos_cover_tree_->GetGeneralizationAndDelete(lhs, a, 0, spec_lhs)) {
+    while (pos_cover_tree.GetGeneralizationAndDelete(lhs, a, 0, spec_lhs)) {
         for (size_t attr = this->number_attributes_; attr > 0; --attr) {
             if (!lhs.test(attr) && (attr != a)) {
                 spec_lhs.set(attr);
-                if (!this->pos_cover_tree_->ContainsGeneralization(spec_lhs, a, 0)) {
-                    this->pos_cover_tree_->AddFunctionalDependency(spec_lhs, a);
+                if (!pos_cover_tree.ContainsGeneralization(spec_lhs, a, 0)) {
+                    pos_cover_tree.AddFunctionalDependency(spec_lhs, a);
                 }
                 spec_lhs.reset(attr);
             }
@@ -1,12 +1,15 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "algorithms/fd/fd_algorithm.h"
 #include "algorithms/fd/fdep/fd_tree_element.h"
+#include "config/deduplicate_rows/type.h"
 #include "config/equal_nulls/type.h"
 #include "config/tabular_data/input_table_type.h"
+#include "config/thread_number/type.h"
 #include "model/table/relation_data.h"
 #include "model/table/relational_schema.h"
 
@@ -20,39 +23,51 @@ public:
 
 private:
     config::InputTable input_table_;
+    config::ThreadNumType threads_num_;
+    // duplicate tuples violate no FD, so only the distinct ones need to be compared
+    config::DeduplicateRowsType deduplicate_rows_;
 
     std::unique_ptr<RelationalSchema> schema_{};
 
     std::vector<std::string> column_names_;
     size_t number_attributes_{};
 
-    std::unique_ptr<FDTreeElement> neg_cover_tree_{};
-    std::unique_ptr<FDTreeElement> pos_cover_tree_{};
-
     std::vector<std::vector<size_t>> tuples_;
 
     void RegisterOptions();
+    void MakeExecuteOptsAvailableFDInternal() final;
 
     void LoadDataInternal() final;
 
     void ResetStateFd() final;
     unsigned long long ExecuteInternal() final;
 
-    // Building negative cover via violated dependencies
-    void BuildNegativeCover();
+    // Discovering FDs with the cover trees of the given width
+    template <typename Bitset>
+    void Discover();
+
+    // Building negative cover via violated dependencies.
+    // Tuple pairs are distributed among threads, each of them builds its own negative cover,
+    // the covers are merged in the end.
+    template <typename Bitset>
+    std::unique_ptr<FDTreeElement<Bitset>> BuildNegativeCover() const;
 
     // Iterating over all pairs t1 and t2 of the relation
     // Adding violated FDs to negative cover tree.
-    void AddViolatedFDs(std::vector<size_t> const& t1, std::vector<size_t> const& t2);
+    template <typename Bitset>
+    void AddViolatedFDs(std::vector<size_t> const& t1, std::vector<size_t> const& t2,
+                        FDTreeElement<Bitset>& neg_cover_tree) const;
 
     // Converting negative cover tree into positive cover tree
-    void CalculatePositiveCover(FDTreeElement const& neg_cover_subtree,
-                                std::bitset<FDTreeElement::kMaxAttrNum>& active_path);
+    template <typename Bitset>
+    void CalculatePositiveCover(FDTreeElement<Bitset> const& neg_cover_subtree,
+                                Bitset& active_path, FDTreeElement<Bitset>& pos_cover_tree) const;
 
     // Specializing general dependencies for not to be followed from violated dependencies of
     // negative cover tree.
-    void SpecializePositiveCover(std::bitset<FDTreeElement::kMaxAttrNum> const& lhs,
-                                 size_t const& a);
+    template <typename Bitset>
+    void SpecializePositiveCover(Bitset const& lhs, size_t const& a,
+                                 FDTreeElement<Bitset>& pos_cover_tree) const;
 };
 
 }  // namespace algos
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <list>
+#include <map>
+
+#include "algorithms/fd/fd.h"
+#include "config/error/type.h"
+
+namespace algos {
+
+// Minimal approximate FDs found for each of the error thresholds of a single mining run
+using FdsPerThreshold = std::map<config::ErrorType, std::list<FD>>;
+
+}  // namespace algos
@@ -1,197 +1,268 @@
 #include "fun.h"
 
+#include <algorithm>
+#include <bitset>
+#include <numeric>
+
+#include <boost/dynamic_bitset.hpp>
 #include <easylogging++.h>
+#include <hash_set2.hpp>
+
+#include "config/thread_number/option.h"
+#include "util/parallel_for.h"
 
 namespace algos {
 
-FunQuadruple FunQuadruple::Union(Column const& that) const {
-    return FunQuadruple(candidate_.Union(that));
+template <typename ColumnSet>
+void FUN::Level<ColumnSet>::Filter(std::vector<char> const& keep) {
+    std::size_t kept = 0;
+    index_.clear();
+    for (std::size_t i = 0; i < quadruples_.size(); ++i) {
+        if (!keep[i]) continue;
+        if (kept != i) {
+            quadruples_[kept] = std::move(quadruples_[i]);
+            plis_[kept] = std::move(plis_[i]);
+        }
+        index_.try_emplace(quadruples_[kept].GetCandidate(), kept);
+        ++kept;
+    }
+    quadruples_.erase(quadruples_.begin() + kept, quadruples_.end());
+    plis_.erase(plis_.begin() + kept, plis_.end());
 }
 
-FunQuadruple FunQuadruple::Union(Vertical const& that) const {
-    return FunQuadruple(candidate_.Union(that));
+FUN::FUN(std::optional<ColumnLayoutRelationDataManager> relation_manager)
+    : PliBasedFDAlgorithm({kDefaultPhaseName}, relation_manager) {
+    RegisterOptions();
 }
 
-bool FunQuadruple::Contains(FunQuadruple const& that) const {
-    return candidate_.Contains(that.candidate_);
+void FUN::RegisterOptions() {
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    RegisterTimeLimitOption();
 }
 
-bool FunQuadruple::Contains(Vertical const& that) const {
-    return candidate_.Contains(that);
+void FUN::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
 }
 
-FUN::FUN(std::optional<ColumnLayoutRelationDataManager> relation_manager)
-    : PliBasedFDAlgorithm({kDefaultPhaseName}, relation_manager) {}
-
-void FUN::ResetStateFd() {
-    fds_.clear();
-}
-
-bool FUN::IsKey(FunQuadruple const& l) const {
-    return l.GetCount() == relation_->GetNumRows();
+template <typename ColumnSet, typename F>
+void FUN::ForEachDirectSubset(Level<ColumnSet> const& level, ColumnSet const& l, F f) {
+    ColumnSet subset = l;
+    util::BitsetTraits<ColumnSet>::ForEach(l, [&level, &f, &subset](std::size_t a) {
+        subset.reset(a);
+        if (FunQuadruple<ColumnSet> const* s = level.Find(subset); s != nullptr) {
+            f(*s);
+        }
+        subset.set(a);
+    });
 }
 
-void FUN::DisplayFD(Level const& l_k_minus_1) {
-    for (FunQuadruple const& l : l_k_minus_1) {
+template <typename ColumnSet>
+void FUN::DisplayFD(Level<ColumnSet> const& l_k_minus_1, Fds<ColumnSet>& fds) const {
+    using Traits = util::BitsetTraits<ColumnSet>;
+    for (FunQuadruple<ColumnSet> const& l : l_k_minus_1.GetQuadruples()) {
         /*  our other algorithms mine l.candidate.GetArity() == 0,
          *  while Metanome's FUN explicitly ignores
          */
-        for (Column const* rhs : l.GetClosure().Without(l.GetQuasiclosure()).GetColumns()) {
-            fds_.try_emplace(*rhs, std::set<Vertical>());
-            bool subset_exists_already = false;
-            for (Vertical const& lhs : fds_.at(*rhs)) {
-                if (l.Contains(lhs)) {
-                    subset_exists_already = true;
-                    break;
-                }
-            }
+        Traits::ForEach(l.GetClosure() & ~l.GetQuasiclosure(), [&fds, &l](std::size_t rhs) {
+            std::vector<ColumnSet>& lhss = fds[rhs];
+            bool const subset_exists_already =
+                    std::any_of(lhss.begin(), lhss.end(), [&l](ColumnSet const& lhs) {
+                        return Traits::IsSubset(lhs, l.GetCandidate());
+                    });
             if (!subset_exists_already) {
-                fds_.at(*rhs).emplace(l.GetCandidate());
+                lhss.push_back(l.GetCandidate());
             }
-        }
+        });
     }
 }
 
-void FUN::PurePrune(Level const& l_k_minus_1, Level& l_k) const {
-    for (auto l = l_k.begin(); l != l_k.end();) {
-        bool erased = false;
-        for (FunQuadruple const& s : l_k_minus_1) {
-            if (l->GetCount() == s.GetCount() && l->Contains(s)) {
-                l = l_k.erase(l);
-                erased = true;
-                break;
-            }
-        }
-        if (!erased) {
-            l++;
-        }
-    }
-}
-
-void FUN::ComputeClosure(Level& l_k_minus_1, Level const& l_k) const {
-    for (FunQuadruple& l : l_k_minus_1) {
-        if (IsKey(l)) {
-            continue;
-        }
-        l.SetClosure(l.GetQuasiclosure());
-        for (Column const* a : r_prime_.Without(l.GetQuasiclosure()).GetColumns()) {
-            if (FastCount(l_k_minus_1, l_k, l.Union(*a)) == l.GetCount()) {
-                l.SetClosure(l.GetClosure().Union(*a));
-            }
-        }
-    }
+template <typename ColumnSet>
+void FUN::PurePrune(Level<ColumnSet> const& l_k_minus_1, Level<ColumnSet>& l_k) const {
+    auto const& quadruples = l_k.GetQuadruples();
+    std::vector<char> keep(quadruples.size(), true);
+    std::vector<std::size_t> indices(quadruples.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    util::ParallelForeach(indices.begin(), indices.end(), threads_num_, [&](std::size_t i) {
+        FunQuadruple<ColumnSet> const& l = quadruples[i];
+        ForEachDirectSubset(l_k_minus_1, l.GetCandidate(), [&](FunQuadruple<ColumnSet> const& s) {
+            if (l.GetCount() == s.GetCount()) keep[i] = false;
+        });
+    });
+    l_k.Filter(keep);
 }
 
-void FUN::ComputeQuasiClosure(Level const& l_k_minus_1, Level& l_k) const {
-    for (FunQuadruple& l : l_k) {
-        if (IsKey(l)) {
-            l.SetClosure(r_);
-        }
-        l.SetQuasiclosure(l.GetCandidate());
-        for (FunQuadruple const& s : l_k_minus_1) {
-            if (l.Contains(s)) {
-                l.SetQuasiclosure(l.GetQuasiclosure().Union(s.GetClosure()));
-            }
-        }
-    }
+template <typename ColumnSet>
+void FUN::ComputeClosure(Level<ColumnSet>& l_k_minus_1, Level<ColumnSet> const& l_k,
+                         ColumnSet const& r_prime) const {
+    auto& quadruples = l_k_minus_1.GetQuadruples();
+    util::ParallelForeach(
+            quadruples.begin(), quadruples.end(), threads_num_,
+            [this, &l_k_minus_1, &l_k, &r_prime](FunQuadruple<ColumnSet>& l) {
+                if (IsKey(l)) {
+                    return;
+                }
+                ColumnSet closure = l.GetQuasiclosure();
+                ColumnSet l_union_a = l.GetCandidate();
+                util::BitsetTraits<ColumnSet>::ForEach(
+                        r_prime & ~l.GetQuasiclosure(), [&](std::size_t a) {
+                            l_union_a.set(a);
+                            if (FastCount(l_k_minus_1, l_k, l_union_a) == l.GetCount()) {
+                                closure.set(a);
+                            }
+                            l_union_a.reset(a);
+                        });
+                l.SetClosure(closure);
+            });
 }
 
-unsigned long FUN::Count(Vertical const& l) const {
-    std::vector<ColumnData> const& column_data = relation_->GetColumnData();
-    size_t first_column_index = l.GetColumnIndices().find_first();
-
-    model::PositionListIndex const* pli = column_data.at(first_column_index).GetPositionListIndex();
-
-    if (l.GetColumnIndices().count() == 1) {
-        return pli->GetNumCluster();
-    }
-
-    //  workaround to avoid auto-destruction of plis
-    std::unique_ptr<model::PositionListIndex> holder;
-
-    for (size_t i = l.GetColumnIndices().find_next(first_column_index);
-         i != boost::dynamic_bitset<>::npos; i = l.GetColumnIndices().find_next(i)) {
-        pli->Intersect(column_data.at(i).GetPositionListIndex()).swap(holder);
-        pli = holder.get();
-    }
-
-    return pli->GetNumCluster();
+template <typename ColumnSet>
+void FUN::ComputeQuasiClosure(Level<ColumnSet> const& l_k_minus_1, Level<ColumnSet>& l_k,
+                              ColumnSet const& r) const {
+    auto& quadruples = l_k.GetQuadruples();
+    util::ParallelForeach(
+            quadruples.begin(), quadruples.end(), threads_num_,
+            [this, &l_k_minus_1, &r](FunQuadruple<ColumnSet>& l) {
+                if (IsKey(l)) {
+                    l.SetClosure(r);
+                }
+                ColumnSet quasiclosure = l.GetCandidate();
+                ForEachDirectSubset(l_k_minus_1, l.GetCandidate(),
+                                    [&quasiclosure](FunQuadruple<ColumnSet> const& s) {
+                                        quasiclosure |= s.GetClosure();
+                                    });
+                l.SetQuasiclosure(quasiclosure);
+            });
 }
 
-unsigned long FUN::FastCount(Level const& l_k_minus_1, Level const& l_k,
-                             FunQuadruple const& l) const {
-    auto position_at_l_k = std::find(l_k.begin(), l_k.end(), l);
-    if (position_at_l_k != l_k.end()) {
-        return position_at_l_k->GetCount();
+template <typename ColumnSet>
+unsigned long FUN::FastCount(Level<ColumnSet> const& l_k_minus_1, Level<ColumnSet> const& l_k,
+                             ColumnSet const& l) const {
+    if (FunQuadruple<ColumnSet> const* l_at_l_k = l_k.Find(l); l_at_l_k != nullptr) {
+        return l_at_l_k->GetCount();
     }
     unsigned long max = 0;
-    for (FunQuadruple const& l_prime : l_k_minus_1) {
-        if (l.Contains(l_prime)) {
-            max = std::max(max, l_prime.GetCount());
-        }
-    }
+    ForEachDirectSubset(l_k_minus_1, l, [&max](FunQuadruple<ColumnSet> const& l_prime) {
+        max = std::max(max, l_prime.GetCount());
+    });
     return max;
 }
 
-std::list<FunQuadruple> FUN::GenerateCandidate(Level const& l_k) const {
-    std::set<FunQuadruple> l_k_plus_1;
-    for (FunQuadruple const& l_prime : l_k) {
+template <typename ColumnSet>
+FUN::Level<ColumnSet> FUN::GenerateCandidate(Level<ColumnSet> const& l_k,
+                                             ColumnSet const& r_prime) const {
+    struct Join {
+        ColumnSet candidate;
+        std::size_t parent;
+        model::ColumnIndex column;
+    };
+
+    std::vector<Join> joins;
+    emhash2::HashSet<ColumnSet> generated;
+    auto const& quadruples = l_k.GetQuadruples();
+    for (std::size_t i = 0; i < quadruples.size(); ++i) {
+        FunQuadruple<ColumnSet> const& l_prime = quadruples[i];
         if (IsKey(l_prime)) {
             continue;
         }
-        for (Column const* a : r_prime_.Without(l_prime.GetCandidate()).GetColumns()) {
-            FunQuadruple l = l_prime.Union(*a);
-            if (l_k_plus_1.find(l) == l_k_plus_1.end()) {
-                l.SetCount(Count(l.GetCandidate()));
-                l_k_plus_1.emplace(l);
-            }
-        }
+        util::BitsetTraits<ColumnSet>::ForEach(
+                r_prime & ~l_prime.GetCandidate(), [&](std::size_t a) {
+                    ColumnSet l = l_prime.GetCandidate();
+                    l.set(a);
+                    if (generated.insert(l).second) {
+                        joins.push_back({std::move(l), i, static_cast<model::ColumnIndex>(a)});
+                    }
+                });
+    }
+
+    // Count(l' ∪ a) is the number of clusters of PLI(l') ∩ PLI(a)
+    std::vector<PliPtr> plis(joins.size());
+    std::vector<std::size_t> indices(joins.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    util::ParallelForeach(indices.begin(), indices.end(), threads_num_, [&](std::size_t i) {
+        Join const& join = joins[i];
+        plis[i] = l_k.GetPli(join.parent)->Intersect(
+                relation_->GetColumnData(join.column).GetPositionListIndex());
+    });
+
+    Level<ColumnSet> l_k_plus_1;
+    for (std::size_t i = 0; i < joins.size(); ++i) {
+        unsigned long const count = plis[i]->GetNumCluster();
+        l_k_plus_1.Add(FunQuadruple<ColumnSet>(joins[i].candidate, count), std::move(plis[i]));
     }
-    return {l_k_plus_1.begin(), l_k_plus_1.end()};
+    return l_k_plus_1;
 }
 
-unsigned long long FUN::ExecuteInternal() {
-    auto start_time = std::chrono::system_clock::now();
-    schema_ = relation_->GetSchema();
-    double progress_step = kTotalProgressPercent / (schema_->GetNumColumns() + 1);
+template <typename ColumnSet>
+unsigned int FUN::Discover() {
+    using Traits = util::BitsetTraits<ColumnSet>;
+    size_t const num_columns = schema_->GetNumColumns();
+    double progress_step = kTotalProgressPercent / (num_columns + 1);
     AddProgress(progress_step);
-    Vertical empty_vertical = *schema_->empty_vertical_;
-
-    r_ = empty_vertical;
-    r_prime_ = empty_vertical;
-    Level l_k_minus_1{FunQuadruple(empty_vertical)};
-    Level l_k;
-    for (std::unique_ptr<Column> const& a : schema_->GetColumns()) {
-        FunQuadruple attribute(*a);
-        attribute.SetCount(Count(attribute.GetCandidate()));
-        l_k.push_back(attribute);
-        r_ = r_.Union(*a);
+    ColumnSet const empty_set = Traits::Create(num_columns);
+
+    ColumnSet r = empty_set;
+    ColumnSet r_prime = empty_set;
+    Fds<ColumnSet> fds(num_columns);
+    Level<ColumnSet> l_k_minus_1;
+    l_k_minus_1.Add(FunQuadruple<ColumnSet>(empty_set, 0), nullptr);
+    Level<ColumnSet> l_k;
+    for (model::ColumnIndex a = 0; a < num_columns; ++a) {
+        PliPtr pli = relation_->GetColumnData(a).GetPliOwnership();
+        ColumnSet column = empty_set;
+        column.set(a);
+        FunQuadruple<ColumnSet> attribute(column, pli->GetNumCluster());
+        r.set(a);
         if (!IsKey(attribute)) {
-            r_prime_ = r_prime_.Union(*a);
+            r_prime.set(a);
         }
         if (attribute.GetCount() == 1) {
-            fds_.emplace(*a, std::set<Vertical>{empty_vertical});
+            fds[a].push_back(empty_set);
         }
+        l_k.Add(std::move(attribute), std::move(pli));
     }
 
-    while (!l_k.empty()) {
-        ComputeClosure(l_k_minus_1, l_k);
-        ComputeQuasiClosure(l_k_minus_1, l_k);
-        DisplayFD(l_k_minus_1);
+    while (!l_k.Empty()) {
+        if (ShouldStop()) break;
+        ComputeClosure(l_k_minus_1, l_k, r_prime);
+        ComputeQuasiClosure(l_k_minus_1, l_k, r);
+        DisplayFD(l_k_minus_1, fds);
         PurePrune(l_k_minus_1, l_k);
-        l_k_minus_1 = l_k;
-        l_k = GenerateCandidate(l_k);
+        l_k_minus_1 = std::move(l_k);
+        l_k = GenerateCandidate(l_k_minus_1, r_prime);
+        l_k_minus_1.ReleasePlis();
         AddProgress(progress_step);
     }
-    DisplayFD(l_k_minus_1);
+    // the last level is complete only if the traversal has not been stopped
+    if (l_k.Empty()) {
+        DisplayFD(l_k_minus_1, fds);
+    }
 
-    int total_fds = 0;
-    for (auto const& [rhs, lverticals] : fds_) {
-        for (Vertical const& lhs : lverticals) {
-            RegisterFd(lhs, rhs);
+    unsigned int total_fds = 0;
+    for (model::ColumnIndex rhs = 0; rhs < num_columns; ++rhs) {
+        for (ColumnSet const& lhs : fds[rhs]) {
+            RegisterFd(Vertical(schema_, Traits::ToDynamic(lhs, num_columns)),
+                       *schema_->GetColumn(rhs));
             total_fds++;
         }
     }
+    return total_fds;
+}
+
+unsigned long long FUN::ExecuteInternal() {
+    auto start_time = std::chrono::system_clock::now();
+    schema_ = relation_->GetSchema();
+
+    unsigned int total_fds;
+    size_t const num_columns = schema_->GetNumColumns();
+    if (num_columns <= 64) {
+        total_fds = Discover<std::bitset<64>>();
+    } else if (num_columns <= 128) {
+        total_fds = Discover<std::bitset<128>>();
+    } else if (num_columns <= 256) {
+        total_fds = Discover<std::bitset<256>>();
+    } else {
+        total_fds = Discover<boost::dynamic_bitset<>>();
+    }
 
     SetProgress(kTotalProgressPercent);
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -1,29 +1,35 @@
 #pragma once
 
-#include <set>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <hash_table8.hpp>
 
 #include "algorithms/fd/pli_based_fd_algorithm.h"
-#include "util/custom_hashes.h"
+#include "config/thread_number/type.h"
+#include "model/table/position_list_index.h"
+#include "model/table/vertical.h"
+#include "util/bitset_utils.h"
 
 namespace algos {
 
+template <typename ColumnSet>
 class FunQuadruple {
 private:
-    Vertical candidate_;
+    ColumnSet candidate_;
     unsigned long count_;
-    Vertical quasiclosure_;
-    Vertical closure_;
+    ColumnSet quasiclosure_;
+    ColumnSet closure_;
 
 public:
-    explicit FunQuadruple(Vertical const& candidate)
+    FunQuadruple(ColumnSet const& candidate, unsigned long count)
         : candidate_(candidate),
-          count_(0),
-          quasiclosure_(*candidate.GetSchema()->empty_vertical_),
-          closure_(*candidate.GetSchema()->empty_vertical_) {}
-
-    explicit FunQuadruple(Column const& candidate) : FunQuadruple(Vertical(candidate)) {}
+          count_(count),
+          quasiclosure_(util::BitsetTraits<ColumnSet>::Create(candidate.size())),
+          closure_(util::BitsetTraits<ColumnSet>::Create(candidate.size())) {}
 
-    Vertical const& GetCandidate() const {
+    ColumnSet const& GetCandidate() const {
         return candidate_;
     }
 
@@ -31,86 +37,128 @@ public:
         return count_;
     }
 
-    Vertical const& GetClosure() const {
+    ColumnSet const& GetClosure() const {
         return closure_;
     }
 
-    Vertical const& GetQuasiclosure() const {
+    ColumnSet const& GetQuasiclosure() const {
         return quasiclosure_;
     }
 
-    void SetCount(unsigned long new_count) {
-        count_ = new_count;
-    }
-
-    void SetClosure(Vertical const& new_closure) {
+    void SetClosure(ColumnSet const& new_closure) {
         closure_ = new_closure;
     }
 
-    void SetQuasiclosure(Vertical const& new_quasiclosure) {
+    void SetQuasiclosure(ColumnSet const& new_quasiclosure) {
         quasiclosure_ = new_quasiclosure;
     }
-
-    bool operator==(FunQuadruple const& that) const {
-        return candidate_ == that.candidate_;
-    }
-
-    bool operator!=(FunQuadruple const& that) const {
-        return candidate_ != that.candidate_;
-    }
-
-    bool operator<(FunQuadruple const& that) const {
-        return candidate_ < that.candidate_;
-    }
-
-    bool operator>(FunQuadruple const& that) const {
-        return candidate_ > that.candidate_;
-    }
-
-    FunQuadruple Union(Column const& that) const;
-
-    FunQuadruple Union(Vertical const& that) const;
-
-    bool Contains(FunQuadruple const& that) const;
-
-    bool Contains(Vertical const& that) const;
 };
 
+/* Column sets are represented by std::bitset<64/128/256> for relations of up to 256 columns and
+ * by boost::dynamic_bitset<> for wider ones (see util::BitsetTraits). Every level is indexed by
+ * candidate, so subsets of a candidate are looked up instead of scanning the previous level, and
+ * keeps the PLIs of its candidates to count the next level with one intersection per candidate.
+ */
 class FUN : public PliBasedFDAlgorithm {
 public:
     FUN(std::optional<ColumnLayoutRelationDataManager> relation_manager = std::nullopt);
 
     // Entities from the algorithm itself
 private:
-    Vertical r_;
-    Vertical r_prime_;
-
-    using Level = std::list<FunQuadruple>;
-
-    void ResetStateFd() final;
+    using PliPtr = std::shared_ptr<model::PositionListIndex const>;
+
+    template <typename ColumnSet>
+    class Level {
+    private:
+        std::vector<FunQuadruple<ColumnSet>> quadruples_;
+        // PLIs of the candidates, needed only to generate the next level
+        std::vector<PliPtr> plis_;
+        emhash8::HashMap<ColumnSet, std::size_t> index_;
+
+    public:
+        void Add(FunQuadruple<ColumnSet> quadruple, PliPtr pli) {
+            index_.try_emplace(quadruple.GetCandidate(), quadruples_.size());
+            quadruples_.push_back(std::move(quadruple));
+            plis_.push_back(std::move(pli));
+        }
+
+        FunQuadruple<ColumnSet> const* Find(ColumnSet const& candidate) const {
+            auto it = index_.find(candidate);
+            return it == index_.end() ? nullptr : &quadruples_[it->second];
+        }
+
+        // Keeps only the candidates for which keep[i] is true
+        void Filter(std::vector<char> const& keep);
+
+        void ReleasePlis() {
+            plis_.clear();
+        }
+
+        std::vector<FunQuadruple<ColumnSet>>& GetQuadruples() {
+            return quadruples_;
+        }
+
+        std::vector<FunQuadruple<ColumnSet>> const& GetQuadruples() const {
+            return quadruples_;
+        }
+
+        PliPtr const& GetPli(std::size_t i) const {
+            return plis_[i];
+        }
+
+        bool Empty() const {
+            return quadruples_.empty();
+        }
+    };
+
+    // fds[a] holds minimal left-hand sides of the FDs with right-hand side a
+    template <typename ColumnSet>
+    using Fds = std::vector<std::vector<ColumnSet>>;
+
+    void RegisterOptions();
+    void MakeExecuteOptsAvailableFDInternal() final;
+
+    void ResetStateFd() final {}
     unsigned long long ExecuteInternal() final;
 
-    Level GenerateCandidate(Level const& l_k) const;
+    template <typename ColumnSet>
+    unsigned int Discover();
 
-    void ComputeClosure(Level& l_k_minus_1, Level const& l_k) const;
+    template <typename ColumnSet>
+    Level<ColumnSet> GenerateCandidate(Level<ColumnSet> const& l_k,
+                                       ColumnSet const& r_prime) const;
 
-    unsigned long Count(Vertical const& l) const;
+    template <typename ColumnSet>
+    void ComputeClosure(Level<ColumnSet>& l_k_minus_1, Level<ColumnSet> const& l_k,
+                        ColumnSet const& r_prime) const;
 
-    unsigned long FastCount(Level const& l_k_minus_1, Level const& l_k,
-                            FunQuadruple const& l) const;
+    template <typename ColumnSet>
+    unsigned long FastCount(Level<ColumnSet> const& l_k_minus_1, Level<ColumnSet> const& l_k,
+                            ColumnSet const& l) const;
 
-    void ComputeQuasiClosure(Level const& l_k_minus_1, Level& l_k) const;
+    template <typename ColumnSet>
+    void ComputeQuasiClosure(Level<ColumnSet> const& l_k_minus_1, Level<ColumnSet>& l_k,
+                             ColumnSet const& r) const;
 
-    void PurePrune(Level const& l_k_minus_1, Level& l_k) const;
+    template <typename ColumnSet>
+    void PurePrune(Level<ColumnSet> const& l_k_minus_1, Level<ColumnSet>& l_k) const;
 
-    void DisplayFD(Level const& l_k_minus_1);
+    template <typename ColumnSet>
+    void DisplayFD(Level<ColumnSet> const& l_k_minus_1, Fds<ColumnSet>& fds) const;
 
     // Supporting entities
 private:
     RelationalSchema const* schema_;
-    std::unordered_map<Column, std::set<Vertical>> fds_;
+    config::ThreadNumType threads_num_;
+
+    template <typename ColumnSet>
+    bool IsKey(FunQuadruple<ColumnSet> const& l) const {
+        return l.GetCount() == relation_->GetNumRows();
+    }
 
-    bool IsKey(FunQuadruple const& l) const;
+    /* Calls f(s) for every s in `level` such that s = l \ {a} for some a in l */
+    template <typename ColumnSet, typename F>
+    static void ForEachDirectSubset(Level<ColumnSet> const& level, ColumnSet const& l, F f);
 };
 
 }  // namespace algos
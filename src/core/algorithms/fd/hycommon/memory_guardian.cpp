@@ -0,0 +1,24 @@
+#include "memory_guardian.h"
+
+#include "model/table/position_list_index.h"
+
+namespace algos::hy {
+
+MemoryGuardian::MemoryGuardian(config::MemLimitMBType mem_limit_mb, PLIs const& plis,
+                               Rows const& compressed_records)
+    : max_memory_bytes_(static_cast<size_t>(mem_limit_mb) * 1024 * 1024), static_memory_bytes_(0) {
+    if (max_memory_bytes_ == 0) return;
+    using Cluster = model::PositionListIndex::Cluster;
+    for (model::PositionListIndex const* pli : plis) {
+        for (Cluster const& cluster : pli->GetIndex()) {
+            static_memory_bytes_ +=
+                    sizeof(Cluster) + cluster.capacity() * sizeof(Cluster::value_type);
+        }
+    }
+
+    for (Row const& row : compressed_records) {
+        static_memory_bytes_ += sizeof(Row) + row.capacity() * sizeof(Row::value_type);
+    }
+}
+
+}  // namespace algos::hy
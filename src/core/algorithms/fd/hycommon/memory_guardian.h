@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+
+#include <easylogging++.h>
+
+#include "config/mem_limit/type.h"
+#include "types.h"
+
+namespace algos::hy {
+
+/**
+ * Keeps HyFD and HyUCC within a memory budget.
+ *
+ * Tracks an approximate footprint of the structures that dominate memory consumption: the prefix
+ * tree, the comparison suggestions and the PLIs together with the compressed records. When the
+ * footprint exceeds the budget, the maximum size of the mined dependencies is lowered and the
+ * prefix tree is trimmed accordingly. The algorithm then finishes with a truncated result instead
+ * of running out of memory, just as the memory guardian from the original HyFD paper does.
+ * A guardian without a limit is inactive: it estimates nothing and never trims the tree.
+ */
+class MemoryGuardian {
+private:
+    // 0 if there is no limit
+    size_t max_memory_bytes_;
+    // PLIs and compressed records are not changed during the execution, so their size is
+    // calculated once
+    size_t static_memory_bytes_;
+    bool is_triggered_ = false;
+
+public:
+    /* mem_limit_mb == 0 means no limit */
+    MemoryGuardian(config::MemLimitMBType mem_limit_mb, PLIs const& plis,
+                   Rows const& compressed_records);
+
+    /**
+     * Trims the tree until the estimated memory usage fits into the budget.
+     *
+     * @param tree prefix tree providing GetMemoryUsage(), GetDepth() and Trim()
+     * @param comparison_suggestions row pairs accumulated by the validator
+     * @param min_depth the tree is never trimmed below this depth
+     * @return whether the tree has been trimmed
+     */
+    template <typename Tree>
+    bool Match(Tree& tree, IdPairs const& comparison_suggestions, unsigned min_depth) {
+        if (max_memory_bytes_ == 0) return false;
+        size_t const suggestions_bytes =
+                comparison_suggestions.capacity() * sizeof(IdPairs::value_type);
+        bool trimmed = false;
+        while (static_memory_bytes_ + suggestions_bytes + tree.GetMemoryUsage() >
+               max_memory_bytes_) {
+            unsigned const depth = tree.GetDepth();
+            if (depth <= min_depth) {
+                LOG(WARNING) << "Memory limit is exceeded, but the prefix tree cannot be trimmed "
+                                "any further";
+                break;
+            }
+
+            tree.Trim(depth - 1);
+            trimmed = true;
+            is_triggered_ = true;
+            LOG(WARNING) << "Memory limit is exceeded, maximum dependency size is lowered to "
+                         << depth - 1 << ". The result will be truncated";
+        }
+        return trimmed;
+    }
+
+    [[nodiscard]] bool IsTriggered() const noexcept {
+        return is_triggered_;
+    }
+};
+
+}  // namespace algos::hy
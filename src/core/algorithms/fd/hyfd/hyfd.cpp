@@ -10,8 +10,10 @@
 #include <boost/dynamic_bitset.hpp>
 #include <easylogging++.h>
 
+#include "algorithms/fd/hycommon/memory_guardian.h"
 #include "algorithms/fd/hycommon/preprocessor.h"
 #include "algorithms/fd/hycommon/util/pli_util.h"
+#include "config/mem_limit/option.h"
 #include "inductor.h"
 #include "sampler.h"
 #include "validator.h"
@@ -19,7 +21,15 @@
 namespace algos::hyfd {
 
 HyFD::HyFD(std::optional<ColumnLayoutRelationDataManager> relation_manager)
-    : PliBasedFDAlgorithm({}, relation_manager) {}
+    : PliBasedFDAlgorithm({}, relation_manager) {
+    RegisterOption(config::kOptionalMemLimitMbOpt(&mem_limit_mb_));
+    RegisterTimeLimitOption();
+    if (!relation_manager.has_value()) RegisterDeduplicateRowsOption();
+}
+
+void HyFD::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable({config::kOptionalMemLimitMbOpt.GetName()});
+}
 
 unsigned long long HyFD::ExecuteInternal() {
     using namespace hy;
@@ -30,21 +40,35 @@ unsigned long long HyFD::ExecuteInternal() {
     auto const plis_shared = std::make_shared<PLIs>(std::move(plis));
     auto const pli_records_shared = std::make_shared<Rows>(std::move(pli_records));
 
+    MemoryGuardian memory_guardian(mem_limit_mb_, *plis_shared, *pli_records_shared);
     Sampler sampler(plis_shared, pli_records_shared);
 
     auto const positive_cover_tree =
             std::make_shared<fd_tree::FDTree>(GetRelation().GetNumColumns());
+    positive_cover_tree->SetMaxLhs(max_lhs_);
     Inductor inductor(positive_cover_tree);
-    Validator validator(positive_cover_tree, plis_shared, pli_records_shared);
+    Validator validator(positive_cover_tree, plis_shared, pli_records_shared, memory_guardian,
+                        [this]() { return ShouldStop(); });
 
     IdPairs comparison_suggestions;
+    bool is_stopped = false;
 
     while (true) {
+        // the candidates of the positive cover are valid FDs only on the validated levels
+        if (ShouldStop()) {
+            is_stopped = true;
+            break;
+        }
         auto non_fds = sampler.GetNonFDs(comparison_suggestions);
 
         inductor.UpdateFdTree(std::move(non_fds));
+        memory_guardian.Match(*positive_cover_tree, comparison_suggestions, 0);
 
         comparison_suggestions = validator.ValidateAndExtendCandidates();
+        if (validator.IsStopped()) {
+            is_stopped = true;
+            break;
+        }
 
         if (comparison_suggestions.empty()) {
             break;
@@ -53,7 +77,22 @@ unsigned long long HyFD::ExecuteInternal() {
         LOG(TRACE) << "Cycle done";
     }
 
+    is_result_truncated_ = memory_guardian.IsTriggered();
+    if (is_result_truncated_) {
+        LOG(WARNING) << "Memory limit was reached, only FDs with LHS of size at most "
+                     << positive_cover_tree->GetMaxLhs() << " were mined";
+    }
+
     auto fds = positive_cover_tree->FillFDs();
+    if (is_stopped) {
+        // only the candidates of the validated levels are FDs
+        unsigned const validated_levels = validator.GetFirstUnvalidatedLevel();
+        std::erase_if(fds, [validated_levels](RawFD const& fd) {
+            return fd.lhs_.count() >= validated_levels;
+        });
+        LOG(INFO) << "Stopped before all the candidates were validated, registered the FDs with "
+                  << "LHS of size less than " << validated_levels;
+    }
     RegisterFDs(std::move(fds), og_mapping);
 
     SetProgress(kTotalProgressPercent);
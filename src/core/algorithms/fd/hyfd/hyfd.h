@@ -8,6 +8,7 @@
 #include "algorithms/fd/hycommon/types.h"
 #include "algorithms/fd/pli_based_fd_algorithm.h"
 #include "algorithms/fd/raw_fd.h"
+#include "config/mem_limit/type.h"
 #include "model/table/position_list_index.h"
 
 namespace algos::hyfd {
@@ -34,10 +35,21 @@ namespace algos::hyfd {
  * Discovery. In Proceedings of the 2016 International Conference on Management of Data (SIGMOD
  * '16). Association for Computing Machinery, New York, NY, USA, 821–833.
  * https://doi.org/10.1145/2882903.2915203
+ *
+ * If a memory limit is set, the execution is watched by a memory guardian: if the prefix tree,
+ * comparison suggestions and PLIs outgrow the limit, the maximum LHS size is lowered and the
+ * result is truncated.
  */
 class HyFD : public PliBasedFDAlgorithm {
 private:
-    void ResetStateFd() final {}
+    config::MemLimitMBType mem_limit_mb_;
+    bool is_result_truncated_ = false;
+
+    void ResetStateFd() final {
+        is_result_truncated_ = false;
+    }
+
+    void MakeExecuteOptsAvailableFDInternal() final;
 
     unsigned long long ExecuteInternal() override;
 
@@ -45,6 +57,14 @@ private:
 
 public:
     HyFD(std::optional<ColumnLayoutRelationDataManager> relation_manager = std::nullopt);
+
+    /**
+     * @return whether the memory guardian had to lower the maximum LHS size, i.e. FDs with large
+     * LHSs may be missing from the result
+     */
+    [[nodiscard]] bool IsResultTruncated() const noexcept {
+        return is_result_truncated_;
+    }
 };
 
 }  // namespace algos::hyfd
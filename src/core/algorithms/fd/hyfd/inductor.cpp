@@ -26,6 +26,10 @@ void Inductor::SpecializeTreeForNonFd(boost::dynamic_bitset<> const& lhs_bits, s
     for (auto& invalid_lhs_bits : invalid_lhss) {
         tree_->Remove(invalid_lhs_bits, rhs_id);
 
+        if (!tree_->IsLhsSizeAllowed(invalid_lhs_bits.count() + 1)) {
+            continue;
+        }
+
         for (size_t i = 0; i < tree_->GetNumAttributes(); ++i) {
             if (i == rhs_id || lhs_bits.test(i)) {
                 continue;
@@ -11,12 +11,14 @@ class Inductor {
 private:
     std::shared_ptr<fd_tree::FDTree> tree_;
 
-    void SpecializeTreeForNonFd(boost::dynamic_bitset<> const& lhs_bits, size_t rhs_id);
-
 public:
     explicit Inductor(std::shared_ptr<fd_tree::FDTree> tree) noexcept : tree_(std::move(tree)) {}
 
     void UpdateFdTree(NonFDList&& non_fds);
+
+    /* Removes the FDs with rhs_id whose LHS is a subset of the non-FD LHS lhs_bits, the empty
+     * one included, and adds their minimal specializations not generalized by another FD */
+    void SpecializeTreeForNonFd(boost::dynamic_bitset<> const& lhs_bits, size_t rhs_id);
 };
 
 }  // namespace algos::hyfd
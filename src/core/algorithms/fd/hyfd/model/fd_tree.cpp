@@ -46,8 +46,6 @@ bool FDTree::ContainsFD(boost::dynamic_bitset<> const& lhs, size_t rhs) {
 
 std::vector<boost::dynamic_bitset<>> FDTree::GetFdAndGenerals(boost::dynamic_bitset<> const& lhs,
                                                               size_t rhs) const {
-    assert(lhs.count() != 0);
-
     std::vector<boost::dynamic_bitset<>> result;
     boost::dynamic_bitset<> const empty_lhs(GetNumAttributes());
     size_t const starting_bit = lhs.find_first();
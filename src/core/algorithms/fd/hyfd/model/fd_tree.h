@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -21,6 +23,11 @@ class FDTree {
 private:
     std::shared_ptr<FDTreeVertex> root_;
 
+    /**
+     * Maximum LHS size of FDs the tree is allowed to hold
+     */
+    unsigned max_lhs_ = std::numeric_limits<unsigned>::max();
+
 public:
     explicit FDTree(size_t num_attributes) : root_(std::make_shared<FDTreeVertex>(num_attributes)) {
         for (size_t id = 0; id < num_attributes; id++) {
@@ -40,6 +47,43 @@ public:
         return *root_;
     }
 
+    [[nodiscard]] unsigned GetMaxLhs() const noexcept {
+        return max_lhs_;
+    }
+
+    void SetMaxLhs(unsigned max_lhs) noexcept {
+        max_lhs_ = max_lhs;
+    }
+
+    /**
+     * @return whether an FD with LHS of the given arity may be stored in the tree
+     */
+    [[nodiscard]] bool IsLhsSizeAllowed(size_t lhs_size) const noexcept {
+        return lhs_size <= max_lhs_;
+    }
+
+    /**
+     * @return approximate number of bytes occupied by the tree
+     */
+    [[nodiscard]] size_t GetMemoryUsage() const {
+        return root_->GetMemoryUsageRecursive();
+    }
+
+    /**
+     * @return maximum LHS arity among FDs stored in the tree
+     */
+    [[nodiscard]] unsigned GetDepth() const {
+        return root_->GetDepthRecursive();
+    }
+
+    /**
+     * Removes all FDs with LHS larger than max_lhs and forbids adding such FDs later.
+     */
+    void Trim(unsigned max_lhs) {
+        max_lhs_ = std::min(max_lhs_, max_lhs);
+        root_->TrimRecursive(max_lhs_);
+    }
+
     std::shared_ptr<FDTreeVertex> AddFD(boost::dynamic_bitset<> const& lhs, size_t rhs);
 
     bool ContainsFD(boost::dynamic_bitset<> const& lhs, size_t rhs);
@@ -136,4 +136,59 @@ void FDTreeVertex::FillFDs(std::vector<RawFD>& fds, boost::dynamic_bitset<>& lhs
     }
 }
 
+size_t FDTreeVertex::GetMemoryUsageRecursive() const {
+    using Block = boost::dynamic_bitset<>::block_type;
+    // The vertex itself, its shared_ptr control block, both bitsets and the children array
+    size_t usage = sizeof(FDTreeVertex) + 2 * sizeof(std::shared_ptr<FDTreeVertex>) +
+                   (fds_.num_blocks() + attributes_.num_blocks()) * sizeof(Block) +
+                   children_.capacity() * sizeof(std::shared_ptr<FDTreeVertex>);
+
+    if (!contains_children_) {
+        return usage;
+    }
+
+    for (auto const& child : children_) {
+        if (child != nullptr) {
+            usage += child->GetMemoryUsageRecursive();
+        }
+    }
+    return usage;
+}
+
+unsigned FDTreeVertex::GetDepthRecursive() const {
+    unsigned depth = 0;
+    if (!contains_children_) {
+        return depth;
+    }
+
+    for (auto const& child : children_) {
+        if (child != nullptr && child->attributes_.any()) {
+            depth = std::max(depth, child->GetDepthRecursive() + 1);
+        }
+    }
+    return depth;
+}
+
+void FDTreeVertex::TrimRecursive(unsigned max_depth) {
+    if (!contains_children_) {
+        return;
+    }
+
+    if (max_depth == 0) {
+        children_.clear();
+        children_.shrink_to_fit();
+        contains_children_ = false;
+        attributes_ = fds_;
+        return;
+    }
+
+    attributes_ = fds_;
+    for (auto const& child : children_) {
+        if (child != nullptr) {
+            child->TrimRecursive(max_depth - 1);
+            attributes_ |= child->attributes_;
+        }
+    }
+}
+
 }  // namespace algos::hyfd::fd_tree
@@ -108,6 +108,21 @@ private:
 
     void FillFDs(std::vector<RawFD>& fds, boost::dynamic_bitset<>& lhs) const;
 
+    /**
+     * Approximate number of bytes occupied by the subtree rooted at this vertex.
+     */
+    size_t GetMemoryUsageRecursive() const;
+
+    /**
+     * Length of the longest path from this vertex to a descendant holding an FD.
+     */
+    unsigned GetDepthRecursive() const;
+
+    /**
+     * Destroys all descendants deeper than max_depth levels and recalculates attributes.
+     */
+    void TrimRecursive(unsigned max_depth);
+
 public:
     explicit FDTreeVertex(size_t numAttributes) noexcept
         : fds_(numAttributes), attributes_(numAttributes), num_attributes_(numAttributes) {}
@@ -113,6 +113,10 @@ size_t AddExtendedCandidatesFromInvalid(std::vector<algos::hyfd::LhsPair>& next_
                                         size_t num_attributes) {
     size_t candidates = 0;
     for (auto const& [lhs, rhs] : invalid_fds) {
+        if (!fds_tree.IsLhsSizeAllowed(lhs.count() + 1)) {
+            continue;
+        }
+
         for (size_t attr = 0; attr < num_attributes; ++attr) {
             if (lhs.test(attr) || rhs == attr || fds_tree.FindFdOrGeneral(lhs, attr) ||
                 (fds_tree.GetRoot().HasChildren() && fds_tree.GetRoot().ContainsChildAt(attr) &&
@@ -243,6 +247,10 @@ Validator::FDValidations Validator::GetValidations(LhsPair const& lhsPair) {
 Validator::FDValidations Validator::ValidateAndExtendSeq(std::vector<LhsPair> const& vertices) {
     FDValidations result;
     for (auto const& vertex : vertices) {
+        if (is_stopped_()) {
+            stopped_ = true;
+            break;
+        }
         result.Add(GetValidations(vertex));
     }
 
@@ -264,6 +272,9 @@ algos::hy::IdPairs Validator::ValidateAndExtendCandidates() {
     algos::hy::IdPairs comparison_suggestions;
     while (!cur_level_vertices.empty()) {
         auto const result = ValidateAndExtendSeq(cur_level_vertices);
+        if (stopped_) {
+            return comparison_suggestions;
+        }
 
         comparison_suggestions.insert(comparison_suggestions.end(),
                                       result.ComparisonSuggestions().begin(),
@@ -278,6 +289,11 @@ algos::hy::IdPairs Validator::ValidateAndExtendCandidates() {
                 next_level, *fds_, result.InvalidInstances(), num_attributes);
         algos::hy::LogLevel(cur_level_vertices, result, candidates, current_level_number_, "FD");
 
+        if (memory_guardian_.Match(*fds_, comparison_suggestions, 0)) {
+            // Vertices of the next level may have been cut off from the tree
+            next_level = fds_->GetLevel(current_level_number_ + 1);
+        }
+
         size_t const num_invalid_fds = result.InvalidInstances().size();
         size_t const num_valid_fds = result.CountValidations() - num_invalid_fds;
         cur_level_vertices = std::move(next_level);
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include "algorithms/fd/hycommon/memory_guardian.h"
 #include "algorithms/fd/hycommon/primitive_validations.h"
 #include "algorithms/fd/hyfd/model/fd_tree.h"
 #include "algorithms/fd/raw_fd.h"
@@ -22,8 +24,11 @@ private:
 
     hy::PLIsPtr plis_;
     hy::RowsPtr compressed_records_;
+    hy::MemoryGuardian& memory_guardian_;
+    std::function<bool()> is_stopped_;
 
     unsigned current_level_number_ = 0;
+    bool stopped_ = false;
 
     FDValidations ProcessZeroLevel(LhsPair const& lhsPair);
     FDValidations ProcessFirstLevel(LhsPair const& lhs_pair);
@@ -39,12 +44,25 @@ private:
 
 public:
     Validator(std::shared_ptr<fd_tree::FDTree> fds, hy::PLIsPtr plis,
-              hy::RowsPtr compressed_records) noexcept
+              hy::RowsPtr compressed_records, hy::MemoryGuardian& memory_guardian,
+              std::function<bool()> is_stopped) noexcept
         : fds_(std::move(fds)),
           plis_(std::move(plis)),
-          compressed_records_(std::move(compressed_records)) {}
+          compressed_records_(std::move(compressed_records)),
+          memory_guardian_(memory_guardian),
+          is_stopped_(std::move(is_stopped)) {}
 
+    /* Once is_stopped returns true, the validation is abandoned in the middle of the level */
     hy::IdPairs ValidateAndExtendCandidates();
+
+    [[nodiscard]] bool IsStopped() const {
+        return stopped_;
+    }
+
+    /* The levels of the tree below this one are validated, their candidates are minimal FDs */
+    [[nodiscard]] unsigned GetFirstUnvalidatedLevel() const {
+        return current_level_number_;
+    }
 };
 
 }  // namespace algos::hyfd
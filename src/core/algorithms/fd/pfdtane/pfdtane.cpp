@@ -4,18 +4,23 @@
 #include <iomanip>
 #include <list>
 #include <memory>
+#include <numeric>
+#include <tuple>
+#include <vector>
 
 #include <easylogging++.h>
 
 #include "config/error/option.h"
 #include "config/error_measure/option.h"
 #include "config/max_lhs/option.h"
+#include "config/thread_number/option.h"
 #include "enums.h"
 #include "fd/tane/lattice_level.h"
 #include "fd/tane/lattice_vertex.h"
 #include "model/table/column_data.h"
 #include "model/table/column_layout_relation_data.h"
 #include "model/table/relational_schema.h"
+#include "util/parallel_for.h"
 
 namespace algos {
 using boost::dynamic_bitset;
@@ -32,48 +37,82 @@ config::ErrorType PFDTane::CalculateZeroAryFdError(ColumnData const* rhs) {
 
 config::ErrorType PFDTane::CalculateFdError(model::PositionListIndex const* x_pli,
                                             model::PositionListIndex const* xa_pli,
-                                            ErrorMeasure measure) {
-    std::deque<Cluster> xa_index = xa_pli->GetIndex();
-    std::shared_ptr<Cluster const> probing_table = x_pli->CalculateAndGetProbingTable();
-    std::sort(xa_index.begin(), xa_index.end(),
-              [&probing_table](Cluster const& a, Cluster const& b) {
-                  return probing_table->at(a.front()) < probing_table->at(b.front());
-              });
-    double sum = 0.0;
-    std::size_t cluster_rows_count = 0;
-    std::deque<Cluster> const& x_index = x_pli->GetIndex();
-    auto xa_cluster_it = xa_index.begin();
+                                            ErrorMeasure measure,
+                                            ColumnLayoutRelationData const* relation_data) {
+    /* XA refines X, so every non-singleton cluster of XA lies inside some non-singleton cluster
+     * of X. One pass over the clusters of X labels their rows, one pass over the clusters of XA
+     * finds the heaviest XA cluster inside every X cluster. A row of weight w stands for w equal
+     * rows, so a row that is a singleton in XA is a class of XA of that weight.
+     */
+    thread_local std::vector<unsigned int> row_to_x_cluster;
+    thread_local std::vector<std::size_t> x_cluster_weights;
+    thread_local std::vector<std::size_t> max_xa_cluster_weights;
+
+    bool const is_weighted = relation_data != nullptr && relation_data->IsDeduplicated();
+    auto const get_cluster_weight = [is_weighted, relation_data](Cluster const& cluster) {
+        if (!is_weighted) return cluster.size();
+        std::size_t weight = 0;
+        for (int row : cluster) {
+            weight += relation_data->GetRowWeight(row);
+        }
+        return weight;
+    };
 
-    for (Cluster const& x_cluster : x_index) {
-        std::size_t max = 1;
+    std::deque<Cluster> const& x_index = x_pli->GetIndex();
+    row_to_x_cluster.resize(x_pli->GetRelationSize());
+    x_cluster_weights.resize(x_index.size());
+    max_xa_cluster_weights.assign(x_index.size(), 1);
+    for (unsigned int x_cluster_id = 0; x_cluster_id < x_index.size(); ++x_cluster_id) {
+        Cluster const& x_cluster = x_index[x_cluster_id];
         for (int x_row : x_cluster) {
-            if (xa_cluster_it == xa_index.end()) {
-                break;
-            }
-            if (x_row == xa_cluster_it->at(0)) {
-                max = std::max(max, xa_cluster_it->size());
-                xa_cluster_it++;
+            row_to_x_cluster[x_row] = x_cluster_id;
+        }
+        x_cluster_weights[x_cluster_id] = get_cluster_weight(x_cluster);
+        if (is_weighted) {
+            std::size_t& max = max_xa_cluster_weights[x_cluster_id];
+            for (int x_row : x_cluster) {
+                max = std::max(max, relation_data->GetRowWeight(x_row));
             }
         }
+    }
+    for (Cluster const& xa_cluster : xa_pli->GetIndex()) {
+        std::size_t& max = max_xa_cluster_weights[row_to_x_cluster[xa_cluster.front()]];
+        max = std::max(max, get_cluster_weight(xa_cluster));
+    }
+
+    double sum = 0.0;
+    std::size_t cluster_rows_count = 0;
+    std::size_t cluster_rows_weight = 0;
+    for (unsigned int x_cluster_id = 0; x_cluster_id < x_index.size(); ++x_cluster_id) {
+        std::size_t const x_cluster_weight = x_cluster_weights[x_cluster_id];
+        std::size_t const max = max_xa_cluster_weights[x_cluster_id];
         sum += measure == +ErrorMeasure::per_tuple ? static_cast<double>(max)
-                                                   : static_cast<double>(max) / x_cluster.size();
-        cluster_rows_count += x_cluster.size();
+                                                   : static_cast<double>(max) / x_cluster_weight;
+        cluster_rows_count += x_index[x_cluster_id].size();
+        cluster_rows_weight += x_cluster_weight;
     }
-    unsigned int unique_rows =
-            static_cast<unsigned int>(x_pli->GetRelationSize() - cluster_rows_count);
-    double probability = static_cast<double>(sum + unique_rows) /
-                         (measure == +ErrorMeasure::per_tuple ? x_pli->GetRelationSize()
-                                                              : x_index.size() + unique_rows);
+    std::size_t const rows_weight =
+            is_weighted ? relation_data->GetNumOriginalRows() : x_pli->GetRelationSize();
+    // every row outside the clusters of X is a class of X that satisfies the FD on its own
+    std::size_t const unique_rows = x_pli->GetRelationSize() - cluster_rows_count;
+    double probability =
+            measure == +ErrorMeasure::per_tuple
+                    ? (sum + static_cast<double>(rows_weight - cluster_rows_weight)) / rows_weight
+                    : (sum + static_cast<double>(unique_rows)) /
+                              static_cast<double>(x_index.size() + unique_rows);
     return 1.0 - probability;
 }
 
 void PFDTane::RegisterOptions() {
     RegisterOption(config::kErrorOpt(&max_ucc_error_));
     RegisterOption(config::kErrorMeasureOpt(&error_measure_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    RegisterTimeLimitOption();
 }
 
 void PFDTane::MakeExecuteOptsAvailableFDInternal() {
-    MakeOptionsAvailable({config::kErrorOpt.GetName(), config::kErrorMeasureOpt.GetName()});
+    MakeOptionsAvailable({config::kErrorOpt.GetName(), config::kErrorMeasureOpt.GetName(),
+                          config::kThreadNumberOpt.GetName()});
 }
 
 void PFDTane::ResetStateFd() {}
@@ -121,7 +160,7 @@ void PFDTane::Prune(model::LatticeLevel* level) {
                                         level->GetLatticeVertex(sibling.GetColumnIndices());
                                 if (sibling_vertex == nullptr ||
                                     !sibling_vertex->GetConstRhsCandidates()
-                                             [rhs.GetColumnIndices().find_first()]) {
+                                             [rhs.FindFirst()]) {
                                     is_rhs_candidate = false;
                                     break;
                                 }
@@ -152,11 +191,24 @@ void PFDTane::Prune(model::LatticeLevel* level) {
 
 void PFDTane::ComputeDependencies(model::LatticeLevel* level) {
     RelationalSchema const* schema = relation_->GetSchema();
+    std::vector<model::LatticeVertex*> xa_vertices;
     for (auto& [key_map, xa_vertex] : level->GetVertices()) {
-        if (xa_vertex->GetIsInvalid()) {
-            continue;
+        if (!xa_vertex->GetIsInvalid()) {
+            xa_vertices.push_back(xa_vertex.get());
         }
-        Vertical xa = xa_vertex->GetVertical();
+    }
+
+    /* A vertex changes only its own PLI and RHS candidates and reads the PLIs of its parents from
+     * the previous level, so the vertices are processed independently. FDs are registered
+     * afterwards in the order of the vertices.
+     */
+    std::vector<std::vector<std::tuple<Vertical const*, Column const*, config::ErrorType>>>
+            found_fds(xa_vertices.size());
+    std::vector<std::size_t> indices(xa_vertices.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    util::ParallelForeach(indices.begin(), indices.end(), threads_num_, [&](std::size_t i) {
+        model::LatticeVertex* xa_vertex = xa_vertices[i];
+        Vertical const& xa = xa_vertex->GetVertical();
         // Calculate XA PLI
         if (xa_vertex->GetPositionListIndex() == nullptr) {
             auto parent_pli_1 = xa_vertex->GetParents()[0]->GetPositionListIndex();
@@ -164,20 +216,14 @@ void PFDTane::ComputeDependencies(model::LatticeLevel* level) {
             xa_vertex->AcquirePositionListIndex(parent_pli_1->Intersect(parent_pli_2));
         }
 
-        dynamic_bitset<> xa_indices = xa.GetColumnIndices();
+        dynamic_bitset<> const& xa_indices = xa.GetColumnIndices();
         dynamic_bitset<> a_candidates = xa_vertex->GetRhsCandidates();
         auto xa_pli = xa_vertex->GetPositionListIndex();
         for (auto const& x_vertex : xa_vertex->GetParents()) {
             Vertical const& lhs = x_vertex->GetVertical();
 
-            // Find index of A in XA. If a is not a candidate, continue. TODO: possible to do it
-            // easier??
-            // like "a_index = xa_indices - x_indices;"
-            int a_index = xa_indices.find_first();
-            dynamic_bitset<> x_indices = lhs.GetColumnIndices();
-            while (a_index >= 0 && x_indices[a_index]) {
-                a_index = xa_indices.find_next(a_index);
-            }
+            // A is the only column of XA that is not in X
+            std::size_t const a_index = (xa_indices & ~lhs.GetColumnIndices()).find_first();
             if (!a_candidates[a_index]) {
                 continue;
             }
@@ -188,13 +234,19 @@ void PFDTane::ComputeDependencies(model::LatticeLevel* level) {
             if (error <= max_fd_error_) {
                 Column const* rhs = schema->GetColumns()[a_index].get();
 
-                RegisterAndCountFd(lhs, rhs, error, schema);
+                found_fds[i].emplace_back(&lhs, rhs, error);
                 xa_vertex->GetRhsCandidates().set(rhs->GetIndex(), false);
                 if (error == 0) {
                     xa_vertex->GetRhsCandidates() &= lhs.GetColumnIndices();
                 }
             }
         }
+    });
+
+    for (auto const& vertex_fds : found_fds) {
+        for (auto const& [lhs, rhs, error] : vertex_fds) {
+            RegisterAndCountFd(*lhs, rhs, error, schema);
+        }
     }
 }
 
@@ -262,7 +314,7 @@ unsigned long long PFDTane::ExecuteInternal() {
 
         // вот тут костыль, чтобы вытянуть индекс колонки из вершины, в которой только один индекс
         ColumnData const& column_data =
-                relation_->GetColumnData(column.GetColumnIndices().find_first());
+                relation_->GetColumnData(column.FindFirst());
         double ucc_error = CalculateUccError(column_data.GetPositionListIndex(), relation_.get());
         if (ucc_error <= max_ucc_error_) {
             vertex->SetKeyCandidate(false);
@@ -270,7 +322,7 @@ unsigned long long PFDTane::ExecuteInternal() {
                 for (unsigned long rhs_index = vertex->GetRhsCandidates().find_first();
                      rhs_index < vertex->GetRhsCandidates().size();
                      rhs_index = vertex->GetRhsCandidates().find_next(rhs_index)) {
-                    if (rhs_index != column.GetColumnIndices().find_first()) {
+                    if (rhs_index != column.FindFirst()) {
                         RegisterAndCountFd(column, schema->GetColumn(rhs_index), 0, schema);
                     }
                 }
@@ -297,6 +349,8 @@ unsigned long long PFDTane::ExecuteInternal() {
         if (level->GetVertices().empty()) {
             break;
         }
+        // the remaining levels are skipped
+        if (ShouldStop()) break;
 
         ComputeDependencies(level);
 
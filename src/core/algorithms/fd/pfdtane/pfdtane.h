@@ -5,6 +5,7 @@
 #include "config/error/type.h"
 #include "config/error_measure/type.h"
 #include "config/max_lhs/type.h"
+#include "config/thread_number/type.h"
 #include "enums.h"
 #include "model/table/position_list_index.h"
 #include "model/table/relation_data.h"
@@ -16,6 +17,7 @@ private:
     config::ErrorType max_fd_error_;
     config::ErrorType max_ucc_error_;
     ErrorMeasure error_measure_ = +ErrorMeasure::per_tuple;
+    config::ThreadNumType threads_num_;
 
     void ResetStateFd() final;
     void RegisterOptions();
@@ -32,9 +34,13 @@ public:
     void RegisterAndCountFd(Vertical const& lhs, Column const* rhs, double error,
                             RelationalSchema const* schema);
     static config::ErrorType CalculateZeroAryFdError(ColumnData const* rhs);
-    static config::ErrorType CalculateFdError(model::PositionListIndex const* x_pli,
-                                              model::PositionListIndex const* xa_pli,
-                                              ErrorMeasure error_measure);
+    /* Thread-safe. Scratch buffers are kept per thread, so repeated calls allocate nothing
+     * once the buffers have grown to the size of the relation. If the PLIs belong to a relation
+     * whose duplicate rows were collapsed, it must be passed, the rows are weighted then.
+     */
+    static config::ErrorType CalculateFdError(
+            model::PositionListIndex const* x_pli, model::PositionListIndex const* xa_pli,
+            ErrorMeasure error_measure, ColumnLayoutRelationData const* relation_data = nullptr);
 };
 
 }  // namespace algos
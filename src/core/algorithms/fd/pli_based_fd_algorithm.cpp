@@ -1,10 +1,55 @@
 #include "pli_based_fd_algorithm.h"
 
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+#include "config/deduplicate_rows/option.h"
 #include "config/equal_nulls/option.h"
+#include "config/names_and_descriptions.h"
 #include "config/tabular_data/input_table/option.h"
+#include "model/table/dataset_stream_sample.h"
+#include "model/table/position_list_index.h"
 
 namespace algos {
 
+namespace {
+// g1 error of every FD, the columns are matched by index, so the FDs may come from another
+// relation with the same schema, e.g. a sample of this one
+std::vector<config::ErrorType> CalculateG1Errors(ColumnLayoutRelationData const& relation,
+                                                 std::list<FD> const& fds) {
+    double const tuple_pairs_num = static_cast<double>(relation.GetNumOriginalTuplePairs());
+    std::vector<config::ErrorType> errors;
+    errors.reserve(fds.size());
+    for (FD const& fd : fds) {
+        if (tuple_pairs_num == 0) {
+            errors.push_back(0);
+            continue;
+        }
+        model::PositionListIndex const* rhs_pli =
+                relation.GetColumnData(fd.GetRhsIndex()).GetPositionListIndex();
+        std::vector<model::ColumnIndex> const lhs_indices = fd.GetLhsIndices();
+        if (lhs_indices.empty()) {
+            errors.push_back(1 - relation.GetNumAgreeingTuplePairs(*rhs_pli) / tuple_pairs_num);
+            continue;
+        }
+        model::PositionListIndex const* lhs_pli =
+                relation.GetColumnData(lhs_indices.front()).GetPositionListIndex();
+        std::unique_ptr<model::PositionListIndex> intersection;
+        for (auto it = std::next(lhs_indices.begin()); it != lhs_indices.end(); ++it) {
+            intersection = lhs_pli->Intersect(relation.GetColumnData(*it).GetPositionListIndex());
+            lhs_pli = intersection.get();
+        }
+        std::unique_ptr<model::PositionListIndex> const joint_pli = lhs_pli->Intersect(rhs_pli);
+        errors.push_back((relation.GetNumAgreeingTuplePairs(*lhs_pli) -
+                          relation.GetNumAgreeingTuplePairs(*joint_pli)) /
+                         tuple_pairs_num);
+    }
+    return errors;
+}
+}  // namespace
+
 PliBasedFDAlgorithm::PliBasedFDAlgorithm(
         std::vector<std::string_view> phase_names,
         std::optional<ColumnLayoutRelationDataManager> relation_manager)
@@ -15,16 +60,41 @@ PliBasedFDAlgorithm::PliBasedFDAlgorithm(
                                           &input_table_, &is_null_equal_null_, &relation_}) {
     if (relation_manager.has_value()) return;
     RegisterRelationManagerOptions();
-    MakeOptionsAvailable({config::kTableOpt.GetName(), config::kEqualNullsOpt.GetName()});
+    MakeOptionsAvailable({config::kTableOpt.GetName(), config::kEqualNullsOpt.GetName(),
+                          config::names::kRowSampleSize});
 }
 
 void PliBasedFDAlgorithm::RegisterRelationManagerOptions() {
+    using namespace config::names;
+    using namespace config::descriptions;
+    using config::Option;
+
     RegisterOption(config::kTableOpt(&input_table_));
     RegisterOption(config::kEqualNullsOpt(&is_null_equal_null_));
+    RegisterOption(Option{&row_sample_size_, kRowSampleSize, kDRowSampleSize, 0u}
+                           .SetConditionalOpts({{[](unsigned int size) { return size != 0; },
+                                                 {kRowSampleSeed}}}));
+    RegisterOption(Option{&row_sample_seed_, kRowSampleSeed, kDRowSampleSeed, 0});
+}
+
+void PliBasedFDAlgorithm::RegisterDeduplicateRowsOption() {
+    RegisterOption(config::kDeduplicateRowsOpt(&deduplicate_rows_));
+    MakeOptionsAvailable({config::kDeduplicateRowsOpt.GetName()});
 }
 
 void PliBasedFDAlgorithm::LoadDataInternal() {
-    relation_ = relation_manager_.GetRelation();
+    if (IsSampled()) {
+        model::DatasetStreamSample<config::InputTable> sample(
+                input_table_, row_sample_size_, static_cast<unsigned>(row_sample_seed_));
+        table_rows_num_ = sample.GetStreamRowsNum();
+        relation_ = ColumnLayoutRelationData::CreateFrom(sample, is_null_equal_null_,
+                                                         deduplicate_rows_);
+    } else {
+        relation_ = deduplicate_rows_ ? ColumnLayoutRelationData::CreateFrom(
+                                                *input_table_, is_null_equal_null_, true)
+                                      : relation_manager_.GetRelation();
+        table_rows_num_ = relation_->GetNumOriginalRows();
+    }
 
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: FD mining is meaningless.");
@@ -35,6 +105,10 @@ std::vector<Column const*> PliBasedFDAlgorithm::GetKeys() const {
     assert(relation_ != nullptr);
 
     std::vector<Column const*> keys;
+    // the columns of a collapsed duplicate row agree, so no column is a key of the table
+    if (relation_->GetNumOriginalRows() != relation_->GetNumRows()) {
+        return keys;
+    }
     for (ColumnData const& col : relation_->GetColumnData()) {
         if (col.GetPositionListIndex()->AllValuesAreUnique()) {
             keys.push_back(col.GetColumn());
@@ -44,4 +118,36 @@ std::vector<Column const*> PliBasedFDAlgorithm::GetKeys() const {
     return keys;
 }
 
+std::vector<model::ConfidenceInterval> PliBasedFDAlgorithm::GetFdErrorIntervals(
+        double confidence) const {
+    if (!(confidence > 0 && confidence < 1)) {
+        throw std::invalid_argument("Confidence must be in (0, 1)");
+    }
+    std::vector<config::ErrorType> const errors = CalculateG1Errors(GetRelation(), FdList());
+    // the tuple pairs of a sample are not independent, but any floor(n/2) disjoint pairs are
+    size_t const independent_pairs_num = GetRelation().GetNumOriginalRows() / 2;
+    double const half_width =
+            !IsSampled() ? 0
+            : independent_pairs_num == 0
+                    ? 1
+                    : std::sqrt(std::log(2 / (1 - confidence)) / (2.0 * independent_pairs_num));
+
+    std::vector<model::ConfidenceInterval> intervals;
+    intervals.reserve(errors.size());
+    for (config::ErrorType error : errors) {
+        intervals.emplace_back(std::max(0.0, error - half_width), error,
+                               std::min(1.0, error + half_width));
+    }
+    return intervals;
+}
+
+std::vector<config::ErrorType> PliBasedFDAlgorithm::CalculateFullDataErrors() {
+    if (!IsSampled()) return CalculateG1Errors(GetRelation(), FdList());
+    input_table_->Reset();
+    std::unique_ptr<ColumnLayoutRelationData> const full_relation =
+            ColumnLayoutRelationData::CreateFrom(*input_table_, is_null_equal_null_,
+                                                 deduplicate_rows_);
+    return CalculateG1Errors(*full_relation, FdList());
+}
+
 }  // namespace algos
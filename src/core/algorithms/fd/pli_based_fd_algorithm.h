@@ -1,8 +1,12 @@
 #pragma once
 
 #include <optional>
+#include <vector>
 
+#include "algorithms/fd/pyrocommon/model/confidence_interval.h"
+#include "config/deduplicate_rows/type.h"
 #include "config/equal_nulls/type.h"
+#include "config/error/type.h"
 #include "config/tabular_data/input_table_type.h"
 #include "fd_algorithm.h"
 #include "model/table/column_layout_relation_data.h"
@@ -37,6 +41,11 @@ private:
     config::InputTable input_table_;
     config::EqNullsType is_null_equal_null_;
     ColumnLayoutRelationDataManager const relation_manager_;
+    // 0 means the whole table is used
+    unsigned int row_sample_size_ = 0;
+    int row_sample_seed_ = 0;
+    config::DeduplicateRowsType deduplicate_rows_ = false;
+    size_t table_rows_num_ = 0;
 
     void RegisterRelationManagerOptions();
 
@@ -45,6 +54,15 @@ protected:
 
     void LoadDataInternal() final;
 
+    /* Lets the user collapse the duplicate rows of the table before mining. Only for the
+     * algorithms that mine exact FDs and do not count rows: the UCCs and the approximate FD
+     * errors found on the distinct rows are not those of the table. GetFdErrorIntervals and
+     * CalculateFullDataErrors weight the rows and are not affected. The rows are hashed by one
+     * thread, as HyFD, which registers the option, has no threads option. Aid, FDep and
+     * AfdErrorCalculator deduplicate the rows themselves and hash them with their threads option.
+     */
+    void RegisterDeduplicateRowsOption();
+
     ColumnLayoutRelationData const& GetRelation() const noexcept {
         // GetRelation should be called after the dataset has been parsed, i.e. after algorithm
         // execution
@@ -57,6 +75,29 @@ public:
                         std::optional<ColumnLayoutRelationDataManager> relation_manager);
 
     std::vector<Column const*> GetKeys() const override;
+
+    // Whether the dependencies are mined on a row sample, see the row_sample_size option
+    bool IsSampled() const noexcept {
+        return row_sample_size_ != 0;
+    }
+
+    // Number of rows of the whole table, the sample is drawn from them
+    size_t GetTableRowsNum() const noexcept {
+        return table_rows_num_;
+    }
+
+    /* Confidence intervals of the g1 errors (shares of violating tuple pairs) that the FDs of
+     * FdList() have on the whole table, estimated from the sample. Each interval holds with the
+     * given probability, the bound is Hoeffding's one for U-statistics, so it does not depend
+     * on the data. Without sampling the intervals are the exact errors.
+     */
+    std::vector<model::ConfidenceInterval> GetFdErrorIntervals(double confidence = 0.95) const;
+
+    /* Exact g1 errors of the FDs of FdList() on the whole table. With sampling the table is read
+     * once more. Only these candidates are validated: if one of them does not hold on the whole
+     * table, its more specific FDs that do hold are not searched for.
+     */
+    std::vector<config::ErrorType> CalculateFullDataErrors();
 };
 
 }  // namespace algos
@@ -2,21 +2,37 @@
 
 #include <chrono>
 #include <mutex>
-#include <thread>
+#include <vector>
 
 #include <easylogging++.h>
 
 #include "algorithms/fd/pyrocommon/core/fd_g1_strategy.h"
+#include "algorithms/fd/pyrocommon/core/key_g1_strategy.h"
 #include "config/error/option.h"
+#include "config/error_thresholds/option.h"
 #include "config/max_lhs/option.h"
 #include "config/names_and_descriptions.h"
 #include "config/option_using.h"
 #include "config/thread_number/option.h"
+#include "util/work_stealing_pool.h"
+
+namespace {
+// Collects the FDs discovered by the search spaces of one of the additional error thresholds
+class ThresholdFdCollector : public DependencyConsumer {
+public:
+    ThresholdFdCollector(std::list<FD>* fds, std::mutex* mutex, config::MaxLhsType max_lhs) {
+        fd_consumer_ = [fds, mutex, max_lhs](PartialFD const& fd) {
+            if (fd.lhs_.GetArity() > max_lhs) return;
+            std::scoped_lock lock(*mutex);
+            fds->emplace_back(fd.lhs_, fd.rhs_);
+        };
+        ucc_consumer_ = nullptr;
+    }
+};
+}  // namespace
 
 namespace algos {
 
-std::mutex search_spaces_mutex;
-
 Pyro::Pyro(std::optional<ColumnLayoutRelationDataManager> relation_manager)
     : PliBasedFDAlgorithm({kDefaultPhaseName}, relation_manager) {
     RegisterOptions();
@@ -24,24 +40,33 @@ Pyro::Pyro(std::optional<ColumnLayoutRelationDataManager> relation_manager)
         this->DiscoverFd(fd);
         this->FDAlgorithm::RegisterFd(fd.lhs_, fd.rhs_);
     };
-    ucc_consumer_ = nullptr;
+    ucc_consumer_ = [this](auto const& ucc) {
+        this->DiscoverUcc(ucc);
+        ucc_collection_.Register(ucc.vertical_);
+    };
 }
 
 void Pyro::RegisterOptions() {
     DESBORDANTE_OPTION_USING;
 
     RegisterOption(config::kErrorOpt(&parameters_.max_ucc_error));
+    RegisterOption(config::kErrorThresholdsOpt(&error_thresholds_));
     RegisterOption(config::kThreadNumberOpt(&parameters_.parallelism));
     RegisterOption(Option{&parameters_.seed, kSeed, kDSeed, 0});
+    RegisterOption(Option{&find_uccs_, kFindUccs, kDFindUccs, false});
+    RegisterTimeLimitOption();
 }
 
 void Pyro::MakeExecuteOptsAvailableFDInternal() {
     using namespace config::names;
-    MakeOptionsAvailable({config::kErrorOpt.GetName(), config::kThreadNumberOpt.GetName(), kSeed});
+    MakeOptionsAvailable({config::kErrorOpt.GetName(), config::kErrorThresholdsOpt.GetName(),
+                          config::kThreadNumberOpt.GetName(), kSeed, kFindUccs});
 }
 
 void Pyro::ResetStateFd() {
     search_spaces_.clear();
+    fds_per_threshold_.clear();
+    ucc_collection_.Clear();
 }
 
 unsigned long long Pyro::ExecuteInternal() {
@@ -62,17 +87,50 @@ unsigned long long Pyro::ExecuteInternal() {
         throw std::runtime_error("Unknown comparator type");
     }
 
+    /* Search spaces of the additional error thresholds are discovered in the same pool and share
+     * the PLI cache and the agree set samples of the profiling context with the search spaces of
+     * the main threshold. The FDs for the main threshold go to FdList(), as usual.
+     */
+    std::mutex fds_per_threshold_mutex;
+    std::vector<std::unique_ptr<DependencyConsumer>> threshold_collectors;
+    std::vector<std::pair<config::ErrorType, DependencyConsumer const*>> thresholds{
+            {parameters_.max_ucc_error, profiling_context.get()}};
+    for (config::ErrorType threshold : error_thresholds_) {
+        std::list<FD>& fds = fds_per_threshold_[threshold];
+        if (threshold == parameters_.max_ucc_error) continue;
+        threshold_collectors.push_back(std::make_unique<ThresholdFdCollector>(
+                &fds, &fds_per_threshold_mutex, max_lhs_));
+        thresholds.emplace_back(threshold, threshold_collectors.back().get());
+    }
+
     int next_id = 0;
-    for (auto& rhs : schema->GetColumns()) {
+    for (auto const& [threshold, consumer] : thresholds) {
+        for (auto& rhs : schema->GetColumns()) {
+            std::unique_ptr<DependencyStrategy> strategy;
+            if (parameters_.ucc_error_measure == "g1prime") {
+                strategy = std::make_unique<FdG1Strategy>(rhs.get(), threshold,
+                                                          parameters_.error_dev);
+            } else {
+                throw std::runtime_error("Unknown key error measure.");
+            }
+            search_spaces_.push_back(std::make_unique<SearchSpace>(
+                    next_id++, std::move(strategy), schema, launch_pad_order, true));
+            search_spaces_.back()->SetContext(profiling_context.get(), consumer);
+        }
+    }
+    // As in the original Pyro, the key search space runs alongside the FD ones and shares the PLI
+    // cache with them, so the PLIs of the column combinations are intersected once for both
+    if (find_uccs_) {
         std::unique_ptr<DependencyStrategy> strategy;
         if (parameters_.ucc_error_measure == "g1prime") {
-            strategy = std::make_unique<FdG1Strategy>(rhs.get(), parameters_.max_ucc_error,
-                                                      parameters_.error_dev);
+            strategy = std::make_unique<KeyG1Strategy>(parameters_.max_ucc_error,
+                                                       parameters_.error_dev);
         } else {
             throw std::runtime_error("Unknown key error measure.");
         }
-        search_spaces_.push_back(std::make_unique<SearchSpace>(next_id++, std::move(strategy),
-                                                               schema, launch_pad_order));
+        search_spaces_.push_back(std::make_unique<SearchSpace>(
+                next_id++, std::move(strategy), schema, launch_pad_order, true));
+        search_spaces_.back()->SetContext(profiling_context.get());
     }
     unsigned long long init_time_millis = std::chrono::duration_cast<std::chrono::milliseconds>(
                                                   std::chrono::system_clock::now() - start_time)
@@ -84,35 +142,27 @@ unsigned long long Pyro::ExecuteInternal() {
     unsigned long long total_trickle = 0;
     double progress_step = 100.0 / search_spaces_.size();
 
-    auto const work_on_search_space =
-            [this, &progress_step](std::list<std::unique_ptr<SearchSpace>>& search_spaces,
-                                   ProfilingContext* profiling_context, int id) {
-                while (true) {
-                    std::unique_ptr<SearchSpace> polled_space;
-                    {
-                        std::scoped_lock<std::mutex> lock(search_spaces_mutex);
-                        if (search_spaces.empty()) {
-                            break;
-                        }
-                        polled_space = std::move(search_spaces.front());
-                        search_spaces.pop_front();
-                    }
-                    LOG(TRACE) << "Thread" << id << " got SearchSpace";
-                    polled_space->SetContext(profiling_context);
-                    polled_space->EnsureInitialized();
-                    polled_space->Discover();
-                    AddProgress(progress_step);
-                }
-            };
-
-    std::vector<std::thread> threads;
-    for (int i = 0; i < parameters_.parallelism; i++) {
-        threads.emplace_back(work_on_search_space, std::ref(search_spaces_),
-                             profiling_context.get(), i);
+    // Search spaces are split into launch pad tasks, so that a single search space with a lot of
+    // work is processed by all of the threads instead of the one that happened to poll it
+    util::WorkStealingPool pool(parameters_.parallelism);
+    // Once the stop is requested, the queued tasks are skipped
+    auto const spawn_task = [this, &pool](std::function<void()> task) {
+        pool.Submit([this, task = std::move(task)]() {
+            if (!ShouldStop()) task();
+        });
+    };
+    auto const on_exhausted = [this, progress_step]() { AddProgress(progress_step); };
+    for (auto& search_space : search_spaces_) {
+        pool.Submit([this, &search_space, &spawn_task, &on_exhausted]() {
+            if (ShouldStop()) return;
+            search_space->EnsureInitialized();
+            search_space->DiscoverConcurrently(parameters_.parallelism, spawn_task, on_exhausted);
+        });
     }
-
-    for (int i = 0; i < parameters_.parallelism; i++) {
-        threads[i].join();
+    pool.Wait();
+    if (auto it = fds_per_threshold_.find(parameters_.max_ucc_error);
+        it != fds_per_threshold_.end()) {
+        it->second = FdList();
     }
 
     SetProgress(100);
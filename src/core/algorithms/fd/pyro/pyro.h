@@ -1,11 +1,14 @@
 #pragma once
 
 #include <list>
-#include <mutex>
 
+#include "algorithms/fd/fds_per_threshold.h"
 #include "algorithms/fd/pli_based_fd_algorithm.h"
 #include "algorithms/fd/pyrocommon/core/dependency_consumer.h"
 #include "algorithms/fd/pyrocommon/core/search_space.h"
+#include "algorithms/ucc/ucc.h"
+#include "config/error_thresholds/type.h"
+#include "util/primitive_collection.h"
 
 namespace algos {
 
@@ -19,6 +22,10 @@ private:
     double caching_method_value_;
 
     pyro::Parameters parameters_;
+    config::ErrorThresholdsType error_thresholds_;
+    FdsPerThreshold fds_per_threshold_;
+    bool find_uccs_ = false;
+    util::PrimitiveCollection<model::UCC> ucc_collection_;
 
     void RegisterOptions();
     void MakeExecuteOptsAvailableFDInternal() final;
@@ -28,6 +35,21 @@ private:
 
 public:
     Pyro(std::optional<ColumnLayoutRelationDataManager> relation_manager = std::nullopt);
+
+    /* Minimal FDs for every threshold of the error_thresholds option, the main error threshold
+     * included if it is listed there. FdList() holds the ones for the main error threshold.
+     * Empty unless the error_thresholds option is set.
+     */
+    FdsPerThreshold const& GetFdsPerThreshold() const noexcept {
+        return fds_per_threshold_;
+    }
+
+    /* Approximate UCCs for the main error threshold, mined along with the FDs in the same pass.
+     * Empty unless the find_uccs option is set.
+     */
+    std::list<model::UCC> const& UCCList() const noexcept {
+        return ucc_collection_.AsList();
+    }
 };
 
 }  // namespace algos
@@ -142,9 +142,9 @@ model::AgreeSetSample const* ProfilingContext::CreateFocusedSample(Vertical cons
     auto pli_pointer = std::holds_alternative<model::PositionListIndex*>(pli)
                                ? std::get<model::PositionListIndex*>(pli)
                                : std::get<std::unique_ptr<model::PositionListIndex>>(pli).get();
+    CustomRandom random = ForkRandom();
     std::unique_ptr<model::ListAgreeSetSample> sample = model::ListAgreeSetSample::CreateFocusedFor(
-            relation_data_, focus, pli_pointer, parameters_.sample_size * boost_factor,
-            custom_random_);
+            relation_data_, focus, pli_pointer, parameters_.sample_size * boost_factor, random);
     LOG(TRACE) << boost::format{"Creating sample focused on: %1%"} % focus.ToString();
     auto sample_ptr = sample.get();
     agree_set_samples_->Put(focus, std::move(sample));
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <random>
 #include <string>
 
@@ -31,6 +32,8 @@ private:
     ColumnLayoutRelationData* relation_data_;
     std::mt19937 random_;
     CustomRandom custom_random_;
+    // search spaces draw random numbers concurrently
+    std::mutex random_mutex_;
 
     model::AgreeSetSample const* CreateColumnFocusedSample(
             Vertical const& focus, model::PositionListIndex const* restriction_pli,
@@ -77,13 +80,21 @@ public:
     // int NextInt(int upper_bound) { return std::uniform_int_distribution<int>{0,
     // upper_bound}(random_); }
     int NextInt(int upper_bound) {
+        std::scoped_lock lock(random_mutex_);
         return custom_random_.NextInt(upper_bound);
     }
 
     double NextDouble() {
+        std::scoped_lock lock(random_mutex_);
         return custom_random_.NextDouble();
     }
 
+    // Generator seeded from the shared one, to draw a lot of numbers without locking
+    CustomRandom ForkRandom() {
+        std::scoped_lock lock(random_mutex_);
+        return CustomRandom(custom_random_.NextLL());
+    }
+
     ~ProfilingContext() override;
 
     static double GetMaximumEntropy(ColumnLayoutRelationData const* cd1);
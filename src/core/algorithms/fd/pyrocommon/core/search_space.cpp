@@ -1,5 +1,7 @@
 #include "search_space.h"
 
+#include <algorithm>
+#include <cassert>
 #include <queue>
 
 #include <easylogging++.h>
@@ -7,9 +9,10 @@
 // TODO: extra careful with const& -> shared_ptr conversions via make_shared-smart pointer may
 // delete the object - pass empty deleter [](*) {}
 
-void SearchSpace::Discover() {
+void SearchSpace::Discover(std::function<bool()> const& is_stopped) {
     LOG(TRACE) << "Discovering in: " << static_cast<std::string>(*strategy_);
     while (true) {  // на второй итерации дропается
+        if (is_stopped && is_stopped()) break;
         auto now = std::chrono::system_clock::now();
         std::optional<DependencyCandidate> launch_pad = PollLaunchPad();
         if (!launch_pad.has_value()) break;
@@ -27,6 +30,47 @@ void SearchSpace::Discover() {
     }
 }
 
+void SearchSpace::DiscoverConcurrently(unsigned max_active_launch_pads,
+                                       std::function<void(std::function<void()>)> spawn_task,
+                                       std::function<void()> on_exhausted) {
+    assert(recursion_depth_ == 0 && local_visitees_ != nullptr);
+    LOG(TRACE) << "Concurrently discovering in: " << static_cast<std::string>(*strategy_);
+    std::scoped_lock lock(launch_pads_mutex_);
+    max_active_launch_pads_ = std::max(max_active_launch_pads, 1U);
+    spawn_task_ = std::move(spawn_task);
+    on_exhausted_ = std::move(on_exhausted);
+    SpawnLaunchPadTasks();
+}
+
+// Must be called under launch_pads_mutex_
+void SearchSpace::SpawnLaunchPadTasks() {
+    while (num_active_launch_pads_ < max_active_launch_pads_) {
+        std::optional<DependencyCandidate> launch_pad = PollLaunchPad();
+        if (!launch_pad.has_value()) break;
+
+        num_active_launch_pads_++;
+        spawn_task_([this, pad = std::move(*launch_pad)]() { ProcessLaunchPad(pad); });
+    }
+    // Launch pads are returned by the active tasks, so the search space is exhausted only when
+    // there are no launch pads left and none of them is being processed
+    if (num_active_launch_pads_ == 0) {
+        on_exhausted_();
+    }
+}
+
+void SearchSpace::ProcessLaunchPad(DependencyCandidate const& launch_pad) {
+    auto now = std::chrono::system_clock::now();
+    bool is_dependency_found = Ascend(launch_pad);
+    polling_launch_pads_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                    std::chrono::system_clock::now() - now)
+                                    .count();
+
+    std::scoped_lock lock(launch_pads_mutex_);
+    ReturnLaunchPad(launch_pad, !is_dependency_found);
+    num_active_launch_pads_--;
+    SpawnLaunchPadTasks();
+}
+
 std::optional<DependencyCandidate> SearchSpace::PollLaunchPad() {
     while (true) {
         if (launch_pads_.empty()) {
@@ -220,7 +264,7 @@ bool SearchSpace::Ascend(DependencyCandidate const& launch_pad) {
         boost::optional<DependencyCandidate> next_candidate;
         int num_seen_elements = is_ascend_randomly_ ? 1 : -1;
         for (auto& extension_column : context_->GetSchema()->GetColumns()) {
-            if (traversal_candidate.vertical_.GetColumnIndices()[extension_column->GetIndex()] ||
+            if (traversal_candidate.vertical_.Contains(extension_column->GetIndex()) ||
                 strategy_->IsIrrelevantColumn(*extension_column)) {
                 continue;
             }
@@ -379,8 +423,7 @@ void SearchSpace::TrickleDown(Vertical const& main_peak, double main_peak_error)
                                   recursion_depth_ % alleged_min_dep.ToString() % info->error_;
             // TODO: Костыль -- info в нескольких местах должен храниться. ХЗ, кому он принадлежит,
             // пока копирую
-            global_visitees_->Put(alleged_min_dep, std::make_unique<VerticalInfo>(*info));
-            strategy_->RegisterDependency(alleged_min_dep, info->error_, *context_);
+            RegisterMinimalDependency(alleged_min_dep, *info);
         }
         if (!info->is_extremal_) {
             num_uncertain_min_deps++;
@@ -460,8 +503,7 @@ void SearchSpace::TrickleDown(Vertical const& main_peak, double main_peak_error)
                 // TODO: тут надо сделать non-const - костыльный mutable; опять Info в двух местах
                 // хранится
                 info->is_extremal_ = true;
-                global_visitees_->Put(alleged_min_dep, std::make_unique<VerticalInfo>(*info));
-                strategy_->RegisterDependency(alleged_min_dep, info->error_, *context_);
+                RegisterMinimalDependency(alleged_min_dep, *info);
             }
         }
         trickling_down_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
@@ -481,10 +523,10 @@ void SearchSpace::TrickleDown(Vertical const& main_peak, double main_peak_error)
         auto scope_verticals = new_scope->KeySet();
         // TODO: что делать с strategy, globalVisitees?
         auto nested_search_space = std::make_unique<SearchSpace>(
-                -1, strategy_->CreateClone(), std::move(new_scope), std::move(global_visitees_),
+                -1, strategy_->CreateClone(), std::move(new_scope), global_visitees_,
                 context_->GetSchema(), launch_pads_.key_comp(), recursion_depth_ + 1,
                 sample_boost_ * context_->GetParameters().sample_booster);
-        nested_search_space->SetContext(context_);
+        nested_search_space->SetContext(context_, consumer_);
 
         std::unordered_set<Column> scope_columns;
         for (auto& vertical : scope_verticals) {
@@ -506,13 +548,11 @@ void SearchSpace::TrickleDown(Vertical const& main_peak, double main_peak_error)
         trickling_down_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
                                    std::chrono::system_clock::now() - now)
                                    .count();
-        nested_search_space->MoveInLocalVisitees(std::move(local_visitees_));
+        nested_search_space->ShareLocalVisitees(local_visitees_);
         nested_search_space->Discover();
         trickling_down_part_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
                                         std::chrono::system_clock::now() - prev)
                                         .count();
-        global_visitees_ = nested_search_space->MoveOutGlobalVisitees();
-        local_visitees_ = nested_search_space->MoveOutLocalVisitees();
 
         for (auto& [alleged_min_dep, info] : alleged_min_deps->EntrySet()) {
             if (!IsImpliedByMinDep(alleged_min_dep, global_visitees_.get())) {
@@ -523,13 +563,19 @@ void SearchSpace::TrickleDown(Vertical const& main_peak, double main_peak_error)
                 // TODO: тут надо сделать non-const - костыльный mutable; опять Info в двух местах
                 // хранится
                 info->is_extremal_ = true;
-                global_visitees_->Put(alleged_min_dep, std::make_unique<VerticalInfo>(*info));
-                strategy_->RegisterDependency(alleged_min_dep, info->error_, *context_);
+                RegisterMinimalDependency(alleged_min_dep, *info);
             }
         }
     }
 }
 
+// Launch pads of a concurrently discovered search space may reach the same minimal dependency,
+// the one that puts it into global_visitees_ first reports it
+void SearchSpace::RegisterMinimalDependency(Vertical const& min_dep, VerticalInfo const& info) {
+    if (global_visitees_->Put(min_dep, std::make_unique<VerticalInfo>(info)) != nullptr) return;
+    strategy_->RegisterDependency(min_dep, info.error_, *consumer_);
+}
+
 std::optional<Vertical> SearchSpace::TrickleDownFrom(
         DependencyCandidate min_dep_candidate, DependencyStrategy* strategy,
         model::VerticalMap<VerticalInfo>* alleged_min_deps,
@@ -702,6 +748,14 @@ void SearchSpace::PrintStats() const {
     LOG(INFO) << "Returning launch pad: " << returning_launch_pad_ / 1000000;
 }
 
+SearchSpace::VisiteesPtr SearchSpace::CreateVisitees(RelationalSchema const* schema,
+                                                     bool is_concurrent) {
+    if (is_concurrent) {
+        return std::make_shared<model::BlockingVerticalMap<VerticalInfo>>(schema);
+    }
+    return std::make_shared<model::VerticalMap<VerticalInfo>>(schema);
+}
+
 void SearchSpace::EnsureInitialized() {
     strategy_->EnsureInitialized(this);
     std::string initialized_launch_pads;
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <utility>
 
@@ -17,10 +20,14 @@ class SearchSpace : public std::enable_shared_from_this<SearchSpace> {
 private:
     using DependencyCandidateComp =
             std::function<bool(DependencyCandidate const&, DependencyCandidate const&)>;
+    using VisiteesPtr = std::shared_ptr<model::VerticalMap<VerticalInfo>>;
     ProfilingContext* context_;
+    // Receives the discovered dependencies
+    DependencyConsumer const* consumer_;
     std::unique_ptr<DependencyStrategy> strategy_;
-    std::unique_ptr<model::VerticalMap<VerticalInfo>> local_visitees_ = nullptr;
-    std::unique_ptr<model::VerticalMap<VerticalInfo>> global_visitees_;
+    // Nested search spaces share visitees with the search space that created them
+    VisiteesPtr local_visitees_ = nullptr;
+    VisiteesPtr global_visitees_;
     std::set<DependencyCandidate, DependencyCandidateComp> launch_pads_;
     std::unique_ptr<model::VerticalMap<DependencyCandidate>> launch_pad_index_;
     std::list<DependencyCandidate> deferred_launch_pads_;
@@ -29,13 +36,26 @@ private:
     int recursion_depth_;
     bool is_ascend_randomly_ = false;
 
-    int num_nested_ = 0;
+    std::atomic<int> num_nested_ = 0;
+
+    // Launch pad bookkeeping of a search space that is discovered concurrently
+    // (see DiscoverConcurrently): launch_pads_, launch_pad_index_ and deferred_launch_pads_ are
+    // accessed only under launch_pads_mutex_
+    std::mutex launch_pads_mutex_;
+    unsigned num_active_launch_pads_ = 0;
+    unsigned max_active_launch_pads_ = 1;
+    std::function<void(std::function<void()>)> spawn_task_;
+    std::function<void()> on_exhausted_;
+
+    static VisiteesPtr CreateVisitees(RelationalSchema const* schema, bool is_concurrent);
 
     // void Discover(std::unique_ptr<VerticalMap<VerticalInfo>> localVisitees);
     std::optional<DependencyCandidate> PollLaunchPad();
     void EscapeLaunchPad(Vertical const& hitting_set_candidate,
                          std::vector<Vertical> pruning_supersets);
     void ReturnLaunchPad(DependencyCandidate const& launch_pad, bool is_defer);
+    void SpawnLaunchPadTasks();
+    void ProcessLaunchPad(DependencyCandidate const& launch_pad);
 
     bool Ascend(DependencyCandidate const& launch_pad);
     void CheckEstimate(DependencyStrategy* strategy,
@@ -48,19 +68,10 @@ private:
                                             model::VerticalMap<VerticalInfo>* global_visitees,
                                             double boost_factor);
 
-    // CAREFUL: resets globalVisitees_, therefore SearchSpace could become invalidated
-    std::unique_ptr<model::VerticalMap<VerticalInfo>> MoveOutGlobalVisitees() {
-        return std::move(global_visitees_);
-    }
-
-    // CAREFUL: resets localVisitees_, therefore SearchSpace could become invalidated
-    std::unique_ptr<model::VerticalMap<VerticalInfo>> MoveOutLocalVisitees() {
-        return std::move(local_visitees_);
-    }
-
-    void MoveInLocalVisitees(std::unique_ptr<model::VerticalMap<VerticalInfo>> local_visitees) {
+    void ShareLocalVisitees(VisiteesPtr local_visitees) {
         local_visitees_ = std::move(local_visitees);
     }
+    void RegisterMinimalDependency(Vertical const& min_dep, VerticalInfo const& info);
 
     static void RequireMinimalDependency(DependencyStrategy* strategy,
                                          Vertical const& min_dependency);
@@ -74,21 +85,20 @@ private:
     static std::string FormatArityHistogram(model::VerticalMap<int*>) = delete;
 
 public:
-    unsigned long long nanos_smart_constructing_ = 0;
-    unsigned long long polling_launch_pads_ = 0;
-    unsigned long long ascending_ = 0;
-    unsigned long long trickling_down_ = 0;
-    unsigned long long trickling_down_part_ = 0;
-    unsigned long long trickling_down_from_ = 0;
-    unsigned long long returning_launch_pad_ = 0;
+    std::atomic<unsigned long long> nanos_smart_constructing_ = 0;
+    std::atomic<unsigned long long> polling_launch_pads_ = 0;
+    std::atomic<unsigned long long> ascending_ = 0;
+    std::atomic<unsigned long long> trickling_down_ = 0;
+    std::atomic<unsigned long long> trickling_down_part_ = 0;
+    std::atomic<unsigned long long> trickling_down_from_ = 0;
+    std::atomic<unsigned long long> returning_launch_pad_ = 0;
 
     bool is_initialized_ = false;
     int id_;
 
     SearchSpace(int id, std::unique_ptr<DependencyStrategy> strategy,
                 std::unique_ptr<model::VerticalMap<Vertical>> scope,
-                std::unique_ptr<model::VerticalMap<VerticalInfo>> global_visitees,
-                RelationalSchema const* schema,
+                VisiteesPtr global_visitees, RelationalSchema const* schema,
                 DependencyCandidateComp const& dependency_candidate_comparator, int recursion_depth,
                 double sample_boost)
         : strategy_(std::move(strategy)),
@@ -100,19 +110,35 @@ public:
           recursion_depth_(recursion_depth),
           id_(id) {}
 
+    // If is_concurrent is set, the visitees are created thread-safe, so that the search space
+    // can be discovered with DiscoverConcurrently
     SearchSpace(int id, std::unique_ptr<DependencyStrategy> strategy,
                 RelationalSchema const* schema,
-                DependencyCandidateComp const& dependency_candidate_comparator)
-        : SearchSpace(id, std::move(strategy), nullptr,
-                      std::make_unique<model::VerticalMap<VerticalInfo>>(schema), schema,
-                      dependency_candidate_comparator, 0, 1) {}
+                DependencyCandidateComp const& dependency_candidate_comparator,
+                bool is_concurrent = false)
+        : SearchSpace(id, std::move(strategy), nullptr, CreateVisitees(schema, is_concurrent),
+                      schema, dependency_candidate_comparator, 0, 1) {
+        if (is_concurrent) {
+            local_visitees_ = CreateVisitees(schema, is_concurrent);
+        }
+    }
 
     void EnsureInitialized();
-    void Discover();
+    // Stops polling launch pads once is_stopped returns true
+    void Discover(std::function<bool()> const& is_stopped = nullptr);
+    // Concurrent counterpart of Discover(). Every polled launch pad is ascended (and trickled
+    // down from) in a separate task handed to spawn_task, at most max_active_launch_pads at once.
+    // on_exhausted is called exactly once, after the last launch pad has been processed.
+    // Returns immediately, the search space must outlive all of the spawned tasks.
+    void DiscoverConcurrently(unsigned max_active_launch_pads,
+                              std::function<void(std::function<void()>)> spawn_task,
+                              std::function<void()> on_exhausted);
     void AddLaunchPad(DependencyCandidate const& launch_pad);
 
-    void SetContext(ProfilingContext* context) {
+    // The dependencies are reported to the context itself unless another consumer is given
+    void SetContext(ProfilingContext* context, DependencyConsumer const* consumer = nullptr) {
         context_ = context;
+        consumer_ = consumer != nullptr ? consumer : context;
         strategy_->context_ = context;
     }
 
@@ -46,7 +46,6 @@ PLICache::~PLICache() {
 // obtains or calculates a PositionListIndex using cache
 std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::GetOrCreateFor(
         Vertical const& vertical, ProfilingContext* profiling_context) {
-    std::scoped_lock lock(getting_pli_mutex_);
     LOG(DEBUG) << boost::format{"PLI for %1% requested: "} % vertical.ToString();
 
     // is PLI already cached?
@@ -178,25 +177,35 @@ size_t PLICache::Size() const {
 std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::CachingProcess(
         Vertical const& vertical, std::unique_ptr<PositionListIndex> pli,
         ProfilingContext* profiling_context) {
-    auto pli_pointer = pli.get();
     switch (caching_method_) {
         case CachingMethod::kCoin:
             if (profiling_context->NextDouble() <
                 profiling_context->GetParameters().caching_probability) {
-                index_->Put(vertical, std::move(pli));
-                return pli_pointer;
+                return Cache(vertical, std::move(pli));
             } else {
                 return pli;
             }
         case CachingMethod::kNoCaching:
             return pli;
         case CachingMethod::kAllCaching:
-            index_->Put(vertical, std::move(pli));
-            return pli_pointer;
+            return Cache(vertical, std::move(pli));
         default:
             throw std::runtime_error(
                     "Only kNoCaching and kAllCaching strategies are currently available");
     }
 }
 
+// The same vertical may have been cached by another thread meanwhile. That PLI is kept then, as
+// the pointers to it that were handed out must stay valid
+PositionListIndex* PLICache::Cache(Vertical const& vertical,
+                                   std::unique_ptr<PositionListIndex> pli) {
+    std::scoped_lock lock(caching_mutex_);
+    if (PositionListIndex* cached_pli = Get(vertical); cached_pli != nullptr) {
+        return cached_pli;
+    }
+    PositionListIndex* pli_pointer = pli.get();
+    index_->Put(vertical, std::move(pli));
+    return pli_pointer;
+}
+
 }  // namespace model
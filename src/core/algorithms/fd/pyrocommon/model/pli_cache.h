@@ -31,7 +31,8 @@ private:
 
     int saved_intersections_ = 0;
 
-    mutable std::mutex getting_pli_mutex_;
+    // PLIs are looked up and intersected without locking, only caching the results is serialized
+    std::mutex caching_mutex_;
 
     CachingMethod caching_method_;
     CacheEvictionMethod eviction_method_;
@@ -47,6 +48,7 @@ private:
     std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> CachingProcess(
             Vertical const& vertical, std::unique_ptr<PositionListIndex> pli,
             ProfilingContext* profiling_context);
+    PositionListIndex* Cache(Vertical const& vertical, std::unique_ptr<PositionListIndex> pli);
 
 public:
     PLICache(ColumnLayoutRelationData* relation_data, CachingMethod caching_method,
@@ -55,6 +57,7 @@ public:
              double median_inverted_entropy);
 
     PositionListIndex* Get(Vertical const& vertical);
+    // Thread-safe, the returned pointer stays valid as long as the cache does
     std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> GetOrCreateFor(
             Vertical const& vertical, ProfilingContext* profiling_context);
 
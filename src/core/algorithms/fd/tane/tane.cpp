@@ -1,5 +1,6 @@
 #include "tane.h"
 
+#include <algorithm>
 #include <chrono>
 #include <iomanip>
 #include <list>
@@ -8,6 +9,7 @@
 #include <easylogging++.h>
 
 #include "config/error/option.h"
+#include "config/error_thresholds/option.h"
 #include "config/max_lhs/option.h"
 #include "lattice_level.h"
 #include "lattice_vertex.h"
@@ -26,29 +28,34 @@ Tane::Tane(std::optional<ColumnLayoutRelationDataManager> relation_manager)
 
 void Tane::RegisterOptions() {
     RegisterOption(config::kErrorOpt(&max_ucc_error_));
+    RegisterOption(config::kErrorThresholdsOpt(&error_thresholds_));
+    RegisterTimeLimitOption();
 }
 
 void Tane::MakeExecuteOptsAvailableFDInternal() {
-    MakeOptionsAvailable({config::kErrorOpt.GetName()});
+    MakeOptionsAvailable({config::kErrorOpt.GetName(), config::kErrorThresholdsOpt.GetName()});
 }
 
 void Tane::ResetStateFd() {
     count_of_fd_ = 0;
     count_of_ucc_ = 0;
     apriori_millis_ = 0;
+    candidate_errors_.clear();
+    fds_per_threshold_.clear();
 }
 
 double Tane::CalculateZeroAryFdError(ColumnData const* rhs,
                                      ColumnLayoutRelationData const* relation_data) {
-    return 1 - rhs->GetPositionListIndex()->GetNepAsLong() /
-                       static_cast<double>(relation_data->GetNumTuplePairs());
+    return 1 - relation_data->GetNumAgreeingTuplePairs(*rhs->GetPositionListIndex()) /
+                       static_cast<double>(relation_data->GetNumOriginalTuplePairs());
 }
 
 double Tane::CalculateFdError(model::PositionListIndex const* lhs_pli,
                               model::PositionListIndex const* joint_pli,
                               ColumnLayoutRelationData const* relation_data) {
-    return (double)(lhs_pli->GetNepAsLong() - joint_pli->GetNepAsLong()) /
-           static_cast<double>(relation_data->GetNumTuplePairs());
+    return (double)(relation_data->GetNumAgreeingTuplePairs(*lhs_pli) -
+                    relation_data->GetNumAgreeingTuplePairs(*joint_pli)) /
+           static_cast<double>(relation_data->GetNumOriginalTuplePairs());
 }
 
 double Tane::CalculateUccError(model::PositionListIndex const* pli,
@@ -58,11 +65,65 @@ double Tane::CalculateUccError(model::PositionListIndex const* pli,
 
 void Tane::RegisterAndCountFd(Vertical const& lhs, Column const* rhs, [[maybe_unused]] double error,
                               [[maybe_unused]] RelationalSchema const* schema) {
+    if (IsMultiThreshold()) {
+        // registered after the traversal, when the errors of all the candidates are known
+        RecordFdError(lhs, rhs, error);
+        return;
+    }
     dynamic_bitset<> lhs_bitset = lhs.GetColumnIndices();
     PliBasedFDAlgorithm::RegisterFd(lhs, *rhs);
     count_of_fd_++;
 }
 
+void Tane::RecordFdError(Vertical const& lhs, Column const* rhs, config::ErrorType error) {
+    auto [it, inserted] = candidate_errors_[rhs->GetIndex()].try_emplace(lhs, error);
+    if (!inserted) {
+        it->second = std::min(it->second, error);
+    }
+}
+
+bool Tane::IsMinimalFd(Vertical const& lhs, Column const* rhs, config::ErrorType error,
+                       config::ErrorType threshold) const {
+    if (error > threshold) {
+        return false;
+    }
+    /* The error can only decrease when the LHS grows, so it is enough to check the direct
+     * subsets. A subset that has not been checked has been pruned, that is, some FD with a
+     * smaller LHS holds even with the lowest threshold.
+     */
+    std::unordered_map<Vertical, config::ErrorType> const& errors =
+            candidate_errors_[rhs->GetIndex()];
+    for (Column const* column : lhs.GetColumns()) {
+        auto it = errors.find(lhs.Without(*column));
+        if (it == errors.end() || it->second <= threshold) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Tane::RegisterMinimalFds(RelationalSchema const* schema) {
+    for (config::ErrorType threshold : error_thresholds_) {
+        fds_per_threshold_.try_emplace(threshold);
+    }
+    for (auto const& column : schema->GetColumns()) {
+        for (auto const& [lhs, error] : candidate_errors_[column->GetIndex()]) {
+            if (lhs.GetArity() > max_lhs_) {
+                continue;
+            }
+            if (IsMinimalFd(lhs, column.get(), error, max_fd_error_)) {
+                PliBasedFDAlgorithm::RegisterFd(lhs, *column);
+                count_of_fd_++;
+            }
+            for (auto& [threshold, fds] : fds_per_threshold_) {
+                if (IsMinimalFd(lhs, column.get(), error, threshold)) {
+                    fds.emplace_back(lhs, *column);
+                }
+            }
+        }
+    }
+}
+
 void Tane::RegisterUcc([[maybe_unused]] Vertical const& key, [[maybe_unused]] double error,
                        [[maybe_unused]] RelationalSchema const* schema) {
     /*dynamic_bitset<> key_bitset = key.getColumnIndices();
@@ -77,6 +138,14 @@ void Tane::RegisterUcc([[maybe_unused]] Vertical const& key, [[maybe_unused]] do
 unsigned long long Tane::ExecuteInternal() {
     max_fd_error_ = max_ucc_error_;
     RelationalSchema const* schema = relation_->GetSchema();
+    // the lattice is pruned with the lowest threshold, the FDs for the others are selected later
+    config::ErrorType const pruning_fd_error =
+            IsMultiThreshold() ? std::min(max_fd_error_, error_thresholds_.front()) : max_fd_error_;
+    bool const is_exact = pruning_fd_error == 0 && max_ucc_error_ == 0 &&
+                          (!IsMultiThreshold() || error_thresholds_.back() == 0);
+    if (IsMultiThreshold()) {
+        candidate_errors_.assign(schema->GetNumColumns(), {});
+    }
 
     LOG(INFO) << schema->GetName() << " has " << relation_->GetNumColumns() << " columns, "
               << relation_->GetNumRows() << " rows, and a maximum NIP of " << std::setw(2)
@@ -117,7 +186,10 @@ unsigned long long Tane::ExecuteInternal() {
 
         // check FDs: 0->A
         double fd_error = CalculateZeroAryFdError(&column_data, relation_.get());
-        if (fd_error <= max_fd_error_) {  // TODO: max_error
+        if (IsMultiThreshold()) {
+            RecordFdError(*schema->empty_vertical_, column.get(), fd_error);
+        }
+        if (fd_error <= pruning_fd_error) {  // TODO: max_error
             zeroary_fd_rhs.set(column->GetIndex());
             RegisterAndCountFd(*schema->empty_vertical_, column.get(), fd_error, schema);
 
@@ -137,7 +209,7 @@ unsigned long long Tane::ExecuteInternal() {
 
         // вот тут костыль, чтобы вытянуть индекс колонки из вершины, в которой только один индекс
         ColumnData const& column_data =
-                relation_->GetColumnData(column.GetColumnIndices().find_first());
+                relation_->GetColumnData(column.FindFirst());
         double ucc_error = CalculateUccError(column_data.GetPositionListIndex(), relation_.get());
         if (ucc_error <= max_ucc_error_) {
             RegisterUcc(column, ucc_error, schema);
@@ -146,13 +218,13 @@ unsigned long long Tane::ExecuteInternal() {
                 for (unsigned long rhs_index = vertex->GetRhsCandidates().find_first();
                      rhs_index < vertex->GetRhsCandidates().size();
                      rhs_index = vertex->GetRhsCandidates().find_next(rhs_index)) {
-                    if (rhs_index != column.GetColumnIndices().find_first()) {
+                    if (rhs_index != column.FindFirst()) {
                         RegisterAndCountFd(column, schema->GetColumn(rhs_index), 0, schema);
                     }
                 }
                 vertex->GetRhsCandidates() &= column.GetColumnIndices();
                 // set vertex invalid if we seek for exact dependencies
-                if (max_fd_error_ == 0 && max_ucc_error_ == 0) {
+                if (is_exact) {
                     vertex->SetInvalid(true);
                 }
             }
@@ -177,6 +249,8 @@ unsigned long long Tane::ExecuteInternal() {
         if (level->GetVertices().empty()) {
             break;
         }
+        // the remaining levels are skipped
+        if (ShouldStop()) break;
 
         for (auto& [key_map, xa_vertex] : level->GetVertices()) {
             if (xa_vertex->GetIsInvalid()) {
@@ -212,7 +286,10 @@ unsigned long long Tane::ExecuteInternal() {
                 // Check X -> A
                 double error = CalculateFdError(x_vertex->GetPositionListIndex(),
                                                 xa_vertex->GetPositionListIndex(), relation_.get());
-                if (error <= max_fd_error_) {
+                if (IsMultiThreshold()) {
+                    RecordFdError(lhs, schema->GetColumns()[a_index].get(), error);
+                }
+                if (error <= pruning_fd_error) {
                     Column const* rhs = schema->GetColumns()[a_index].get();
 
                     // TODO: register FD to a file or something
@@ -260,7 +337,7 @@ unsigned long long Tane::ExecuteInternal() {
                                             level->GetLatticeVertex(sibling.GetColumnIndices());
                                     if (sibling_vertex == nullptr ||
                                         !sibling_vertex->GetConstRhsCandidates()
-                                                 [rhs.GetColumnIndices().find_first()]) {
+                                                 [rhs.FindFirst()]) {
                                         is_rhs_candidate = false;
                                         break;
                                     }
@@ -280,7 +357,7 @@ unsigned long long Tane::ExecuteInternal() {
                 }
             }
             // if we seek for exact FDs then SetInvalid
-            if (max_fd_error_ == 0 && max_ucc_error_ == 0) {
+            if (is_exact) {
                 for (auto key_vertex : key_vertices) {
                     key_vertex->GetRhsCandidates() &= key_vertex->GetVertical().GetColumnIndices();
                     key_vertex->SetInvalid(true);
@@ -292,6 +369,10 @@ unsigned long long Tane::ExecuteInternal() {
         AddProgress(progress_step);
     }
 
+    if (IsMultiThreshold()) {
+        RegisterMinimalFds(schema);
+    }
+
     SetProgress(100);
     std::chrono::milliseconds elapsed_milliseconds =
             std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() -
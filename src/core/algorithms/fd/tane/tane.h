@@ -1,22 +1,44 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "algorithms/fd/fds_per_threshold.h"
 #include "algorithms/fd/pli_based_fd_algorithm.h"
 #include "config/error/type.h"
+#include "config/error_thresholds/type.h"
 #include "model/table/position_list_index.h"
 #include "model/table/relation_data.h"
+#include "util/custom_hashes.h"
 
 namespace algos {
 
 class Tane : public PliBasedFDAlgorithm {
 private:
+    config::ErrorThresholdsType error_thresholds_;
+    /* Multi-threshold mode: errors of all the checked candidates, per RHS column index. The
+     * lattice is pruned with the lowest threshold, the minimal FDs for every threshold are
+     * selected from these errors after the traversal.
+     */
+    std::vector<std::unordered_map<Vertical, config::ErrorType>> candidate_errors_;
+    FdsPerThreshold fds_per_threshold_;
+
     void RegisterOptions();
     void MakeExecuteOptsAvailableFDInternal() final;
 
     void ResetStateFd() final;
     unsigned long long ExecuteInternal() final;
 
+    bool IsMultiThreshold() const noexcept {
+        return !error_thresholds_.empty();
+    }
+
+    void RecordFdError(Vertical const& lhs, Column const* rhs, config::ErrorType error);
+    bool IsMinimalFd(Vertical const& lhs, Column const* rhs, config::ErrorType error,
+                     config::ErrorType threshold) const;
+    void RegisterMinimalFds(RelationalSchema const* schema);
+
 public:
     config::ErrorType max_fd_error_;
     config::ErrorType max_ucc_error_;
@@ -29,6 +51,7 @@ public:
 
     static double CalculateZeroAryFdError(ColumnData const* rhs,
                                           ColumnLayoutRelationData const* relation_data);
+    // Share of the tuple pairs violating the FD, the pairs of collapsed duplicate rows included
     static double CalculateFdError(model::PositionListIndex const* lhs_pli,
                                    model::PositionListIndex const* joint_pli,
                                    ColumnLayoutRelationData const* relation_data);
@@ -42,6 +65,14 @@ public:
     // void RegisterFd(Vertical const* lhs, Column const* rhs, double error, RelationalSchema const*
     // schema);
     void RegisterUcc(Vertical const& key, double error, RelationalSchema const* schema);
+
+    /* Minimal FDs for every threshold of the error_thresholds option, the main error threshold
+     * included if it is listed there. FdList() holds the ones for the main error threshold.
+     * Empty unless the error_thresholds option is set.
+     */
+    FdsPerThreshold const& GetFdsPerThreshold() const noexcept {
+        return fds_per_threshold_;
+    }
 };
 
 }  // namespace algos
@@ -1,3 +1,5 @@
 #pragma once
 
+#include "algorithms/fd/fd_verifier/afd_error_calculator.h"
+#include "algorithms/fd/fd_verifier/batch_fd_verifier.h"
 #include "algorithms/fd/fd_verifier/fd_verifier.h"
@@ -21,6 +21,7 @@ Faida::Faida() : INDAlgorithm({}) {
     RegisterOption(Option{&ignore_null_cols_, kIgnoreNullCols, kDIgnoreNullCols, false});
     RegisterOption(Option{&ignore_const_cols_, kIgnoreConstantCols, kDIgnoreConstantCols, false});
     RegisterOption(config::kThreadNumberOpt(&number_of_threads_));
+    RegisterTimeLimitOption();
 
     MakeOptionsAvailable({kSampleSize});
 }
@@ -118,7 +119,7 @@ unsigned long long Faida::ExecuteInternal() {
     LOG(DEBUG) << "Found " << last_result.size() << " INDs on level " << level_num;
     RegisterInds(last_result);
 
-    while (!last_result.empty() && ++level_num != max_arity_) {
+    while (!last_result.empty() && ++level_num != max_arity_ && !ShouldStop()) {
         candidates = faida::apriori_candidate_generator::CreateCombinedCandidates(last_result);
         if (candidates.empty()) {
             LOG(DEBUG) << "\nNo candidates on level " << level_num;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string_view>
 #include <vector>
@@ -56,6 +57,11 @@ public:
     std::list<IND> const& INDList() const noexcept {
         return ind_collection_.AsList();
     }
+
+    // Streaming counterpart of INDList(), see FDAlgorithm::SetFdConsumer
+    void SetIndConsumer(std::function<bool(IND const&)> consumer) {
+        SetPrimitiveConsumer(ind_collection_, std::move(consumer));
+    }
 };
 
 }  // namespace algos
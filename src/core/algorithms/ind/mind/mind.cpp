@@ -26,6 +26,7 @@ Mind::Mind() : INDAlgorithm({}) {
 
     RegisterOption(config::kErrorOpt(&max_ind_error_));
     RegisterOption(config::kMaxArityOpt(&max_arity_));
+    RegisterTimeLimitOption();
 }
 
 void Mind::MakeLoadOptsAvailable() {
@@ -232,7 +233,8 @@ void Mind::MineNaryINDs() {
      * Stop INDs mining if no new dependencies were found at the previous lattice level
      * (from this condition it follows that no more dependencies can be found).
      */
-    while (prev_it != INDList().end() && INDList().back().GetArity() != max_arity_) {
+    while (prev_it != INDList().end() && INDList().back().GetArity() != max_arity_ &&
+           !ShouldStop()) {
         for (auto p_it = prev_it; p_it != INDList().end(); ++p_it) {
             std::for_each(std::next(p_it), INDList().end(), [&](const IND& q) {
                 std::optional<RawIND> candidate_opt =
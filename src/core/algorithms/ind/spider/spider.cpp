@@ -9,6 +9,7 @@
 #include <queue>
 #include <string>
 #include <type_traits>
+#include <utility>
 
 #include "attribute.h"
 #include "config/equal_nulls/option.h"
@@ -30,6 +31,7 @@ Spider::Spider() : INDAlgorithm({}) {
     RegisterOption(config::kThreadNumberOpt(&threads_num_));
     RegisterOption(config::kMemLimitMbOpt(&mem_limit_mb_));
     RegisterOption(config::kErrorOpt(&max_ind_error_));
+    RegisterTimeLimitOption();
     MakeLoadOptsAvailable();
 }
 
@@ -62,14 +64,31 @@ std::vector<Attribute> InitAttributes(std::vector<model::ColumnDomain> const& do
 }
 
 template <typename Attribute>
-std::vector<Attribute> GetProcessedAttributes(std::vector<model::ColumnDomain> const& domains,
-                                              config::EqNullsType is_null_equal_null) {
+struct ProcessedAttributes {
+    std::vector<Attribute> attrs;
+    // attributes whose values were not all processed before the stop, their references are not
+    // narrowed down to the valid ones
+    boost::dynamic_bitset<> unfinished;
+};
+
+template <typename Attribute>
+ProcessedAttributes<Attribute> GetProcessedAttributes(
+        std::vector<model::ColumnDomain> const& domains, config::EqNullsType is_null_equal_null,
+        std::function<bool()> const& is_stopped) {
     using AttributeRW = std::reference_wrapper<Attribute>;
     std::vector attrs = InitAttributes<Attribute>(domains);
     std::priority_queue<AttributeRW, std::vector<AttributeRW>, std::greater<Attribute>> attr_pq(
             attrs.begin(), attrs.end());
     boost::dynamic_bitset<> ids_bitset(attrs.size());
+    boost::dynamic_bitset<> unfinished(attrs.size());
     while (!attr_pq.empty()) {
+        // the attributes left in the queue are the ones with unprocessed values
+        if (is_stopped()) {
+            for (; !attr_pq.empty(); attr_pq.pop()) {
+                unfinished.set(attr_pq.top().get().GetId());
+            }
+            break;
+        }
         AttributeRW attr_rw = attr_pq.top();
         std::string const& value = attr_rw.get().GetCurrentValue();
         do {
@@ -97,14 +116,16 @@ std::vector<Attribute> GetProcessedAttributes(std::vector<model::ColumnDomain> c
         }
         ids_bitset.reset();
     }
-    return attrs;
+    return {std::move(attrs), std::move(unfinished)};
 }
 };  // namespace
 
 void Spider::MineINDs() {
     using spider::INDAttribute;
-    std::vector const attrs = GetProcessedAttributes<INDAttribute>(domains_, is_null_equal_null_);
+    auto const [attrs, unfinished] = GetProcessedAttributes<INDAttribute>(
+            domains_, is_null_equal_null_, [this]() { return ShouldStop(); });
     for (auto const& dep : attrs) {
+        if (unfinished.test(dep.GetId())) continue;
         for (AttributeIndex ref_id : dep.GetRefIds()) {
             RegisterIND(dep.ToCC(), attrs[ref_id].ToCC());
         }
@@ -113,8 +134,10 @@ void Spider::MineINDs() {
 
 void Spider::MineAINDs() {
     using spider::AINDAttribute;
-    std::vector const attrs = GetProcessedAttributes<AINDAttribute>(domains_, is_null_equal_null_);
+    auto const [attrs, unfinished] = GetProcessedAttributes<AINDAttribute>(
+            domains_, is_null_equal_null_, [this]() { return ShouldStop(); });
     for (auto const& dep : attrs) {
+        if (unfinished.test(dep.GetId())) continue;
         for (AttributeIndex ref_id : dep.GetRefIds(max_ind_error_)) {
             RegisterIND(dep.ToCC(), attrs[ref_id].ToCC());
         }
@@ -1,8 +1,10 @@
 #include "algorithms/metric/highlight_calculator.h"
 
 #include <algorithm>
+#include <cassert>
 
 #include "util/convex_hull.h"
+#include "util/sorted_page.h"
 
 namespace {
 
@@ -46,6 +48,7 @@ void HighlightCalculator::CalculateOneDimensionalHighlights(
         cluster_highlights.emplace_back(indexed_point.index, furthest_point_index, max_dist);
     }
     highlights_.push_back(std::move(cluster_highlights));
+    highlights_sorted_ = false;
 }
 
 template <typename T>
@@ -76,6 +79,7 @@ void HighlightCalculator::BruteCalculateHighlights(
         }
     }
     highlights_.push_back(std::move(cluster_highlights));
+    highlights_sorted_ = false;
 }
 
 void HighlightCalculator::CalculateHighlightsForStrings(
@@ -92,6 +96,30 @@ void HighlightCalculator::CalculateMultidimensionalHighlights(
             indexed_points, std::move(cluster_highlights), util::EuclideanDistance);
 }
 
+std::vector<std::vector<Highlight>> const& HighlightCalculator::GetHighlights() const {
+    if (!highlights_sorted_) {
+        for (auto& cluster_highlight : highlights_) {
+            std::stable_sort(cluster_highlight.begin(), cluster_highlight.end(), highlights_order_);
+        }
+        highlights_sorted_ = true;
+    }
+    return highlights_;
+}
+
+std::vector<Highlight> HighlightCalculator::GetHighlights(size_t cluster_index, size_t offset,
+                                                          size_t limit) const {
+    assert(cluster_index < highlights_.size());
+    std::vector<Highlight> const& cluster_highlight = highlights_[cluster_index];
+    if (highlights_sorted_) {
+        if (offset >= cluster_highlight.size()) {
+            return {};
+        }
+        auto page_begin = cluster_highlight.begin() + offset;
+        return {page_begin, page_begin + std::min(limit, cluster_highlight.size() - offset)};
+    }
+    return util::GetSortedPage(cluster_highlight, highlights_order_, offset, limit);
+}
+
 void HighlightCalculator::SortHighlightsByDistanceAscending() {
     SortHighlights([this](auto const& h1, auto const& h2) {
         auto const& col = typed_relation_->GetColumnData(rhs_indices_[0]);
@@ -114,7 +142,12 @@ void HighlightCalculator::SortHighlightsByDistanceAscending() {
 }
 
 void HighlightCalculator::SortHighlightsByDistanceDescending() {
-    SortHighlights([this](auto const& h1, auto const& h2) {
+    SortHighlights(CompareHighlightsByDistanceDescending());
+}
+
+auto HighlightCalculator::CompareHighlightsByDistanceDescending() const
+        -> HighlightCompareFunction {
+    return [this](auto const& h1, auto const& h2) {
         if (h1.max_distance == 0 && h2.max_distance == 0) {
             auto const& col = typed_relation_->GetColumnData(rhs_indices_[0]);
             if (col.IsEmpty(h1.data_index)) {
@@ -131,7 +164,7 @@ void HighlightCalculator::SortHighlightsByDistanceDescending() {
             }
         }
         return h1.max_distance > h2.max_distance;
-    });
+    };
 }
 
 void HighlightCalculator::SortHighlightsByFurthestIndexAscending() {
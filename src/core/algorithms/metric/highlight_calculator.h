@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+
 #include "algorithms/metric/highlight.h"
 #include "algorithms/metric/points.h"
 #include "config/indices/type.h"
@@ -9,17 +11,24 @@ namespace algos::metric {
 
 class HighlightCalculator {
 private:
-    std::vector<std::vector<Highlight>> highlights_;
+    using HighlightCompareFunction = std::function<bool(Highlight const& h1, Highlight const& h2)>;
+
+    /* Highlights of the clusters are sorted by distance descending only when all of them are
+     * requested or SortHighlights is called, pages are selected without sorting the rest */
+    mutable std::vector<std::vector<Highlight>> highlights_;
+    mutable bool highlights_sorted_ = true;
+    HighlightCompareFunction highlights_order_;
     std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation_;
     config::IndicesType rhs_indices_;
 
-    template <typename Compare>
-    void SortHighlights(Compare compare) {
-        for (auto& cluster_highlight : highlights_) {
-            std::sort(cluster_highlight.begin(), cluster_highlight.end(), compare);
-        }
+    void SortHighlights(HighlightCompareFunction compare) {
+        highlights_order_ = std::move(compare);
+        highlights_sorted_ = false;
+        GetHighlights();
     }
 
+    HighlightCompareFunction CompareHighlightsByDistanceDescending() const;
+
     template <typename T>
     void BruteCalculateHighlights(std::vector<IndexedPoint<T>> const& indexed_points,
                                   std::vector<Highlight>&& cluster_highlights,
@@ -46,14 +55,22 @@ public:
     void SortHighlightsByIndexAscending();
     void SortHighlightsByIndexDescending();
 
-    std::vector<std::vector<Highlight>> const& GetHighlights() const {
-        return highlights_;
+    std::vector<std::vector<Highlight>> const& GetHighlights() const;
+
+    /* Highlights of the cluster_index-th violating cluster from offset to offset + limit, the same
+     * ones GetHighlights would return at these positions */
+    std::vector<Highlight> GetHighlights(size_t cluster_index, size_t offset, size_t limit) const;
+
+    size_t GetNumClusters() const {
+        return highlights_.size();
     }
 
     explicit HighlightCalculator(
             std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation,
             config::IndicesType rhs_indices)
-        : typed_relation_(std::move(typed_relation)), rhs_indices_(std::move(rhs_indices)){};
+        : highlights_order_(CompareHighlightsByDistanceDescending()),
+          typed_relation_(std::move(typed_relation)),
+          rhs_indices_(std::move(rhs_indices)){};
 };
 
 }  // namespace algos::metric
@@ -16,6 +16,7 @@
 #include "config/names_and_descriptions.h"
 #include "config/option_using.h"
 #include "config/tabular_data/input_table/option.h"
+#include "util/sorted_page.h"
 
 namespace algos::metric {
 
@@ -156,8 +157,6 @@ unsigned long long MetricVerifier::ExecuteInternal() {
         LOG(DEBUG) << "Metric fd does not hold.";
     }
 
-    SortHighlightsByDistanceDescending();
-
     VisualizeHighlights();
 
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -191,10 +190,10 @@ std::string MetricVerifier::GetStringValue(config::IndicesType const& index_vec,
 }
 
 void MetricVerifier::VisualizeHighlights() const {
-    if (highlight_calculator_->GetHighlights().empty()) {
-        return;
-    }
-    for (auto const& cluster_highlight : highlight_calculator_->GetHighlights()) {
+    for (size_t i = 0; i < highlight_calculator_->GetNumClusters(); ++i) {
+        // only the first page of every cluster is logged, the other values are not retrieved
+        std::vector<Highlight> const cluster_highlight =
+                highlight_calculator_->GetHighlights(i, 0, util::kNumVisualizedHighlights);
         LOG(DEBUG) << "----------------------------------------- LHS value: "
                    << GetStringValue(lhs_indices_, cluster_highlight[0].data_index);
         for (auto const& highlight : cluster_highlight) {
@@ -109,6 +109,17 @@ public:
         return highlight_calculator_->GetHighlights();
     }
 
+    /* Number of the clusters violating the metric FD, which have highlights */
+    size_t GetNumHighlightedClusters() const {
+        return highlight_calculator_->GetNumClusters();
+    }
+
+    /* Highlights of the cluster_index-th violating cluster from offset to offset + limit, only they
+     * are sorted */
+    std::vector<Highlight> GetHighlights(size_t cluster_index, size_t offset, size_t limit) const {
+        return highlight_calculator_->GetHighlights(cluster_index, offset, limit);
+    }
+
     void SetParameter(long double parameter) {
         parameter_ = parameter;
     }
@@ -6,7 +6,6 @@
 #include <easylogging++.h>
 
 #include "config/tabular_data/input_table/option.h"
-#include "config/time_limit/option.h"
 #include "util/timed_invoke.h"
 
 namespace algos {
@@ -15,10 +14,6 @@ Fastod::Fastod() : Algorithm({}) {
     PrepareOptions();
 }
 
-bool Fastod::IsTimeUp() const {
-    return time_limit_seconds_ > 0 && timer_.GetElapsedSeconds() >= time_limit_seconds_;
-}
-
 void Fastod::CCPut(AttributeSet const& key, AttributeSet attribute_set) {
     cc_[key] = std::move(attribute_set);
 }
@@ -34,23 +29,18 @@ void Fastod::PrepareOptions() {
 
 void Fastod::RegisterOptions() {
     RegisterOption(config::kTableOpt(&input_table_));
-    RegisterOption(config::kTimeLimitSecondsOpt(&time_limit_seconds_));
+    RegisterTimeLimitOption();
 }
 
 void Fastod::MakeLoadOptionsAvailable() {
     MakeOptionsAvailable({config::kTableOpt.GetName()});
 }
 
-void Fastod::MakeExecuteOptsAvailable() {
-    MakeOptionsAvailable({config::kTimeLimitSecondsOpt.GetName()});
-}
-
 void Fastod::LoadDataInternal() {
     data_ = std::make_shared<DataFrame>(DataFrame::FromInputTable(input_table_));
 }
 
 void Fastod::ResetState() {
-    is_complete_ = false;
     level_ = 1;
 
     result_asc_.clear();
@@ -95,7 +85,7 @@ void Fastod::PrintStatistics() const {
 }
 
 bool Fastod::IsComplete() const {
-    return is_complete_;
+    return !IsResultIncomplete();
 }
 
 std::vector<fastod::AscCanonicalOD> const& Fastod::GetAscendingDependencies() const {
@@ -135,8 +125,7 @@ void Fastod::ComputeODs() {
             del_attrs.push_back(fastod::DeleteAttribute(context, column));
         }
 
-        if (IsTimeUp()) {
-            is_complete_ = false;
+        if (ShouldStop()) {
             return;
         }
 
@@ -157,8 +146,7 @@ void Fastod::ComputeODs() {
     for (AttributeSet const& context : context_in_current_level_) {
         auto const& del_attrs = deleted_attrs[delete_index++];
 
-        if (IsTimeUp()) {
-            is_complete_ = false;
+        if (ShouldStop()) {
             return;
         }
 
@@ -213,8 +201,7 @@ void Fastod::CalculateNextLevel() {
     }
 
     for (auto const& [prefix, single_attributes] : prefix_blocks) {
-        if (IsTimeUp()) {
-            is_complete_ = false;
+        if (ShouldStop()) {
             return;
         }
 
@@ -253,14 +240,15 @@ void Fastod::Discover() {
     while (!context_in_current_level_.empty()) {
         ComputeODs();
 
-        if (IsTimeUp()) {
+        if (ShouldStop()) {
             break;
         }
 
         PruneLevels();
         CalculateNextLevel();
 
-        if (IsTimeUp()) {
+        // a level computed before the stop is the last one if it is empty
+        if (!context_in_current_level_.empty() && ShouldStop()) {
             break;
         }
 
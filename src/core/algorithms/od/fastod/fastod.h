@@ -13,7 +13,6 @@
 #include "algorithms/od/fastod/storage/partition_cache.h"
 #include "algorithms/od/fastod/util/timer.h"
 #include "config/tabular_data/input_table_type.h"
-#include "config/time_limit/type.h"
 
 namespace algos {
 
@@ -28,8 +27,6 @@ private:
     using DataFrame = fastod::DataFrame;
     using Timer = fastod::Timer;
 
-    config::TimeLimitSecondsType time_limit_seconds_ = 0u;
-    bool is_complete_ = true;
     size_t level_ = 1;
 
     std::vector<AscCanonicalOD> result_asc_;
@@ -48,7 +45,6 @@ private:
     std::shared_ptr<DataFrame> data_;
     config::InputTable input_table_;
 
-    void MakeExecuteOptsAvailable() override;
     void LoadDataInternal() override;
     void ResetState() override;
     unsigned long long ExecuteInternal() final;
@@ -57,8 +53,6 @@ private:
     void RegisterOptions();
     void MakeLoadOptionsAvailable();
 
-    bool IsTimeUp() const;
-
     void Initialize();
     void ComputeODs();
     void PruneLevels();
@@ -28,6 +28,7 @@ void Order::RegisterOptions() {
     using config::Option;
 
     RegisterOption(config::kTableOpt(&input_table_));
+    RegisterTimeLimitOption();
 }
 
 void Order::LoadDataInternal() {
@@ -361,7 +362,7 @@ unsigned long long Order::ExecuteInternal() {
     auto start_time = std::chrono::system_clock::now();
     CreateSingleColumnSortedPartitions();
     lattice_ = std::make_unique<ListLattice>(candidate_sets_, single_attributes_);
-    while (!lattice_->IsEmpty()) {
+    while (!lattice_->IsEmpty() && !ShouldStop()) {
         ComputeDependencies(lattice_->GetLatticeLevel());
         lattice_->Prune(candidate_sets_);
         lattice_->GenerateNextLevel(candidate_sets_);
@@ -0,0 +1,268 @@
+#include "algorithms/ucc/dynucc/dynucc.h"
+
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+
+#include "config/names_and_descriptions.h"
+#include "config/option_using.h"
+#include "config/tabular_data/crud_operations/operations.h"
+#include "config/thread_number/option.h"
+#include "util/parallel_for.h"
+
+namespace algos::dynucc {
+
+DynUCC::DynUCC() : UCCAlgorithm({}) {
+    RegisterOptions();
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+}
+
+void DynUCC::RegisterOptions() {
+    DESBORDANTE_OPTION_USING;
+
+    auto check_inserts = [this](config::InputTable const& insert_batch) {
+        table_data_->CheckInsertBatch(insert_batch);
+    };
+    auto check_deletes = [this](std::unordered_set<size_t> const& delete_batch) {
+        table_data_->CheckDeleteBatch(delete_batch);
+    };
+    auto check_updates = [this](config::InputTable const& update_batch) {
+        table_data_->CheckUpdateBatch(update_batch);
+    };
+
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    RegisterOption(
+            config::kInsertStatementsOpt(&insert_statements_table_).SetValueCheck(check_inserts));
+    RegisterOption(
+            config::kDeleteStatementsOpt(&delete_statement_indices_).SetValueCheck(check_deletes));
+    RegisterOption(
+            config::kUpdateStatementsOpt(&update_statements_table_).SetValueCheck(check_updates));
+}
+
+void DynUCC::MakeExecuteOptsAvailable() {
+    MakeOptionsAvailable(kCrudOptions);
+}
+
+void DynUCC::LoadDataInternal() {
+    size_t const num_columns = input_table_->GetNumberOfColumns();
+    if (num_columns == 0) {
+        throw std::runtime_error("Got an empty dataset: UCC mining is meaningless.");
+    }
+    schema_ = std::make_unique<RelationalSchema>(input_table_->GetRelationName());
+    for (size_t i = 0; i < num_columns; ++i) {
+        schema_->AppendColumn(input_table_->GetColumnName(i));
+    }
+    schema_->Init();
+
+    table_data_ = std::make_unique<model::DynamicTableData>(*input_table_);
+    input_table_->Reset();
+
+    column_plis_.clear();
+    for (size_t column = 0; column < num_columns; ++column) {
+        std::vector<model::DynPLI::ClusterValue> column_values;
+        column_values.reserve(table_data_->GetNumRowsTotal());
+        for (size_t row = 0; row < table_data_->GetNumRowsTotal(); ++row) {
+            column_values.push_back({table_data_->GetValueId(row, column)});
+        }
+        column_plis_.push_back(model::DynPLI::CreateFor(column_values));
+    }
+
+    // a single column is a minimal UCC candidate, the non-UCCs specialize the cover from there
+    positive_cover_ = std::make_unique<hyucc::UCCTree>(num_columns);
+    inductor_ = std::make_unique<hyucc::Inductor>(positive_cover_.get());
+    negative_cover_ = std::make_unique<dyn::NegativeCover>(schema_.get());
+    ucc_indices_.clear();
+    SampleNonUCCs();
+    ValidatePositiveCover();
+}
+
+unsigned long long DynUCC::ExecuteInternal() {
+    auto start_time = std::chrono::system_clock::now();
+
+    // the indices find the rows by their values, so the rows leave them before they change
+    std::unordered_set<size_t> removed_rows{delete_statement_indices_};
+    for (size_t row : table_data_->GetUpdatedRowIndices(update_statements_table_)) {
+        removed_rows.insert(row);
+    }
+    EraseRowsFromIndices(removed_rows);
+
+    size_t const first_inserted_row = table_data_->GetNumRowsTotal();
+    std::vector<size_t> changed_rows = table_data_->Update(
+            insert_statements_table_, update_statements_table_, delete_statement_indices_);
+    if (insert_statements_table_ != nullptr) insert_statements_table_->Reset();
+    if (update_statements_table_ != nullptr) update_statements_table_->Reset();
+    for (size_t row = first_inserted_row; row < table_data_->GetNumRowsTotal(); ++row) {
+        changed_rows.push_back(row);
+    }
+    UpdatePLIs(removed_rows, changed_rows);
+
+    auto const find_duplicate = [this](Vertical const& column_combination) {
+        // the empty set is never a UCC candidate, it is not kept as a non-UCC either
+        if (column_combination.GetArity() == 0) return std::optional<RowPair>{};
+        return FindDuplicate(column_combination);
+    };
+    // the non-UCCs are revalidated on the whole changed table, so the UCCs induced from them
+    // that are not indexed yet are validated on it as well
+    if (negative_cover_->RemoveRows(removed_rows, find_duplicate)) {
+        InducePositiveCover();
+    }
+    CheckChangedRows(changed_rows);
+    RegisterUCCs();
+
+    auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now() - start_time);
+    return elapsed_milliseconds.count();
+}
+
+void DynUCC::UpdatePLIs(std::unordered_set<size_t> const& removed_rows,
+                        std::vector<size_t> const& changed_rows) {
+    // every changed row goes into the PLIs under its id in table_data_, the updated ones too
+    for (size_t column = 0; column < schema_->GetNumColumns(); ++column) {
+        std::vector<std::pair<std::optional<size_t>, model::DynPLI::ClusterValue>> inserts;
+        inserts.reserve(changed_rows.size());
+        for (size_t row : changed_rows) {
+            inserts.emplace_back(row, model::DynPLI::ClusterValue{
+                                              table_data_->GetValueId(row, column)});
+        }
+        column_plis_[column]->UpdateWith(inserts, removed_rows);
+    }
+}
+
+bool DynUCC::AreEqual(size_t first_row, size_t second_row, size_t column) const {
+    return table_data_->GetValueId(first_row, column) ==
+                   table_data_->GetValueId(second_row, column) &&
+           (is_null_equal_null_ || !table_data_->IsNull(first_row, column));
+}
+
+boost::dynamic_bitset<> DynUCC::GetAgreeSet(RowPair const& rows) const {
+    boost::dynamic_bitset<> agree_set(schema_->GetNumColumns());
+    for (size_t column = 0; column < agree_set.size(); ++column) {
+        agree_set[column] = AreEqual(rows.first, rows.second, column);
+    }
+    return agree_set;
+}
+
+std::optional<DynUCC::RowPair> DynUCC::FindDuplicate(Vertical const& column_combination) const {
+    return dyn::FindAgreeingRows(column_combination.GetColumnIndices(), *table_data_,
+                                 column_plis_, is_null_equal_null_);
+}
+
+void DynUCC::AddNonUCCOf(RowPair const& rows) {
+    boost::dynamic_bitset<> const agree_set = GetAgreeSet(rows);
+    // the empty set is never a UCC candidate, like in HyUCC
+    if (agree_set.none()) return;
+    // a non-UCC covered by a known one has no UCC candidates left below it to specialize
+    if (negative_cover_->Add(schema_->GetVertical(agree_set), rows)) {
+        inductor_->SpecializeUCCTree(agree_set);
+    }
+}
+
+void DynUCC::SampleNonUCCs() {
+    // a sampled non-UCC spares the index of every candidate below it that would have failed
+    dyn::ForEachNeighbourPair(column_plis_, [this](RowPair const& rows) { AddNonUCCOf(rows); });
+}
+
+void DynUCC::PruneIndices() {
+    std::unordered_set<Vertical> uccs;
+    for (boost::dynamic_bitset<> const& ucc : positive_cover_->FillUCCs()) {
+        uccs.insert(schema_->GetVertical(ucc));
+    }
+    std::erase_if(ucc_indices_, [&uccs](auto const& entry) { return !uccs.contains(entry.first); });
+}
+
+void DynUCC::ValidatePositiveCover() {
+    // a specialization of an invalid UCC is larger than it, so the smallest candidates are
+    // validated first, their non-UCCs may remove larger candidates before they cost an index
+    while (true) {
+        PruneIndices();
+        std::vector<boost::dynamic_bitset<>> candidates;
+        for (boost::dynamic_bitset<>& ucc : positive_cover_->FillUCCs()) {
+            if (ucc_indices_.contains(schema_->GetVertical(ucc))) continue;
+            if (!candidates.empty() && ucc.count() > candidates.front().count()) continue;
+            if (!candidates.empty() && ucc.count() < candidates.front().count()) {
+                candidates.clear();
+            }
+            candidates.push_back(std::move(ucc));
+        }
+        if (candidates.empty()) return;
+
+        std::vector<std::unique_ptr<UCCIndex>> indices(candidates.size());
+        std::vector<std::optional<RowPair>> duplicates(candidates.size());
+        std::vector<size_t> candidate_indices(candidates.size());
+        std::iota(candidate_indices.begin(), candidate_indices.end(), 0);
+        util::ParallelForeach(candidate_indices.begin(), candidate_indices.end(), threads_num_,
+                              [&](size_t i) {
+                                  indices[i] = std::make_unique<UCCIndex>(
+                                          *table_data_, candidates[i], is_null_equal_null_);
+                                  duplicates[i] = indices[i]->InsertTable();
+                              });
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            if (duplicates[i].has_value()) {
+                AddNonUCCOf(*duplicates[i]);
+            } else {
+                ucc_indices_.emplace(schema_->GetVertical(candidates[i]), std::move(indices[i]));
+            }
+        }
+    }
+}
+
+void DynUCC::CheckChangedRows(std::vector<size_t> const& changed_rows) {
+    // the indexed UCCs hold on the other rows, a duplicate involves a changed row
+    std::vector<UCCIndex*> indices;
+    indices.reserve(ucc_indices_.size());
+    for (auto const& [ucc, index] : ucc_indices_) {
+        indices.push_back(index.get());
+    }
+    std::vector<std::optional<RowPair>> duplicates(indices.size());
+    std::vector<size_t> ucc_numbers(indices.size());
+    std::iota(ucc_numbers.begin(), ucc_numbers.end(), 0);
+    util::ParallelForeach(ucc_numbers.begin(), ucc_numbers.end(), threads_num_, [&](size_t i) {
+        for (size_t row : changed_rows) {
+            if (std::optional<size_t> other_row = indices[i]->Insert(row)) {
+                duplicates[i] = RowPair(*other_row, row);
+                return;
+            }
+        }
+    });
+    // the UCCs of the duplicates leave the positive cover, their indices are dropped
+    for (std::optional<RowPair> const& duplicate : duplicates) {
+        if (duplicate.has_value()) AddNonUCCOf(*duplicate);
+    }
+    ValidatePositiveCover();
+}
+
+void DynUCC::EraseRowsFromIndices(std::unordered_set<size_t> const& removed_rows) {
+    if (removed_rows.empty()) return;
+
+    std::vector<UCCIndex*> indices;
+    indices.reserve(ucc_indices_.size());
+    for (auto const& [ucc, index] : ucc_indices_) {
+        indices.push_back(index.get());
+    }
+    util::ParallelForeach(indices.begin(), indices.end(), threads_num_, [&](UCCIndex* index) {
+        for (size_t row : removed_rows) {
+            index->Erase(row);
+        }
+    });
+}
+
+void DynUCC::InducePositiveCover() {
+    positive_cover_ = std::make_unique<hyucc::UCCTree>(schema_->GetNumColumns());
+    inductor_ = std::make_unique<hyucc::Inductor>(positive_cover_.get());
+
+    // as in HyUCC, the larger non-UCCs go first and prune the candidates the smaller ones would
+    // split otherwise
+    for (boost::dynamic_bitset<> const& non_ucc : negative_cover_->GetColumnIndicesLargestFirst()) {
+        inductor_->SpecializeUCCTree(non_ucc);
+    }
+    // the UCCs that were in the cover keep their indices, the new ones are validated later
+    PruneIndices();
+}
+
+void DynUCC::RegisterUCCs() {
+    for (boost::dynamic_bitset<>& ucc : positive_cover_->FillUCCs()) {
+        ucc_collection_.Register(schema_.get(), std::move(ucc));
+    }
+}
+
+}  // namespace algos::dynucc
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "algorithms/dynamic/common/negative_cover.h"
+#include "algorithms/dynamic/common/row_pairs.h"
+#include "algorithms/ucc/dynucc/ucc_index.h"
+#include "algorithms/ucc/hyucc/inductor.h"
+#include "algorithms/ucc/hyucc/model/ucc_tree.h"
+#include "algorithms/ucc/ucc_algorithm.h"
+#include "config/tabular_data/input_table_type.h"
+#include "config/thread_number/type.h"
+#include "model/table/dynamic_position_list_index.h"
+#include "model/table/dynamic_table_data.h"
+#include "model/table/relational_schema.h"
+#include "util/custom_hashes.h"
+
+namespace algos::dynucc {
+
+/* Incremental UCC discovery: keeps the minimal UCCs of a table current while the table is changed
+ * by batches of inserts, updates and deletes, passed through the CRUD options of every Execute()
+ * call, like DynFD takes them.
+ *
+ * Along with the positive cover (a UCC prefix tree, as in HyUCC) the algorithm keeps the negative
+ * cover: the maximal non-UCCs, each with a pair of rows duplicating it.
+ * - Inserted rows can only invalidate UCCs by duplicating a row. Every UCC of the cover has a hash
+ *   index of its rows, so an inserted row is checked by one lookup per UCC. The agree set of a
+ *   duplicate pair is a new non-UCC that specializes the cover, the specializations are validated
+ *   level by level and get their indices on the way.
+ * - Deleted rows can only turn non-UCCs into UCCs. Only the non-UCCs whose duplicate pair lost a
+ *   row are revalidated, the ones that are unique now are replaced by their maximal non-UCC
+ *   subsets and the positive cover is induced again from the negative cover.
+ * An update is a delete of the old row and an insert of the new one under the same row index.
+ *
+ * The approach follows Swan: Ziawasch Abedjan, Jorge-Arnulfo Quiané-Ruiz, and Felix Naumann. 2014.
+ * Detecting unique column combinations on dynamic data. In Proceedings of the 30th IEEE
+ * International Conference on Data Engineering (ICDE 2014).
+ */
+class DynUCC : public UCCAlgorithm {
+private:
+    using RowPair = dyn::RowPair;
+
+    config::InputTable insert_statements_table_ = nullptr;
+    config::InputTable update_statements_table_ = nullptr;
+    std::unordered_set<size_t> delete_statement_indices_;
+    config::ThreadNumType threads_num_;
+
+    std::unique_ptr<RelationalSchema> schema_;
+    std::unique_ptr<model::DynamicTableData> table_data_;
+    dyn::ColumnPLIs column_plis_;
+
+    std::unique_ptr<hyucc::UCCTree> positive_cover_;
+    std::unique_ptr<hyucc::Inductor> inductor_;
+    // every UCC of the positive cover that holds on the current table has an index of its rows
+    std::unordered_map<Vertical, std::unique_ptr<UCCIndex>> ucc_indices_;
+    // maximal non-UCCs with a pair of rows duplicating them
+    std::unique_ptr<dyn::NegativeCover> negative_cover_;
+
+    void RegisterOptions();
+    void MakeExecuteOptsAvailable() final;
+    void LoadDataInternal() final;
+    unsigned long long ExecuteInternal() final;
+
+    void ResetUCCAlgorithmState() final {}
+
+    void UpdatePLIs(std::unordered_set<size_t> const& removed_rows,
+                    std::vector<size_t> const& changed_rows);
+
+    bool AreEqual(size_t first_row, size_t second_row, size_t column) const;
+    boost::dynamic_bitset<> GetAgreeSet(RowPair const& rows) const;
+    std::optional<RowPair> FindDuplicate(Vertical const& column_combination) const;
+
+    void AddNonUCCOf(RowPair const& rows);
+    void SampleNonUCCs();
+    void PruneIndices();
+    void ValidatePositiveCover();
+    void CheckChangedRows(std::vector<size_t> const& changed_rows);
+    void EraseRowsFromIndices(std::unordered_set<size_t> const& removed_rows);
+    void InducePositiveCover();
+    void RegisterUCCs();
+
+public:
+    DynUCC();
+};
+
+}  // namespace algos::dynucc
@@ -0,0 +1,73 @@
+#include "algorithms/ucc/dynucc/ucc_index.h"
+
+#include <cstdint>
+
+namespace algos::dynucc {
+
+std::size_t UCCIndex::ProjectionHash::operator()(std::size_t row) const noexcept {
+    // the mixing step of model::ClusterValueHash, without building the projection
+    std::uint64_t hash = 0x9E3779B97F4A7C15ULL ^ index->columns_.size();
+    for (std::size_t column : index->columns_) {
+        hash ^= static_cast<std::uint32_t>(index->table_data_->GetValueId(row, column));
+        hash *= 0xBF58476D1CE4E5B9ULL;
+        hash ^= hash >> 31;
+    }
+    return static_cast<std::size_t>(hash);
+}
+
+bool UCCIndex::ProjectionEqual::operator()(std::size_t first_row,
+                                           std::size_t second_row) const noexcept {
+    model::DynamicTableData const& table_data = *index->table_data_;
+    for (std::size_t column : index->columns_) {
+        if (table_data.GetValueId(first_row, column) != table_data.GetValueId(second_row, column)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+UCCIndex::UCCIndex(model::DynamicTableData const& table_data, boost::dynamic_bitset<> const& ucc,
+                   bool is_null_equal_null)
+    : table_data_(&table_data),
+      is_null_equal_null_(is_null_equal_null),
+      rows_(0, ProjectionHash{this}, ProjectionEqual{this}) {
+    for (std::size_t column = ucc.find_first(); column != boost::dynamic_bitset<>::npos;
+         column = ucc.find_next(column)) {
+        columns_.push_back(column);
+    }
+}
+
+bool UCCIndex::IsIndexed(std::size_t row) const {
+    if (is_null_equal_null_) return true;
+    for (std::size_t column : columns_) {
+        if (table_data_->IsNull(row, column)) return false;
+    }
+    return true;
+}
+
+std::optional<std::size_t> UCCIndex::Insert(std::size_t row) {
+    if (!IsIndexed(row)) return std::nullopt;
+    auto [it, is_new] = rows_.insert(row);
+    if (is_new) return std::nullopt;
+    return *it;
+}
+
+void UCCIndex::Erase(std::size_t row) {
+    if (!IsIndexed(row)) return;
+    // the projection is unique, the row found by it is this one
+    auto it = rows_.find(row);
+    if (it != rows_.end() && *it == row) rows_.erase(it);
+}
+
+std::optional<std::pair<std::size_t, std::size_t>> UCCIndex::InsertTable() {
+    rows_.reserve(table_data_->GetNumRowsActual());
+    for (std::size_t row = 0; row < table_data_->GetNumRowsTotal(); ++row) {
+        if (!table_data_->IsRowIndexValid(row)) continue;
+        if (std::optional<std::size_t> other_row = Insert(row)) {
+            return std::make_pair(*other_row, row);
+        }
+    }
+    return std::nullopt;
+}
+
+}  // namespace algos::dynucc
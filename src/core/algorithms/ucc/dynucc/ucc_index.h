@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "model/table/dynamic_table_data.h"
+
+namespace algos::dynucc {
+
+/* Hash index of the rows of a unique column combination. Rows are stored by their ids and hashed
+ * and compared by their projections onto the combination, so the index keeps no copies of the
+ * values, and the row a new one duplicates is found in expected constant time. Rows with a null in
+ * the combination are not indexed unless nulls are equal, they duplicate no row. */
+class UCCIndex {
+private:
+    struct ProjectionHash {
+        UCCIndex const* index;
+
+        std::size_t operator()(std::size_t row) const noexcept;
+    };
+
+    struct ProjectionEqual {
+        UCCIndex const* index;
+
+        bool operator()(std::size_t first_row, std::size_t second_row) const noexcept;
+    };
+
+    model::DynamicTableData const* table_data_;
+    std::vector<std::size_t> columns_;
+    bool is_null_equal_null_;
+    std::unordered_set<std::size_t, ProjectionHash, ProjectionEqual> rows_;
+
+    bool IsIndexed(std::size_t row) const;
+
+public:
+    UCCIndex(model::DynamicTableData const& table_data, boost::dynamic_bitset<> const& ucc,
+             bool is_null_equal_null);
+
+    // the hasher refers to the index, so it stays in place
+    UCCIndex(UCCIndex const&) = delete;
+    UCCIndex& operator=(UCCIndex const&) = delete;
+
+    /* Adds the row unless an indexed row has the same projection, returns that row then */
+    std::optional<std::size_t> Insert(std::size_t row);
+
+    /* Must be called before the values of the row change */
+    void Erase(std::size_t row);
+
+    /* Indexes every row of the table, stops at the first duplicate and returns the pair */
+    std::optional<std::pair<std::size_t, std::size_t>> InsertTable();
+};
+
+}  // namespace algos::dynucc
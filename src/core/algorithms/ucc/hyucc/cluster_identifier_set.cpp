@@ -0,0 +1,72 @@
+#include "cluster_identifier_set.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <utility>
+
+#include "fd/hycommon/util/pli_util.h"
+
+namespace algos::hyucc {
+
+ClusterIdentifierSet::ClusterIdentifierSet(std::vector<hy::ClusterId> attributes)
+    : attributes_(std::move(attributes)) {}
+
+std::size_t ClusterIdentifierSet::Hash(hy::ClusterId const* identifier) const noexcept {
+    std::size_t hash = 0;
+    for (std::size_t i = 0; i < attributes_.size(); ++i) {
+        hash = (hash ^ identifier[i]) * 0x9e3779b97f4a7c15ULL;
+    }
+    return hash ^ (hash >> 32);
+}
+
+bool ClusterIdentifierSet::AreEqual(hy::ClusterId const* first,
+                                    hy::ClusterId const* second) const noexcept {
+    return std::equal(first, first + attributes_.size(), second);
+}
+
+void ClusterIdentifierSet::Reset(std::size_t cluster_size) {
+    // the load factor stays below one half
+    std::size_t const capacity = std::bit_ceil(2 * std::max<std::size_t>(cluster_size, 1));
+    if (slots_.size() < capacity) {
+        slots_.assign(capacity, 0);
+    } else {
+        std::fill(slots_.begin(), slots_.begin() + capacity, 0);
+    }
+    mask_ = capacity - 1;
+    identifiers_.clear();
+    identifiers_.reserve(cluster_size * attributes_.size());
+    records_.clear();
+    records_.reserve(cluster_size);
+}
+
+std::optional<hy::TablePos> ClusterIdentifierSet::Insert(hy::Row const& compressed_record,
+                                                         hy::TablePos record) {
+    std::size_t const offset = identifiers_.size();
+    for (hy::ClusterId attr : attributes_) {
+        hy::ClusterId const cluster_id = compressed_record[attr];
+        if (hy::PLIUtil::IsSingletonCluster(cluster_id)) {
+            identifiers_.resize(offset);
+            return std::nullopt;
+        }
+        identifiers_.push_back(cluster_id);
+    }
+
+    hy::ClusterId const* identifier = identifiers_.data() + offset;
+    for (std::size_t slot = Hash(identifier) & mask_;; slot = (slot + 1) & mask_) {
+        Slot const occupant = slots_[slot];
+        if (occupant == 0) {
+            assert(records_.size() <= mask_ / 2);
+            records_.push_back(record);
+            slots_[slot] = static_cast<Slot>(records_.size());
+            return std::nullopt;
+        }
+        std::size_t const occupant_index = occupant - 1;
+        if (AreEqual(identifiers_.data() + occupant_index * attributes_.size(), identifier)) {
+            identifiers_.resize(offset);
+            return records_[occupant_index];
+        }
+    }
+}
+
+}  // namespace algos::hyucc
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "fd/hycommon/types.h"
+
+namespace algos::hyucc {
+
+/* Set of the cluster identifiers of one pivot cluster's records, used to look for two records
+ * that agree on all of the attributes. All identifiers have the same width, so they are packed one
+ * after another into a flat buffer instead of being allocated as separate vectors, and are hashed
+ * into an open-addressing table with linear probing. Reset() clears only as many slots as the next
+ * cluster needs, so one set serves every cluster of a candidate without allocations.
+ */
+class ClusterIdentifierSet {
+private:
+    // slot value is the index of the identifier in the buffer plus one, zero marks a free slot
+    using Slot = std::uint32_t;
+
+    std::vector<hy::ClusterId> attributes_;
+    std::vector<hy::ClusterId> identifiers_;
+    std::vector<hy::TablePos> records_;
+    std::vector<Slot> slots_;
+    std::size_t mask_ = 0;
+
+    std::size_t Hash(hy::ClusterId const* identifier) const noexcept;
+    bool AreEqual(hy::ClusterId const* first, hy::ClusterId const* second) const noexcept;
+
+public:
+    explicit ClusterIdentifierSet(std::vector<hy::ClusterId> attributes);
+
+    /* Prepares the set for the records of a cluster of the given size */
+    void Reset(std::size_t cluster_size);
+
+    /* Adds the identifier of the record, returns the record added before with the same identifier
+     * if there is one. A record that is in a singleton cluster of some attribute agrees with no
+     * other record and is not added.
+     */
+    std::optional<hy::TablePos> Insert(hy::Row const& compressed_record, hy::TablePos record);
+};
+
+}  // namespace algos::hyucc
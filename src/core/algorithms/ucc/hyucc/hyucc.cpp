@@ -1,9 +1,13 @@
 #include "hyucc.h"
 
 #include <chrono>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
 
 #include <easylogging++.h>
 
+#include "fd/hycommon/memory_guardian.h"
 #include "fd/hycommon/types.h"
 #include "inductor.h"
 #include "preprocessor.h"
@@ -29,30 +33,58 @@ unsigned long long HyUCC::ExecuteInternal() {
     auto const plis_shared = std::make_shared<PLIs>(std::move(plis));
     auto const pli_records_shared = std::make_shared<Rows>(std::move(pli_records));
 
+    MemoryGuardian memory_guardian(mem_limit_mb_, *plis_shared, *pli_records_shared);
     hyucc::Sampler sampler(plis_shared, pli_records_shared, threads_num_);
 
     auto ucc_tree = std::make_unique<UCCTree>(relation_->GetNumColumns());
     Inductor inductor(ucc_tree.get());
-    Validator validator(ucc_tree.get(), plis_shared, pli_records_shared, threads_num_);
+    Validator validator(ucc_tree.get(), plis_shared, pli_records_shared, threads_num_,
+                        memory_guardian, [this]() { return ShouldStop(); });
 
     IdPairs comparison_suggestions;
+    bool is_stopped = false;
 
     while (true) {
+        // the candidates of the tree are valid UCCs only on the validated levels
+        if (ShouldStop()) {
+            is_stopped = true;
+            break;
+        }
         LOG(DEBUG) << "Sampling...";
         NonUCCList non_uccs = sampler.GetNonUCCs(comparison_suggestions);
 
         LOG(DEBUG) << "Inducing...";
         inductor.UpdateUCCTree(std::move(non_uccs));
+        memory_guardian.Match(*ucc_tree, comparison_suggestions, 1);
 
         LOG(DEBUG) << "Validating...";
         comparison_suggestions = validator.ValidateAndExtendCandidates();
+        if (validator.IsStopped()) {
+            is_stopped = true;
+            break;
+        }
 
         if (comparison_suggestions.empty()) {
             break;
         }
     }
 
+    is_result_truncated_ = memory_guardian.IsTriggered();
+    if (is_result_truncated_) {
+        LOG(WARNING) << "Memory limit was reached, only UCCs of size at most "
+                     << ucc_tree->GetMaxUCCSize() << " were mined";
+    }
+
     auto uccs = ucc_tree->FillUCCs();
+    if (is_stopped) {
+        // only the candidates of the validated levels are UCCs
+        unsigned const validated_levels = validator.GetFirstUnvalidatedLevel();
+        std::erase_if(uccs, [validated_levels](boost::dynamic_bitset<> const& ucc) {
+            return ucc.count() >= validated_levels;
+        });
+        LOG(INFO) << "Stopped before all the candidates were validated, registered the UCCs of "
+                  << "size less than " << validated_levels;
+    }
     RegisterUCCs(std::move(uccs), og_mapping);
 
     LOG(DEBUG) << "Mined UCCs:";
@@ -2,6 +2,8 @@
 
 #include <memory>
 
+#include "config/mem_limit/option.h"
+#include "config/mem_limit/type.h"
 #include "config/thread_number/option.h"
 #include "config/thread_number/type.h"
 #include "fd/hycommon/types.h"
@@ -15,22 +17,35 @@ class HyUCC : public UCCAlgorithm {
 private:
     std::unique_ptr<ColumnLayoutRelationData> relation_;
     config::ThreadNumType threads_num_ = 1;
+    config::MemLimitMBType mem_limit_mb_;
+    bool is_result_truncated_ = false;
 
     void LoadDataInternal() override;
     unsigned long long ExecuteInternal() override;
 
-    void ResetUCCAlgorithmState() override {}
+    void ResetUCCAlgorithmState() override {
+        is_result_truncated_ = false;
+    }
 
     void RegisterUCCs(std::vector<boost::dynamic_bitset<>>&& uccs,
                       std::vector<hy::ClusterId> const& og_mapping);
 
     void MakeExecuteOptsAvailable() final {
-        MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+        MakeOptionsAvailable(
+                {config::kThreadNumberOpt.GetName(), config::kOptionalMemLimitMbOpt.GetName()});
     }
 
 public:
     HyUCC() : UCCAlgorithm({}) {
         RegisterOption(config::kThreadNumberOpt(&threads_num_));
+        RegisterOption(config::kOptionalMemLimitMbOpt(&mem_limit_mb_));
+        RegisterTimeLimitOption();
+    }
+
+    // Whether the memory guardian had to lower the maximum UCC size, i.e. large UCCs may be
+    // missing from the result
+    [[nodiscard]] bool IsResultTruncated() const noexcept {
+        return is_result_truncated_;
     }
 };
 
@@ -18,6 +18,10 @@ void Inductor::SpecializeUCCTree(model::RawUCC const& non_ucc) {
 
     for (auto& invalid_ucc : invalid_uccs) {
         tree_->Remove(invalid_ucc);
+        if (!tree_->IsUCCSizeAllowed(invalid_ucc.count() + 1)) {
+            continue;
+        }
+
         for (size_t attr_num = tree_->GetNumAttributes(); attr_num > 0; --attr_num) {
             size_t attr_idx = attr_num - 1;
 
@@ -12,12 +12,14 @@ class Inductor {
 private:
     UCCTree* tree_;
 
-    void SpecializeUCCTree(model::RawUCC const& non_ucc);
-
 public:
     explicit Inductor(UCCTree* tree) noexcept : tree_(tree) {}
 
     void UpdateUCCTree(NonUCCList&& non_uccs);
+
+    /* Removes the UCCs that are subsets of non_ucc and adds their minimal specializations not
+     * generalized by another UCC */
+    void SpecializeUCCTree(model::RawUCC const& non_ucc);
 };
 
 }  // namespace algos::hyucc
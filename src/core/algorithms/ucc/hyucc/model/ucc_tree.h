@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 
 #include <boost/dynamic_bitset.hpp>
@@ -11,6 +13,8 @@ namespace algos::hyucc {
 class UCCTree {
 private:
     std::unique_ptr<UCCTreeVertex> root_;
+    // Maximum size of UCCs the tree is allowed to hold
+    unsigned max_ucc_size_ = std::numeric_limits<unsigned>::max();
 
 public:
     explicit UCCTree(size_t num_attributes) : root_(UCCTreeVertex::Create(num_attributes, false)) {
@@ -38,6 +42,30 @@ public:
         return root_->GetLevelRecursive(target_level);
     }
 
+    [[nodiscard]] unsigned GetMaxUCCSize() const noexcept {
+        return max_ucc_size_;
+    }
+
+    [[nodiscard]] bool IsUCCSizeAllowed(size_t ucc_size) const noexcept {
+        return ucc_size <= max_ucc_size_;
+    }
+
+    // Approximate number of bytes occupied by the tree
+    [[nodiscard]] size_t GetMemoryUsage() const {
+        return root_->GetMemoryUsageRecursive();
+    }
+
+    // Maximum size of UCCs stored in the tree
+    [[nodiscard]] unsigned GetDepth() const {
+        return root_->GetDepthRecursive();
+    }
+
+    // Removes all UCCs larger than max_ucc_size and forbids adding such UCCs later
+    void Trim(unsigned max_ucc_size) {
+        max_ucc_size_ = std::min(max_ucc_size_, max_ucc_size);
+        root_->TrimRecursive(max_ucc_size_);
+    }
+
     UCCTreeVertex* AddUCC(boost::dynamic_bitset<> const& ucc, bool* is_new_out = nullptr);
     [[nodiscard]] UCCTreeVertex* AddUCCGetIfNew(boost::dynamic_bitset<> const& ucc);
     [[nodiscard]] std::vector<boost::dynamic_bitset<>> FillUCCs() const;
@@ -1,5 +1,7 @@
 #include "ucc_tree_vertex.h"
 
+#include <algorithm>
+
 namespace algos::hyucc {
 
 void UCCTreeVertex::InitChildren(bool is_ucc) {
@@ -125,6 +127,47 @@ void UCCTreeVertex::FillUCCsRecursive(std::vector<boost::dynamic_bitset<>>& uccs
     }
 }
 
+size_t UCCTreeVertex::GetMemoryUsageRecursive() const {
+    size_t usage = sizeof(UCCTreeVertex) +
+                   children_.capacity() * sizeof(std::unique_ptr<UCCTreeVertex>);
+    for (auto const& child : children_) {
+        if (child != nullptr) {
+            usage += child->GetMemoryUsageRecursive();
+        }
+    }
+    return usage;
+}
+
+unsigned UCCTreeVertex::GetDepthRecursive() const {
+    unsigned depth = 0;
+    for (auto const& child : children_) {
+        if (child != nullptr) {
+            depth = std::max(depth, child->GetDepthRecursive() + 1);
+        }
+    }
+    return depth;
+}
+
+void UCCTreeVertex::TrimRecursive(unsigned max_depth) {
+    if (max_depth == 0) {
+        children_.clear();
+        children_.shrink_to_fit();
+        return;
+    }
+
+    for (size_t i = 0; i != children_.size(); ++i) {
+        auto* child = GetChildIfExists(i);
+        if (child == nullptr) {
+            continue;
+        }
+
+        child->TrimRecursive(max_depth - 1);
+        if (child->IsObsolete()) {
+            children_[i] = nullptr;
+        }
+    }
+}
+
 [[nodiscard]] std::vector<LhsPair> UCCTreeVertex::GetLevelRecursive(unsigned target_level) {
     std::vector<LhsPair> level;
     boost::dynamic_bitset<> ucc(num_attributes_);
@@ -43,6 +43,12 @@ private:
     void GetLevelRecursiveImpl(unsigned target_level, unsigned cur_level,
                                boost::dynamic_bitset<> ucc, std::vector<LhsPair>& result);
     void FillUCCsRecursive(std::vector<boost::dynamic_bitset<>>& uccs, boost::dynamic_bitset<> ucc);
+    // Approximate number of bytes occupied by the subtree rooted at this vertex
+    [[nodiscard]] size_t GetMemoryUsageRecursive() const;
+    // Length of the longest path from this vertex to a descendant
+    [[nodiscard]] unsigned GetDepthRecursive() const;
+    // Destroys all descendants deeper than max_depth levels
+    void TrimRecursive(unsigned max_depth);
 
     explicit UCCTreeVertex(size_t num_attributes, bool is_ucc)
         : num_attributes_(num_attributes), is_ucc_(is_ucc) {}
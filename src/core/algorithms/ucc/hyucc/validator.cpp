@@ -1,10 +1,8 @@
 #include "validator.h"
 
-#include <future>
-
-#include <boost/asio/post.hpp>
-#include <boost/asio/thread_pool.hpp>
+#include <optional>
 
+#include "cluster_identifier_set.h"
 #include "fd/hycommon/efficiency_threshold.h"
 #include "fd/hycommon/validator_helpers.h"
 #include "ucc/hyucc/model/ucc_tree_vertex.h"
@@ -21,6 +19,10 @@ size_t AddExtendedCandidatesFromInvalid(std::vector<algos::hyucc::LhsPair>& next
                                         size_t num_attributes) {
     size_t candidates = 0;
     for (auto const& ucc : invalid_uccs) {
+        if (!ucc_tree.IsUCCSizeAllowed(ucc.count() + 1)) {
+            continue;
+        }
+
         for (size_t attr = 0; attr < num_attributes; ++attr) {
             if (ucc.test(attr)) {
                 continue;
@@ -50,23 +52,28 @@ namespace algos::hyucc {
 
 using model::RawUCC;
 
+size_t Validator::GetPivotAttribute(RawUCC const& ucc) const {
+    // The PLI with the fewest records in its clusters gives the fewest identifiers to build
+    size_t pivot_attr = ucc.find_first();
+    for (size_t attr = ucc.find_next(pivot_attr); attr != RawUCC::npos;
+         attr = ucc.find_next(attr)) {
+        if ((*plis_)[attr]->GetSize() < (*plis_)[pivot_attr]->GetSize()) {
+            pivot_attr = attr;
+        }
+    }
+    return pivot_attr;
+}
+
 bool Validator::IsUnique(model::PLI const& pivot_pli, RawUCC const& ucc,
                          hy::IdPairs& comparison_suggestions) {
-    std::vector<hy::ClusterId> indices = util::BitsetToIndices<hy::ClusterId>(ucc);
+    ClusterIdentifierSet cluster_identifiers(util::BitsetToIndices<hy::ClusterId>(ucc));
     for (model::PLI::Cluster const& cluster : pivot_pli.GetIndex()) {
-        auto cluster_to_record =
-                hy::MakeClusterIdentifierToTMap<model::PLI::Cluster::value_type>(cluster.size());
+        cluster_identifiers.Reset(cluster.size());
         for (auto const record_id : cluster) {
-            std::vector<hy::ClusterId> cluster_id =
-                    hy::BuildClustersIdentifier((*compressed_records_)[record_id], indices);
-            if (cluster_id.empty()) {
-                continue;
-            }
-
-            auto const [it, inserted] =
-                    cluster_to_record.try_emplace(std::move(cluster_id), record_id);
-            if (!inserted) {
-                comparison_suggestions.emplace_back(record_id, it->second);
+            std::optional<hy::TablePos> const duplicate =
+                    cluster_identifiers.Insert((*compressed_records_)[record_id], record_id);
+            if (duplicate.has_value()) {
+                comparison_suggestions.emplace_back(record_id, *duplicate);
                 return false;
             }
         }
@@ -81,18 +88,17 @@ Validator::UCCValidations Validator::GetValidations(LhsPair const& vertex_and_uc
     validations.SetCountValidations(1);
     validations.SetCountIntersections(1);
 
-    size_t ucc_attr = ucc.find_first();
     bool is_unique;
     if (current_level_number_ == 1) {
+        size_t const ucc_attr = ucc.find_first();
         assert(ucc_attr != boost::dynamic_bitset<>::npos);
         is_unique = (*plis_)[ucc_attr]->AllValuesAreUnique();
     } else {
-        ucc.reset(ucc_attr);
-        // It's guaranteed that the first cluster has the fewest records because of sorting
-        // in the Sampler
-        model::PLI const* pivot_pli = (*plis_)[ucc_attr];
+        size_t const pivot_attr = GetPivotAttribute(ucc);
+        ucc.reset(pivot_attr);
+        model::PLI const* pivot_pli = (*plis_)[pivot_attr];
         is_unique = IsUnique(*pivot_pli, ucc, validations.ComparisonSuggestions());
-        ucc.set(ucc_attr);
+        ucc.set(pivot_attr);
     }
 
     if (!is_unique) {
@@ -110,6 +116,10 @@ Validator::UCCValidations Validator::ValidateAndExtendSeq(
         if (!vertex_and_ucc.first->IsUCC()) {
             continue;
         }
+        if (is_stopped_()) {
+            stopped_ = true;
+            break;
+        }
         result.Add(GetValidations(vertex_and_ucc));
     }
     return result;
@@ -117,28 +127,26 @@ Validator::UCCValidations Validator::ValidateAndExtendSeq(
 
 Validator::UCCValidations Validator::ValidateAndExtendParallel(
         std::vector<LhsPair> const& current_level) {
-    UCCValidations result;
-    boost::asio::thread_pool pool(threads_num_);
-    std::vector<std::future<UCCValidations>> validation_futures;
-
-    for (auto const& vertex_and_ucc : current_level) {
-        if (!vertex_and_ucc.first->IsUCC()) {
+    assert(pool_ != nullptr);
+    std::vector<UCCValidations> validations(current_level.size());
+    for (size_t i = 0; i < current_level.size(); ++i) {
+        if (!current_level[i].first->IsUCC()) {
             continue;
         }
-
-        std::packaged_task<UCCValidations()> task(
-                [this, &vertex_and_ucc]() { return GetValidations(vertex_and_ucc); });
-        validation_futures.push_back(task.get_future());
-        boost::asio::post(pool, std::move(task));
+        pool_->Submit([this, &current_level, &validations, i]() {
+            if (stopped_ || is_stopped_()) {
+                stopped_ = true;
+                return;
+            }
+            validations[i] = GetValidations(current_level[i]);
+        });
     }
+    pool_->Wait();
 
-    pool.join();
-
-    for (auto& future : validation_futures) {
-        assert(future.valid());
-        result.Add(future.get());
+    UCCValidations result;
+    for (UCCValidations const& candidate_validations : validations) {
+        result.Add(candidate_validations);
     }
-
     return result;
 }
 
@@ -165,6 +173,9 @@ hy::IdPairs Validator::ValidateAndExtendCandidates() {
     hy::IdPairs comparison_suggestions;
     while (!current_level.empty()) {
         UCCValidations result = ValidateAndExtend(current_level);
+        if (stopped_) {
+            return comparison_suggestions;
+        }
         comparison_suggestions.insert(comparison_suggestions.end(),
                                       result.ComparisonSuggestions().begin(),
                                       result.ComparisonSuggestions().end());
@@ -175,6 +186,11 @@ hy::IdPairs Validator::ValidateAndExtendCandidates() {
 
         LogLevel(current_level, result, candidates, current_level_number_, "UCC");
 
+        if (memory_guardian_.Match(*tree_, comparison_suggestions, 1)) {
+            // Vertices of the next level may have been destroyed by the trimming
+            next_level = tree_->GetLevel(current_level_number_ + 1);
+        }
+
         size_t const num_invalid_uccs = result.InvalidInstances().size();
         size_t const num_valid_uccs = result.CountValidations() - num_invalid_uccs;
         current_level = std::move(next_level);
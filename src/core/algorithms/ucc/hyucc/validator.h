@@ -1,15 +1,20 @@
 #pragma once
 
+#include <atomic>
 #include <cassert>
+#include <functional>
+#include <memory>
 #include <utility>
 #include <vector>
 
 #include "algorithms/ucc/hyucc/model/ucc_tree.h"
 #include "algorithms/ucc/raw_ucc.h"
 #include "config/thread_number/type.h"
+#include "fd/hycommon/memory_guardian.h"
 #include "fd/hycommon/primitive_validations.h"
 #include "fd/hycommon/types.h"
 #include "model/table/position_list_index.h"
+#include "util/work_stealing_pool.h"
 
 namespace algos::hyucc {
 
@@ -20,9 +25,16 @@ private:
     UCCTree* tree_;
     hy::PLIsPtr plis_;
     hy::RowsPtr compressed_records_;
+    hy::MemoryGuardian& memory_guardian_;
+    std::function<bool()> is_stopped_;
     unsigned current_level_number_ = 1;
+    // set by any of the validating threads
+    std::atomic<bool> stopped_ = false;
     config::ThreadNumType threads_num_ = 1;
+    // created once and reused by every validation round
+    std::unique_ptr<util::WorkStealingPool> pool_;
 
+    size_t GetPivotAttribute(model::RawUCC const& ucc) const;
     bool IsUnique(model::PLI const& pivot_pli, model::RawUCC const& ucc,
                   hy::IdPairs& comparison_suggestions);
     UCCValidations GetValidations(LhsPair const& vertex_and_ucc);
@@ -32,13 +44,30 @@ private:
 
 public:
     Validator(UCCTree* tree, hy::PLIsPtr plis, hy::RowsPtr compressed_records,
-              config::ThreadNumType threads_num) noexcept
+              config::ThreadNumType threads_num, hy::MemoryGuardian& memory_guardian,
+              std::function<bool()> is_stopped)
         : tree_(tree),
           plis_(std::move(plis)),
           compressed_records_(std::move(compressed_records)),
-          threads_num_(threads_num) {}
+          memory_guardian_(memory_guardian),
+          is_stopped_(std::move(is_stopped)),
+          threads_num_(threads_num) {
+        if (threads_num_ > 1) {
+            pool_ = std::make_unique<util::WorkStealingPool>(threads_num_);
+        }
+    }
 
+    /* Once is_stopped returns true, the validation is abandoned in the middle of the level */
     hy::IdPairs ValidateAndExtendCandidates();
+
+    [[nodiscard]] bool IsStopped() const {
+        return stopped_;
+    }
+
+    /* The levels of the tree below this one are validated, their candidates are minimal UCCs */
+    [[nodiscard]] unsigned GetFirstUnvalidatedLevel() const {
+        return current_level_number_;
+    }
 };
 
 }  // namespace algos::hyucc
@@ -1,8 +1,7 @@
 #include "algorithms/ucc/pyroucc/pyroucc.h"
 
 #include <chrono>
-#include <mutex>
-#include <thread>
+#include <functional>
 
 #include <easylogging++.h>
 
@@ -11,6 +10,8 @@
 #include "config/max_lhs/option.h"
 #include "config/names_and_descriptions.h"
 #include "config/option_using.h"
+#include "config/thread_number/option.h"
+#include "util/work_stealing_pool.h"
 
 namespace algos {
 
@@ -28,12 +29,15 @@ void PyroUCC::RegisterOptions() {
 
     RegisterOption(config::kErrorOpt(&parameters_.max_ucc_error));
     RegisterOption(config::kMaxLhsOpt(&parameters_.max_lhs));
+    RegisterOption(config::kThreadNumberOpt(&parameters_.parallelism));
     RegisterOption(Option{&parameters_.seed, kSeed, kDSeed, 0});
+    RegisterTimeLimitOption();
 }
 
 void PyroUCC::MakeExecuteOptsAvailable() {
     using namespace config::names;
-    MakeOptionsAvailable({config::kMaxLhsOpt.GetName(), config::kErrorOpt.GetName(), kSeed});
+    MakeOptionsAvailable({config::kMaxLhsOpt.GetName(), config::kErrorOpt.GetName(),
+                          config::kThreadNumberOpt.GetName(), kSeed});
 }
 
 void PyroUCC::LoadDataInternal() {
@@ -73,7 +77,8 @@ unsigned long long PyroUCC::ExecuteInternal() {
     } else {
         throw std::runtime_error("Unknown key error measure.");
     }
-    search_space_ = std::make_unique<SearchSpace>(0, std::move(strategy), schema, launch_pad_order);
+    search_space_ = std::make_unique<SearchSpace>(0, std::move(strategy), schema, launch_pad_order,
+                                                  true);
     unsigned long long init_time_millis = std::chrono::duration_cast<std::chrono::milliseconds>(
                                                   std::chrono::system_clock::now() - start_time)
                                                   .count();
@@ -82,7 +87,16 @@ unsigned long long PyroUCC::ExecuteInternal() {
 
     search_space_->SetContext(profiling_context.get());
     search_space_->EnsureInitialized();
-    search_space_->Discover();
+    // Every launch pad is ascended and trickled down from in a separate task, the tasks share the
+    // PLI cache of the profiling context. Once the stop is requested, the queued tasks are skipped
+    util::WorkStealingPool pool(parameters_.parallelism);
+    auto const spawn_task = [this, &pool](std::function<void()> task) {
+        pool.Submit([this, task = std::move(task)]() {
+            if (!ShouldStop()) task();
+        });
+    };
+    search_space_->DiscoverConcurrently(parameters_.parallelism, spawn_task, []() {});
+    pool.Wait();
     SetProgress(100);
 
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <list>
 #include <string_view>
 #include <vector>
@@ -46,6 +47,11 @@ public:
     std::list<model::UCC>& UCCList() noexcept {
         return ucc_collection_.AsList();
     }
+
+    // Streaming counterpart of UCCList(), see FDAlgorithm::SetFdConsumer
+    void SetUccConsumer(std::function<bool(model::UCC const&)> consumer) {
+        SetPrimitiveConsumer(ucc_collection_, std::move(consumer));
+    }
 };
 
 }  // namespace algos
@@ -0,0 +1,196 @@
+#include "algorithms/ucc/ucc_verifier/batch_ucc_verifier.h"
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include <easylogging++.h>
+
+#include "config/equal_nulls/option.h"
+#include "config/exceptions.h"
+#include "config/indices/validate_index.h"
+#include "config/names_and_descriptions.h"
+#include "config/option_using.h"
+#include "config/tabular_data/input_table/option.h"
+#include "config/thread_number/option.h"
+#include "util/parallel_for.h"
+
+namespace algos {
+
+BatchUCCVerifier::BatchUCCVerifier() : Algorithm({}) {
+    RegisterOptions();
+    MakeOptionsAvailable({config::kTableOpt.GetName(), config::kEqualNullsOpt.GetName()});
+}
+
+void BatchUCCVerifier::RegisterOptions() {
+    DESBORDANTE_OPTION_USING;
+
+    auto normalize_uccs = [](config::UCCsIndicesType& uccs) {
+        for (config::IndicesType& indices : uccs) {
+            std::sort(indices.begin(), indices.end());
+            indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+        }
+    };
+    auto check_uccs = [this](config::UCCsIndicesType const& uccs) {
+        size_t const num_columns = relation_->GetSchema()->GetNumColumns();
+        for (config::IndicesType const& indices : uccs) {
+            if (indices.empty()) {
+                throw config::ConfigurationError("Indices cannot be empty");
+            }
+            config::ValidateIndex(indices.back(), num_columns);
+        }
+    };
+
+    RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(config::kEqualNullsOpt(&is_null_equal_null_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    RegisterOption(Option{&uccs_, kUCCsIndices, kDUCCsIndices}
+                           .SetNormalizeFunc(normalize_uccs)
+                           .SetValueCheck(check_uccs));
+    RegisterOption(Option{&collect_violations_, kCollectViolations, kDCollectViolations, true});
+}
+
+void BatchUCCVerifier::MakeExecuteOptsAvailable() {
+    using namespace config::names;
+
+    MakeOptionsAvailable({kUCCsIndices, kCollectViolations, config::kThreadNumberOpt.GetName()});
+}
+
+void BatchUCCVerifier::LoadDataInternal() {
+    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+
+    if (relation_->GetColumnData().empty()) {
+        throw std::runtime_error("Got an empty dataset: UCC verifying is meaningless.");
+    }
+}
+
+unsigned long long BatchUCCVerifier::ExecuteInternal() {
+    auto start_time = std::chrono::system_clock::now();
+
+    pli_cache_ = std::make_unique<model::BlockingVerticalMap<model::PLI>>(relation_->GetSchema());
+    ucc_holds_.assign(uccs_.size(), false);
+    if (collect_violations_) {
+        stats_calculators_.assign(uccs_.size(), UCCStatsCalculator(relation_->GetNumRows()));
+    }
+
+    CalculatePrefixPLIs();
+    VerifyUCCs();
+    pli_cache_.reset();
+
+    auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now() - start_time);
+    return elapsed_milliseconds.count();
+}
+
+Vertical BatchUCCVerifier::GetVertical(config::IndicesType const& indices) const {
+    RelationalSchema const* schema = relation_->GetSchema();
+    return schema->GetVertical(schema->IndicesToBitset(indices));
+}
+
+void BatchUCCVerifier::CalculatePrefixPLIs() {
+    RelationalSchema const* schema = relation_->GetSchema();
+
+    // levels[i] maps every proper prefix of arity i + 2 to its greatest column, the candidates
+    // themselves are intersected during the verification
+    std::vector<std::unordered_map<Vertical, model::ColumnIndex>> levels;
+    std::unordered_set<model::ColumnIndex> single_columns;
+    for (config::IndicesType const& indices : uccs_) {
+        single_columns.insert(indices.front());
+        Vertical prefix(*schema->GetColumn(indices.front()));
+        for (size_t i = 1; i + 1 < indices.size(); ++i) {
+            prefix = prefix.Union(*schema->GetColumn(indices[i]));
+            if (levels.size() < i) levels.resize(i);
+            levels[i - 1].emplace(prefix, indices[i]);
+        }
+    }
+
+    for (model::ColumnIndex column : single_columns) {
+        pli_cache_->Put(Vertical(*schema->GetColumn(column)),
+                        relation_->GetColumnData(column).GetPliOwnership());
+    }
+    for (auto const& level : levels) {
+        std::vector<std::pair<Vertical, model::ColumnIndex>> const level_sets(level.begin(),
+                                                                              level.end());
+        util::ParallelForeach(
+                level_sets.begin(), level_sets.end(), threads_num_, [&](auto const& level_set) {
+                    auto const& [columns, last_column] = level_set;
+                    std::shared_ptr<model::PLI const> prefix_pli =
+                            pli_cache_->Get(columns.Without(*schema->GetColumn(last_column)));
+                    assert(prefix_pli != nullptr);
+                    std::shared_ptr<model::PLI> pli = prefix_pli->Intersect(
+                            relation_->GetColumnData(last_column).GetPositionListIndex());
+                    pli_cache_->Put(columns, std::move(pli));
+                });
+    }
+    LOG(DEBUG) << "Calculated PLIs of " << pli_cache_->GetSize() << " column sets";
+}
+
+bool BatchUCCVerifier::UCCHoldsFor(model::PLI const& prefix_pli,
+                                   model::ColumnIndex last_column) const {
+    std::vector<int> const& probing_table = relation_->GetColumnData(last_column).GetProbingTable();
+    std::unordered_set<int> cluster_values;
+    for (model::PLI::Cluster const& cluster : prefix_pli.GetIndex()) {
+        for (int row : cluster) {
+            int const value = probing_table[row];
+            if (value == model::PLI::kSingletonValueId) continue;
+            // two rows of the cluster agree on the last column too
+            if (!cluster_values.insert(value).second) return false;
+        }
+        cluster_values.clear();
+    }
+    return true;
+}
+
+void BatchUCCVerifier::CalculateStatistics(size_t ucc_index) {
+    config::IndicesType const& indices = uccs_[ucc_index];
+    Vertical const ucc = GetVertical(indices);
+    std::shared_ptr<model::PLI const> pli = pli_cache_->Get(ucc);
+    if (pli == nullptr) {
+        RelationalSchema const* schema = relation_->GetSchema();
+        std::shared_ptr<model::PLI const> prefix_pli =
+                pli_cache_->Get(ucc.Without(*schema->GetColumn(indices.back())));
+        assert(prefix_pli != nullptr);
+        pli = prefix_pli->Intersect(
+                relation_->GetColumnData(indices.back()).GetPositionListIndex());
+    }
+    UCCStatsCalculator& stats_calculator = stats_calculators_[ucc_index];
+    stats_calculator.CalculateStatistics(pli->GetIndex());
+    ucc_holds_[ucc_index] = stats_calculator.UCCHolds();
+}
+
+void BatchUCCVerifier::VerifyUCCs() {
+    RelationalSchema const* schema = relation_->GetSchema();
+    std::vector<size_t> ucc_indices(uccs_.size());
+    std::iota(ucc_indices.begin(), ucc_indices.end(), 0);
+    util::ParallelForeach(ucc_indices.begin(), ucc_indices.end(), threads_num_, [&](size_t i) {
+        if (collect_violations_) {
+            CalculateStatistics(i);
+            return;
+        }
+        config::IndicesType const& indices = uccs_[i];
+        Vertical const ucc = GetVertical(indices);
+        // the candidate may be a prefix of another one
+        if (std::shared_ptr<model::PLI const> pli = pli_cache_->Get(ucc); pli != nullptr) {
+            ucc_holds_[i] = pli->AllValuesAreUnique();
+            return;
+        }
+        std::shared_ptr<model::PLI const> prefix_pli =
+                pli_cache_->Get(ucc.Without(*schema->GetColumn(indices.back())));
+        assert(prefix_pli != nullptr);
+        ucc_holds_[i] = UCCHoldsFor(*prefix_pli, indices.back());
+    });
+}
+
+std::vector<size_t> BatchUCCVerifier::GetViolatedUCCIndices() const {
+    std::vector<size_t> violated;
+    for (size_t i = 0; i < ucc_holds_.size(); ++i) {
+        if (!ucc_holds_[i]) violated.push_back(i);
+    }
+    return violated;
+}
+
+}  // namespace algos
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "algorithms/algorithm.h"
+#include "algorithms/ucc/ucc_verifier/ucc_stats_calculator.h"
+#include "config/equal_nulls/type.h"
+#include "config/indices/type.h"
+#include "config/tabular_data/input_table_type.h"
+#include "config/thread_number/type.h"
+#include "model/table/column_layout_relation_data.h"
+#include "model/table/vertical_map.h"
+
+namespace algos {
+
+/* Verifies many candidate UCCs over one table at once. PLIs of the prefixes of the candidates are
+ * computed level by level, so candidates with a common prefix share the intersections, and the
+ * candidates are then checked in parallel. If violating clusters are not collected, a candidate is
+ * checked against the PLI of its prefix directly and the check stops at the first violation. */
+class BatchUCCVerifier : public Algorithm {
+private:
+    config::InputTable input_table_;
+
+    config::UCCsIndicesType uccs_;
+    config::EqNullsType is_null_equal_null_;
+    config::ThreadNumType threads_num_;
+    bool collect_violations_;
+
+    std::shared_ptr<ColumnLayoutRelationData> relation_;
+    // PLIs of the prefixes of the candidates, only needed during the execution
+    std::unique_ptr<model::VerticalMap<model::PLI>> pli_cache_;
+    // not std::vector<bool>, the candidates are checked concurrently
+    std::vector<std::uint8_t> ucc_holds_;
+    // empty if the violating clusters are not collected
+    std::vector<UCCStatsCalculator> stats_calculators_;
+
+    void RegisterOptions();
+    Vertical GetVertical(config::IndicesType const& indices) const;
+    void CalculatePrefixPLIs();
+    void VerifyUCCs();
+    bool UCCHoldsFor(model::PLI const& prefix_pli, model::ColumnIndex last_column) const;
+    void CalculateStatistics(size_t ucc_index);
+
+    void ResetState() final {
+        pli_cache_.reset();
+        ucc_holds_.clear();
+        stats_calculators_.clear();
+    }
+
+protected:
+    void LoadDataInternal() override;
+    void MakeExecuteOptsAvailable() override;
+    unsigned long long ExecuteInternal() override;
+
+public:
+    size_t GetNumUCCs() const {
+        return ucc_holds_.size();
+    }
+
+    /* Whether the ucc_index-th candidate of the option is a UCC, in the order the candidates
+     * were given */
+    bool UCCHolds(size_t ucc_index) const {
+        assert(ucc_index < ucc_holds_.size());
+        return ucc_holds_[ucc_index];
+    }
+
+    /* Indices of the candidates that are not UCCs */
+    std::vector<size_t> GetViolatedUCCIndices() const;
+
+    /* Statistics of the candidate, only available if the violating clusters were collected */
+    UCCStatsCalculator const& GetStatistics(size_t ucc_index) const {
+        assert(collect_violations_);
+        assert(ucc_index < stats_calculators_.size());
+        return stats_calculators_[ucc_index];
+    }
+
+    size_t GetNumClustersViolatingUCC(size_t ucc_index) const {
+        return GetStatistics(ucc_index).GetNumClustersViolatingUCC();
+    }
+
+    size_t GetNumRowsViolatingUCC(size_t ucc_index) const {
+        return GetStatistics(ucc_index).GetNumRowsViolatingUCC();
+    }
+
+    std::vector<model::PLI::Cluster> const& GetClustersViolatingUCC(size_t ucc_index) const {
+        return GetStatistics(ucc_index).GetClustersViolatingUCC();
+    }
+
+    double GetError(size_t ucc_index) const {
+        return GetStatistics(ucc_index).GetAUCCError();
+    }
+
+    BatchUCCVerifier();
+};
+
+}  // namespace algos
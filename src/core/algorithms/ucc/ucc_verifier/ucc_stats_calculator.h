@@ -67,7 +67,7 @@ public:
     }
 
     /* Returns error for aucc to hold*/
-    double GetAUCCError() {
+    double GetAUCCError() const {
         return aucc_error_;
     }
 };
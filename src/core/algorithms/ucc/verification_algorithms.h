@@ -1,3 +1,4 @@
 #pragma once
 
+#include "ucc/ucc_verifier/batch_ucc_verifier.h"
 #include "ucc/ucc_verifier/ucc_verifier.h"
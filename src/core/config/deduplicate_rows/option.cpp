@@ -0,0 +1,9 @@
+#include "config/deduplicate_rows/option.h"
+
+#include "config/names_and_descriptions.h"
+
+namespace config {
+using names::kDeduplicateRows, descriptions::kDDeduplicateRows;
+extern CommonOption<DeduplicateRowsType> const kDeduplicateRowsOpt{kDeduplicateRows,
+                                                                   kDDeduplicateRows, false};
+}  // namespace config
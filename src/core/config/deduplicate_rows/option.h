@@ -0,0 +1,8 @@
+#pragma once
+
+#include "config/common_option.h"
+#include "config/deduplicate_rows/type.h"
+
+namespace config {
+extern CommonOption<DeduplicateRowsType> const kDeduplicateRowsOpt;
+}  // namespace config
@@ -0,0 +1,5 @@
+#pragma once
+
+namespace config {
+using DeduplicateRowsType = bool;
+}  // namespace config
@@ -33,6 +33,12 @@ constexpr auto kDThreads =
         "hardware can handle concurrently.";
 constexpr auto kDError = "error threshold value for Approximate FD algorithms";
 auto const kDErrorMeasure = details::kDErrorMeasureString.c_str();
+constexpr auto kDErrorThresholds =
+        "additional error thresholds for Approximate FD algorithms, the FDs for all of them are "
+        "mined in a single run";
+constexpr auto kDFindUccs =
+        "also discover the approximate UCCs for the main error threshold in the same run, sharing "
+        "the PLI cache with the FD discovery";
 constexpr auto kDMaximumLhs = "max considered LHS size";
 constexpr auto kDMaximumArity = "max considered arity";
 constexpr auto kDSeed = "RNG seed";
@@ -46,7 +52,12 @@ auto const kDMetric = details::kDMetricString.c_str();
 constexpr auto kDLhsIndices = "LHS column indices";
 constexpr auto kDRhsIndices = "RHS column indices";
 constexpr auto kDRhsIndex = "RHS column index";
+constexpr auto kDFdsIndices = "FDs to verify, pairs of LHS and RHS column indices";
 constexpr auto kDUCCIndices = "column indices for UCC verification";
+constexpr auto kDUCCsIndices = "column sets to verify as UCCs, lists of column indices";
+constexpr auto kDCollectViolations =
+        "collect all clusters violating a UCC. If false, only whether a UCC holds is found out "
+        "and its check stops at the first violating cluster";
 constexpr auto kDParameter = "metric FD parameter";
 constexpr auto kDDistFromNullIsInfinity =
         "specify whether distance from NULL value is infinity "
@@ -102,10 +113,20 @@ constexpr auto kDIgnoreConstantCols =
 constexpr auto kDGraphData = "Path to dot-file with graph";
 constexpr auto kDGfdData = "Path to file with GFD";
 constexpr auto kDMemLimitMB = "memory limit im MBs";
+constexpr auto kDOptionalMemLimitMB =
+        "memory limit in MBs, 0 means no limit. Once it is exceeded, the maximum size of the "
+        "mined dependencies is lowered and the result is truncated";
 constexpr auto kDDifferenceTable = "CSV table containing difference limits for each column";
 constexpr auto kDNumRows = "Use only first N rows of the table";
 constexpr auto kDNUmColumns = "Use only first N columns of the table";
 constexpr auto kDInsertStatements = "Rows to be inserted into the table using the insert operation";
 constexpr auto kDDeleteStatements = "Rows to be deleted from the table using the delete operation";
 constexpr auto kDUpdateStatements = "Rows to be replaced in the table using the update operation";
+constexpr auto kDRowSampleSize =
+        "number of rows of a uniform random sample the dependencies are mined on, 0 to use the "
+        "whole table";
+constexpr auto kDRowSampleSeed = "seed of the random row sample";
+constexpr auto kDDeduplicateRows =
+        "collapse duplicate rows of the table into one before mining, duplicate rows do not "
+        "change which FDs hold";
 }  // namespace config::descriptions
@@ -0,0 +1,20 @@
+#include "config/error_thresholds/option.h"
+
+#include <algorithm>
+
+#include "config/exceptions.h"
+#include "config/names_and_descriptions.h"
+
+namespace config {
+using names::kErrorThresholds, descriptions::kDErrorThresholds;
+extern CommonOption<ErrorThresholdsType> const kErrorThresholdsOpt{
+        kErrorThresholds, kDErrorThresholds, ErrorThresholdsType{}, [](auto &thresholds) {
+            for (ErrorType threshold : thresholds) {
+                if (!(threshold >= 0 && threshold <= 1)) {
+                    throw ConfigurationError("ERROR: error thresholds should be between 0 and 1.");
+                }
+            }
+            std::sort(thresholds.begin(), thresholds.end());
+            thresholds.erase(std::unique(thresholds.begin(), thresholds.end()), thresholds.end());
+        }};
+}  // namespace config
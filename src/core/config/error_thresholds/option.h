@@ -0,0 +1,8 @@
+#pragma once
+
+#include "config/common_option.h"
+#include "config/error_thresholds/type.h"
+
+namespace config {
+extern CommonOption<ErrorThresholdsType> const kErrorThresholdsOpt;
+}  // namespace config
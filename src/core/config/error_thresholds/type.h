@@ -0,0 +1,9 @@
+#pragma once
+
+#include <vector>
+
+#include "config/error/type.h"
+
+namespace config {
+using ErrorThresholdsType = std::vector<ErrorType>;
+}  // namespace config
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <utility>
 #include <vector>
 
 #include "model/table/column_index.h"
@@ -7,4 +8,7 @@
 namespace config {
 using IndexType = model::ColumnIndex;
 using IndicesType = std::vector<IndexType>;
+using FdIndicesType = std::pair<IndicesType, IndicesType>;
+using FdsIndicesType = std::vector<FdIndicesType>;
+using UCCsIndicesType = std::vector<IndicesType>;
 }  // namespace config
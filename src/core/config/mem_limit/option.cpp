@@ -3,7 +3,7 @@
 #include "config/names_and_descriptions.h"
 
 namespace config {
-using names::kMemLimitMB, descriptions::kDMemLimitMB;
+using names::kMemLimitMB, descriptions::kDMemLimitMB, descriptions::kDOptionalMemLimitMB;
 extern CommonOption<MemLimitMBType> const kMemLimitMbOpt{
         kMemLimitMB, kDMemLimitMB, 2 * 1024u, [](auto &value) {
             constexpr MemLimitMBType min_limit_mb = 16u;
@@ -12,4 +12,12 @@ extern CommonOption<MemLimitMBType> const kMemLimitMbOpt{
                                          "MB");
             }
         }};
+extern CommonOption<MemLimitMBType> const kOptionalMemLimitMbOpt{
+        kMemLimitMB, kDOptionalMemLimitMB, 0u, [](auto &value) {
+            constexpr MemLimitMBType min_limit_mb = 16u;
+            if (value != 0 && value < min_limit_mb) {
+                throw ConfigurationError("Memory limit must be 0 or at least " +
+                                         std::to_string(min_limit_mb) + "MB");
+            }
+        }};
 }  // namespace config
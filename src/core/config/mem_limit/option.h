@@ -5,4 +5,6 @@
 
 namespace config {
 extern CommonOption<MemLimitMBType> const kMemLimitMbOpt;
+// Memory limit that is not enforced unless it is set, 0 means no limit
+extern CommonOption<MemLimitMBType> const kOptionalMemLimitMbOpt;
 }  // namespace config
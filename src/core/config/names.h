@@ -13,6 +13,8 @@ constexpr auto kEqualNulls = "is_null_equal_null";
 constexpr auto kThreads = "threads";
 constexpr auto kError = "error";
 constexpr auto kErrorMeasure = "error_measure";
+constexpr auto kErrorThresholds = "error_thresholds";
+constexpr auto kFindUccs = "find_uccs";
 constexpr auto kMaximumLhs = "max_lhs";
 constexpr auto kMaximumArity = "max_arity";
 constexpr auto kSeed = "seed";
@@ -26,7 +28,10 @@ constexpr auto kMetric = "metric";
 constexpr auto kLhsIndices = "lhs_indices";
 constexpr auto kRhsIndices = "rhs_indices";
 constexpr auto kRhsIndex = "rhs_index";
+constexpr auto kFdsIndices = "fds";
 constexpr auto kUCCIndices = "ucc_indices";
+constexpr auto kUCCsIndices = "uccs";
+constexpr auto kCollectViolations = "collect_violations";
 constexpr auto kParameter = "parameter";
 constexpr auto kDistFromNullIsInfinity = "dist_from_null_is_infinity";
 constexpr auto kQGramLength = "q";
@@ -62,4 +67,7 @@ constexpr auto kNumColumns = "num_columns";
 constexpr auto kInsertStatements = "insert";
 constexpr auto kDeleteStatements = "delete";
 constexpr auto kUpdateStatements = "update";
+constexpr auto kRowSampleSize = "row_sample_size";
+constexpr auto kRowSampleSeed = "row_sample_seed";
+constexpr auto kDeduplicateRows = "deduplicate_rows";
 }  // namespace config::names
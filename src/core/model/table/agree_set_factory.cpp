@@ -1,8 +1,11 @@
 #include "agree_set_factory.h"
 
+#include <algorithm>
 #include <atomic>
-#include <condition_variable>
+#include <functional>
+#include <iterator>
 #include <shared_mutex>
+#include <system_error>
 #include <thread>
 #include <unordered_set>
 
@@ -16,7 +19,6 @@
 #include <easylogging++.h>
 
 #include "identifier_set.h"
-#include "parallel_for.h"
 
 namespace model {
 
@@ -61,8 +63,79 @@ AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAgreeSets() const {
     return agree_sets;
 }
 
+namespace {
+
+/* Calls process(unit_index, agree_sets) for every unit in [0, units_num) using threads_num
+ * threads. Units are handed out one by one, because their costs vary a lot (e.g. clusters of the
+ * maximal representation). Each thread collects agree sets into its own set, so no
+ * synchronization is needed until the sets are merged after all threads are joined.
+ * process returns the progress its unit makes. The workers only sum it up, add_progress is called
+ * by the calling thread alone: between its own units and once the workers are joined.
+ */
+template <typename Process, typename AddProgress>
+AgreeSetFactory::SetOfAgreeSets CollectAgreeSets(size_t const units_num, unsigned threads_num,
+                                                 Process const& process,
+                                                 AddProgress const& add_progress) {
+    using SetOfAgreeSets = AgreeSetFactory::SetOfAgreeSets;
+    threads_num = std::min(static_cast<size_t>(threads_num), units_num);
+    if (threads_num <= 1) {
+        SetOfAgreeSets agree_sets;
+        for (size_t i = 0; i != units_num; ++i) {
+            add_progress(process(i, agree_sets));
+        }
+        return agree_sets;
+    }
+
+    std::vector<SetOfAgreeSets> threads_agree_sets(threads_num);
+    std::atomic<size_t> next_unit = 0;
+    std::atomic<double> progress = 0;
+    auto const work = [&process, &next_unit, &progress, units_num](SetOfAgreeSets& agree_sets,
+                                                                   auto const& on_unit_done) {
+        for (size_t i = next_unit++; i < units_num; i = next_unit++) {
+            progress.fetch_add(process(i, agree_sets), std::memory_order_relaxed);
+            on_unit_done();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threads_num - 1);
+    for (unsigned i = 1; i < threads_num; ++i) {
+        try {
+            threads.emplace_back(work, std::ref(threads_agree_sets[i]), [] {});
+        } catch (std::system_error const& e) {
+            /* The remaining units are processed by the threads that have been created */
+            LOG(WARNING) << "Created " << threads.size() << " threads to generate agree sets. "
+                         << "Could not create new thread: " << e.what();
+            break;
+        }
+    }
+    double reported_progress = 0;
+    auto const report_progress = [&progress, &reported_progress, &add_progress]() {
+        double const current_progress = progress.load(std::memory_order_relaxed);
+        add_progress(current_progress - reported_progress);
+        reported_progress = current_progress;
+    };
+    work(threads_agree_sets.front(), report_progress);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    report_progress();
+
+    auto largest = std::max_element(
+            threads_agree_sets.begin(), threads_agree_sets.end(),
+            [](auto const& lhs, auto const& rhs) { return lhs.size() < rhs.size(); });
+    SetOfAgreeSets agree_sets = std::move(*largest);
+    largest->clear();
+    for (auto& thread_agree_sets : threads_agree_sets) {
+        agree_sets.insert(std::make_move_iterator(thread_agree_sets.begin()),
+                          std::make_move_iterator(thread_agree_sets.end()));
+    }
+    return agree_sets;
+}
+
+}  // namespace
+
 AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAsUsingVectorOfIdSets() const {
-    SetOfAgreeSets agree_sets;
     vector<IdentifierSet> identifier_sets;
     SetOfVectors const max_representation = GenPliMaxRepresentation();
 
@@ -90,27 +163,27 @@ AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAsUsingVectorOfIdSets() cons
     }
 
     // compute agree sets using identifier sets
-    // using vector of identifier sets
-    if (!identifier_sets.empty()) {
-        size_t const size = identifier_sets.size();
-        size_t const pairs_num = (size_t)(size * (size - 1) / 2);
-        double const percent_per_idset =
-                (pairs_num == 0) ? algos::FDAlgorithm::kTotalProgressPercent
-                                 : algos::FDAlgorithm::kTotalProgressPercent / pairs_num;
-        auto back_it = std::prev(identifier_sets.end());
-        for (auto p = identifier_sets.begin(); p != back_it; ++p) {
-            for (auto q = std::next(p); q != identifier_sets.end(); ++q) {
-                agree_sets.insert(p->Intersect(*q));
-                AddProgress(percent_per_idset);
-            }
-        }
+    // using vector of identifier sets, each unit of work is one identifier set intersected
+    // with all of the following ones
+    size_t const size = identifier_sets.size();
+    if (size < 2) {
+        return {};
     }
+    size_t const pairs_num = size * (size - 1) / 2;
+    double const percent_per_pair = algos::FDAlgorithm::kTotalProgressPercent / pairs_num;
+    auto const intersect_with_following = [this, &identifier_sets, size, percent_per_pair](
+                                                  size_t p, SetOfAgreeSets& agree_sets) {
+        for (size_t q = p + 1; q != size; ++q) {
+            agree_sets.insert(identifier_sets[p].Intersect(identifier_sets[q]));
+        }
+        return percent_per_pair * (size - p - 1);
+    };
 
-    return agree_sets;
+    return CollectAgreeSets(size - 1, config_.threads_num, intersect_with_following,
+                            [this](double progress) { AddProgress(progress); });
 }
 
 AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAsUsingMapOfIdSets() const {
-    SetOfAgreeSets agree_sets;
     std::unordered_map<int, IdentifierSet> identifier_sets;
     SetOfVectors const max_representation = GenPliMaxRepresentation();
 
@@ -132,82 +205,38 @@ AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAsUsingMapOfIdSets() const {
     }
 
     // compute agree sets using identifier sets
-    // metanome approach (using map of identifier sets)
+    // metanome approach (using map of identifier sets), each unit of work is one cluster of the
+    // maximal representation
     double const percent_per_cluster =
             max_representation.empty()
                     ? algos::FDAlgorithm::kTotalProgressPercent
                     : algos::FDAlgorithm::kTotalProgressPercent / max_representation.size();
-
-    if (config_.threads_num > 1) {
-        /* Not as fast and simple as it can be, need to use concurrent unordered_set.
-         * Without concurrent data structure need to create separate unordered_set<AgreeSet>
-         * for each thread, and as a consequence it is necessary to ensure the thread safety
-         * of threads_agree_sets initialization or to manually parallelize for loop over the
-         * max_representation. Leads to the bulky code with synchronization primitives or to
-         * the copying of util::ParallelForeach code.
-         */
-        std::map<std::thread::id, std::unordered_set<AgreeSet>> threads_agree_sets;
-        std::condition_variable map_init_cv;
-        bool map_initialized = false;
-        std::mutex map_init_mutex;
-        /* Need to know the exact number of threads used by util::ParallelForeach to identify
-         * when threads_agree_sets is initialized (when its size equals to the number
-         * of used threads).
-         * NOTE: if ParallelForeach fails to create exactly actual_threads_num threads when
-         *       threads_agree_sets.size() always will be not equal to actual_threads_num leading
-         *       to the infinite wait on cv.
-         */
-        unsigned short const actual_threads_num =
-                std::min(max_representation.size(), (size_t)config_.threads_num);
-        auto task = [&identifier_sets, &agree_sets, percent_per_cluster, actual_threads_num,
-                     &map_init_mutex, this, &threads_agree_sets, &map_init_cv,
-                     &map_initialized](SetOfVectors::value_type const& cluster) {
-            std::thread::id const thread_id = std::this_thread::get_id();
-
-            if (!map_initialized) {
-                std::unique_lock lock(map_init_mutex);
-                threads_agree_sets.insert({thread_id, std::unordered_set<AgreeSet>()});
-                if (threads_agree_sets.size() != actual_threads_num) {
-                    map_init_cv.wait(lock, [&map_initialized]() { return map_initialized; });
-                } else {
-                    map_initialized = true;
-                    map_init_cv.notify_all();
-                }
-            }
-
-            auto back_it = std::prev(cluster.cend());
-            for (auto p = cluster.cbegin(); p != back_it; ++p) {
-                for (auto q = std::next(p); q != cluster.end(); ++q) {
-                    IdentifierSet const& id_set1 = identifier_sets.at(*p);
-                    IdentifierSet const& id_set2 = identifier_sets.at(*q);
-                    threads_agree_sets[thread_id].insert(id_set1.Intersect(id_set2));
-                }
-            }
-            AddProgress(percent_per_cluster);
-        };
-
-        util::ParallelForeach(max_representation.begin(), max_representation.end(),
-                              config_.threads_num, task);
-
-        for (auto& [thread_id, thread_as] : threads_agree_sets) {
-            agree_sets.insert(std::make_move_iterator(thread_as.begin()),
-                              std::make_move_iterator(thread_as.end()));
-        }
-    } else {
+    vector<std::vector<int> const*> const clusters = [&max_representation]() {
+        vector<std::vector<int> const*> clusters;
+        clusters.reserve(max_representation.size());
         for (auto const& cluster : max_representation) {
-            auto back_it = std::prev(cluster.end());
-            for (auto p = cluster.begin(); p != back_it; ++p) {
-                for (auto q = std::next(p); q != cluster.end(); ++q) {
-                    IdentifierSet const& id_set1 = identifier_sets.at(*p);
-                    IdentifierSet const& id_set2 = identifier_sets.at(*q);
-                    agree_sets.insert(id_set1.Intersect(id_set2));
-                }
+            clusters.push_back(&cluster);
+        }
+        return clusters;
+    }();
+    auto const intersect_cluster = [this, &identifier_sets, &clusters, percent_per_cluster](
+                                           size_t cluster_index, SetOfAgreeSets& agree_sets) {
+        std::vector<int> const& cluster = *clusters[cluster_index];
+        vector<IdentifierSet const*> cluster_id_sets;
+        cluster_id_sets.reserve(cluster.size());
+        for (int tuple_index : cluster) {
+            cluster_id_sets.push_back(&identifier_sets.at(tuple_index));
+        }
+        for (auto p = cluster_id_sets.begin(); p != cluster_id_sets.end(); ++p) {
+            for (auto q = std::next(p); q != cluster_id_sets.end(); ++q) {
+                agree_sets.insert((*p)->Intersect(**q));
             }
-            AddProgress(percent_per_cluster);
         }
-    }
+        return percent_per_cluster;
+    };
 
-    return agree_sets;
+    return CollectAgreeSets(clusters.size(), config_.threads_num, intersect_cluster,
+                            [this](double progress) { AddProgress(progress); });
 }
 
 AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAsUsingMcAndGetAgreeSets() const {
@@ -29,6 +29,9 @@ enum class AgreeSetsGenMethod {
                                *     set of ids of the already added tuples is used.
                                *  3. Iterates over all pairs of identifier sets from vector.
                                *  4. Gets agree set for current pair by intersecting.
+                               *  Steps 3-4 are performed by config_.threads_num threads, each
+                               *  thread intersects one identifier set with all of the following
+                               *  ones at a time and collects agree sets into its own set.
                                */
     kUsingMapOfIDSets,        /*< Metanome approach.
                                *  Generates agree sets using identifier sets.
@@ -41,6 +44,9 @@ enum class AgreeSetsGenMethod {
                                *     of maximal representation.
                                *  4. Gets agree set for current pair of tuples by intersecting
                                *     their identifier sets.
+                               *  Steps 3-4 are performed by config_.threads_num threads, each
+                               *  thread processes one cluster at a time and collects agree sets
+                               *  into its own set.
                                */
     kUsingGetAgreeSet,        /*< The most naive (so the slowest) way to generate agree sets.
                                *  Generates agree set for all pairs of tuples that
@@ -4,12 +4,28 @@
 //
 #include "column_layout_relation_data.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
+#include <numeric>
 #include <utility>
 
+#include <boost/container_hash/hash.hpp>
 #include <easylogging++.h>
 
+#include "util/row_deduplication.h"
+
+ColumnLayoutRelationData::ColumnLayoutRelationData(std::unique_ptr<RelationalSchema> schema,
+                                                   std::vector<ColumnData> column_data,
+                                                   std::vector<size_t> row_weights) noexcept
+    : RelationData(std::move(schema), std::move(column_data)),
+      row_weights_(std::move(row_weights)) {
+    for (size_t weight : row_weights_) {
+        original_rows_num_ += weight;
+        duplicate_pairs_num_ += CountPairs(weight);
+    }
+}
+
 std::vector<int> ColumnLayoutRelationData::GetTuple(int tuple_index) const {
     int num_columns = schema_->GetNumColumns();
     std::vector<int> tuple = std::vector<int>(num_columns);
@@ -19,8 +35,69 @@ std::vector<int> ColumnLayoutRelationData::GetTuple(int tuple_index) const {
     return tuple;
 }
 
+unsigned long long ColumnLayoutRelationData::GetNumAgreeingTuplePairs(
+        model::PositionListIndex const& pli) const {
+    if (!IsDeduplicated()) {
+        return pli.GetNepAsLong();
+    }
+    // a row agrees with its collapsed copies whether it is in a cluster or not
+    unsigned long long pairs_num = duplicate_pairs_num_;
+    for (model::PositionListIndex::Cluster const& cluster : pli.GetIndex()) {
+        unsigned long long cluster_weight = 0;
+        for (int row : cluster) {
+            cluster_weight += row_weights_[row];
+            pairs_num -= CountPairs(row_weights_[row]);
+        }
+        pairs_num += CountPairs(cluster_weight);
+    }
+    return pairs_num;
+}
+
+std::vector<size_t> ColumnLayoutRelationData::CollapseDuplicateRows(
+        std::vector<std::vector<int>>& column_vectors, bool is_null_eq_null, unsigned threads_num) {
+    if (!is_null_eq_null) {
+        // every NULL gets its own id for a while, so the rows holding NULLs are never equal
+        int next_null_id = kNullValueId;
+        for (std::vector<int>& column : column_vectors) {
+            for (int& value_id : column) {
+                if (value_id == kNullValueId) value_id = next_null_id--;
+            }
+        }
+    }
+
+    auto const hash = [&column_vectors](size_t row) {
+        size_t row_hash = 0;
+        for (std::vector<int> const& column : column_vectors) {
+            boost::hash_combine(row_hash, column[row]);
+        }
+        return row_hash;
+    };
+    auto const equal = [&column_vectors](size_t first, size_t second) {
+        return std::all_of(column_vectors.begin(), column_vectors.end(),
+                           [first, second](std::vector<int> const& column) {
+                               return column[first] == column[second];
+                           });
+    };
+    util::DeduplicatedRows deduplicated =
+            util::DeduplicateRows(column_vectors.front().size(), hash, equal, threads_num);
+
+    for (std::vector<int>& column : column_vectors) {
+        std::vector<int> kept_values;
+        kept_values.reserve(deduplicated.kept_rows.size());
+        for (size_t row : deduplicated.kept_rows) {
+            kept_values.push_back(std::max(column[row], kNullValueId));
+        }
+        column = std::move(kept_values);
+    }
+    LOG(DEBUG) << "Kept " << column_vectors.front().size() << " distinct rows out of "
+               << std::accumulate(deduplicated.weights.begin(), deduplicated.weights.end(),
+                                  size_t{0});
+    return std::move(deduplicated.weights);
+}
+
 std::unique_ptr<ColumnLayoutRelationData> ColumnLayoutRelationData::CreateFrom(
-        model::IDatasetStream& data_stream, bool is_null_eq_null) {
+        model::IDatasetStream& data_stream, bool is_null_eq_null, bool deduplicate_rows,
+        unsigned threads_num) {
     auto schema = std::make_unique<RelationalSchema>(data_stream.GetRelationName());
     std::unordered_map<std::string, int> value_dictionary;
     int next_value_id = 1;
@@ -57,6 +134,11 @@ std::unique_ptr<ColumnLayoutRelationData> ColumnLayoutRelationData::CreateFrom(
         }
     }
 
+    std::vector<size_t> row_weights;
+    if (deduplicate_rows && num_columns != 0) {
+        row_weights = CollapseDuplicateRows(column_vectors, is_null_eq_null, threads_num);
+    }
+
     std::vector<ColumnData> column_data;
     for (size_t i = 0; i < num_columns; ++i) {
         auto column = Column(schema.get(), data_stream.GetColumnName(i), i);
@@ -67,5 +149,6 @@ std::unique_ptr<ColumnLayoutRelationData> ColumnLayoutRelationData::CreateFrom(
 
     schema->Init();
 
-    return std::make_unique<ColumnLayoutRelationData>(std::move(schema), std::move(column_data));
+    return std::make_unique<ColumnLayoutRelationData>(std::move(schema), std::move(column_data),
+                                                      std::move(row_weights));
 }
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 #include <vector>
 
 #include "column_data.h"
@@ -14,11 +15,31 @@
 #include "relational_schema.h"
 
 class ColumnLayoutRelationData final : public RelationData {
+private:
+    // row_weights_[i] is the number of rows of the table equal to the i-th row, empty if the
+    // duplicate rows were not collapsed
+    std::vector<size_t> row_weights_;
+    size_t original_rows_num_ = 0;
+    // number of the tuple pairs of the table whose rows were collapsed into one
+    unsigned long long duplicate_pairs_num_ = 0;
+
+    static unsigned long long CountPairs(unsigned long long rows_num) {
+        return rows_num * (rows_num - 1) / 2;
+    }
+
+    // Leaves only the first occurrence of every row in the columns, returns the row weights
+    static std::vector<size_t> CollapseDuplicateRows(std::vector<std::vector<int>>& column_vectors,
+                                                     bool is_null_eq_null, unsigned threads_num);
+
 public:
     static constexpr int kNullValueId = -1;
 
     using RelationData::AbstractRelationData;
 
+    ColumnLayoutRelationData(std::unique_ptr<RelationalSchema> schema,
+                             std::vector<ColumnData> column_data,
+                             std::vector<size_t> row_weights) noexcept;
+
     [[nodiscard]] size_t GetNumRows() const final {
         if (column_data_.empty()) {
             return 0;
@@ -28,6 +49,43 @@ public:
 
     [[nodiscard]] std::vector<int> GetTuple(int tuple_index) const;
 
+    // Whether the duplicate rows of the table were collapsed, every row has a weight then
+    [[nodiscard]] bool IsDeduplicated() const noexcept {
+        return !row_weights_.empty();
+    }
+
+    [[nodiscard]] std::vector<size_t> const& GetRowWeights() const noexcept {
+        return row_weights_;
+    }
+
+    // Number of rows of the table equal to the row, 1 if the duplicates were not collapsed
+    [[nodiscard]] size_t GetRowWeight(size_t row) const {
+        return IsDeduplicated() ? row_weights_[row] : 1;
+    }
+
+    // Number of rows of the table before its duplicate rows were collapsed
+    [[nodiscard]] size_t GetNumOriginalRows() const {
+        return IsDeduplicated() ? original_rows_num_ : GetNumRows();
+    }
+
+    [[nodiscard]] unsigned long long GetNumOriginalTuplePairs() const {
+        return CountPairs(GetNumOriginalRows());
+    }
+
+    /* Number of the tuple pairs of the table before deduplication that agree on the columns of
+     * the PLI, i.e. the PLI's NEP with the row weights taken into account. The error measures
+     * count tuple pairs with it, so they are the same whether the duplicates were collapsed.
+     */
+    [[nodiscard]] unsigned long long GetNumAgreeingTuplePairs(
+            model::PositionListIndex const& pli) const;
+
+    /* With deduplicate_rows the rows equal to an earlier row are dropped and the rows get
+     * weights. If NULLs are not equal to each other, the rows holding a NULL are never merged,
+     * since they do not agree with their copies. Rows are hashed by threads_num threads, 0 means
+     * all the hardware threads.
+     */
     static std::unique_ptr<ColumnLayoutRelationData> CreateFrom(model::IDatasetStream& data_stream,
-                                                                bool is_null_eq_null);
+                                                                bool is_null_eq_null,
+                                                                bool deduplicate_rows = false,
+                                                                unsigned threads_num = 1);
 };
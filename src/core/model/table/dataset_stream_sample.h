@@ -0,0 +1,82 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "dataset_stream_wrapper.h"
+#include "idataset_stream.h"
+
+namespace model {
+
+///
+/// \brief A dataset stream that yields a uniform random sample of the rows of the original
+///        dataset stream, in their original order.
+///
+/// \note The whole original stream is read once on construction (reservoir sampling), only the
+///       sampled rows are kept in memory.
+///
+template <typename DatasetStream = std::shared_ptr<IDatasetStream>>
+class DatasetStreamSample final : public DatasetStreamWrapper<DatasetStream> {
+public:
+    using Row = typename DatasetStreamWrapper<DatasetStream>::Row;
+
+private:
+    std::vector<Row> sample_;
+    std::size_t next_row_ = 0;
+    std::size_t stream_rows_num_ = 0;
+
+    void DrawSample(std::size_t sample_size, std::mt19937::result_type seed) {
+        std::mt19937 gen(seed);
+        std::vector<std::pair<std::size_t, Row>> reservoir;
+        reservoir.reserve(sample_size);
+        for (; this->stream_->HasNextRow(); ++stream_rows_num_) {
+            Row row = this->stream_->GetNextRow();
+            if (reservoir.size() < sample_size) {
+                reservoir.emplace_back(stream_rows_num_, std::move(row));
+                continue;
+            }
+            std::uniform_int_distribution<std::size_t> dist(0, stream_rows_num_);
+            std::size_t const index = dist(gen);
+            if (index < sample_size) reservoir[index] = {stream_rows_num_, std::move(row)};
+        }
+
+        std::sort(reservoir.begin(), reservoir.end(),
+                  [](auto const& lhs, auto const& rhs) { return lhs.first < rhs.first; });
+        sample_.reserve(reservoir.size());
+        for (auto& [_, row] : reservoir) {
+            sample_.push_back(std::move(row));
+        }
+    }
+
+public:
+    template <typename Stream = DatasetStream>
+    explicit DatasetStreamSample(Stream&& stream, std::size_t sample_size,
+                                 std::mt19937::result_type seed)
+        : DatasetStreamWrapper<DatasetStream>(std::forward<Stream>(stream)) {
+        DrawSample(sample_size, seed);
+    }
+
+    Row GetNextRow() override {
+        return sample_[next_row_++];
+    }
+
+    [[nodiscard]] bool HasNextRow() const override {
+        return next_row_ < sample_.size();
+    }
+
+    /// Starts over the same sample, the original stream is not read again.
+    void Reset() override {
+        next_row_ = 0;
+    }
+
+    /// Number of rows of the original stream the sample was drawn from.
+    [[nodiscard]] std::size_t GetStreamRowsNum() const noexcept {
+        return stream_rows_num_;
+    }
+};
+
+}  // namespace model
@@ -1,82 +1,101 @@
 #include "model/table/dynamic_position_list_index.h"
 
 #include <algorithm>
-#include <chrono>
-#include <cmath>
-#include <map>
-#include <memory>
-#include <stack>
-#include <utility>
-
-#include <boost/dynamic_bitset.hpp>
-#include <easylogging++.h>
-
-namespace {
-// O(cluster)
-void ProcessDeleteToCluster(model::DynamicPositionListIndex::Cluster& cluster,
-                            std::unordered_set<size_t>& deleted_records_ids) {
-    auto records_pred = [&](size_t element) {
-        return static_cast<bool>(deleted_records_ids.erase(element));
-    };
-    std::erase_if(cluster, records_pred);
-}
-
-}  // namespace
+#include <cassert>
 
 namespace model {
 
-DynamicPositionListIndex::DynamicPositionListIndex(ClusterCollection clusters, size_t size,
-                                                   size_t relation_size)
-    : clusters_(std::move(clusters)),
-      valid_records_number_(size),
-      next_record_id_(relation_size),
-      probing_table_cache_() {
-    ForceCacheProbingTable();
-}
-
 std::unique_ptr<DynamicPositionListIndex> DynamicPositionListIndex::CreateFor(
-        std::vector<ClusterValue>& records) {
-    ClusterCollection clusters;
+        std::vector<ClusterValue> const& records) {
+    auto pli = std::make_unique<DynamicPositionListIndex>();
+    pli->probing_table_.resize(records.size());
+    pli->cluster_positions_.resize(records.size());
     for (size_t record_id = 0; record_id < records.size(); ++record_id) {
-        ClusterValue const& value = records[record_id];
-        clusters[value].push_back(record_id);
+        pli->AddRecord(record_id, records[record_id]);
     }
+    return pli;
+}
 
-    return std::make_unique<DynamicPositionListIndex>(std::move(clusters), records.size(),
-                                                      records.size());
+auto DynamicPositionListIndex::FindCluster(std::uint64_t hash, int const* value) const
+        -> std::optional<ClusterId> {
+    auto [first, last] = cluster_ids_.equal_range(hash);
+    for (; first != last; ++first) {
+        if (std::equal(value, value + width_, GetValueData(first->second))) return first->second;
+    }
+    return std::nullopt;
 }
 
-void DynamicPositionListIndex::UpdateWith(
-        std::vector<std::pair<std::optional<size_t>, ClusterValue>>& inserted_records,
-        std::unordered_set<size_t> deleted_records_ids) {
-    if (inserted_records.empty() && deleted_records_ids.empty()) {
-        return;
+auto DynamicPositionListIndex::GetOrAddCluster(int const* value) -> ClusterId {
+    std::uint64_t const hash = HashOf(value);
+    if (std::optional<ClusterId> found = FindCluster(hash, value)) return *found;
+    ClusterId id;
+    if (free_cluster_ids_.empty()) {
+        id = clusters_.size();
+        clusters_.emplace_back();
+        cluster_values_.insert(cluster_values_.end(), value, value + width_);
+    } else {
+        id = free_cluster_ids_.back();
+        free_cluster_ids_.pop_back();
+        std::copy(value, value + width_, cluster_values_.begin() + id * width_);
     }
-    valid_records_number_ -= deleted_records_ids.size();
-    for (auto it = clusters_.begin(); it != clusters_.end();) {
-        auto& [cluster_value, cluster] = *it;
-        ProcessDeleteToCluster(cluster, deleted_records_ids);
+    cluster_ids_.emplace(hash, id);
+    ++num_clusters_;
+    return id;
+}
+
+void DynamicPositionListIndex::AddRecord(size_t record_id, ClusterValue const& value) {
+    if (clusters_.empty()) width_ = value.size();
+    assert(value.size() == width_);
+    ClusterId const id = GetOrAddCluster(value.data());
+    cluster_positions_[record_id] = clusters_[id].size();
+    clusters_[id].push_back(record_id);
+    probing_table_[record_id] = id;
+    ++valid_records_number_;
+}
+
+void DynamicPositionListIndex::UpdateWith(
+        std::vector<std::pair<std::optional<size_t>, ClusterValue>> const& inserted_records,
+        std::unordered_set<size_t> const& deleted_records_ids) {
+    for (size_t record_id : deleted_records_ids) {
+        ClusterId& id = probing_table_[record_id];
+        if (id == kDeletedRow) continue;
+        // the last record of the cluster takes the place of the deleted one
+        Cluster& cluster = clusters_[id];
+        unsigned const position = cluster_positions_[record_id];
+        cluster[position] = cluster.back();
+        cluster_positions_[cluster[position]] = position;
+        cluster.pop_back();
         if (cluster.empty()) {
-            it = clusters_.erase(it);
-        } else {
-            ++it;
+            cluster.shrink_to_fit();
+            auto [first, last] = cluster_ids_.equal_range(HashOf(GetValueData(id)));
+            cluster_ids_.erase(std::find_if(first, last, [id](auto const& hash_and_id) {
+                return hash_and_id.second == id;
+            }));
+            free_cluster_ids_.push_back(id);
+            --num_clusters_;
         }
-        if (deleted_records_ids.empty()) break;
+        id = kDeletedRow;
+        --valid_records_number_;
     }
-    for (auto const& [encoded_value_opt, cluster_value] : inserted_records) {
-        if (encoded_value_opt.has_value()) {
-            clusters_[cluster_value].emplace_back(*encoded_value_opt);
-        } else {
-            clusters_[cluster_value].emplace_back(next_record_id_++);
-            ++valid_records_number_;
+
+    for (auto const& [record_id, value] : inserted_records) {
+        size_t const id = record_id.value_or(probing_table_.size());
+        if (id >= probing_table_.size()) {
+            probing_table_.resize(id + 1, kDeletedRow);
+            cluster_positions_.resize(id + 1);
         }
+        AddRecord(id, value);
     }
+}
 
-    ForceCacheProbingTable();
+auto DynamicPositionListIndex::FindCluster(ClusterValue const& value) const
+        -> std::optional<ClusterId> {
+    if (value.size() != width_) return std::nullopt;
+    return FindCluster(HashOf(value.data()), value.data());
 }
 
 std::unordered_map<int, unsigned> DynamicPositionListIndex::CreateFrequencies(
-        Cluster const& cluster, std::vector<int> const& probing_table) {
+        Cluster const& cluster, std::vector<ClusterId> const& probing_table) {
     std::unordered_map<int, unsigned> frequencies;
 
     for (int index : cluster) {
@@ -86,26 +105,9 @@ std::unordered_map<int, unsigned> DynamicPositionListIndex::CreateFrequencies(
     return frequencies;
 }
 
-std::shared_ptr<std::vector<int> const> DynamicPositionListIndex::CalculateAndGetProbingTable()
-        const {
-    // cluster values cache: used in the Probe() method
-    cluster_values_cache_.clear();
-    std::vector<int> probing_table = std::vector<int>(next_record_id_);
-    int next_cluster_id = 0;
-    for (auto& [value, cluster] : clusters_) {
-        int value_id = next_cluster_id++;
-        for (int position : cluster) {
-            probing_table[position] = value_id;
-        }
-        cluster_values_cache_.emplace_back(value);
-    }
-
-    return std::make_shared<std::vector<int>>(probing_table);
-}
-
 std::unique_ptr<DynamicPositionListIndex> DynamicPositionListIndex::Intersect(
         DynamicPositionListIndex const* that) const {
-    assert(this->next_record_id_ == that->next_record_id_);
+    assert(this->GetRelationSize() == that->GetRelationSize());
 
     if (this->valid_records_number_ > that->valid_records_number_) {
         return that->Probe(this);
@@ -116,45 +118,47 @@ std::unique_ptr<DynamicPositionListIndex> DynamicPositionListIndex::Intersect(
 
 std::unique_ptr<DynamicPositionListIndex> DynamicPositionListIndex::Probe(
         DynamicPositionListIndex const* that) const {
-    std::shared_ptr<std::vector<int> const> probing_table = that->GetCachedProbingTable();
-    std::vector<ClusterValue> const& cluster_values = that->GetClusterValuesCache();
-    assert(this->next_record_id_ == probing_table->size());
-    ClusterCollection new_clusters;
-    unsigned int new_size = 0;
-
-    std::unordered_map<int, std::pair<ClusterValue, Cluster>> partial_clusters;
-
-    for (auto const& [value, cluster] : clusters_) {
-        for (int position : cluster) {
-            int probing_table_value_id = (*probing_table)[position];
-            auto partial_cluster = partial_clusters.find(probing_table_value_id);
-            if (partial_cluster != partial_clusters.end()) {
-                auto& [key, positions] = partial_cluster->second;
-                positions.emplace_back(position);
-            } else {
-                ClusterValue key = value;
-                auto& cluster_value = cluster_values[probing_table_value_id];
-                key.insert(key.end(), cluster_value.begin(), cluster_value.end());
-                partial_clusters[probing_table_value_id] = {std::move(key), {position}};
+    std::vector<ClusterId> const& probing_table = that->probing_table_;
+    assert(probing_table_.size() == probing_table.size());
+    auto result = std::make_unique<DynamicPositionListIndex>();
+    result->width_ = width_ + that->width_;
+    result->probing_table_.assign(probing_table.size(), kDeletedRow);
+    result->cluster_positions_.resize(probing_table.size());
+
+    // cluster id in the result of every value of that index met in the current cluster
+    std::unordered_map<ClusterId, ClusterId> partial_clusters;
+    for (ClusterId id = 0; id < static_cast<ClusterId>(clusters_.size()); ++id) {
+        for (int position : clusters_[id]) {
+            ClusterId const that_id = probing_table[position];
+            auto [it, is_new] = partial_clusters.try_emplace(that_id, result->clusters_.size());
+            if (is_new) {
+                std::vector<int>& values = result->cluster_values_;
+                values.insert(values.end(), GetValueData(id), GetValueData(id) + width_);
+                int const* that_value = that->GetValueData(that_id);
+                values.insert(values.end(), that_value, that_value + that->width_);
+                result->cluster_ids_.emplace(
+                        result->HashOf(values.data() + values.size() - result->width_),
+                        it->second);
+                result->clusters_.emplace_back();
+                ++result->num_clusters_;
             }
-        }
-
-        for (auto& [_, new_cluster] : partial_clusters) {
-            new_size += new_cluster.second.size();
-            new_clusters.emplace(std::move(new_cluster));
+            Cluster& new_cluster = result->clusters_[it->second];
+            result->cluster_positions_[position] = new_cluster.size();
+            new_cluster.push_back(position);
+            result->probing_table_[position] = it->second;
         }
         partial_clusters.clear();
     }
-
-    return std::make_unique<DynamicPositionListIndex>(std::move(new_clusters), new_size,
-                                                      next_record_id_);
+    result->valid_records_number_ = valid_records_number_;
+    return result;
 }
 
 std::string DynamicPositionListIndex::ToString() const {
     std::string res = "[";
-    for (auto& cluster : clusters_) {
+    for (Cluster const& cluster : clusters_) {
+        if (cluster.empty()) continue;
         res.push_back('[');
-        for (int v : cluster.second) {
+        for (int v : cluster) {
             res.append(std::to_string(v) + ",");
         }
         if (res.find(',') != std::string::npos) res.erase(res.find_last_of(','));
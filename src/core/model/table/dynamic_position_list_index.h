@@ -1,75 +1,118 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
-#include "model/table/column.h"
-
-class ColumnLayoutRelationData;
+namespace model {
 
-template <>
-struct std::hash<std::vector<int>> {
-    std::size_t operator()(std::vector<int> const& vec) const noexcept {
-        std::size_t secret = vec.size();
-        std::size_t hash = (1 << secret) ^ secret;
-        for (auto const& el : vec) {
-            hash ^= (el << secret) - (hash >> secret);
+/* Hash of a dictionary-encoded cluster key, every value id is mixed in with a multiply-xorshift
+ * step so keys differing in one position or in the order of their values spread well */
+struct ClusterValueHash {
+    static std::uint64_t Hash(int const* first, int const* last) noexcept {
+        std::uint64_t hash = 0x9E3779B97F4A7C15ULL ^ static_cast<std::uint64_t>(last - first);
+        for (; first != last; ++first) {
+            hash ^= static_cast<std::uint32_t>(*first);
+            hash *= 0xBF58476D1CE4E5B9ULL;
+            hash ^= hash >> 31;
         }
         return hash;
     }
+
+    std::size_t operator()(std::vector<int> const& value) const noexcept {
+        return static_cast<std::size_t>(Hash(value.data(), value.data() + value.size()));
+    }
 };
 
-namespace model {
+/* Position list index of a table changed by batches of inserts, updates and deletes. Clusters are
+ * stored flat and addressed by dense ids, the probing table maps every row to the id of its
+ * cluster and marks deleted rows, and every row knows its place in its cluster, so a batch costs
+ * time in its own size, not in the size of the table. Records in a cluster are not ordered. */
 class DynamicPositionListIndex {
 public:
     using Cluster = std::vector<int>;
+    /* Dictionary-encoded values of the indexed columns, all keys of an index have equal width */
     using ClusterValue = std::vector<int>;
-    using ClusterCollection = std::unordered_map<ClusterValue, Cluster>;
+    using ClusterId = int;
+
+    /* Probing table entry of a deleted row */
+    static constexpr ClusterId kDeletedRow = -1;
 
 private:
-    ClusterCollection clusters_;
-    size_t valid_records_number_;
-    size_t next_record_id_;
+    // clusters emptied by deletes stay as empty slots and are reused by the next new value
+    std::vector<Cluster> clusters_;
+    // values of every cluster slot, width_ ids per slot, stored flat so a key costs no allocation
+    std::vector<int> cluster_values_;
+    size_t width_ = 0;
+    // cluster ids by the 64-bit hash of their values, equal hashes are told apart by the values
+    std::unordered_multimap<std::uint64_t, ClusterId> cluster_ids_;
+    std::vector<ClusterId> free_cluster_ids_;
+    std::vector<ClusterId> probing_table_;
+    // index of every record in its cluster, deletes swap the last record of the cluster in
+    std::vector<unsigned> cluster_positions_;
+    size_t num_clusters_ = 0;
+    size_t valid_records_number_ = 0;
+
+    int const* GetValueData(ClusterId id) const {
+        return cluster_values_.data() + id * width_;
+    }
 
-    std::shared_ptr<std::vector<int> const> probing_table_cache_;
-    mutable std::vector<ClusterValue> cluster_values_cache_;
+    std::uint64_t HashOf(int const* value) const {
+        return ClusterValueHash::Hash(value, value + width_);
+    }
+
+    std::optional<ClusterId> FindCluster(std::uint64_t hash, int const* value) const;
+    ClusterId GetOrAddCluster(int const* value);
+    void AddRecord(size_t record_id, ClusterValue const& value);
 
 public:
-    DynamicPositionListIndex(ClusterCollection clusters, size_t size, size_t relation_size);
+    DynamicPositionListIndex() = default;
 
     static std::unique_ptr<DynamicPositionListIndex> CreateFor(
-            std::vector<std::vector<int>>& records);
+            std::vector<ClusterValue> const& records);
 
-    void UpdateWith(std::vector<std::pair<std::optional<size_t>, ClusterValue>>& inserted_records,
-                    std::unordered_set<size_t> deleted_records_ids);
+    /* Applies a batch: deleted records leave their clusters first, then every record is added,
+     * under its id if given, under the next free id otherwise. An update is a deletion and an
+     * insertion of the same id. */
+    void UpdateWith(std::vector<std::pair<std::optional<size_t>, ClusterValue>> const&
+                            inserted_records,
+                    std::unordered_set<size_t> const& deleted_records_ids);
 
     static std::unordered_map<int, unsigned> CreateFrequencies(
-            Cluster const& cluster, std::vector<int> const& probing_table);
+            Cluster const& cluster, std::vector<ClusterId> const& probing_table);
 
-    // Calculates PT -- heavy operation
-    std::shared_ptr<std::vector<int> const> CalculateAndGetProbingTable() const;
+    /* Cluster id of every record ever indexed, kDeletedRow for the deleted ones */
+    std::vector<ClusterId> const& GetProbingTable() const noexcept {
+        return probing_table_;
+    }
 
-    // Returns cached PT or nullptr, if PT has not been cached yet
-    std::shared_ptr<std::vector<int> const> GetCachedProbingTable() const {
-        return probing_table_cache_;
-    };
+    /* All cluster slots, including the empty ones */
+    std::vector<Cluster> const& GetClusters() const noexcept {
+        return clusters_;
+    }
 
-    // Calculates PT and cache it
-    void ForceCacheProbingTable() {
-        probing_table_cache_ = CalculateAndGetProbingTable();
-    };
+    Cluster const& GetCluster(ClusterId id) const {
+        return clusters_[id];
+    }
 
-    ClusterCollection const& GetClusters() const noexcept {
-        return clusters_;
-    };
+    ClusterValue GetClusterValue(ClusterId id) const {
+        return ClusterValue(GetValueData(id), GetValueData(id) + width_);
+    }
 
-    /* If you use this method and change index in any way, all other methods will become invalid */
-    ClusterCollection& GetClusters() noexcept {
-        return clusters_;
+    /* Returns the id of the cluster with the given value, if such a cluster is not empty */
+    std::optional<ClusterId> FindCluster(ClusterValue const& value) const;
+
+    bool IsRecordDeleted(size_t record_id) const {
+        return probing_table_[record_id] == kDeletedRow;
     }
 
     unsigned int GetNumCluster() const {
-        return clusters_.size();
+        return num_clusters_;
     }
 
     unsigned int GetSize() const {
@@ -77,11 +120,7 @@ public:
     }
 
     unsigned int GetRelationSize() const {
-        return next_record_id_;
-    }
-
-    std::vector<ClusterValue> const& GetClusterValuesCache() const {
-        return cluster_values_cache_;
+        return probing_table_.size();
     }
 
     std::unique_ptr<DynamicPositionListIndex> Intersect(DynamicPositionListIndex const* that) const;
@@ -0,0 +1,74 @@
+#include "model/table/dynamic_table_data.h"
+
+namespace model {
+
+void DynamicTableData::CheckInsertBatch(config::InputTable const& insert_batch) const {
+    if (insert_batch == nullptr || !insert_batch->HasNextRow()) {
+        return;
+    }
+    if (insert_batch->GetNumberOfColumns() != column_names_.size()) {
+        throw config::ConfigurationError(
+                "Schema mismatch: insert statements must have the same number of columns as the "
+                "input table");
+    }
+    for (size_t i = 0; i < column_names_.size(); ++i) {
+        if (insert_batch->GetColumnName(i) != column_names_[i]) {
+            throw config::ConfigurationError(
+                    "Schema mismatch: insert statements' column names must match the input table");
+        }
+    }
+}
+
+void DynamicTableData::CheckDeleteBatch(std::unordered_set<size_t> const& delete_batch) const {
+    for (size_t id : delete_batch) {
+        if (!IsRowIndexValid(id)) {
+            throw config::ConfigurationError("Attempt to delete a non-existing row");
+        }
+    }
+}
+
+void DynamicTableData::CheckUpdateBatch(config::InputTable const& update_batch) const {
+    if (update_batch == nullptr || !update_batch->HasNextRow()) {
+        return;
+    }
+    if (update_batch->GetNumberOfColumns() != column_names_.size() + 1) {
+        throw config::ConfigurationError(
+                "Schema mismatch: update statements must have the number of columns one more "
+                "than the input table");
+    }
+    for (size_t i = 0; i < column_names_.size(); ++i) {
+        if (update_batch->GetColumnName(i + 1) != column_names_[i]) {
+            throw config::ConfigurationError(
+                    "Schema mismatch: update statements column names, except of first one, must "
+                    "match the input table");
+        }
+    }
+    std::unordered_set<size_t> rows_to_update;
+    while (update_batch->HasNextRow()) {
+        std::vector<std::string> const row = update_batch->GetNextRow();
+        size_t id = std::stoull(row.front());
+        if (!IsRowIndexValid(id)) {
+            throw config::ConfigurationError("Attempt to update a non-existing row");
+        }
+        if (!rows_to_update.emplace(id).second) {
+            throw config::ConfigurationError("Update statements have duplicates");
+        }
+    }
+    update_batch->Reset();
+}
+
+std::vector<size_t> DynamicTableData::GetUpdatedRowIndices(
+        config::InputTable const& update_batch) const {
+    std::vector<size_t> row_indices;
+    if (update_batch == nullptr) return row_indices;
+    while (update_batch->HasNextRow()) {
+        std::vector<std::string> const row = update_batch->GetNextRow();
+        // Update() skips such rows as well
+        if (row.size() != columns_.size() + 1) continue;
+        row_indices.push_back(std::stoull(row.front()));
+    }
+    update_batch->Reset();
+    return row_indices;
+}
+
+}  // namespace model
@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -12,51 +13,94 @@
 
 namespace model {
 
+/* Table changed by batches of CRUD operations. Cells are dictionary-encoded, every distinct string
+ * is stored once, and deleted rows are only marked in a bitmap, their ids are never reused. */
 struct DynamicTableData {
 private:
-    std::vector<std::vector<std::string>> columns_;
-    std::unordered_set<size_t> deleted_rows_{};
+    std::vector<std::string> column_names_;
+    std::vector<std::vector<int>> columns_;
+    std::vector<std::string> values_;
+    std::unordered_map<std::string, int> value_ids_;
+    std::vector<bool> is_row_deleted_;
+    size_t num_rows_deleted_ = 0;
+
+    int EncodeValue(std::string&& value) {
+        auto [it, is_new] = value_ids_.try_emplace(value, values_.size());
+        if (is_new) {
+            values_.push_back(std::move(value));
+        }
+        return it->second;
+    }
+
+    void AppendRow(std::vector<std::string>& row, size_t first_value_index) {
+        for (size_t i = first_value_index; i < row.size(); ++i) {
+            columns_[i - first_value_index].push_back(EncodeValue(std::move(row[i])));
+        }
+        is_row_deleted_.push_back(false);
+    }
 
 public:
     DynamicTableData(IDatasetStream& input_table) {
         columns_.resize(input_table.GetNumberOfColumns());
+        for (size_t i = 0; i < columns_.size(); ++i) {
+            column_names_.push_back(input_table.GetColumnName(i));
+        }
         while (input_table.HasNextRow()) {
             std::vector<std::string> row = input_table.GetNextRow();
             if (row.size() != columns_.size()) {
                 LOG(DEBUG) << "Got input table row with " << row.size() << " size, skipping...";
                 continue;
             }
-            for (size_t i = 0; i < row.size(); ++i) {
-                columns_[i].push_back(std::move(row[i]));
-            }
+            AppendRow(row, 0);
         };
     }
 
     size_t GetNumRowsActual() const {
-        return columns_[0].size() - deleted_rows_.size();
+        return GetNumRowsTotal() - num_rows_deleted_;
     }
 
     size_t GetNumRowsTotal() const {
-        return columns_[0].size();
+        return is_row_deleted_.size();
     }
 
-    std::string const& GetValue(size_t row_index, size_t col_index) const {
+    /* Returns the dictionary id of the cell, equal cells of any columns have equal ids */
+    int GetValueId(size_t row_index, size_t col_index) const {
         assert(col_index < columns_.size() && row_index < columns_[col_index].size());
         return columns_[col_index][row_index];
     }
 
-    bool IsRowIndexValid(size_t row_index) {
-        return !(deleted_rows_.contains(row_index) || row_index >= GetNumRowsTotal());
+    std::string const& GetValue(size_t row_index, size_t col_index) const {
+        return values_[GetValueId(row_index, col_index)];
+    }
+
+    /* Empty cells are nulls */
+    bool IsNull(size_t row_index, size_t col_index) const {
+        return GetValue(row_index, col_index).empty();
+    }
+
+    bool IsRowIndexValid(size_t row_index) const {
+        return row_index < GetNumRowsTotal() && !is_row_deleted_[row_index];
     }
 
-    void Update(config::InputTable insert_data, config::InputTable update_data,
-                std::unordered_set<size_t> const& delete_data) {
+    /* Value checks of the CRUD options of the algorithms working on the table. They throw
+     * config::ConfigurationError if the batch does not match the schema or refers to a row that
+     * is not in the table. The update batch is read through and reset. */
+    void CheckInsertBatch(config::InputTable const& insert_batch) const;
+    void CheckDeleteBatch(std::unordered_set<size_t> const& delete_batch) const;
+    void CheckUpdateBatch(config::InputTable const& update_batch) const;
+
+    /* Returns the ids of the rows the update batch changes without applying it. The batch is
+     * read through and reset. */
+    std::vector<size_t> GetUpdatedRowIndices(config::InputTable const& update_batch) const;
+
+    /* Applies the batch and returns the ids of the updated rows, in the order of update_data.
+     * The inserted rows get the ids following the previous GetNumRowsTotal(). */
+    std::vector<size_t> Update(config::InputTable insert_data, config::InputTable update_data,
+                               std::unordered_set<size_t> const& delete_data) {
         for (size_t row_id : delete_data) {
-            for (size_t i = 0; i < columns_.size(); ++i) {
-                columns_[i][row_id] = {};
-            }
-            deleted_rows_.emplace(row_id);
+            is_row_deleted_[row_id] = true;
         }
+        num_rows_deleted_ += delete_data.size();
         if (insert_data != nullptr) {
             while (insert_data->HasNextRow()) {
                 std::vector<std::string> row = insert_data->GetNextRow();
@@ -65,11 +109,10 @@ public:
                                << " size, skipping...";
                     continue;
                 }
-                for (size_t i = 0; i < row.size(); ++i) {
-                    columns_[i].push_back(std::move(row[i]));
-                }
+                AppendRow(row, 0);
             }
         }
+        std::vector<size_t> updated_rows;
         if (update_data != nullptr) {
             while (update_data->HasNextRow()) {
                 std::vector<std::string> row = update_data->GetNextRow();
@@ -79,16 +122,18 @@ public:
                     continue;
                 }
                 size_t row_id = std::stoull(row.front());
-                if (deleted_rows_.contains(row_id)) {
+                if (is_row_deleted_[row_id]) {
                     throw config::ConfigurationError(
                             "Attempt to update a deleted row during processing of update "
                             "operations");
                 }
                 for (size_t i = 1; i < row.size(); ++i) {
-                    columns_[i - 1][row_id] = std::move(row[i]);
+                    columns_[i - 1][row_id] = EncodeValue(std::move(row[i]));
                 }
+                updated_rows.push_back(row_id);
             }
         }
+        return updated_rows;
     }
 };
 
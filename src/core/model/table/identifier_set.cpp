@@ -4,24 +4,25 @@ namespace model {
 
 IdentifierSet::IdentifierSet(ColumnLayoutRelationData const* const relation, int index)
     : relation_(relation), tuple_index_(index) {
-    data_.reserve(relation_->GetNumColumns());
+    cluster_indices_.reserve(relation_->GetNumColumns());
     for (ColumnData const& col : relation_->GetColumnData()) {
-        data_.push_back({.attribute = col.GetColumn(),
-                         .cluster_index = col.GetProbingTableValue(tuple_index_)});
+        cluster_indices_.push_back(col.GetProbingTableValue(tuple_index_));
     }
 }
 
 std::string IdentifierSet::ToString() const {
-    if (data_.empty()) {
+    if (cluster_indices_.empty()) {
         return "[]";
     }
 
+    std::vector<ColumnData> const& columns_data = relation_->GetColumnData();
     std::string str = "[";
-    for (auto p = data_.begin(); p != data_.end() - 1; ++p) {
-        str += "(" + p->attribute->GetName() + ", " + std::to_string(p->cluster_index) + "), ";
+    for (size_t i = 0; i != cluster_indices_.size(); ++i) {
+        if (i != 0) str += ", ";
+        str += "(" + columns_data[i].GetColumn()->GetName() + ", " +
+               std::to_string(cluster_indices_[i]) + ")";
     }
-    str += "(" + data_.back().attribute->GetName() + ", " +
-           std::to_string(data_.back().cluster_index) + ")]";
+    str += "]";
     return str;
 }
 
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
+#include <boost/dynamic_bitset.hpp>
+
 #include "model/table/column_data.h"
 #include "model/table/column_layout_relation_data.h"
 #include "model/table/vertical.h"
@@ -11,14 +14,12 @@ namespace model {
 
 /* Class which represents the relationship between a tuple and
  * all partitions containing it. Given the tuple t, IdentifierSet
- * stores vector of <attribute, cluster_index> pairs, where `cluster_index`
- * is the index of cluster in `attribute` pli the t belongs to.
+ * stores for every attribute the index of cluster in `attribute` pli the t belongs to
+ * (0 if t is a singleton in that pli).
  * Intersection of two identifier sets is the agree set for appropriate tuples.
  * For more information check out http://www.vldb.org/pvldb/vol8/p1082-papenbrock.pdf
- * TODO: consider using Vertical + vector<int> indices
- * instead of vector<IdentitfierSetValue>. Probably it will be faster
- * but also maybe will hurt readability.
- * UPD: Did not notice any difference in perfmormance.
+ * Cluster indices are stored densely (one int per attribute), so that the intersection is a
+ * branchless element-wise comparison of two contiguous arrays, which compilers vectorize.
  */
 class IdentifierSet {
 public:
@@ -32,34 +33,30 @@ public:
     Vertical Intersect(IdentifierSet const& other) const;
 
 private:
-    struct IdentifierSetValue {
-        Column const* attribute;
-        int cluster_index;
-    };
+    using Block = boost::dynamic_bitset<>::block_type;
+    static constexpr size_t kBitsPerBlock = boost::dynamic_bitset<>::bits_per_block;
 
     ColumnLayoutRelationData const* const relation_;
-    std::vector<IdentifierSetValue> data_;
+    std::vector<int> cluster_indices_;
     int const tuple_index_;
 };
 
 inline Vertical IdentifierSet::Intersect(IdentifierSet const& other) const {
-    boost::dynamic_bitset<> intersection(relation_->GetNumColumns());
-    auto p = data_.begin();
-    auto q = other.data_.begin();
-
-    while (p != data_.end() && q != other.data_.end()) {
-        if (p->attribute->GetIndex() < q->attribute->GetIndex()) {
-            ++p;
-        } else {
-            if (q->attribute->GetIndex() == p->attribute->GetIndex() && p->cluster_index != 0 &&
-                p->cluster_index == q->cluster_index) {
-                intersection.set(p->attribute->GetIndex());
-                ++p;
-            }
-            ++q;
+    size_t const num_columns = cluster_indices_.size();
+    int const* const lhs = cluster_indices_.data();
+    int const* const rhs = other.cluster_indices_.data();
+    boost::dynamic_bitset<> intersection;
+
+    for (size_t begin = 0; begin < num_columns; begin += kBitsPerBlock) {
+        size_t const end = std::min(begin + kBitsPerBlock, num_columns);
+        Block block = 0;
+        for (size_t i = begin; i < end; ++i) {
+            block |= static_cast<Block>((lhs[i] != 0) & (lhs[i] == rhs[i])) << (i - begin);
         }
+        intersection.append(block);
     }
 
+    intersection.resize(num_columns);
     return relation_->GetSchema()->GetVertical(intersection);
 }
 
@@ -22,8 +22,8 @@
 namespace model {
 
 int const PositionListIndex::kSingletonValueId = 0;
-unsigned long long PositionListIndex::micros_ = 0;
-int PositionListIndex::intersection_count_ = 0;
+std::atomic<unsigned long long> PositionListIndex::micros_ = 0;
+std::atomic<int> PositionListIndex::intersection_count_ = 0;
 
 PositionListIndex::PositionListIndex(std::deque<std::vector<int>> index,
                                      std::vector<int> null_cluster, unsigned int size,
@@ -169,6 +169,8 @@ std::unique_ptr<PositionListIndex> PositionListIndex::Probe(
     std::vector<int> null_cluster;
 
     std::unordered_map<int, std::vector<int>> partial_index;
+    // counted locally, the shared counter is updated once per call
+    int intersection_count = 0;
 
     for (auto& positions : index_) {
         for (int position : positions) {
@@ -182,7 +184,7 @@ std::unique_ptr<PositionListIndex> PositionListIndex::Probe(
             }
             int probing_table_value_id = (*probing_table)[position];
             if (probing_table_value_id == kSingletonValueId) continue;
-            intersection_count_++;
+            intersection_count++;
             partial_index[probing_table_value_id].push_back(position);
         }
 
@@ -198,6 +200,7 @@ std::unique_ptr<PositionListIndex> PositionListIndex::Probe(
         }
         partial_index.clear();
     }
+    intersection_count_.fetch_add(intersection_count, std::memory_order_relaxed);
 
     double new_entropy = log(relation_size_) - new_key_gap / relation_size_;
     SortClusters(new_index);
@@ -209,7 +212,7 @@ std::unique_ptr<PositionListIndex> PositionListIndex::Probe(
 
 // TODO: null_cluster_ не поддерживается
 std::unique_ptr<PositionListIndex> PositionListIndex::ProbeAll(
-        Vertical const& probing_columns, ColumnLayoutRelationData& relation_data) {
+        Vertical const& probing_columns, ColumnLayoutRelationData& relation_data) const {
     assert(this->relation_size_ == relation_data.GetNumRows());
     std::deque<std::vector<int>> new_index;
     unsigned int new_size = 0;
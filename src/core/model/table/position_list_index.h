@@ -4,6 +4,7 @@
 //
 
 #pragma once
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <unordered_map>
@@ -31,7 +32,8 @@ private:
     unsigned int relation_size_;
     unsigned int original_relation_size_;
     std::shared_ptr<std::vector<int> const> probing_table_cache_;
-    unsigned int freq_ = 0;
+    // PLIs of a shared cache are requested concurrently
+    std::atomic<unsigned int> freq_ = 0;
 
     static unsigned long long CalculateNep(unsigned int num_elements) {
         return static_cast<unsigned long long>(num_elements) * (num_elements - 1) / 2;
@@ -42,8 +44,8 @@ private:
                           Vertical const& probing_columns, std::vector<int>& probe);
 
 public:
-    static int intersection_count_;
-    static unsigned long long micros_;
+    static std::atomic<int> intersection_count_;
+    static std::atomic<unsigned long long> micros_;
     static int const kSingletonValueId;
 
     PositionListIndex(std::deque<Cluster> index, Cluster null_cluster, unsigned int size,
@@ -149,7 +151,7 @@ public:
     std::unique_ptr<PositionListIndex> Probe(
             std::shared_ptr<std::vector<int> const> probing_table) const;
     std::unique_ptr<PositionListIndex> ProbeAll(Vertical const& probing_columns,
-                                                ColumnLayoutRelationData& relation_data);
+                                                ColumnLayoutRelationData& relation_data) const;
     std::string ToString() const;
 };
 
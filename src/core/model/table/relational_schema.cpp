@@ -83,10 +83,10 @@ std::unordered_set<Vertical> RelationalSchema::CalculateHittingSet(
         }
 
         for (auto& invalid_member : invalid_hitting_set_members) {
-            for (size_t corrective_column_index = vertical.GetColumnIndices().find_first();
+            for (size_t corrective_column_index = vertical.FindFirst();
                  corrective_column_index != boost::dynamic_bitset<>::npos;
                  corrective_column_index =
-                         vertical.GetColumnIndices().find_next(corrective_column_index)) {
+                         vertical.FindNext(corrective_column_index)) {
                 auto corrective_column = *GetColumn(corrective_column_index);
                 auto corrected_member =
                         invalid_member.Union(static_cast<Vertical>(corrective_column));
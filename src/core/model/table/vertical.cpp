@@ -1,106 +1,255 @@
 #include "vertical.h"
 
+#include <bit>
+#include <cassert>
 #include <utility>
 
-Vertical::Vertical(RelationalSchema const* rel_schema, boost::dynamic_bitset<> indices)
-    : column_indices_(std::move(indices)), schema_(rel_schema) {}
+#include <boost/container_hash/hash.hpp>
 
-Vertical::Vertical(Column const& col) : schema_(col.GetSchema()) {
-    column_indices_ = boost::dynamic_bitset<>(schema_->GetNumColumns());
-    column_indices_.set(col.GetIndex());
+Vertical::Vertical(RelationalSchema const* rel_schema, boost::dynamic_bitset<> const& indices)
+    : size_(indices.size()), schema_(rel_schema) {
+    if (size_ > kMaxInlineColumns) {
+        wide_indices_ = std::make_unique<boost::dynamic_bitset<>>(indices);
+        return;
+    }
+    boost::to_block_range(indices, inline_indices_.begin());
 }
 
-bool Vertical::Contains(Vertical const& that) const {
-    boost::dynamic_bitset<> const& that_indices = that.column_indices_;
-    if (column_indices_.size() < that_indices.size()) return false;
+std::unique_ptr<Vertical> Vertical::EmptyVertical(RelationalSchema const* rel_schema) {
+    return std::make_unique<Vertical>(rel_schema,
+                                      boost::dynamic_bitset<>(rel_schema->GetNumColumns()));
+}
 
-    return that.column_indices_.is_subset_of(column_indices_);
+Vertical::Vertical(Column const& col)
+    : size_(col.GetSchema()->GetNumColumns()), schema_(col.GetSchema()) {
+    if (size_ > kMaxInlineColumns) {
+        wide_indices_ = std::make_unique<boost::dynamic_bitset<>>(size_);
+        wide_indices_->set(col.GetIndex());
+        return;
+    }
+    inline_indices_[col.GetIndex() / kWordBits] = Word{1} << (col.GetIndex() % kWordBits);
+}
+
+Vertical::Vertical(Vertical const& other)
+    : inline_indices_(other.inline_indices_),
+      wide_indices_(other.IsInline() ? nullptr
+                                     : std::make_unique<boost::dynamic_bitset<>>(
+                                               *other.wide_indices_)),
+      size_(other.size_),
+      schema_(other.schema_) {}
+
+Vertical& Vertical::operator=(Vertical const& rhs) {
+    if (this == &rhs) return *this;
+    inline_indices_ = rhs.inline_indices_;
+    wide_indices_ = rhs.IsInline() ? nullptr
+                                   : std::make_unique<boost::dynamic_bitset<>>(*rhs.wide_indices_);
+    size_ = rhs.size_;
+    schema_ = rhs.schema_;
+    return *this;
+}
+
+boost::dynamic_bitset<> Vertical::GetColumnIndices() const {
+    if (!IsInline()) return *wide_indices_;
+    boost::dynamic_bitset<> indices(inline_indices_.begin(),
+                                    inline_indices_.begin() + GetWordsNum());
+    indices.resize(size_);
+    return indices;
+}
+
+bool Vertical::operator==(Vertical const& other) const {
+    if (size_ != other.size_) return false;
+    if (IsInline() && other.IsInline()) return inline_indices_ == other.inline_indices_;
+    return GetColumnIndices() == other.GetColumnIndices();
+}
+
+bool Vertical::Contains(Vertical const& that) const {
+    if (size_ < that.size_) return false;
+    if (!IsInline() || !that.IsInline()) {
+        return that.GetColumnIndices().is_subset_of(GetColumnIndices());
+    }
+    for (size_t i = 0; i < that.GetWordsNum(); ++i) {
+        if ((that.inline_indices_[i] & ~inline_indices_[i]) != 0) return false;
+    }
+    return true;
 }
 
 bool Vertical::Contains(Column const& that) const {
-    return column_indices_.test(that.GetIndex());
+    return Contains(that.GetIndex());
+}
+
+bool Vertical::Contains(size_t column_index) const {
+    assert(column_index < size_);
+    if (!IsInline()) return wide_indices_->test(column_index);
+    return (inline_indices_[column_index / kWordBits] >> (column_index % kWordBits)) & 1;
 }
 
 bool Vertical::Intersects(Vertical const& that) const {
-    boost::dynamic_bitset<> const& that_indices = that.column_indices_;
-    return column_indices_.intersects(that_indices);
+    if (!IsInline() || !that.IsInline()) {
+        return GetColumnIndices().intersects(that.GetColumnIndices());
+    }
+    for (size_t i = 0; i < GetWordsNum(); ++i) {
+        if ((inline_indices_[i] & that.inline_indices_[i]) != 0) return true;
+    }
+    return false;
 }
 
 Vertical Vertical::Union(Vertical const& that) const {
-    boost::dynamic_bitset<> retained_column_indices(column_indices_);
-    retained_column_indices |= that.column_indices_;
-    return schema_->GetVertical(retained_column_indices);
+    if (IsInline() && that.IsInline()) {
+        return CombineInline(that, [](Word lhs, Word rhs) { return lhs | rhs; });
+    }
+    boost::dynamic_bitset<> retained_column_indices = GetColumnIndices();
+    retained_column_indices |= that.GetColumnIndices();
+    return schema_->GetVertical(std::move(retained_column_indices));
 }
 
 Vertical Vertical::Union(Column const& that) const {
-    boost::dynamic_bitset<> retained_column_indices(column_indices_);
-    retained_column_indices.set(that.GetIndex());
-    return schema_->GetVertical(retained_column_indices);
+    Vertical result(*this);
+    if (IsInline()) {
+        result.inline_indices_[that.GetIndex() / kWordBits] |= Word{1}
+                                                              << (that.GetIndex() % kWordBits);
+    } else {
+        result.wide_indices_->set(that.GetIndex());
+    }
+    return result;
 }
 
 Vertical Vertical::Project(Vertical const& that) const {
-    boost::dynamic_bitset<> retained_column_indices(column_indices_);
-    retained_column_indices &= that.column_indices_;
-    return schema_->GetVertical(retained_column_indices);
+    if (IsInline() && that.IsInline()) {
+        return CombineInline(that, [](Word lhs, Word rhs) { return lhs & rhs; });
+    }
+    boost::dynamic_bitset<> retained_column_indices = GetColumnIndices();
+    retained_column_indices &= that.GetColumnIndices();
+    return schema_->GetVertical(std::move(retained_column_indices));
 }
 
 Vertical Vertical::Without(Vertical const& that) const {
-    boost::dynamic_bitset<> retained_column_indices(column_indices_);
-    retained_column_indices &= ~that.column_indices_;
-    return schema_->GetVertical(retained_column_indices);
+    if (IsInline() && that.IsInline()) {
+        return CombineInline(that, [](Word lhs, Word rhs) { return lhs & ~rhs; });
+    }
+    boost::dynamic_bitset<> retained_column_indices = GetColumnIndices();
+    retained_column_indices -= that.GetColumnIndices();
+    return schema_->GetVertical(std::move(retained_column_indices));
 }
 
 Vertical Vertical::Without(Column const& that) const {
-    boost::dynamic_bitset<> retained_column_indices(column_indices_);
-    retained_column_indices.reset(that.GetIndex());
-    return schema_->GetVertical(retained_column_indices);
+    Vertical result(*this);
+    if (IsInline()) {
+        result.inline_indices_[that.GetIndex() / kWordBits] &=
+                ~(Word{1} << (that.GetIndex() % kWordBits));
+    } else {
+        result.wide_indices_->reset(that.GetIndex());
+    }
+    return result;
 }
 
 Vertical Vertical::Invert() const {
-    boost::dynamic_bitset<> flipped_indices(column_indices_);
-    flipped_indices.resize(schema_->GetNumColumns());
-    flipped_indices.flip();
-    return schema_->GetVertical(flipped_indices);
+    size_t const num_columns = schema_->GetNumColumns();
+    if (!IsInline() || num_columns > kMaxInlineColumns) {
+        boost::dynamic_bitset<> flipped_indices = GetColumnIndices();
+        flipped_indices.resize(num_columns);
+        flipped_indices.flip();
+        return schema_->GetVertical(std::move(flipped_indices));
+    }
+    Vertical result(*this);
+    result.size_ = num_columns;
+    for (size_t i = 0; i < kInlineWordsNum; ++i) {
+        size_t const first_bit = i * kWordBits;
+        if (first_bit >= num_columns) {
+            result.inline_indices_[i] = 0;
+        } else if (num_columns - first_bit < kWordBits) {
+            Word const mask = (Word{1} << (num_columns - first_bit)) - 1;
+            result.inline_indices_[i] = ~inline_indices_[i] & mask;
+        } else {
+            result.inline_indices_[i] = ~inline_indices_[i];
+        }
+    }
+    return result;
 }
 
 Vertical Vertical::Invert(Vertical const& scope) const {
-    boost::dynamic_bitset<> flipped_indices(column_indices_);
-    flipped_indices ^= scope.column_indices_;
-    return schema_->GetVertical(flipped_indices);
+    if (IsInline() && scope.IsInline()) {
+        return CombineInline(scope, [](Word lhs, Word rhs) { return lhs ^ rhs; });
+    }
+    boost::dynamic_bitset<> flipped_indices = GetColumnIndices();
+    flipped_indices ^= scope.GetColumnIndices();
+    return schema_->GetVertical(std::move(flipped_indices));
 }
 
-std::unique_ptr<Vertical> Vertical::EmptyVertical(RelationalSchema const* rel_schema) {
-    return std::make_unique<Vertical>(rel_schema,
-                                      boost::dynamic_bitset<>(rel_schema->GetNumColumns()));
+unsigned int Vertical::GetArity() const {
+    if (!IsInline()) return wide_indices_->count();
+    unsigned int arity = 0;
+    for (size_t i = 0; i < GetWordsNum(); ++i) {
+        arity += std::popcount(inline_indices_[i]);
+    }
+    return arity;
+}
+
+size_t Vertical::FindFirst() const {
+    if (!IsInline()) return wide_indices_->find_first();
+    for (size_t i = 0; i < GetWordsNum(); ++i) {
+        if (inline_indices_[i] != 0) return i * kWordBits + std::countr_zero(inline_indices_[i]);
+    }
+    return boost::dynamic_bitset<>::npos;
+}
+
+size_t Vertical::FindNext(size_t column_index) const {
+    if (!IsInline()) return wide_indices_->find_next(column_index);
+    size_t const index = column_index + 1;
+    size_t word_index = index / kWordBits;
+    if (word_index >= GetWordsNum()) return boost::dynamic_bitset<>::npos;
+    Word const rest = inline_indices_[word_index] >> (index % kWordBits);
+    if (rest != 0) return index + std::countr_zero(rest);
+    for (++word_index; word_index < GetWordsNum(); ++word_index) {
+        if (inline_indices_[word_index] != 0) {
+            return word_index * kWordBits + std::countr_zero(inline_indices_[word_index]);
+        }
+    }
+    return boost::dynamic_bitset<>::npos;
+}
+
+size_t Vertical::GetHash() const {
+    if (IsInline()) {
+        size_t hash = inline_indices_[0];
+        for (size_t i = 1; i < GetWordsNum(); ++i) {
+            if (inline_indices_[i] != 0) boost::hash_combine(hash, inline_indices_[i]);
+        }
+        return hash;
+    }
+    size_t hash = 0;
+    for (size_t index = FindFirst(); index != boost::dynamic_bitset<>::npos;
+         index = FindNext(index)) {
+        if (index < kWordBits) {
+            hash |= size_t{1} << index;
+        } else {
+            boost::hash_combine(hash, index);
+        }
+    }
+    return hash;
 }
 
 std::vector<Column const*> Vertical::GetColumns() const {
     std::vector<Column const*> columns;
-    for (size_t index = column_indices_.find_first(); index != boost::dynamic_bitset<>::npos;
-         index = column_indices_.find_next(index)) {
+    ForEachColumnIndex([this, &columns](size_t index) {
         columns.push_back(schema_->GetColumns()[index].get());
-    }
+    });
     return columns;
 }
 
 std::vector<unsigned> Vertical::GetColumnIndicesAsVector() const {
     std::vector<unsigned> columns;
-    for (size_t index = column_indices_.find_first(); index != boost::dynamic_bitset<>::npos;
-         index = column_indices_.find_next(index)) {
-        columns.push_back(schema_->GetColumns()[index].get()->GetIndex());
-    }
+    ForEachColumnIndex([&columns](size_t index) { columns.push_back(index); });
     return columns;
 }
 
 std::string Vertical::ToString() const {
     std::string result = "[";
 
-    if (column_indices_.find_first() == boost::dynamic_bitset<>::npos) return "[]";
+    if (FindFirst() == boost::dynamic_bitset<>::npos) return "[]";
 
-    for (size_t index = column_indices_.find_first(); index != boost::dynamic_bitset<>::npos;
-         index = column_indices_.find_next(index)) {
+    for (size_t index = FindFirst(); index != boost::dynamic_bitset<>::npos;
+         index = FindNext(index)) {
         result += schema_->GetColumn(index)->GetName();
-        if (column_indices_.find_next(index) != boost::dynamic_bitset<>::npos) {
+        if (FindNext(index) != boost::dynamic_bitset<>::npos) {
             result += ' ';
         }
     }
@@ -113,14 +262,14 @@ std::string Vertical::ToString() const {
 std::string Vertical::ToIndicesString() const {
     std::string result = "[";
 
-    if (column_indices_.find_first() == boost::dynamic_bitset<>::npos) {
+    if (FindFirst() == boost::dynamic_bitset<>::npos) {
         return "[]";
     }
 
-    for (size_t index = column_indices_.find_first(); index != boost::dynamic_bitset<>::npos;
-         index = column_indices_.find_next(index)) {
+    for (size_t index = FindFirst(); index != boost::dynamic_bitset<>::npos;
+         index = FindNext(index)) {
         result += std::to_string(index);
-        if (column_indices_.find_next(index) != boost::dynamic_bitset<>::npos) {
+        if (FindNext(index) != boost::dynamic_bitset<>::npos) {
             result += ',';
         }
     }
@@ -132,22 +281,25 @@ std::string Vertical::ToIndicesString() const {
 
 std::vector<Vertical> Vertical::GetParents() const {
     if (GetArity() < 2) return std::vector<Vertical>();
-    std::vector<Vertical> parents(GetArity());
-    int i = 0;
-    for (size_t column_index = column_indices_.find_first();
-         column_index != boost::dynamic_bitset<>::npos;
-         column_index = column_indices_.find_next(column_index)) {
-        auto parent_column_indices = column_indices_;
-        parent_column_indices.reset(column_index);
-        parents[i++] = GetSchema()->GetVertical(std::move(parent_column_indices));
-    }
+    std::vector<Vertical> parents;
+    parents.reserve(GetArity());
+    ForEachColumnIndex([this, &parents](size_t column_index) {
+        parents.push_back(Without(*schema_->GetColumn(column_index)));
+    });
     return parents;
 }
 
 bool Vertical::operator<(Vertical const& rhs) const {
     assert(*schema_ == *rhs.schema_);
-    if (this->column_indices_ == rhs.column_indices_) return false;
-
-    boost::dynamic_bitset<> const& lr_xor = (this->column_indices_ ^ rhs.column_indices_);
-    return rhs.column_indices_.test(lr_xor.find_first());
+    if (!IsInline() || !rhs.IsInline()) {
+        boost::dynamic_bitset<> const lhs_indices = GetColumnIndices();
+        boost::dynamic_bitset<> const rhs_indices = rhs.GetColumnIndices();
+        if (lhs_indices == rhs_indices) return false;
+        return rhs_indices.test((lhs_indices ^ rhs_indices).find_first());
+    }
+    for (size_t i = 0; i < GetWordsNum(); ++i) {
+        Word const difference = inline_indices_[i] ^ rhs.inline_indices_[i];
+        if (difference != 0) return (rhs.inline_indices_[i] >> std::countr_zero(difference)) & 1;
+    }
+    return false;
 }
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <array>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -14,23 +16,51 @@
 #include "column.h"
 
 class Vertical {
+public:
+    using Word = boost::dynamic_bitset<>::block_type;
+    static constexpr size_t kWordBits = std::numeric_limits<Word>::digits;
+    static constexpr size_t kInlineWordsNum = 4;
+    // Verticals of schemas up to this wide do not allocate
+    static constexpr size_t kMaxInlineColumns = kInlineWordsNum * kWordBits;
+
 private:
     // Vertical(shared_ptr<RelationalSchema>& relSchema, int indices);
 
-    // TODO: unique_ptr<column_indices_> if this is big
-    boost::dynamic_bitset<> column_indices_;
-    RelationalSchema const* schema_;
+    // Indices of up to kMaxInlineColumns columns are stored in inline_indices_, the bits past
+    // size_ are zero. Wider sets are stored in wide_indices_.
+    std::array<Word, kInlineWordsNum> inline_indices_{};
+    std::unique_ptr<boost::dynamic_bitset<>> wide_indices_;
+    size_t size_ = 0;
+    RelationalSchema const* schema_ = nullptr;
+
+    bool IsInline() const noexcept {
+        return wide_indices_ == nullptr;
+    }
+
+    size_t GetWordsNum() const noexcept {
+        return (size_ + kWordBits - 1) / kWordBits;
+    }
+
+    // Both sets must be stored inline
+    template <typename WordOp>
+    Vertical CombineInline(Vertical const& that, WordOp word_op) const {
+        Vertical result(*this);
+        for (size_t i = 0; i < GetWordsNum(); ++i) {
+            result.inline_indices_[i] = word_op(inline_indices_[i], that.inline_indices_[i]);
+        }
+        return result;
+    }
 
 public:
     static std::unique_ptr<Vertical> EmptyVertical(RelationalSchema const* rel_schema);
 
-    Vertical(RelationalSchema const* rel_schema, boost::dynamic_bitset<> indices);
+    Vertical(RelationalSchema const* rel_schema, boost::dynamic_bitset<> const& indices);
     Vertical() = default;
 
     explicit Vertical(Column const& col);
 
-    Vertical(Vertical const& other) = default;
-    Vertical& operator=(Vertical const& rhs) = default;
+    Vertical(Vertical const& other);
+    Vertical& operator=(Vertical const& rhs);
     Vertical(Vertical&& other) = default;
     Vertical& operator=(Vertical&& rhs) = default;
 
@@ -44,25 +74,18 @@ public:
      */
     bool operator<(Vertical const& rhs) const;
 
-    bool operator==(Vertical const& other) const {
-        return column_indices_ == other.column_indices_;
-    }
+    bool operator==(Vertical const& other) const;
 
     bool operator!=(Vertical const& other) const {
-        return column_indices_ != other.column_indices_;
+        return !(*this == other);
     }
 
     bool operator>(Vertical const& rhs) const {
         return !(*this < rhs && *this == rhs);
     }
 
-    boost::dynamic_bitset<> GetColumnIndices() const {
-        return column_indices_;
-    }
-
-    boost::dynamic_bitset<> const& GetColumnIndicesRef() const {
-        return column_indices_;
-    }
+    // Allocates, prefer the methods below that do not
+    boost::dynamic_bitset<> GetColumnIndices() const;
 
     RelationalSchema const* GetSchema() const {
         return schema_;
@@ -70,6 +93,7 @@ public:
 
     bool Contains(Vertical const& that) const;
     bool Contains(Column const& that) const;
+    bool Contains(size_t column_index) const;
     bool Intersects(Vertical const& that) const;
     Vertical Union(Vertical const& that) const;
     Vertical Union(Column const& that) const;
@@ -79,10 +103,24 @@ public:
     Vertical Invert() const;
     Vertical Invert(Vertical const& scope) const;
 
-    unsigned int GetArity() const {
-        return column_indices_.count();
+    unsigned int GetArity() const;
+
+    // Same as boost::dynamic_bitset<>::find_first/find_next, boost::dynamic_bitset<>::npos if
+    // there are no more columns
+    size_t FindFirst() const;
+    size_t FindNext(size_t column_index) const;
+
+    template <typename Func>
+    void ForEachColumnIndex(Func func) const {
+        for (size_t index = FindFirst(); index != boost::dynamic_bitset<>::npos;
+             index = FindNext(index)) {
+            func(index);
+        }
     }
 
+    // The bits of the first kWordBits columns, mixed with the other columns if there are any
+    size_t GetHash() const;
+
     std::vector<Column const*> GetColumns() const;
     std::vector<unsigned> GetColumnIndicesAsVector() const;
     std::vector<Vertical> GetParents() const;
@@ -2,7 +2,9 @@
 
 #include <exception>
 #include <queue>
+#include <stdexcept>
 #include <unordered_set>
+#include <utility>
 
 #include "fd/pyrocommon/core/dependency_candidate.h"
 #include "fd/pyrocommon/core/vertical_info.h"
@@ -11,225 +13,13 @@
 
 namespace model {
 
-template <class Value>
-std::shared_ptr<Value> VerticalMap<Value>::SetTrie::Associate(Bitset const& key, size_t next_bit,
-                                                              std::shared_ptr<Value> value) {
-    next_bit = (next_bit == 0 ? key.find_first() : key.find_next(next_bit - 1));
-    if (next_bit == boost::dynamic_bitset<>::npos) {
-        std::swap(value, value_);
-        return value;
-    }
-    return GetOrCreateSubTrie(next_bit)->Associate(key, next_bit + 1, std::move(value));
-}
-
-template <class Value>
-std::shared_ptr<Value const> VerticalMap<Value>::SetTrie::Get(Bitset const& key,
-                                                              size_t next_bit) const {
-    next_bit = (next_bit == 0 ? key.find_first() : key.find_next(next_bit - 1));
-    if (next_bit == boost::dynamic_bitset<>::npos) {
-        return value_;
-    }
-
-    auto subtrie = GetSubtrie(next_bit);
-    if (subtrie == nullptr) return nullptr;
-    return subtrie->Get(key, next_bit + 1);
-}
-
-template <class Value>
-std::shared_ptr<Value> VerticalMap<Value>::SetTrie::Remove(Bitset const& key, size_t next_bit) {
-    next_bit = (next_bit == 0 ? key.find_first() : key.find_next(next_bit - 1));
-    if (next_bit == Bitset::npos) {
-        auto removed_value = value_;
-        value_ = nullptr;
-        return removed_value;
-    }
-
-    auto subtrie = GetSubtrie(next_bit);
-    if (subtrie == nullptr) return nullptr;
-    auto removed_value = subtrie->Remove(key, next_bit + 1);
-    if (subtrie->IsEmpty()) {
-        subtries_[next_bit - offset_] = nullptr;
-    }
-
-    return removed_value;
-}
-
-template <class Value>
-bool VerticalMap<Value>::SetTrie::IsEmpty() const {
-    if (value_ == nullptr) return false;
-    return std::all_of(subtries_.begin(), subtries_.end(),
-                       [](auto& subtrie_ptr) { return subtrie_ptr == nullptr; });
-}
-
-template <class Value>
-typename VerticalMap<Value>::SetTrie* VerticalMap<Value>::SetTrie::GetOrCreateSubTrie(
-        size_t index) {
-    if (subtries_.empty()) {
-        subtries_ = std::vector<std::unique_ptr<SetTrie>>(dimension_ - offset_);
-    }
-    SetTrie* subtrie = GetSubtrie(index);
-    if (subtrie == nullptr) {
-        subtries_[index - offset_] = std::make_unique<SetTrie>(index + 1, dimension_);
-    }
-    return subtries_[index - offset_].get();
-}
-
-template <class Value>
-typename VerticalMap<Value>::SetTrie* VerticalMap<Value>::SetTrie::GetSubtrie(size_t index) {
-    return const_cast<VerticalMap<Value>::SetTrie*>(
-            (const_cast<VerticalMap<Value>::SetTrie const*>(this))->GetSubtrie(index));
-}
-
-template <class Value>
-typename VerticalMap<Value>::SetTrie const* VerticalMap<Value>::SetTrie::GetSubtrie(
-        size_t index) const {
-    if (subtries_.empty()) {
-        return nullptr;
-    }
-    if (index < offset_ || index >= dimension_) {
-        throw std::runtime_error("Error in GetSubtrie: index must be in [offset_; dimension_)");
-    }
-    return subtries_[index - offset_].get();
-}
-
-template <class Value>
-void VerticalMap<Value>::SetTrie::TraverseEntries(
-        Bitset& subset_key,
-        std::function<void(Bitset const&, std::shared_ptr<Value const>)> collector) const {
-    if (value_ != nullptr) {
-        collector(Bitset(subset_key), value_);
-    }
-    for (size_t i = offset_; i < dimension_; i++) {
-        auto subtrie = GetSubtrie(i);
-        if (subtrie != nullptr) {
-            subset_key.set(i);
-            subtrie->TraverseEntries(subset_key, collector);
-            subset_key.reset(i);
-        }
-    }
-}
-
-template <class Value>
-bool VerticalMap<Value>::SetTrie::CollectSubsetKeys(
-        Bitset const& key, size_t next_bit, Bitset& subset_key,
-        std::function<bool(Bitset const&, std::shared_ptr<Value const>)> const& collector) const {
-    if (value_ != nullptr) {
-        if (!collector(Bitset(subset_key), value_)) return false;
-    }
-
-    for (next_bit = (next_bit == 0 ? key.find_first() : key.find_next(next_bit - 1));
-         next_bit != Bitset::npos; next_bit = key.find_next(next_bit)) {
-        auto subtrie = GetSubtrie(next_bit);
-        if (subtrie != nullptr) {
-            subset_key.set(next_bit);
-            if (!subtrie->CollectSubsetKeys(key, next_bit + 1, subset_key, collector)) return false;
-            subset_key.reset(next_bit);
-        }
-    }
-    return true;
-}
-
-template <class Value>
-bool VerticalMap<Value>::SetTrie::CollectSupersetKeys(
-        Bitset const& key, size_t next_bit, Bitset& superset_key,
-        std::function<bool(Bitset const&, std::shared_ptr<Value const>)> const& collector) const {
-    if (next_bit != Bitset::npos) {
-        next_bit = (next_bit == 0 ? key.find_first() : key.find_next(next_bit - 1));
-    }
-    if (next_bit == Bitset::npos) {
-        if (value_ != nullptr) {
-            if (!collector(Bitset(superset_key), value_)) return false;
-        }
-        for (size_t i = offset_; i < dimension_; i++) {
-            auto subtrie = GetSubtrie(i);
-            if (subtrie != nullptr) {
-                superset_key.set(i);
-                if (!subtrie->CollectSupersetKeys(key, next_bit, superset_key, collector))
-                    return false;
-                superset_key.reset(i);
-            }
-        }
-    } else {
-        for (size_t i = offset_; i < next_bit; i++) {
-            auto subtrie = GetSubtrie(i);
-            if (subtrie != nullptr) {
-                superset_key.set(i);
-                if (!subtrie->CollectSupersetKeys(key, next_bit, superset_key, collector))
-                    return false;
-                superset_key.reset(i);
-            }
-        }
-
-        auto subtrie = GetSubtrie(next_bit);
-        if (subtrie != nullptr) {
-            superset_key.set(next_bit);
-            if (!subtrie->CollectSupersetKeys(key, next_bit + 1, superset_key, collector))
-                return false;
-            superset_key.reset(next_bit);
-        }
-    }
-    return true;
-}
-
-template <class Value>
-bool VerticalMap<Value>::SetTrie::CollectRestrictedSupersetKeys(
-        Bitset const& key, Bitset const& blacklist, size_t next_bit, Bitset& superset_key,
-        std::function<void(Bitset const&, std::shared_ptr<Value const>)> const& collector) const {
-    if (next_bit != Bitset::npos) {
-        next_bit = (next_bit == 0 ? key.find_first() : key.find_next(next_bit - 1));
-    }
-    if (next_bit == Bitset::npos) {
-        if (value_ != nullptr) {
-            collector(Bitset(superset_key), value_);
-        }
-        for (size_t i = offset_; i < dimension_; i++) {
-            if (blacklist.test(i)) continue;
-            auto subtrie = GetSubtrie(i);
-            if (subtrie != nullptr) {
-                superset_key.set(i);
-                if (!subtrie->CollectRestrictedSupersetKeys(key, blacklist, next_bit, superset_key,
-                                                            collector)) {
-                    return false;
-                }
-                superset_key.reset(i);
-            }
-        }
-    } else {
-        for (size_t i = offset_; i < next_bit; i++) {
-            if (blacklist.test(i)) continue;
-            auto subtrie = GetSubtrie(i);
-            if (subtrie != nullptr) {
-                superset_key.set(i);
-                if (!subtrie->CollectRestrictedSupersetKeys(key, blacklist, next_bit, superset_key,
-                                                            collector)) {
-                    return false;
-                }
-                superset_key.reset(i);
-            }
-        }
-
-        auto subtrie = GetSubtrie(next_bit);
-        if (subtrie != nullptr) {
-            superset_key.set(next_bit);
-            if (!subtrie->CollectRestrictedSupersetKeys(key, blacklist, next_bit + 1, superset_key,
-                                                        collector)) {
-                return false;
-            }
-            superset_key.reset(next_bit);
-        }
-    }
-    return true;
-}
-
 template <class Value>
 std::vector<Vertical> VerticalMap<Value>::GetSubsetKeys(Vertical const& vertical) const {
     std::vector<Vertical> subset_keys;
-    Bitset subset_key(relation_->GetNumColumns());
-    set_trie_.CollectSubsetKeys(vertical.GetColumnIndices(), 0, subset_key,
-                                [&subset_keys, this](auto& indices, [[maybe_unused]] auto value) {
-                                    subset_keys.push_back(relation_->GetVertical(indices));
-                                    return true;
-                                });
+    set_trie_.ForEachSubset(vertical, [&subset_keys](Vertical const& key, auto const&) {
+        subset_keys.push_back(key);
+        return true;
+    });
     return subset_keys;
 }
 
@@ -237,12 +27,10 @@ template <class Value>
 std::vector<typename VerticalMap<Value>::Entry> VerticalMap<Value>::GetSubsetEntries(
         Vertical const& vertical) const {
     std::vector<typename VerticalMap<Value>::Entry> entries;
-    Bitset subset_key(relation_->GetNumColumns());
-    set_trie_.CollectSubsetKeys(vertical.GetColumnIndices(), 0, subset_key,
-                                [&entries, this](auto& indices, auto value) {
-                                    entries.emplace_back(relation_->GetVertical(indices), value);
-                                    return true;
-                                });
+    set_trie_.ForEachSubset(vertical, [&entries](Vertical const& key, auto value) {
+        entries.emplace_back(key, std::move(value));
+        return true;
+    });
     return entries;
 }
 
@@ -251,12 +39,10 @@ template <class Value>
 typename VerticalMap<Value>::Entry VerticalMap<Value>::GetAnySubsetEntry(
         Vertical const& vertical) const {
     typename VerticalMap<Value>::Entry entry;
-    Bitset subset_key(relation_->GetNumColumns());
-    set_trie_.CollectSubsetKeys(vertical.GetColumnIndices(), 0, subset_key,
-                                [&entry, this](auto& indices, auto value) {
-                                    entry = {relation_->GetVertical(indices), value};
-                                    return false;
-                                });
+    set_trie_.ForEachSubset(vertical, [&entry](Vertical const& key, auto value) {
+        entry = {key, std::move(value)};
+        return false;
+    });
     return entry;
 }
 
@@ -265,17 +51,11 @@ typename VerticalMap<Value>::Entry VerticalMap<Value>::GetAnySubsetEntry(
         Vertical const& vertical,
         std::function<bool(Vertical const*, std::shared_ptr<Value const>)> const& condition) const {
     typename VerticalMap<Value>::Entry entry;
-    Bitset subset_key(relation_->GetNumColumns());
-    set_trie_.CollectSubsetKeys(vertical.GetColumnIndices(), 0, subset_key,
-                                [&entry, this, &condition](auto& indices, auto value) {
-                                    auto kv = relation_->GetVertical(indices);
-                                    if (condition(&kv, value)) {
-                                        entry = {kv, value};
-                                        return false;
-                                    } else {
-                                        return true;
-                                    }
-                                });
+    set_trie_.ForEachSubset(vertical, [&entry, &condition](Vertical const& key, auto value) {
+        if (!condition(&key, value)) return true;
+        entry = {key, std::move(value)};
+        return false;
+    });
     return entry;
 }
 
@@ -283,12 +63,10 @@ template <class Value>
 std::vector<typename VerticalMap<Value>::Entry> VerticalMap<Value>::GetSupersetEntries(
         Vertical const& vertical) const {
     std::vector<typename VerticalMap<Value>::Entry> entries;
-    Bitset superset_key(relation_->GetNumColumns());
-    set_trie_.CollectSupersetKeys(vertical.GetColumnIndices(), 0, superset_key,
-                                  [&entries, this](auto& indices, auto value) {
-                                      entries.emplace_back(relation_->GetVertical(indices), value);
-                                      return true;
-                                  });
+    set_trie_.ForEachSuperset(vertical, [&entries](Vertical const& key, auto value) {
+        entries.emplace_back(key, std::move(value));
+        return true;
+    });
     return entries;
 }
 
@@ -296,12 +74,10 @@ template <class Value>
 typename VerticalMap<Value>::Entry VerticalMap<Value>::GetAnySupersetEntry(
         Vertical const& vertical) const {
     typename VerticalMap<Value>::Entry entry;
-    Bitset superset_key(relation_->GetNumColumns());
-    set_trie_.CollectSupersetKeys(vertical.GetColumnIndices(), 0, superset_key,
-                                  [&entry, this](auto& indices, auto value) {
-                                      entry = {relation_->GetVertical(indices), value};
-                                      return false;
-                                  });
+    set_trie_.ForEachSuperset(vertical, [&entry](Vertical const& key, auto value) {
+        entry = {key, std::move(value)};
+        return false;
+    });
     return entry;
 }
 
@@ -310,36 +86,30 @@ typename VerticalMap<Value>::Entry VerticalMap<Value>::GetAnySupersetEntry(
         Vertical const& vertical,
         std::function<bool(Vertical const*, std::shared_ptr<Value const>)> condition) const {
     typename VerticalMap<Value>::Entry entry;
-    Bitset superset_key(relation_->GetNumColumns());
-    set_trie_.CollectSupersetKeys(vertical.GetColumnIndices(), 0, superset_key,
-                                  [&entry, this, &condition](auto& indices, auto value) {
-                                      auto kv = relation_->GetVertical(indices);
-                                      if (condition(&kv, value)) {
-                                          entry = {kv, value};
-                                          return false;
-                                      } else {
-                                          return true;
-                                      }
-                                  });
+    set_trie_.ForEachSuperset(vertical, [&entry, &condition](Vertical const& key, auto value) {
+        if (!condition(&key, value)) return true;
+        entry = {key, std::move(value)};
+        return false;
+    });
     return entry;
 }
 
 template <class Value>
 std::vector<typename VerticalMap<Value>::Entry> VerticalMap<Value>::GetRestrictedSupersetEntries(
         Vertical const& vertical, Vertical const& exclusion) const {
-    if (vertical.GetColumnIndices().intersects(exclusion.GetColumnIndices()))
+    if (vertical.Intersects(exclusion))
         throw std::runtime_error(
                 "Error in GetRestrictedSupersetEntries: a vertical shouldn't intersect with a "
                 "restriction");
 
     std::vector<typename VerticalMap<Value>::Entry> entries;
-    Bitset superset_key(relation_->GetNumColumns());
-    set_trie_.CollectRestrictedSupersetKeys(
-            vertical.GetColumnIndices(), exclusion.GetColumnIndices(), 0, superset_key,
-            [&entries, this](auto& indices, auto value) {
-                entries.emplace_back(relation_->GetVertical(indices), value);
+    set_trie_.ForEachSuperset(
+            vertical,
+            [&entries](Vertical const& key, auto value) {
+                entries.emplace_back(key, std::move(value));
                 return true;
-            });
+            },
+            &exclusion);
     return entries;
 }
 
@@ -347,7 +117,8 @@ template <class Value>
 bool VerticalMap<Value>::RemoveSupersetEntries(Vertical const& key) {
     std::vector<typename VerticalMap<Value>::Entry> superset_entries = GetSupersetEntries(key);
     for (auto superset_entry : superset_entries) {
-        Remove(superset_entry.first);
+        // not the virtual call: BlockingVerticalMap holds the write lock already
+        VerticalMap::Remove(superset_entry.first);
     }
     return !superset_entries.empty();
 }
@@ -356,7 +127,8 @@ template <class Value>
 bool VerticalMap<Value>::RemoveSubsetEntries(Vertical const& key) {
     std::vector<typename VerticalMap<Value>::Entry> subset_entries = GetSubsetEntries(key);
     for (auto subset_entry : subset_entries) {
-        Remove(subset_entry.first);
+        // not the virtual call: BlockingVerticalMap holds the write lock already
+        VerticalMap::Remove(subset_entry.first);
     }
     return !subset_entries.empty();
 }
@@ -364,9 +136,9 @@ bool VerticalMap<Value>::RemoveSubsetEntries(Vertical const& key) {
 template <class Value>
 std::unordered_set<Vertical> VerticalMap<Value>::KeySet() {
     std::unordered_set<Vertical> key_set;
-    Bitset subset_key(relation_->GetNumColumns());
-    set_trie_.TraverseEntries(subset_key, [&key_set, this](auto& k, [[maybe_unused]] auto v) {
-        key_set.insert(relation_->GetVertical(k));
+    set_trie_.ForEachEntry([&key_set](Vertical const& key, auto const&) {
+        key_set.insert(key);
+        return true;
     });
     return key_set;
 }
@@ -374,9 +146,9 @@ std::unordered_set<Vertical> VerticalMap<Value>::KeySet() {
 template <class Value>
 std::vector<std::shared_ptr<Value const>> VerticalMap<Value>::Values() {
     std::vector<std::shared_ptr<Value const>> values;
-    Bitset subset_key(relation_->GetNumColumns());
-    set_trie_.TraverseEntries(subset_key, [&values]([[maybe_unused]] auto& k, auto v) -> void {
-        values.push_back(v);
+    set_trie_.ForEachEntry([&values](Vertical const&, auto value) {
+        values.push_back(std::move(value));
+        return true;
     });
     return values;
 }
@@ -384,9 +156,9 @@ std::vector<std::shared_ptr<Value const>> VerticalMap<Value>::Values() {
 template <class Value>
 std::unordered_set<typename VerticalMap<Value>::Entry> VerticalMap<Value>::EntrySet() {
     std::unordered_set<typename VerticalMap<Value>::Entry> entry_set;
-    Bitset subset_key(relation_->GetNumColumns());
-    set_trie_.TraverseEntries(subset_key, [&entry_set, this](auto& k, auto v) -> void {
-        entry_set.emplace(relation_->GetVertical(k), v);
+    set_trie_.ForEachEntry([&entry_set](Vertical const& key, auto value) {
+        entry_set.emplace(key, std::move(value));
+        return true;
     });
     return entry_set;
 }
@@ -399,14 +171,14 @@ unsigned int VerticalMap<Value>::RemoveFromUsageCounter(
 
 template <class Value>
 std::shared_ptr<Value> VerticalMap<Value>::Remove(Vertical const& key) {
-    auto removed_value = set_trie_.Remove(key.GetColumnIndices(), 0);
+    auto removed_value = set_trie_.Remove(key);
     if (removed_value != nullptr) size_--;
     return removed_value;
 }
 
 template <class Value>
 std::shared_ptr<Value> VerticalMap<Value>::Remove(VerticalMap::Bitset const& key) {
-    auto removed_value = set_trie_.Remove(key, 0);
+    auto removed_value = set_trie_.Remove(relation_->GetVertical(key));
     if (removed_value != nullptr) size_--;
     return removed_value;
 }
@@ -419,11 +191,11 @@ void VerticalMap<Value>::Shrink(double factor, std::function<bool(Entry, Entry)>
 
     std::priority_queue<Entry, std::vector<Entry>, std::function<bool(Entry, Entry)>> key_queue(
             compare, std::vector<Entry>(size_));
-    Bitset subset_key(relation_->GetNumColumns());
-    set_trie_.TraverseEntries(subset_key, [&key_queue, this, &can_remove](auto& k, auto v) {
-        if (Entry entry(relation_->GetVertical(k), v); can_remove(entry)) {
-            key_queue.push(entry);
+    set_trie_.ForEachEntry([&key_queue, &can_remove](Vertical const& key, auto value) {
+        if (Entry entry(key, std::move(value)); can_remove(entry)) {
+            key_queue.push(std::move(entry));
         }
+        return true;
     });
     unsigned int num_of_removed = 0;
     unsigned int target_size = size_ * factor;
@@ -434,48 +206,57 @@ void VerticalMap<Value>::Shrink(double factor, std::function<bool(Entry, Entry)>
         // insert additional logging
 
         num_of_removed++;
-        Remove(key);
+        // not the virtual call: BlockingVerticalMap holds the write lock already
+        VerticalMap::Remove(key);
     }
     shrink_invocations_++;
     time_spent_on_shrinking_ += 1;  // haven't implemented time measuring yet
 }
 
 template <class Value>
-void VerticalMap<Value>::Shrink(std::unordered_map<Vertical, unsigned int>& usage_counter,
-                                std::function<bool(Entry)> const& can_remove) {
+std::vector<typename VerticalMap<Value>::Entry> VerticalMap<Value>::Shrink(
+        std::unordered_map<Vertical, unsigned int>& usage_counter,
+        std::function<bool(Entry)> const& can_remove) {
     // some logging
 
-    std::vector<int> usage_counters(usage_counter.size());
+    std::vector<unsigned int> usage_counters;
+    usage_counters.reserve(usage_counter.size());
     for (auto& [first, second] : usage_counter) {
         usage_counters.push_back(second);
     }
     std::sort(usage_counters.begin(), usage_counters.end());
-    unsigned int median_of_usage = usage_counters.size() % 2 == 0
-                                           ? (usage_counters[usage_counters.size() / 2 + 1] +
-                                              usage_counters[usage_counters.size() / 2]) /
-                                                     2
-                                           : usage_counters[usage_counters.size() / 2];
+    unsigned int median_of_usage = 0;
+    if (!usage_counters.empty()) {
+        median_of_usage = usage_counters.size() % 2 == 0
+                                  ? (usage_counters[usage_counters.size() / 2 - 1] +
+                                     usage_counters[usage_counters.size() / 2]) /
+                                            2
+                                  : usage_counters[usage_counters.size() / 2];
+    }
 
     std::queue<Entry> key_queue;
-    Bitset subset_key(relation_->GetNumColumns());
-    set_trie_.TraverseEntries(
-            subset_key,
-            [&key_queue, this, &can_remove, &usage_counter, median_of_usage](auto& k,
-                                                                             auto v) -> void {
-                if (Entry entry(relation_->GetVertical(k), v);
-                    can_remove(entry) && usage_counter.at(entry.first) <= median_of_usage) {
-                    key_queue.push(entry);
-                }
-            });
-    unsigned int num_of_removed = 0;
+    set_trie_.ForEachEntry([&key_queue, &can_remove, &usage_counter, median_of_usage](
+                                   Vertical const& key, auto value) {
+        // entries that are missing from the counter have not been used at all
+        if (Entry entry(key, std::move(value)); can_remove(entry)) {
+            auto it = usage_counter.find(entry.first);
+            if (it == usage_counter.end() || it->second <= median_of_usage) {
+                key_queue.push(std::move(entry));
+            }
+        }
+        return true;
+    });
+    std::vector<Entry> removed;
     while (!key_queue.empty()) {
         auto key = key_queue.front().first;
         key_queue.pop();
 
         // insert additional logging
 
-        num_of_removed++;
-        Remove(key);
+        // not the virtual call: BlockingVerticalMap holds the write lock already
+        if (std::shared_ptr<Value> value = VerticalMap::Remove(key); value != nullptr) {
+            removed.emplace_back(key, std::move(value));
+        }
         RemoveFromUsageCounter(usage_counter, key);
     }
 
@@ -486,11 +267,12 @@ void VerticalMap<Value>::Shrink(std::unordered_map<Vertical, unsigned int>& usag
 
     shrink_invocations_++;
     time_spent_on_shrinking_ += 1;  // haven't implemented time measuring yet
+    return removed;
 }
 
 template <class Value>
 std::shared_ptr<Value> VerticalMap<Value>::Put(Vertical const& key, std::shared_ptr<Value> value) {
-    auto old_value = set_trie_.Associate(key.GetColumnIndices(), 0, std::move(value));
+    auto old_value = set_trie_.Associate(key, std::move(value));
     if (old_value == nullptr) size_++;
 
     return old_value;
@@ -498,17 +280,17 @@ std::shared_ptr<Value> VerticalMap<Value>::Put(Vertical const& key, std::shared_
 
 template <class Value>
 std::shared_ptr<Value const> VerticalMap<Value>::Get(Vertical const& key) const {
-    return set_trie_.Get(key.GetColumnIndices(), 0);
+    return set_trie_.Get(key);
 }
 
 template <class Value>
 std::shared_ptr<Value> VerticalMap<Value>::Get(Vertical const& key) {
-    return std::const_pointer_cast<Value>(set_trie_.Get(key.GetColumnIndices(), 0));
+    return std::const_pointer_cast<Value>(set_trie_.Get(key));
 }
 
 template <class Value>
 std::shared_ptr<Value const> VerticalMap<Value>::Get(Bitset const& key) const {
-    return set_trie_.Get(key, 0);
+    return set_trie_.Get(relation_->GetVertical(key));
 }
 
 // explicitly instantiate to solve template implementation linking issues
@@ -522,171 +304,60 @@ template class VerticalMap<VerticalInfo>;
 
 template class VerticalMap<Vertical>;
 
-template <class V>
-size_t BlockingVerticalMap<V>::GetSize() const {
-    std::shared_lock read_lock(read_write_mutex_);
-    return VerticalMap<V>::GetSize();
-}
-
-template <class V>
-bool BlockingVerticalMap<V>::IsEmpty() const {
-    std::shared_lock read_lock(read_write_mutex_);
-    return VerticalMap<V>::IsEmpty();
-}
-
-template <class V>
-std::shared_ptr<V const> BlockingVerticalMap<V>::Get(Vertical const& key) const {
-    std::shared_lock read_lock(read_write_mutex_);
-    return VerticalMap<V>::Get(key);
-}
-
-template <class V>
-std::shared_ptr<V const> BlockingVerticalMap<V>::Get(Bitset const& key) const {
-    std::shared_lock read_lock(read_write_mutex_);
-    return VerticalMap<V>::Get(key);
-}
-
-template <class V>
-bool BlockingVerticalMap<V>::ContainsKey(Vertical const& key) const {
-    std::shared_lock read_lock(read_write_mutex_);
-    return VerticalMap<V>::ContainsKey(key);
-}
-
 template <class V>
 std::shared_ptr<V> BlockingVerticalMap<V>::Put(Vertical const& key, std::shared_ptr<V> value) {
-    std::scoped_lock write_lock(read_write_mutex_);
-    return VerticalMap<V>::Put(key, value);
+    std::scoped_lock write_lock(write_mutex_);
+    return VerticalMap<V>::Put(key, std::move(value));
 }
 
 template <class V>
 std::shared_ptr<V> BlockingVerticalMap<V>::Remove(Vertical const& key) {
-    std::scoped_lock write_lock(read_write_mutex_);
+    std::scoped_lock write_lock(write_mutex_);
     return VerticalMap<V>::Remove(key);
 }
 
 template <class V>
 std::shared_ptr<V> BlockingVerticalMap<V>::Remove(Bitset const& key) {
-    std::scoped_lock write_lock(read_write_mutex_);
+    std::scoped_lock write_lock(write_mutex_);
     return VerticalMap<V>::Remove(key);
 }
 
-template <class V>
-std::shared_ptr<V> BlockingVerticalMap<V>::Get(Vertical const& key) {
-    std::shared_lock read_lock(read_write_mutex_);
-    return VerticalMap<V>::Get(key);
-}
-
-template <class V>
-std::unordered_set<Vertical> BlockingVerticalMap<V>::KeySet() {
-    std::shared_lock read_lock(read_write_mutex_);
-    return VerticalMap<V>::KeySet();
-}
-
-template <class V>
-std::vector<std::shared_ptr<V const>> BlockingVerticalMap<V>::Values() {
-    std::shared_lock read_lock(read_write_mutex_);
-    return VerticalMap<V>::Values();
-}
-
-template <class V>
-std::unordered_set<typename BlockingVerticalMap<V>::Entry> BlockingVerticalMap<V>::EntrySet() {
-    std::shared_lock read_lock(read_write_mutex_);
-    return VerticalMap<V>::EntrySet();
-}
-
-template <class V>
-std::vector<Vertical> BlockingVerticalMap<V>::GetSubsetKeys(Vertical const& vertical) const {
-    std::shared_lock read_lock(read_write_mutex_);
-    return VerticalMap<V>::GetSubsetKeys(vertical);
-}
-
-template <class V>
-std::vector<typename BlockingVerticalMap<V>::Entry> BlockingVerticalMap<V>::GetSubsetEntries(
-        Vertical const& vertical) const {
-    std::shared_lock read_lock(read_write_mutex_);
-    return VerticalMap<V>::GetSubsetEntries(vertical);
-}
-
-template <class V>
-typename BlockingVerticalMap<V>::Entry BlockingVerticalMap<V>::GetAnySubsetEntry(
-        Vertical const& vertical) const {
-    std::shared_lock read_lock(read_write_mutex_);
-    return VerticalMap<V>::GetAnySubsetEntry(vertical);
-}
-
-template <class V>
-typename BlockingVerticalMap<V>::Entry BlockingVerticalMap<V>::GetAnySubsetEntry(
-        Vertical const& vertical,
-        std::function<bool(Vertical const*, std::shared_ptr<V const>)> const& condition) const {
-    std::shared_lock read_lock(read_write_mutex_);
-    return VerticalMap<V>::GetAnySubsetEntry(vertical, condition);
-}
-
-template <class V>
-std::vector<typename BlockingVerticalMap<V>::Entry> BlockingVerticalMap<V>::GetSupersetEntries(
-        Vertical const& vertical) const {
-    std::shared_lock read_lock(read_write_mutex_);
-    return VerticalMap<V>::GetSupersetEntries(vertical);
-}
-
-template <class V>
-typename BlockingVerticalMap<V>::Entry BlockingVerticalMap<V>::GetAnySupersetEntry(
-        Vertical const& vertical) const {
-    std::shared_lock read_lock(read_write_mutex_);
-    return VerticalMap<V>::GetAnySupersetEntry(vertical);
-}
-
-template <class V>
-typename BlockingVerticalMap<V>::Entry BlockingVerticalMap<V>::GetAnySupersetEntry(
-        Vertical const& vertical,
-        std::function<bool(Vertical const*, std::shared_ptr<V const>)> condition) const {
-    std::shared_lock read_lock(read_write_mutex_);
-    return VerticalMap<V>::GetAnySupersetEntry(vertical, condition);
-}
-
-template <class V>
-std::vector<typename BlockingVerticalMap<V>::Entry>
-BlockingVerticalMap<V>::GetRestrictedSupersetEntries(Vertical const& vertical,
-                                                     Vertical const& exclusion) const {
-    std::shared_lock read_lock(read_write_mutex_);
-    return VerticalMap<V>::GetRestrictedSupersetEntries(vertical, exclusion);
-}
-
 template <class V>
 bool BlockingVerticalMap<V>::RemoveSupersetEntries(Vertical const& key) {
-    std::scoped_lock write_lock(read_write_mutex_);
+    std::scoped_lock write_lock(write_mutex_);
     return VerticalMap<V>::RemoveSupersetEntries(key);
 }
 
 template <class V>
 bool BlockingVerticalMap<V>::RemoveSubsetEntries(Vertical const& key) {
-    std::scoped_lock write_lock(read_write_mutex_);
+    std::scoped_lock write_lock(write_mutex_);
     return VerticalMap<V>::RemoveSubsetEntries(key);
 }
 
 template <class V>
 void BlockingVerticalMap<V>::Shrink(double factor, std::function<bool(Entry, Entry)> const& compare,
                                     std::function<bool(Entry)> const& can_remove) {
-    std::scoped_lock write_lock(read_write_mutex_);
+    std::scoped_lock write_lock(write_mutex_);
     VerticalMap<V>::Shrink(factor, compare, can_remove);
 }
 
 template <class V>
-void BlockingVerticalMap<V>::Shrink(std::unordered_map<Vertical, unsigned int>& usage_counter,
-                                    std::function<bool(Entry)> const& can_remove) {
-    std::scoped_lock write_lock(read_write_mutex_);
-    VerticalMap<V>::Shrink(usage_counter, can_remove);
+std::vector<typename BlockingVerticalMap<V>::Entry> BlockingVerticalMap<V>::Shrink(
+        std::unordered_map<Vertical, unsigned int>& usage_counter,
+        std::function<bool(Entry)> const& can_remove) {
+    std::scoped_lock write_lock(write_mutex_);
+    return VerticalMap<V>::Shrink(usage_counter, can_remove);
 }
 
 template <class V>
 long long BlockingVerticalMap<V>::GetShrinkInvocations() {
-    std::shared_lock read_lock(read_write_mutex_);
+    std::scoped_lock write_lock(write_mutex_);
     return VerticalMap<V>::GetShrinkInvocations();
 }
 
 template <class V>
 long long BlockingVerticalMap<V>::GetTimeSpentOnShrinking() {
-    std::shared_lock read_lock(read_write_mutex_);
+    std::scoped_lock write_lock(write_mutex_);
     return VerticalMap<V>::GetTimeSpentOnShrinking();
 }
 
@@ -1,13 +1,15 @@
 #pragma once
+#include <atomic>
 #include <functional>
 #include <memory>
-#include <shared_mutex>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
 
+#include "model/table/vertical_set_trie.h"
 #include "util/custom_hashes.h"
 
 namespace model {
@@ -21,79 +23,12 @@ class VerticalMap {
 protected:
     using Bitset = boost::dynamic_bitset<>;
 
-    // typename std::shared_ptr<Value> shared_ptr<Value>;
-
-    // Each node corresponds to a bit in a bitset. Each node also has a vector of the possible
-    // consequent set bits.
-    class SetTrie {
-    private:
-        size_t offset_;
-        size_t dimension_;
-        std::vector<std::unique_ptr<SetTrie>> subtries_;  // unique_ptr?
-        std::shared_ptr<Value> value_;
-
-        bool IsEmpty() const;
-
-    public:
-        explicit SetTrie(size_t dimension) : SetTrie(0, dimension) {}
-
-        SetTrie(size_t offset, size_t dimension) : offset_(offset), dimension_(dimension) {}
-
-        // Sets given key to a given value
-        // Returns the old value with ownership
-        // Not a const method as SetTrie gets changed
-        std::shared_ptr<Value> Associate(Bitset const& key, size_t next_bit,
-                                         std::shared_ptr<Value> value);
-
-        // Returns a pointer to the value mapped by the given key
-        std::shared_ptr<Value const> Get(Bitset const& key, size_t next_bit) const;
-
-        // Erases an entry with the given key
-        // Returns the old value with ownership
-        std::shared_ptr<Value> Remove(Bitset const& key, size_t next_bit);
-
-        // Gets the subtrie with the given index. If such a subtrie does not exist, creates one
-        // Not a const method as a SetTrie may be created
-        SetTrie* GetOrCreateSubTrie(size_t index);
-
-        // Gets the subtrie with the given index
-        // Non-const version of the method -- needed in getOrCreateSubtrie to manipulate SetTrie*
-        SetTrie* GetSubtrie(size_t index);
-
-        // Gets the subtrie with the given index
-        // Const version of the method
-        SetTrie const* GetSubtrie(size_t index) const;
-
-        // Calls collector on every trie that is a subset of the given subset_key
-        bool CollectSubsetKeys(
-                Bitset const& key, size_t next_bit, Bitset& subset_key,
-                std::function<bool(Bitset const&, std::shared_ptr<Value const>)> const& collector)
-                const;
-
-        // Calls collector on every trie that is a superset of the given subsetKey
-        bool CollectSupersetKeys(
-                Bitset const& key, size_t next_bit, Bitset& superset_key,
-                std::function<bool(Bitset const&, std::shared_ptr<Value const>)> const& collector)
-                const;
-
-        // Calls collector on every trie that is a superset of the given subsetKey with no bits from
-        // the blacklist
-        bool CollectRestrictedSupersetKeys(
-                Bitset const& key, Bitset const& blacklist, size_t next_bit, Bitset& superset_key,
-                std::function<void(Bitset const&, std::shared_ptr<Value const>)> const& collector)
-                const;
-
-        // Calls collector on every entry
-        void TraverseEntries(
-                Bitset& subset_key,
-                std::function<void(Bitset const&, std::shared_ptr<Value const>)> collector) const;
-    };
-
     RelationalSchema const* relation_;
-    size_t size_ = 0;
+    // read without the writer's lock by BlockingVerticalMap
+    std::atomic<size_t> size_ = 0;
     long long shrink_invocations_ = 0;
     long long time_spent_on_shrinking_ = 0;
-    SetTrie set_trie_;
+    VerticalSetTrie<Value> set_trie_;
 
     unsigned int RemoveFromUsageCounter(std::unordered_map<Vertical, unsigned int>& usage_counter,
                                         Vertical const& key);
@@ -102,7 +37,7 @@ public:
     using Entry = std::pair<Vertical, std::shared_ptr<Value const>>;
 
     explicit VerticalMap(RelationalSchema const* relation)
-        : relation_(relation), set_trie_(relation->GetNumColumns()) {}
+        : relation_(relation), set_trie_(relation) {}
 
     virtual size_t GetSize() const {
         return size_;
@@ -155,8 +90,9 @@ public:
      * */
     virtual void Shrink(double factor, std::function<bool(Entry, Entry)> const& compare,
                         std::function<bool(Entry)> const& can_remove);
-    virtual void Shrink(std::unordered_map<Vertical, unsigned int>& usage_counter,
-                        std::function<bool(Entry)> const& can_remove);
+    // returns the removed entries
+    virtual std::vector<Entry> Shrink(std::unordered_map<Vertical, unsigned int>& usage_counter,
+                                      std::function<bool(Entry)> const& can_remove);
 
     virtual long long GetShrinkInvocations() {
         return shrink_invocations_;
@@ -170,57 +106,32 @@ public:
 };
 
 /*
- * A version of VerticalMap for parallel processing. Uses reader-writer mutex for blocking.
+ * A version of VerticalMap for parallel processing. Readers do not block: the set trie allows them
+ * to run alongside a writer, only the modifications are serialized with a mutex.
  * */
 template <class V>
 class BlockingVerticalMap : public VerticalMap<V> {
 private:
-    // mutable нужен, чтобы const методы могли его лочить (т.к. меняется состояние мьютекса)
-    mutable std::shared_mutex read_write_mutex_;
-    // shared_mutex, scoped_lock, shared_lock
+    // modifications call each other through VerticalMap, so the mutex is never taken twice
+    std::mutex write_mutex_;
+
 public:
     using typename VerticalMap<V>::Entry;
     using typename VerticalMap<V>::Bitset;
 
     explicit BlockingVerticalMap(RelationalSchema const* relation) : VerticalMap<V>(relation) {}
 
-    virtual size_t GetSize() const override;
-    virtual bool IsEmpty() const override;
-
-    virtual std::shared_ptr<V const> Get(Vertical const& key) const override;
-    virtual std::shared_ptr<V const> Get(Bitset const& key) const override;
-    virtual bool ContainsKey(Vertical const& key) const override;
     virtual std::shared_ptr<V> Put(Vertical const& key, std::shared_ptr<V> value) override;
     virtual std::shared_ptr<V> Remove(Vertical const& key) override;
     virtual std::shared_ptr<V> Remove(Bitset const& key) override;
 
-    virtual std::shared_ptr<V> Get(Vertical const& key) override;
-
-    virtual std::unordered_set<Vertical> KeySet() override;
-    virtual std::vector<std::shared_ptr<V const>> Values() override;
-    virtual std::unordered_set<Entry> EntrySet() override;
-
-    virtual std::vector<Vertical> GetSubsetKeys(Vertical const& vertical) const override;
-    virtual std::vector<Entry> GetSubsetEntries(Vertical const& vertical) const override;
-    virtual Entry GetAnySubsetEntry(Vertical const& vertical) const override;
-    virtual Entry GetAnySubsetEntry(
-            Vertical const& vertical,
-            std::function<bool(Vertical const*, std::shared_ptr<V const>)> const& condition)
-            const override;
-    virtual std::vector<Entry> GetSupersetEntries(Vertical const& vertical) const override;
-    virtual Entry GetAnySupersetEntry(Vertical const& vertical) const override;
-    virtual Entry GetAnySupersetEntry(Vertical const& vertical,
-                                      std::function<bool(Vertical const*, std::shared_ptr<V const>)>
-                                              condition) const override;
-    virtual std::vector<Entry> GetRestrictedSupersetEntries(
-            Vertical const& vertical, Vertical const& exclusion) const override;
     virtual bool RemoveSupersetEntries(Vertical const& key) override;
     virtual bool RemoveSubsetEntries(Vertical const& key) override;
 
     virtual void Shrink(double factor, std::function<bool(Entry, Entry)> const& compare,
                         std::function<bool(Entry)> const& can_remove) override;
-    virtual void Shrink(std::unordered_map<Vertical, unsigned int>& usage_counter,
-                        std::function<bool(Entry)> const& can_remove) override;
+    virtual std::vector<Entry> Shrink(std::unordered_map<Vertical, unsigned int>& usage_counter,
+                                      std::function<bool(Entry)> const& can_remove) override;
 
     virtual long long GetShrinkInvocations() override;
     virtual long long GetTimeSpentOnShrinking() override;
@@ -0,0 +1,345 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "model/table/relational_schema.h"
+#include "model/table/vertical.h"
+
+namespace model {
+
+/* Prefix tree mapping column sets to values, the columns of a key are visited in ascending
+ * order. Nodes live in a segmented pool and refer to each other by 32-bit indices, the children
+ * of a node form a singly linked list sorted by column, so the size of a node does not depend on
+ * the width of the schema.
+ *
+ * Readers (Get and the ForEach* visitors) may run concurrently with one writer, writers have to
+ * be serialized by the caller. Links and values are published atomically and an unlinked node is
+ * reused only once no reader is left that could still be standing on it, so readers never block.
+ * Readers are counted per epoch: the nodes unlinked in one epoch wait only for the readers that
+ * entered before its end, so a steady stream of new readers does not keep them from reuse.
+ */
+template <typename Value>
+class VerticalSetTrie {
+public:
+    using ValuePtr = std::shared_ptr<Value>;
+    using ConstValuePtr = std::shared_ptr<Value const>;
+
+private:
+    using NodeIndex = std::uint32_t;
+
+    static constexpr NodeIndex kNoNode = std::numeric_limits<NodeIndex>::max();
+    static constexpr NodeIndex kRoot = 0;
+    // segment i holds 2^(kFirstSegmentBits + i) nodes, segments are never moved
+    static constexpr std::size_t kFirstSegmentBits = 6;
+    static constexpr std::size_t kSegmentsNum = 32 - kFirstSegmentBits;
+    static constexpr std::size_t kReaderSlotsNum = 8;
+    static constexpr std::size_t kCacheLineSize = 64;
+
+    struct Node {
+        // accessed by std::atomic_load and std::atomic_store only
+        ValuePtr value;
+        std::atomic<NodeIndex> first_child = kNoNode;
+        std::atomic<NodeIndex> next_sibling = kNoNode;
+        std::uint32_t column = 0;
+    };
+
+    // readers are counted in several slots to keep them from contending on one cache line, the
+    // readers of even and odd epochs separately
+    struct alignas(kCacheLineSize) ReaderSlot {
+        std::array<std::atomic<std::size_t>, 2> readers{};
+    };
+
+    class ReadGuard {
+    private:
+        std::atomic<std::size_t>& readers_;
+
+        static std::atomic<std::size_t>& Enter(VerticalSetTrie const& trie) {
+            ReaderSlot& slot = trie.reader_slots_[GetReaderSlotIndex()];
+            while (true) {
+                std::size_t const epoch = trie.epoch_.load();
+                std::atomic<std::size_t>& readers = slot.readers[epoch % 2];
+                readers.fetch_add(1);
+                // if the epoch has ended before the reader was counted, the writer may have found
+                // no readers of it and freed its nodes, the reader has to be counted in the next
+                if (trie.epoch_.load() == epoch) return readers;
+                readers.fetch_sub(1);
+            }
+        }
+
+    public:
+        explicit ReadGuard(VerticalSetTrie const& trie) : readers_(Enter(trie)) {}
+
+        ReadGuard(ReadGuard const&) = delete;
+        ReadGuard& operator=(ReadGuard const&) = delete;
+
+        ~ReadGuard() {
+            readers_.fetch_sub(1);
+        }
+    };
+
+    RelationalSchema const* schema_;
+    Vertical const empty_key_;
+    std::array<std::atomic<Node*>, kSegmentsNum> segments_{};
+    mutable std::array<ReaderSlot, kReaderSlotsNum> reader_slots_;
+    std::atomic<std::size_t> epoch_ = 0;
+    // only touched by the writer
+    NodeIndex nodes_num_ = 0;
+    std::vector<NodeIndex> free_nodes_;
+    // nodes unlinked in the current epoch
+    std::vector<NodeIndex> retired_nodes_;
+    // nodes unlinked in the previous epoch, waiting for its readers to leave
+    std::vector<NodeIndex> draining_nodes_;
+
+    static std::size_t GetReaderSlotIndex() {
+        thread_local std::size_t const slot_index =
+                std::hash<std::thread::id>{}(std::this_thread::get_id()) % kReaderSlotsNum;
+        return slot_index;
+    }
+
+    static std::size_t GetSegmentIndex(NodeIndex index) {
+        return std::bit_width((std::size_t{index} >> kFirstSegmentBits) + 1) - 1;
+    }
+
+    static std::size_t GetSegmentStart(std::size_t segment_index) {
+        return ((std::size_t{1} << segment_index) - 1) << kFirstSegmentBits;
+    }
+
+    Node& GetNode(NodeIndex index) const {
+        std::size_t const segment_index = GetSegmentIndex(index);
+        return segments_[segment_index].load()[index - GetSegmentStart(segment_index)];
+    }
+
+    NodeIndex CreateNode(std::uint32_t column, NodeIndex next_sibling) {
+        NodeIndex index;
+        if (!free_nodes_.empty()) {
+            index = free_nodes_.back();
+            free_nodes_.pop_back();
+        } else {
+            index = nodes_num_++;
+            std::size_t const segment_index = GetSegmentIndex(index);
+            if (index == GetSegmentStart(segment_index)) {
+                std::size_t const segment_size = std::size_t{1}
+                                                 << (kFirstSegmentBits + segment_index);
+                segments_[segment_index].store(new Node[segment_size]);
+            }
+        }
+        // the node is not reachable yet, it is published by the store into its predecessor
+        Node& node = GetNode(index);
+        node.column = column;
+        node.first_child.store(kNoNode, std::memory_order_relaxed);
+        node.next_sibling.store(next_sibling, std::memory_order_relaxed);
+        return index;
+    }
+
+    NodeIndex FindChild(NodeIndex parent, std::size_t column) const {
+        NodeIndex child = GetNode(parent).first_child.load();
+        while (child != kNoNode) {
+            Node const& node = GetNode(child);
+            if (node.column >= column) return node.column == column ? child : kNoNode;
+            child = node.next_sibling.load();
+        }
+        return kNoNode;
+    }
+
+    NodeIndex GetOrCreateChild(NodeIndex parent, std::size_t column) {
+        std::atomic<NodeIndex>* link = &GetNode(parent).first_child;
+        NodeIndex child = link->load();
+        while (child != kNoNode) {
+            Node& node = GetNode(child);
+            if (node.column == column) return child;
+            if (node.column > column) break;
+            link = &node.next_sibling;
+            child = link->load();
+        }
+        NodeIndex const new_child = CreateNode(column, child);
+        link->store(new_child);
+        return new_child;
+    }
+
+    bool HasReaders(std::size_t epoch) const {
+        for (ReaderSlot const& slot : reader_slots_) {
+            if (slot.readers[epoch % 2].load() != 0) return true;
+        }
+        return false;
+    }
+
+    /* The nodes retired in an epoch are freed once the readers of that epoch are gone: readers
+     * that enter later cannot reach them, they are unlinked already. The epoch ends only after the
+     * previous one has drained, so the readers of the two epochs sharing a counter never mix.
+     */
+    void ReclaimRetiredNodes() {
+        std::size_t const epoch = epoch_.load();
+        if (!draining_nodes_.empty()) {
+            if (HasReaders(epoch - 1)) return;
+            free_nodes_.insert(free_nodes_.end(), draining_nodes_.begin(), draining_nodes_.end());
+            draining_nodes_.clear();
+        }
+        if (retired_nodes_.empty()) return;
+        std::swap(retired_nodes_, draining_nodes_);
+        epoch_.store(epoch + 1);
+        if (!HasReaders(epoch)) {
+            free_nodes_.insert(free_nodes_.end(), draining_nodes_.begin(), draining_nodes_.end());
+            draining_nodes_.clear();
+        }
+    }
+
+    template <typename Visitor>
+    bool VisitSubsets(NodeIndex node_index, Vertical const& key, Vertical const& path,
+                      Visitor& visitor) const {
+        Node const& node = GetNode(node_index);
+        if (ValuePtr value = std::atomic_load(&node.value); value != nullptr) {
+            if (!visitor(path, ConstValuePtr(std::move(value)))) return false;
+        }
+        for (NodeIndex child = node.first_child.load(); child != kNoNode;
+             child = GetNode(child).next_sibling.load()) {
+            std::size_t const column = GetNode(child).column;
+            if (!key.Contains(column)) continue;
+            if (!VisitSubsets(child, key, path.Union(*schema_->GetColumn(column)), visitor)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // next_column is the least column of key that is not on the path yet
+    template <typename Visitor>
+    bool VisitSupersets(NodeIndex node_index, Vertical const& key, std::size_t next_column,
+                        Vertical const* excluded, Vertical const& path, Visitor& visitor) const {
+        Node const& node = GetNode(node_index);
+        if (next_column == boost::dynamic_bitset<>::npos) {
+            if (ValuePtr value = std::atomic_load(&node.value); value != nullptr) {
+                if (!visitor(path, ConstValuePtr(std::move(value)))) return false;
+            }
+        }
+        for (NodeIndex child = node.first_child.load(); child != kNoNode;
+             child = GetNode(child).next_sibling.load()) {
+            std::size_t const column = GetNode(child).column;
+            // the missing column of key can no longer appear deeper
+            if (next_column != boost::dynamic_bitset<>::npos && column > next_column) break;
+            if (excluded != nullptr && excluded->Contains(column)) continue;
+            std::size_t const child_next_column =
+                    column == next_column ? key.FindNext(column) : next_column;
+            if (!VisitSupersets(child, key, child_next_column, excluded,
+                                path.Union(*schema_->GetColumn(column)), visitor)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    explicit VerticalSetTrie(RelationalSchema const* schema)
+        : schema_(schema), empty_key_(*Vertical::EmptyVertical(schema)) {
+        CreateNode(0, kNoNode);
+    }
+
+    VerticalSetTrie(VerticalSetTrie const&) = delete;
+    VerticalSetTrie& operator=(VerticalSetTrie const&) = delete;
+
+    ~VerticalSetTrie() {
+        for (std::atomic<Node*>& segment : segments_) {
+            delete[] segment.load();
+        }
+    }
+
+    ConstValuePtr Get(Vertical const& key) const {
+        ReadGuard guard(*this);
+        NodeIndex node = kRoot;
+        for (std::size_t column = key.FindFirst(); column != boost::dynamic_bitset<>::npos;
+             column = key.FindNext(column)) {
+            node = FindChild(node, column);
+            if (node == kNoNode) return nullptr;
+        }
+        return std::atomic_load(&GetNode(node).value);
+    }
+
+    /* Returns the previous value of the key, nullptr if there was none. */
+    ValuePtr Associate(Vertical const& key, ValuePtr value) {
+        NodeIndex node = kRoot;
+        for (std::size_t column = key.FindFirst(); column != boost::dynamic_bitset<>::npos;
+             column = key.FindNext(column)) {
+            node = GetOrCreateChild(node, column);
+        }
+        return std::atomic_exchange(&GetNode(node).value, std::move(value));
+    }
+
+    /* Returns the removed value, nullptr if the key was absent. Nodes left without a value and
+     * without children are unlinked.
+     */
+    ValuePtr Remove(Vertical const& key) {
+        // the nodes on the key's path with the links that lead to them
+        std::vector<std::pair<std::atomic<NodeIndex>*, NodeIndex>> path;
+        NodeIndex node = kRoot;
+        for (std::size_t column = key.FindFirst(); column != boost::dynamic_bitset<>::npos;
+             column = key.FindNext(column)) {
+            std::atomic<NodeIndex>* link = &GetNode(node).first_child;
+            for (node = link->load(); node != kNoNode && GetNode(node).column < column;
+                 node = link->load()) {
+                link = &GetNode(node).next_sibling;
+            }
+            if (node == kNoNode || GetNode(node).column != column) return nullptr;
+            path.emplace_back(link, node);
+        }
+
+        ValuePtr removed_value = std::atomic_exchange(&GetNode(node).value, ValuePtr{});
+        if (removed_value == nullptr) return nullptr;
+        for (auto it = path.rbegin(); it != path.rend(); ++it) {
+            auto [link, index] = *it;
+            Node& path_node = GetNode(index);
+            if (std::atomic_load(&path_node.value) != nullptr ||
+                path_node.first_child.load() != kNoNode) {
+                break;
+            }
+            // readers standing on the node still get to its siblings
+            link->store(path_node.next_sibling.load());
+            retired_nodes_.push_back(index);
+        }
+        ReclaimRetiredNodes();
+        return removed_value;
+    }
+
+    /* Calls visitor(key, value) for every entry whose key is a subset of the given one, stops
+     * once the visitor returns false. Returns false if it was stopped.
+     */
+    template <typename Visitor>
+    bool ForEachSubset(Vertical const& key, Visitor&& visitor) const {
+        ReadGuard guard(*this);
+        return VisitSubsets(kRoot, key, empty_key_, visitor);
+    }
+
+    /* Same as ForEachSubset for supersets of the key, keys that contain a column of excluded are
+     * skipped.
+     */
+    template <typename Visitor>
+    bool ForEachSuperset(Vertical const& key, Visitor&& visitor,
+                         Vertical const* excluded = nullptr) const {
+        ReadGuard guard(*this);
+        return VisitSupersets(kRoot, key, key.FindFirst(), excluded, empty_key_, visitor);
+    }
+
+    template <typename Visitor>
+    bool ForEachEntry(Visitor&& visitor) const {
+        return ForEachSuperset(empty_key_, std::forward<Visitor>(visitor));
+    }
+
+    /* Number of the nodes ever allocated, the root included. Freed nodes are taken before new
+     * ones are allocated. Only for the writer to call.
+     */
+    std::size_t GetNumAllocatedNodes() const {
+        return nodes_num_;
+    }
+};
+
+}  // namespace model
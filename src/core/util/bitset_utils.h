@@ -1,5 +1,11 @@
 #pragma once
 
+#include <bitset>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
 #include <boost/dynamic_bitset.hpp>
 
 namespace util {
@@ -30,4 +36,133 @@ std::vector<Index> BitsetToIndices(boost::dynamic_bitset<> const& bitset) {
     return indices;
 }
 
+/* Uniform interface over attribute sets of fixed (std::bitset<N>) and dynamic
+ * (boost::dynamic_bitset<>) width. Allows to write an algorithm once and to instantiate it with
+ * the narrowest representation that fits the relation: fixed-width bitsets live inline, do not
+ * allocate, and their word-wise operations are unrolled and vectorized by the compiler.
+ */
+template <typename Bitset>
+struct BitsetTraits;
+
+template <std::size_t N>
+struct BitsetTraits<std::bitset<N>> {
+    using Bitset = std::bitset<N>;
+
+    static constexpr std::size_t kNpos = boost::dynamic_bitset<>::npos;
+
+    static constexpr bool Fits(std::size_t num_columns) {
+        return num_columns <= N;
+    }
+
+    static Bitset Create([[maybe_unused]] std::size_t num_columns) {
+        assert(Fits(num_columns));
+        return Bitset();
+    }
+
+    static Bitset FromDynamic(boost::dynamic_bitset<> const& bitset) {
+        assert(Fits(bitset.size()));
+        Bitset result;
+        for (std::size_t i = bitset.find_first(); i != boost::dynamic_bitset<>::npos;
+             i = bitset.find_next(i)) {
+            result.set(i);
+        }
+        return result;
+    }
+
+    static boost::dynamic_bitset<> ToDynamic(Bitset const& bitset, std::size_t num_columns) {
+        boost::dynamic_bitset<> result(num_columns);
+        ForEach(bitset, [&result](std::size_t i) { result.set(i); });
+        return result;
+    }
+
+    static bool IsSubset(Bitset const& subset, Bitset const& superset) {
+        return (subset & ~superset).none();
+    }
+
+    static bool Intersects(Bitset const& lhs, Bitset const& rhs) {
+        return (lhs & rhs).any();
+    }
+
+    // Compares bitsets as unsigned integers, like boost::dynamic_bitset<>::operator< does
+    static bool Less(Bitset const& lhs, Bitset const& rhs) {
+        constexpr std::size_t kWordBits = std::numeric_limits<unsigned long long>::digits;
+        Bitset const word_mask(std::numeric_limits<unsigned long long>::max());
+        for (std::size_t word = (N + kWordBits - 1) / kWordBits; word-- > 0;) {
+            unsigned long long const l = ((lhs >> (word * kWordBits)) & word_mask).to_ullong();
+            unsigned long long const r = ((rhs >> (word * kWordBits)) & word_mask).to_ullong();
+            if (l != r) return l < r;
+        }
+        return false;
+    }
+
+    // Both return kNpos if there is no next set bit
+    static std::size_t FindFirst(Bitset const& bitset) {
+        std::size_t const i = bitset._Find_first();
+        return i == N ? kNpos : i;
+    }
+
+    static std::size_t FindNext(Bitset const& bitset, std::size_t prev) {
+        std::size_t const i = bitset._Find_next(prev);
+        return i == N ? kNpos : i;
+    }
+
+    template <typename F>
+    static void ForEach(Bitset const& bitset, F f) {
+        for (std::size_t i = bitset._Find_first(); i != N; i = bitset._Find_next(i)) {
+            f(i);
+        }
+    }
+};
+
+template <>
+struct BitsetTraits<boost::dynamic_bitset<>> {
+    using Bitset = boost::dynamic_bitset<>;
+
+    static constexpr std::size_t kNpos = Bitset::npos;
+
+    static constexpr bool Fits(std::size_t) {
+        return true;
+    }
+
+    static Bitset Create(std::size_t num_columns) {
+        return Bitset(num_columns);
+    }
+
+    static Bitset FromDynamic(Bitset const& bitset) {
+        return bitset;
+    }
+
+    static Bitset ToDynamic(Bitset const& bitset, [[maybe_unused]] std::size_t num_columns) {
+        assert(bitset.size() == num_columns);
+        return bitset;
+    }
+
+    static bool IsSubset(Bitset const& subset, Bitset const& superset) {
+        return subset.is_subset_of(superset);
+    }
+
+    static bool Intersects(Bitset const& lhs, Bitset const& rhs) {
+        return lhs.intersects(rhs);
+    }
+
+    static bool Less(Bitset const& lhs, Bitset const& rhs) {
+        return lhs < rhs;
+    }
+
+    static std::size_t FindFirst(Bitset const& bitset) {
+        return bitset.find_first();
+    }
+
+    static std::size_t FindNext(Bitset const& bitset, std::size_t prev) {
+        return bitset.find_next(prev);
+    }
+
+    template <typename F>
+    static void ForEach(Bitset const& bitset, F f) {
+        for (std::size_t i = bitset.find_first(); i != Bitset::npos; i = bitset.find_next(i)) {
+            f(i);
+        }
+    }
+};
+
 }  // namespace util
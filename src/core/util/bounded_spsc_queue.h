@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace util {
+
+/* Ring buffer for one producer thread and one consumer thread. Push blocks while the queue is full
+ * and Pop blocks while it is empty, both return immediately once the queue is closed. Elements
+ * pushed before Close() are still popped. Pushes and pops that do not block take no locks: only a
+ * blocked thread takes the mutex to sleep on the condition variable, the other side takes it to
+ * wake it up.
+ */
+template <typename T>
+class BoundedSpscQueue {
+private:
+    static constexpr std::size_t kCacheLineSize = 64;
+
+    std::vector<std::optional<T>> buffer_;
+    // index of the next element to pop, only written by the consumer
+    alignas(kCacheLineSize) std::atomic<std::size_t> head_ = 0;
+    // index of the next element to push, only written by the producer
+    alignas(kCacheLineSize) std::atomic<std::size_t> tail_ = 0;
+    std::atomic<bool> closed_ = false;
+    std::mutex mutex_;
+    // signalled on every push, pop and close while some thread is blocked
+    std::condition_variable changed_;
+    std::atomic<std::size_t> waiters_ = 0;
+
+    /* A waiter is counted before it checks the condition and a notifier checks the counter after
+     * it changes the state, so either the waiter sees the change or it is woken up. */
+    template <typename Predicate>
+    void WaitUntil(Predicate const& ready) {
+        if (ready()) return;
+        std::unique_lock lock(mutex_);
+        waiters_.fetch_add(1);
+        // pairs with the fence in Notify
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        changed_.wait(lock, ready);
+        waiters_.fetch_sub(1);
+    }
+
+    void Notify() noexcept {
+        // keeps the check from being reordered before the release store of the change
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load() == 0) return;
+        // the waiter holds the mutex from its check until it sleeps, so it cannot miss the signal
+        std::lock_guard lock(mutex_);
+        changed_.notify_all();
+    }
+
+public:
+    explicit BoundedSpscQueue(std::size_t capacity) : buffer_(capacity) {
+        assert(capacity > 0);
+    }
+
+    BoundedSpscQueue(BoundedSpscQueue const&) = delete;
+    BoundedSpscQueue& operator=(BoundedSpscQueue const&) = delete;
+
+    /* Returns false without pushing if the queue is closed. */
+    bool Push(T value) {
+        std::size_t const tail = tail_.load(std::memory_order_relaxed);
+        WaitUntil([this, tail]() {
+            return closed_.load() || tail - head_.load(std::memory_order_acquire) < buffer_.size();
+        });
+        if (closed_.load()) return false;
+        buffer_[tail % buffer_.size()] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        Notify();
+        return true;
+    }
+
+    /* Returns std::nullopt if the queue is closed and all the pushed elements were popped. */
+    std::optional<T> Pop() {
+        std::size_t const head = head_.load(std::memory_order_relaxed);
+        WaitUntil([this, head]() {
+            return closed_.load() || tail_.load(std::memory_order_acquire) != head;
+        });
+        // the queue is closed then, and everything pushed before the close is visible once the
+        // close is observed
+        if (tail_.load(std::memory_order_acquire) == head) return std::nullopt;
+        std::optional<T>& slot = buffer_[head % buffer_.size()];
+        std::optional<T> value = std::move(slot);
+        slot.reset();
+        head_.store(head + 1, std::memory_order_release);
+        Notify();
+        return value;
+    }
+
+    /* May be called from any thread, wakes up the blocked producer and consumer. */
+    void Close() noexcept {
+        closed_.store(true);
+        Notify();
+    }
+
+    bool IsClosed() const noexcept {
+        return closed_.load();
+    }
+
+    std::size_t GetCapacity() const noexcept {
+        return buffer_.size();
+    }
+};
+
+}  // namespace util
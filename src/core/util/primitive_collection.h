@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <list>
 #include <mutex>
 
@@ -13,17 +14,28 @@ class PrimitiveCollection {
 private:
     std::list<T> collection_;
     std::mutex mutable mutex_;
+    std::function<void(T const&)> consumer_;
 
 public:
     void Register(T primitive) {
         std::scoped_lock lock(mutex_);
         collection_.push_back(std::move(primitive));
+        if (consumer_) consumer_(collection_.back());
     }
 
     template <typename... Args>
     void Register(Args&&... args) {
         std::scoped_lock lock(mutex_);
         collection_.emplace_back(std::forward<Args>(args)...);
+        if (consumer_) consumer_(collection_.back());
+    }
+
+    /* Sets the function that is passed every newly registered instance. It is called under the
+     * lock of the collection, so it is never called concurrently, but it may be called from any
+     * thread that registers instances. Must not be changed while instances are being registered.
+     */
+    void SetConsumer(std::function<void(T const&)> consumer) noexcept {
+        consumer_ = std::move(consumer);
     }
 
     void Clear() noexcept {
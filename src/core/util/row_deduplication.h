@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "util/parallel_for.h"
+
+namespace util {
+
+/* Rows of a table that are left after its duplicate rows are collapsed */
+struct DeduplicatedRows {
+    // indices of the kept rows in ascending order, every one is the first occurrence of its tuple
+    std::vector<size_t> kept_rows;
+    // weights[i] is the number of rows equal to kept_rows[i], the row itself included
+    std::vector<size_t> weights;
+};
+
+/* Finds the equal rows among the rows [0, num_rows) of a table. hash(row) must be equal for equal
+ * rows, equal(first, second) tells whether two rows are equal. The rows are hashed in parallel,
+ * then every thread groups the rows whose hashes fall into its shard, so only the rows with equal
+ * hashes are compared. threads_num == 0 means all the hardware threads.
+ */
+template <typename Hash, typename Equal>
+DeduplicatedRows DeduplicateRows(size_t num_rows, Hash const& hash, Equal const& equal,
+                                 unsigned threads_num) {
+    if (threads_num == 0) {
+        threads_num = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t const shards_num = std::max<size_t>(1, std::min<size_t>(threads_num, num_rows));
+    std::vector<size_t> shards(shards_num);
+    std::iota(shards.begin(), shards.end(), 0);
+
+    std::vector<size_t> hashes(num_rows);
+    util::ParallelForeach(shards.begin(), shards.end(), threads_num, [&](size_t shard) {
+        size_t const end = num_rows * (shard + 1) / shards_num;
+        for (size_t row = num_rows * shard / shards_num; row < end; ++row) {
+            hashes[row] = hash(row);
+        }
+    });
+
+    // first_occurrences[row] is the first row equal to row
+    std::vector<size_t> first_occurrences(num_rows);
+    util::ParallelForeach(shards.begin(), shards.end(), threads_num, [&](size_t shard) {
+        std::unordered_multimap<size_t, size_t> first_occurrences_by_hash;
+        for (size_t row = 0; row < num_rows; ++row) {
+            size_t const row_hash = hashes[row];
+            if (row_hash % shards_num != shard) continue;
+            auto [begin, end] = first_occurrences_by_hash.equal_range(row_hash);
+            auto it = std::find_if(begin, end, [&equal, row](auto const& entry) {
+                return equal(entry.second, row);
+            });
+            if (it == end) {
+                first_occurrences_by_hash.emplace(row_hash, row);
+                first_occurrences[row] = row;
+            } else {
+                first_occurrences[row] = it->second;
+            }
+        }
+    });
+
+    DeduplicatedRows deduplicated;
+    for (size_t row = 0; row < num_rows; ++row) {
+        size_t const first_occurrence = first_occurrences[row];
+        if (first_occurrence == row) {
+            // the entry of a kept row is not needed anymore, it holds the row's index among the
+            // kept ones from now on
+            first_occurrences[row] = deduplicated.kept_rows.size();
+            deduplicated.kept_rows.push_back(row);
+            deduplicated.weights.push_back(1);
+        } else {
+            ++deduplicated.weights[first_occurrences[first_occurrence]];
+        }
+    }
+    return deduplicated;
+}
+
+}  // namespace util
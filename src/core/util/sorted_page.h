@@ -0,0 +1,48 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace util {
+
+/* Page size of the highlights the verifiers log, the values of the other rows are not retrieved */
+inline constexpr size_t kNumVisualizedHighlights = 20;
+
+/* Returns the elements that would take the positions [offset, offset + limit) if the elements were
+ * stable sorted by compare. Only the page itself is sorted, the elements before it are just
+ * partitioned off, so a page costs O(n + limit * log(limit)) instead of a full sort. The elements
+ * themselves are not reordered and only the page is copied.
+ */
+template <typename T, typename Compare>
+std::vector<T> GetSortedPage(std::vector<T> const& elements, Compare const& compare, size_t offset,
+                             size_t limit) {
+    if (offset >= elements.size()) {
+        return {};
+    }
+    size_t const page_end = offset + std::min(limit, elements.size() - offset);
+
+    std::vector<T const*> order;
+    order.reserve(elements.size());
+    for (T const& element : elements) {
+        order.push_back(&element);
+    }
+    // equal elements keep their relative order, so consecutive pages neither repeat nor skip them
+    auto const stable_compare = [&compare](T const* first, T const* second) {
+        if (compare(*first, *second)) return true;
+        if (compare(*second, *first)) return false;
+        return first < second;
+    };
+    std::nth_element(order.begin(), order.begin() + offset, order.end(), stable_compare);
+    std::partial_sort(order.begin() + offset, order.begin() + page_end, order.end(),
+                      stable_compare);
+
+    std::vector<T> page;
+    page.reserve(page_end - offset);
+    for (size_t i = offset; i < page_end; ++i) {
+        page.push_back(*order[i]);
+    }
+    return page;
+}
+
+}  // namespace util
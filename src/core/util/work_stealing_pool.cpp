@@ -0,0 +1,111 @@
+#include "work_stealing_pool.h"
+
+#include <cassert>
+#include <utility>
+
+namespace util {
+
+thread_local WorkStealingPool* WorkStealingPool::current_pool_ = nullptr;
+thread_local std::size_t WorkStealingPool::current_worker_ = 0;
+
+WorkStealingPool::WorkStealingPool(unsigned threads_num) {
+    assert(threads_num != 0);
+    workers_.reserve(threads_num);
+    for (unsigned i = 0; i < threads_num; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    threads_.reserve(threads_num);
+    for (std::size_t i = 0; i < threads_num; ++i) {
+        threads_.emplace_back(&WorkStealingPool::Run, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::scoped_lock lock(state_mutex_);
+        is_stopped_ = true;
+    }
+    work_available_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::Submit(Task task) {
+    std::size_t const worker_index = current_pool_ == this
+                                             ? current_worker_
+                                             : next_worker_.fetch_add(1) % workers_.size();
+    {
+        /* Counters are increased before the task becomes visible, so that unfinished_ cannot
+         * drop to zero while the task is still about to be executed.
+         */
+        std::scoped_lock lock(state_mutex_);
+        ++queued_;
+        ++unfinished_;
+    }
+    {
+        Worker& worker = *workers_[worker_index];
+        std::scoped_lock lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+    work_available_.notify_one();
+}
+
+std::optional<WorkStealingPool::Task> WorkStealingPool::TryPop(std::size_t worker_index) {
+    std::optional<Task> task;
+    {
+        Worker& own = *workers_[worker_index];
+        std::scoped_lock lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+        }
+    }
+    for (std::size_t i = 1; !task.has_value() && i < workers_.size(); ++i) {
+        Worker& victim = *workers_[(worker_index + i) % workers_.size()];
+        std::scoped_lock lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+    }
+    if (task.has_value()) {
+        std::scoped_lock lock(state_mutex_);
+        --queued_;
+    }
+    return task;
+}
+
+void WorkStealingPool::Run(std::size_t worker_index) {
+    current_pool_ = this;
+    current_worker_ = worker_index;
+    while (true) {
+        std::optional<Task> task = TryPop(worker_index);
+        if (!task.has_value()) {
+            std::unique_lock lock(state_mutex_);
+            work_available_.wait(lock, [this]() { return queued_ != 0 || is_stopped_; });
+            if (is_stopped_) return;
+            continue;
+        }
+
+        try {
+            (*task)();
+        } catch (...) {
+            std::scoped_lock lock(state_mutex_);
+            if (exception_ == nullptr) exception_ = std::current_exception();
+        }
+
+        std::scoped_lock lock(state_mutex_);
+        if (--unfinished_ == 0) all_done_.notify_all();
+    }
+}
+
+void WorkStealingPool::Wait() {
+    std::unique_lock lock(state_mutex_);
+    all_done_.wait(lock, [this]() { return unfinished_ == 0; });
+    if (exception_ != nullptr) {
+        std::rethrow_exception(std::exchange(exception_, nullptr));
+    }
+}
+
+}  // namespace util
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace util {
+
+/* Fixed-size thread pool in which every worker owns a deque of tasks.
+ * A task submitted from inside a worker is pushed to the back of that worker's deque and is
+ * later popped from the back by the same worker, so freshly spawned subtasks stay on the core
+ * that produced them. An idle worker steals the oldest task from the front of another worker's
+ * deque. Tasks submitted from outside of the pool are spread over the deques round-robin.
+ * Tasks may submit new tasks, Wait() returns only when there is nothing left to run.
+ */
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+
+    std::mutex state_mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable all_done_;
+    /* Number of tasks waiting in the deques */
+    std::size_t queued_ = 0;
+    /* Number of tasks that are either waiting or running */
+    std::size_t unfinished_ = 0;
+    bool is_stopped_ = false;
+    std::exception_ptr exception_;
+
+    std::atomic<std::size_t> next_worker_ = 0;
+
+    static thread_local WorkStealingPool* current_pool_;
+    static thread_local std::size_t current_worker_;
+
+    std::optional<Task> TryPop(std::size_t worker_index);
+    void Run(std::size_t worker_index);
+
+public:
+    explicit WorkStealingPool(unsigned threads_num);
+
+    WorkStealingPool(WorkStealingPool const&) = delete;
+    WorkStealingPool& operator=(WorkStealingPool const&) = delete;
+
+    ~WorkStealingPool();
+
+    void Submit(Task task);
+
+    /* Blocks until all submitted tasks (including the ones submitted by other tasks) are
+     * finished. Rethrows the first exception thrown by a task, if any.
+     */
+    void Wait();
+
+    std::size_t GetThreadsNum() const noexcept {
+        return threads_.size();
+    }
+};
+
+}  // namespace util
@@ -18,9 +18,10 @@ namespace {
 namespace py = pybind11;
 using algos::Algorithm;
 auto const kVoidIndex = std::type_index{typeid(void)};
+}  // namespace
 
+namespace python_bindings {
 void ConfigureAlgo(Algorithm& algorithm, py::kwargs const& kwargs) {
-    using python_bindings::PyToAny;
     algos::ConfigureFromFunction(
             algorithm, [&kwargs, &algorithm](std::string_view option_name) -> boost::any {
                 std::type_index type_index = algorithm.GetTypeIndex(option_name);
@@ -30,9 +31,7 @@ void ConfigureAlgo(Algorithm& algorithm, py::kwargs const& kwargs) {
                                : boost::any{};
             });
 }
-}  // namespace
 
-namespace python_bindings {
 void BindMainClasses(py::module_& main_module) {
     using namespace pybind11::literals;
 
@@ -102,6 +101,10 @@ void BindMainClasses(py::module_& main_module) {
                         return res;
                     },
                     "Get option values represented as the closest Python type")
+            .def("is_result_incomplete", &Algorithm::IsResultIncomplete,
+                 "Whether the last execution was stopped early, e.g. by the time limit. Only "
+                 "the algorithms that check for a stop while running accept the time_limit "
+                 "option. The results found until then are still available.")
             .def(
                     "execute",
                     [](Algorithm& algo, py::kwargs const& kwargs) {
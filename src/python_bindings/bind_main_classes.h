@@ -2,6 +2,9 @@
 
 #include <pybind11/pybind11.h>
 
+#include "algorithms/algorithm.h"
+
 namespace python_bindings {
+void ConfigureAlgo(algos::Algorithm& algorithm, pybind11::kwargs const& kwargs);
 void BindMainClasses(pybind11::module_& main_module);
 }  // namespace python_bindings
@@ -9,7 +9,9 @@
 #include "cfd/bind_cfd.h"
 #include "data/bind_data_types.h"
 #include "dd/bind_split.h"
+#include "dynamic/bind_dynamic_fd.h"
 #include "dynamic/bind_dynamic_fd_verification.h"
+#include "dynamic/bind_dynamic_ucc.h"
 #include "fd/bind_fd.h"
 #include "fd/bind_fd_verification.h"
 #include "gfd/bind_gfd_verification.h"
@@ -38,7 +40,8 @@ PYBIND11_MODULE(desbordante, module) {
     for (auto bind_func :
          {BindMainClasses, BindDataTypes, BindFd, BindCfd, BindAr, BindUcc, BindAc, BindOd,
           BindFdVerification, BindMfdVerification, BindUccVerification, BindStatistics, BindInd,
-          BindGfdVerification, BindSplit, BindDynamicFdVerification}) {
+          BindGfdVerification, BindSplit, BindDynamicFdVerification, BindDynamicFd,
+          BindDynamicUcc}) {
         bind_func(module);
     }
 }
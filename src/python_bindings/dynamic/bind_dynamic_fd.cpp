@@ -0,0 +1,19 @@
+#include "dynamic/bind_dynamic_fd.h"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "algorithms/fd/dynfd/dynfd.h"
+#include "algorithms/fd/fd_algorithm.h"
+#include "py_util/bind_primitive.h"
+
+namespace python_bindings {
+void BindDynamicFd(pybind11::module_& main_module) {
+    using namespace algos;
+
+    // FdAlgorithm is bound by BindFd, get_fds returns the cover after the last execution
+    auto algos_module = main_module.def_submodule("dynamic_fd").def_submodule("algorithms");
+    algos_module.attr("Default") =
+            detail::RegisterAlgorithm<dynfd::DynFD, FDAlgorithm>(algos_module, "DynFD");
+}
+}  // namespace python_bindings
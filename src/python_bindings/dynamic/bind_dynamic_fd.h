@@ -0,0 +1,7 @@
+#pragma once
+
+#include <pybind11/pybind11.h>
+
+namespace python_bindings {
+void BindDynamicFd(pybind11::module_& main_module);
+}  // namespace python_bindings
@@ -0,0 +1,19 @@
+#include "dynamic/bind_dynamic_ucc.h"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "algorithms/ucc/dynucc/dynucc.h"
+#include "algorithms/ucc/ucc_algorithm.h"
+#include "py_util/bind_primitive.h"
+
+namespace python_bindings {
+void BindDynamicUcc(pybind11::module_& main_module) {
+    using namespace algos;
+
+    // UccAlgorithm is bound by BindUcc, get_uccs returns the UCCs after the last execution
+    auto algos_module = main_module.def_submodule("dynamic_ucc").def_submodule("algorithms");
+    algos_module.attr("Default") =
+            detail::RegisterAlgorithm<dynucc::DynUCC, UCCAlgorithm>(algos_module, "DynUCC");
+}
+}  // namespace python_bindings
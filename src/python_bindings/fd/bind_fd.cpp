@@ -1,13 +1,19 @@
 #include "bind_fd.h"
 
+#include <array>
+#include <tuple>
+#include <vector>
+
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
 #include "algorithms/fd/fd.h"
 #include "algorithms/fd/fd_algorithm.h"
 #include "algorithms/fd/mining_algorithms.h"
+#include "algorithms/fd/pyrocommon/model/confidence_interval.h"
 #include "config/indices/type.h"
 #include "py_util/bind_primitive.h"
+#include "py_util/primitive_stream.h"
 #include "util/bitset_utils.h"
 
 namespace {
@@ -27,6 +33,36 @@ py::tuple MakeFdNameTuple(FD const& fd) {
     auto [lhs, rhs] = fd.ToNameTuple();
     return py::make_tuple(VectorToTuple(std::move(lhs)), std::move(rhs));
 }
+
+// Takes the bound algorithm type, PliBasedFDAlgorithm is not registered with pybind11
+template <typename Algorithm>
+std::vector<std::tuple<double, double, double>> GetFdErrorIntervals(Algorithm const& algorithm,
+                                                                    double confidence) {
+    std::vector<std::tuple<double, double, double>> intervals;
+    for (model::ConfidenceInterval const& interval : algorithm.GetFdErrorIntervals(confidence)) {
+        intervals.emplace_back(interval.GetMin(), interval.GetMean(), interval.GetMax());
+    }
+    return intervals;
+}
+
+// Methods of the algorithms that can mine FDs on a row sample
+template <typename... AlgorithmTypes>
+void BindRowSampleMethods(py::module_ const& algos_module,
+                          std::array<char const*, sizeof...(AlgorithmTypes)> algo_names) {
+    using namespace pybind11::literals;
+    using algos::PliBasedFDAlgorithm;
+
+    auto name_it = algo_names.begin();
+    (py::reinterpret_borrow<py::class_<AlgorithmTypes, algos::FDAlgorithm>>(
+             algos_module.attr(*name_it++))
+             .def("get_fd_error_intervals", &GetFdErrorIntervals<AlgorithmTypes>,
+                  "confidence"_a = 0.95,
+                  "(min, estimate, max) of the g1 error each FD has on the whole table")
+             .def("calculate_full_data_errors", &PliBasedFDAlgorithm::CalculateFullDataErrors,
+                  "Exact g1 error of each FD on the whole table")
+             .def("get_table_rows_num", &PliBasedFDAlgorithm::GetTableRowsNum),
+     ...);
+}
 }  // namespace
 
 namespace python_bindings {
@@ -61,6 +97,21 @@ void BindFd(py::module_& main_module) {
                                    {"HyFD", "Aid", "Depminer", "DFD", "FastFDs", "FDep", "FdMine",
                                     "FUN", kPyroName, kTaneName, kPFDTaneName});
 
+    BindPrimitiveStream(fd_module, "FdAlgorithm", "FdStream", "iter_fds",
+                        &FDAlgorithm::SetFdConsumer);
+
+    py::reinterpret_borrow<py::class_<Pyro, FDAlgorithm>>(fd_algos_module.attr(kPyroName))
+            .def("get_fds_per_threshold", &Pyro::GetFdsPerThreshold)
+            .def("get_uccs", &Pyro::UCCList);
+    py::reinterpret_borrow<py::class_<Tane, FDAlgorithm>>(fd_algos_module.attr(kTaneName))
+            .def("get_fds_per_threshold", &Tane::GetFdsPerThreshold);
+    py::reinterpret_borrow<py::class_<hyfd::HyFD, FDAlgorithm>>(fd_algos_module.attr("HyFD"))
+            .def("is_result_truncated", &hyfd::HyFD::IsResultTruncated);
+
+    BindRowSampleMethods<hyfd::HyFD, Depminer, DFD, FastFDs, FdMine, FUN, Pyro, Tane, PFDTane>(
+            fd_algos_module, {"HyFD", "Depminer", "DFD", "FastFDs", "FdMine", "FUN", kPyroName,
+                              kTaneName, kPFDTaneName});
+
     auto define_submodule = [&fd_algos_module, &main_module](char const* name,
                                                              std::vector<char const*> algorithms) {
         auto algos_module = main_module.def_submodule(name).def_submodule("algorithms");
@@ -1,8 +1,11 @@
 #include "bind_fd_verification.h"
 
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include "algorithms/fd/fd_verifier/afd_error_calculator.h"
+#include "algorithms/fd/fd_verifier/batch_fd_verifier.h"
 #include "algorithms/fd/fd_verifier/fd_verifier.h"
 #include "algorithms/fd/fd_verifier/highlight.h"
 #include "algorithms/fd/verification_algorithms.h"
@@ -16,6 +19,7 @@ namespace python_bindings {
 void BindFdVerification(pybind11::module_& main_module) {
     using namespace algos;
     using namespace algos::fd_verifier;
+    using namespace pybind11::literals;
 
     auto fd_verification_module = main_module.def_submodule("fd_verification");
     py::class_<Highlight>(fd_verification_module, "Highlight")
@@ -28,7 +32,42 @@ void BindFdVerification(pybind11::module_& main_module) {
             .def("get_error", &FDVerifier::GetError)
             .def("get_num_error_clusters", &FDVerifier::GetNumErrorClusters)
             .def("get_num_error_rows", &FDVerifier::GetNumErrorRows)
-            .def("get_highlights", &FDVerifier::GetHighlights);
+            .def("get_highlights", py::overload_cast<>(&FDVerifier::GetHighlights, py::const_))
+            .def("get_highlights",
+                 py::overload_cast<size_t, size_t>(&FDVerifier::GetHighlights, py::const_),
+                 "offset"_a, "limit"_a)
+            .def("get_highlight_lhs_value", &FDVerifier::GetHighlightLhsValue, "highlight"_a)
+            .def("get_highlight_rhs_values", &FDVerifier::GetHighlightRhsValues, "highlight"_a);
+    // FDVerifier stays the default algorithm of the module
+    detail::RegisterAlgorithm<BatchFDVerifier, algos::Algorithm>(
+            fd_verification_module.def_submodule("algorithms"), "BatchFDVerifier")
+            .def("get_num_fds", &BatchFDVerifier::GetNumFDs)
+            .def("fd_holds", &BatchFDVerifier::FDHolds, "fd_index"_a)
+            .def("get_error", &BatchFDVerifier::GetError, "fd_index"_a)
+            .def("get_num_error_clusters", &BatchFDVerifier::GetNumErrorClusters, "fd_index"_a)
+            .def("get_num_error_rows", &BatchFDVerifier::GetNumErrorRows, "fd_index"_a)
+            .def("get_violated_fd_indices", &BatchFDVerifier::GetViolatedFDIndices)
+            .def("get_highlights", py::overload_cast<size_t>(&BatchFDVerifier::GetHighlights),
+                 "fd_index"_a)
+            .def("get_highlights",
+                 py::overload_cast<size_t, size_t, size_t>(&BatchFDVerifier::GetHighlights),
+                 "fd_index"_a, "offset"_a, "limit"_a);
+    detail::RegisterAlgorithm<AfdErrorCalculator, algos::Algorithm>(
+            fd_verification_module.def_submodule("algorithms"), "AfdErrorCalculator")
+            .def("get_num_fds", &AfdErrorCalculator::GetNumFDs)
+            .def("get_num_cached_plis", &AfdErrorCalculator::GetNumCachedPLIs)
+            // one row per FD, the columns are the g1, g3 and per-value errors
+            .def("get_errors", [](AfdErrorCalculator const& calculator) {
+                std::vector<AfdErrors> const& errors = calculator.GetErrors();
+                py::array_t<double> result({errors.size(), std::size_t{3}});
+                auto view = result.mutable_unchecked<2>();
+                for (std::size_t i = 0; i < errors.size(); ++i) {
+                    view(i, 0) = errors[i].g1;
+                    view(i, 1) = errors[i].g3;
+                    view(i, 2) = errors[i].per_value;
+                }
+                return result;
+            });
 
     main_module.attr("afd_verification") = fd_verification_module;
 }
@@ -7,6 +7,7 @@
 #include "algorithms/ind/ind_algorithm.h"
 #include "algorithms/ind/mining_algorithms.h"
 #include "py_util/bind_primitive.h"
+#include "py_util/primitive_stream.h"
 
 namespace py = pybind11;
 
@@ -29,6 +30,8 @@ void BindInd(py::module_& main_module) {
     auto ind_algos_module =
             BindPrimitive<Spider, Faida, Mind>(ind_module, &INDAlgorithm::INDList, "IndAlgorithm",
                                                "get_inds", {kSpiderName, "Faida", kMindName});
+    BindPrimitiveStream(ind_module, "IndAlgorithm", "IndStream", "iter_inds",
+                        &INDAlgorithm::SetIndConsumer);
     auto define_submodule = [&ind_algos_module, &main_module](char const* name,
                                                               std::vector<char const*> algorithms) {
         auto algos_module = main_module.def_submodule(name).def_submodule("algorithms");
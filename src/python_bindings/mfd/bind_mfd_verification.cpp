@@ -15,6 +15,7 @@ namespace python_bindings {
 void BindMfdVerification(py::module_& main_module) {
     using namespace algos;
     using namespace algos::metric;
+    using namespace pybind11::literals;
 
     auto mfd_module = main_module.def_submodule("mfd_verification");
     py::class_<Highlight>(mfd_module, "Highlight")
@@ -23,7 +24,13 @@ void BindMfdVerification(py::module_& main_module) {
             .def_readonly("furthest_data_index", &Highlight::furthest_data_index)
             .def_readonly("max_distance", &Highlight::max_distance);
     BindPrimitiveNoBase<MetricVerifier>(mfd_module, "MetricVerifier")
-            .def("get_highlights", &MetricVerifier::GetHighlights)
+            .def("get_highlights",
+                 py::overload_cast<>(&MetricVerifier::GetHighlights, py::const_))
+            .def("get_highlights",
+                 py::overload_cast<size_t, size_t, size_t>(&MetricVerifier::GetHighlights,
+                                                           py::const_),
+                 "cluster_index"_a, "offset"_a, "limit"_a)
+            .def("get_num_highlighted_clusters", &MetricVerifier::GetNumHighlightedClusters)
             .def("mfd_holds", &MetricVerifier::GetResult);
 }
 }  // namespace python_bindings
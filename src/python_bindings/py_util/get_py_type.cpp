@@ -12,6 +12,7 @@
 #include "algorithms/metric/enums.h"
 #include "association_rules/ar_algorithm_enums.h"
 #include "config/error_measure/type.h"
+#include "config/indices/type.h"
 #include "config/tabular_data/input_table_type.h"
 #include "config/tabular_data/input_tables_type.h"
 #include "model/table/column_combination.h"
@@ -79,6 +80,9 @@ py::tuple GetPyType(std::type_index type_index) {
             PyTypePair<algos::InputFormat, kPyStr>,
             PyTypePair<algos::cfd::Substrategy, kPyStr>,
             PyTypePair<std::vector<unsigned int>, kPyList, kPyInt>,
+            PyTypePair<std::vector<double>, kPyList, kPyFloat>,
+            PyTypePair<config::FdsIndicesType, kPyList, kPyTuple>,
+            PyTypePair<config::UCCsIndicesType, kPyList, kPyList>,
             {typeid(config::InputTable),
              []() { return MakeTypeTuple(py::type::of<config::InputTable>()); }},
             {typeid(config::InputTables),
@@ -10,6 +10,7 @@
 #include "association_rules/ar_algorithm_enums.h"
 #include "config/equal_nulls/type.h"
 #include "config/error/type.h"
+#include "config/error_thresholds/type.h"
 #include "config/indices/type.h"
 #include "config/max_lhs/type.h"
 #include "config/thread_number/type.h"
@@ -36,7 +37,10 @@ std::unordered_map<std::type_index, ConvFunction> const kConverters{
         normal_conv_pair<config::ThreadNumType>,
         normal_conv_pair<config::MaxLhsType>,
         normal_conv_pair<config::ErrorType>,
+        normal_conv_pair<config::ErrorThresholdsType>,
         normal_conv_pair<config::IndicesType>,
+        normal_conv_pair<config::FdsIndicesType>,
+        normal_conv_pair<config::UCCsIndicesType>,
         enum_conv_pair<algos::metric::MetricAlgo>,
         enum_conv_pair<algos::metric::Metric>,
         enum_conv_pair<algos::InputFormat>};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include <pybind11/pybind11.h>
+
+#include "bind_main_classes.h"
+#include "util/bounded_spsc_queue.h"
+
+namespace python_bindings {
+
+/* Python iterator over the instances found by an algorithm that is executed on a background
+ * thread. The algorithm blocks once `capacity` instances are waiting to be taken. Closing the
+ * iterator (or dropping it) stops the execution early.
+ */
+template <typename AlgorithmType, typename T>
+class PrimitiveStream {
+private:
+    using ConsumerSetter = void (AlgorithmType::*)(std::function<bool(T const&)>);
+
+    AlgorithmType& algorithm_;
+    ConsumerSetter set_consumer_;
+    util::BoundedSpscQueue<T> queue_;
+    std::exception_ptr exception_;
+    std::thread thread_;
+
+    void Join() {
+        if (!thread_.joinable()) return;
+        pybind11::gil_scoped_release release;
+        thread_.join();
+    }
+
+public:
+    PrimitiveStream(AlgorithmType& algorithm, ConsumerSetter set_consumer, std::size_t capacity)
+        : algorithm_(algorithm), set_consumer_(set_consumer), queue_(capacity) {
+        (algorithm_.*set_consumer_)([this](T const& primitive) { return queue_.Push(primitive); });
+        thread_ = std::thread([this]() {
+            try {
+                algorithm_.Execute();
+            } catch (...) {
+                exception_ = std::current_exception();
+            }
+            queue_.Close();
+        });
+    }
+
+    PrimitiveStream(PrimitiveStream const&) = delete;
+    PrimitiveStream& operator=(PrimitiveStream const&) = delete;
+
+    T Next() {
+        std::optional<T> primitive;
+        {
+            pybind11::gil_scoped_release release;
+            primitive = queue_.Pop();
+        }
+        if (primitive) return std::move(*primitive);
+        Join();
+        (algorithm_.*set_consumer_)(nullptr);
+        if (exception_) std::rethrow_exception(std::exchange(exception_, nullptr));
+        throw pybind11::stop_iteration();
+    }
+
+    void Close() {
+        if (!thread_.joinable()) return;
+        algorithm_.RequestStop();
+        queue_.Close();
+        Join();
+        (algorithm_.*set_consumer_)(nullptr);
+    }
+
+    ~PrimitiveStream() {
+        Close();
+    }
+};
+
+/* Adds `method_name(capacity=1024, **kwargs)` to the bound algorithm base class, the method
+ * configures the algorithm like `execute` does and returns a PrimitiveStream.
+ */
+template <typename AlgorithmType, typename T>
+void BindPrimitiveStream(pybind11::module_& module, char const* base_name,
+                         char const* stream_name, char const* method_name,
+                         void (AlgorithmType::*set_consumer)(std::function<bool(T const&)>)) {
+    namespace py = pybind11;
+    using namespace pybind11::literals;
+    using Stream = PrimitiveStream<AlgorithmType, T>;
+
+    py::class_<Stream>(module, stream_name)
+            .def("__iter__", [](py::object self) { return self; })
+            // the instances refer to the schema owned by the algorithm
+            .def("__next__", &Stream::Next, py::keep_alive<0, 1>())
+            .def("close", &Stream::Close, "Stop the execution and drop the remaining results.")
+            .def("__enter__", [](py::object self) { return self; })
+            .def("__exit__", [](Stream& stream, py::args const&) { stream.Close(); });
+    py::reinterpret_borrow<py::class_<AlgorithmType, algos::Algorithm>>(module.attr(base_name))
+            .def(
+                    method_name,
+                    [set_consumer](AlgorithmType& algorithm, std::size_t capacity,
+                                   py::kwargs const& kwargs) {
+                        if (capacity == 0) throw py::value_error("capacity must be positive");
+                        ConfigureAlgo(algorithm, kwargs);
+                        return std::make_unique<Stream>(algorithm, set_consumer, capacity);
+                    },
+                    "capacity"_a = 1024, py::keep_alive<0, 1>(),
+                    "Process data on a background thread, yielding results as they are found. "
+                    "Closing the iterator stops the execution, results found so far stay "
+                    "available.");
+}
+
+}  // namespace python_bindings
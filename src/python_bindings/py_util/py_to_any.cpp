@@ -13,6 +13,7 @@
 #include "association_rules/ar_algorithm_enums.h"
 #include "config/error_measure/type.h"
 #include "config/exceptions.h"
+#include "config/indices/type.h"
 #include "config/tabular_data/input_table_type.h"
 #include "config/tabular_data/input_tables_type.h"
 #include "parser/csv_parser/csv_parser.h"
@@ -115,6 +116,9 @@ std::unordered_map<std::type_index, ConvFunc> const kConverters{
         kNormalConvPair<unsigned int>,
         kNormalConvPair<long double>,
         kNormalConvPair<std::vector<unsigned int>>,
+        kNormalConvPair<config::FdsIndicesType>,
+        kNormalConvPair<config::UCCsIndicesType>,
+        kNormalConvPair<std::vector<double>>,
         kNormalConvPair<unsigned short>,
         kNormalConvPair<int>,
         kNormalConvPair<size_t>,
@@ -29,6 +29,9 @@ def check_metric_verifier_failure(dataset, options) -> bool:
         alg.set_option(opt_name, options[opt_name])
 
 
+# First -> Second, Third -> First and First, Second -> Third are violated, Third -> Second holds
+TEST_LONG_FDS = [([0], [1]), ([2], [0]), ([0, 1], [2]), ([2], [1])]
+
 ALGO_CORRECT_OPTIONS_INFO = [
     (desb.fd.algorithms.Depminer, [ONLY_NULL_EQUAL_NULL_OPTION_CONTAINER]),
     (desb.fd.algorithms.FUN, [ONLY_NULL_EQUAL_NULL_OPTION_CONTAINER]),
@@ -191,7 +194,72 @@ class TestPythonBindings(unittest.TestCase):
             with self.subTest(msg=f"metric_verifier_load: {load}"):
                 with self.assertRaises(desb.ConfigurationError):
                     check_metric_verifier_failure(load.path, load.options)
-                
+
+    def test_row_sample_error_intervals(self):
+        algo = desb.fd.algorithms.Tane()
+        algo.load_data(table=("WDC_satellites.csv", ",", True), row_sample_size=50,
+                       row_sample_seed=1)
+        algo.execute()
+        self.assertEqual(algo.get_table_rows_num(), 173)
+        fds_num = len(algo.get_fds())
+        intervals = algo.get_fd_error_intervals(confidence=0.9)
+        self.assertEqual(len(intervals), fds_num)
+        for low, estimate, high in intervals:
+            self.assertLessEqual(0, low)
+            self.assertLessEqual(low, estimate)
+            self.assertLessEqual(estimate, high)
+            self.assertLessEqual(high, 1)
+        errors = algo.calculate_full_data_errors()
+        self.assertEqual(len(errors), fds_num)
+        for error in errors:
+            self.assertTrue(0 <= error <= 1)
+
+    def test_afd_error_calculator_errors(self):
+        algo = desb.fd_verification.algorithms.AfdErrorCalculator()
+        algo.load_data(table=("TestLong.csv", ",", True))
+        algo.execute(fds=TEST_LONG_FDS)
+        errors = algo.get_errors()
+        self.assertEqual(errors.shape, (len(TEST_LONG_FDS), 3))
+        expected_errors = [[3 / 28, 0.375, 0.375], [1 / 28, 0.125, 1 / 14],
+                           [1 / 28, 0.125, 1 / 14], [0, 0, 0]]
+        for fd_errors, expected in zip(errors.tolist(), expected_errors):
+            for error, expected_error in zip(fd_errors, expected):
+                self.assertAlmostEqual(error, expected_error)
+
+    def test_batch_fd_verifier(self):
+        algo = desb.fd_verification.algorithms.BatchFDVerifier()
+        algo.load_data(table=("TestLong.csv", ",", True))
+        algo.execute(fds=TEST_LONG_FDS)
+        self.assertEqual(algo.get_num_fds(), len(TEST_LONG_FDS))
+        self.assertEqual(algo.get_violated_fd_indices(), [0, 1, 2])
+        self.assertTrue(algo.fd_holds(3))
+        self.assertAlmostEqual(algo.get_error(0), 3 / 28)
+        self.assertEqual([algo.get_num_error_clusters(i) for i in range(4)], [3, 1, 1, 0])
+        self.assertEqual([algo.get_num_error_rows(i) for i in range(4)], [6, 2, 2, 0])
+
+    def test_pyro_uccs(self):
+        algo = desb.afd.algorithms.Pyro()
+        algo.load_data(table=("TestLong.csv", ",", True))
+        algo.execute(error=0.0, seed=0, find_uccs=True)
+        self.assertEqual([ucc.indices for ucc in algo.get_uccs()], [[0, 2]])
+
+    def test_dynamic_fd(self):
+        algo = desb.dynamic_fd.algorithms.DynFD()
+        algo.load_data(table=("TestLong.csv", ",", True))
+        algo.execute()
+        self.assertEqual({fd.to_index_tuple() for fd in algo.get_fds()}, {((2,), 1)})
+        # the row (2, 2, 7) was the only one violating Third -> First
+        algo.execute(delete={5})
+        self.assertEqual({fd.to_index_tuple() for fd in algo.get_fds()},
+                         {((2,), 0), ((2,), 1)})
+
+    def test_dynamic_ucc(self):
+        algo = desb.dynamic_ucc.algorithms.DynUCC()
+        algo.load_data(table=("TestLong.csv", ",", True))
+        algo.execute()
+        self.assertEqual([ucc.indices for ucc in algo.get_uccs()], [[0, 2]])
+        algo.execute(delete={5})
+        self.assertEqual([ucc.indices for ucc in algo.get_uccs()], [[2]])
 
 
 if __name__ == "__main__":
@@ -7,6 +7,7 @@
 #include "algorithms/ucc/ucc.h"
 #include "config/indices/type.h"
 #include "py_util/bind_primitive.h"
+#include "py_util/primitive_stream.h"
 #include "util/bitset_utils.h"
 
 namespace {
@@ -22,8 +23,13 @@ void BindUcc(py::module_& main_module) {
     py::class_<UCC>(ucc_module, "UCC")
             .def("__str__", &UCC::ToIndicesString)
             .def_property_readonly("indices", &UCC::GetColumnIndicesAsVector);
-    BindPrimitive<HyUCC, PyroUCC>(ucc_module,
-                                  py::overload_cast<>(&UCCAlgorithm::UCCList, py::const_),
-                                  "UccAlgorithm", "get_uccs", {"HyUCC", "PyroUCC"});
+    auto ucc_algos_module =
+            BindPrimitive<HyUCC, PyroUCC>(ucc_module,
+                                          py::overload_cast<>(&UCCAlgorithm::UCCList, py::const_),
+                                          "UccAlgorithm", "get_uccs", {"HyUCC", "PyroUCC"});
+    py::reinterpret_borrow<py::class_<HyUCC, UCCAlgorithm>>(ucc_algos_module.attr("HyUCC"))
+            .def("is_result_truncated", &HyUCC::IsResultTruncated);
+    BindPrimitiveStream(ucc_module, "UccAlgorithm", "UccStream", "iter_uccs",
+                        &UCCAlgorithm::SetUccConsumer);
 }
 }  // namespace python_bindings
@@ -3,6 +3,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include "algorithms/ucc/ucc_verifier/batch_ucc_verifier.h"
 #include "algorithms/ucc/verification_algorithms.h"
 #include "py_util/bind_primitive.h"
 
@@ -13,6 +14,7 @@ namespace py = pybind11;
 namespace python_bindings {
 void BindUccVerification(pybind11::module_& main_module) {
     using namespace algos;
+    using namespace pybind11::literals;
 
     auto ucc_verification_module = main_module.def_submodule("ucc_verification");
 
@@ -22,6 +24,19 @@ void BindUccVerification(pybind11::module_& main_module) {
             .def("get_num_rows_violating_ucc", &UCCVerifier::GetNumRowsViolatingUCC)
             .def("get_clusters_violating_ucc", &UCCVerifier::GetClustersViolatingUCC)
             .def("get_error", &UCCVerifier::GetError);
+    // UCCVerifier stays the default algorithm of the module
+    detail::RegisterAlgorithm<BatchUCCVerifier, algos::Algorithm>(
+            ucc_verification_module.def_submodule("algorithms"), "BatchUccVerifier")
+            .def("get_num_uccs", &BatchUCCVerifier::GetNumUCCs)
+            .def("ucc_holds", &BatchUCCVerifier::UCCHolds, "ucc_index"_a)
+            .def("get_violated_ucc_indices", &BatchUCCVerifier::GetViolatedUCCIndices)
+            .def("get_num_clusters_violating_ucc", &BatchUCCVerifier::GetNumClustersViolatingUCC,
+                 "ucc_index"_a)
+            .def("get_num_rows_violating_ucc", &BatchUCCVerifier::GetNumRowsViolatingUCC,
+                 "ucc_index"_a)
+            .def("get_clusters_violating_ucc", &BatchUCCVerifier::GetClustersViolatingUCC,
+                 "ucc_index"_a)
+            .def("get_error", &BatchUCCVerifier::GetError, "ucc_index"_a);
     main_module.attr("aucc_verification") = ucc_verification_module;
 }
 }  // namespace python_bindings
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "config/tabular_data/input_table_type.h"
+#include "model/table/idataset_stream.h"
+
+namespace tests {
+
+/// table given by its rows, the input of the dynamic algorithms' CRUD options
+class RowsStream : public model::IDatasetStream {
+private:
+    std::vector<std::string> column_names_;
+    std::vector<Row> rows_;
+    size_t next_row_ = 0;
+
+public:
+    RowsStream(std::vector<std::string> column_names, std::vector<Row> rows)
+        : column_names_(std::move(column_names)), rows_(std::move(rows)) {}
+
+    Row GetNextRow() override {
+        return rows_[next_row_++];
+    }
+
+    bool HasNextRow() const override {
+        return next_row_ < rows_.size();
+    }
+
+    size_t GetNumberOfColumns() const override {
+        return column_names_.size();
+    }
+
+    std::string GetColumnName(size_t index) const override {
+        return column_names_[index];
+    }
+
+    std::string GetRelationName() const override {
+        return "rows";
+    }
+
+    void Reset() override {
+        next_row_ = 0;
+    }
+};
+
+/// table of the row numbers modulo different primes: combinations of its columns are keys and
+/// determine the other columns, a large one takes the miners seconds to process
+inline config::InputTable MakeModuloTable(int num_rows) {
+    std::vector<int> const moduli{2, 3, 5, 7, 11, 13, 17, 19, 23, 29};
+    std::vector<std::string> column_names;
+    for (size_t i = 0; i < moduli.size(); ++i) {
+        column_names.push_back("Col" + std::to_string(i));
+    }
+    std::vector<model::IDatasetStream::Row> rows;
+    for (int row_num = 0; row_num < num_rows; ++row_num) {
+        model::IDatasetStream::Row row;
+        for (int modulus : moduli) {
+            row.push_back(std::to_string(row_num % modulus));
+        }
+        rows.push_back(std::move(row));
+    }
+    return std::make_shared<RowsStream>(std::move(column_names), std::move(rows));
+}
+
+/// table a test changes along with a dynamic algorithm, row indices are those the algorithm
+/// assigns
+class TableMirror {
+private:
+    std::vector<std::string> column_names_;
+    std::vector<std::optional<model::IDatasetStream::Row>> rows_;
+
+public:
+    explicit TableMirror(std::vector<std::string> column_names)
+        : column_names_(std::move(column_names)) {}
+
+    std::vector<std::string> const& GetColumnNames() const {
+        return column_names_;
+    }
+
+    std::vector<size_t> GetRowIndices() const {
+        std::vector<size_t> indices;
+        for (size_t i = 0; i < rows_.size(); ++i) {
+            if (rows_[i].has_value()) indices.push_back(i);
+        }
+        return indices;
+    }
+
+    void Insert(model::IDatasetStream::Row row) {
+        rows_.emplace_back(std::move(row));
+    }
+
+    void Update(size_t index, model::IDatasetStream::Row row) {
+        rows_[index] = std::move(row);
+    }
+
+    void Delete(size_t index) {
+        rows_[index].reset();
+    }
+
+    config::InputTable MakeTable() const {
+        std::vector<model::IDatasetStream::Row> rows;
+        for (auto const& row : rows_) {
+            if (row.has_value()) rows.push_back(*row);
+        }
+        return std::make_shared<RowsStream>(column_names_, std::move(rows));
+    }
+};
+
+}  // namespace tests
@@ -0,0 +1,156 @@
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "algorithms/algo_factory.h"
+#include "algorithms/fd/fd_verifier/afd_error_calculator.h"
+#include "algorithms/fd/fd_verifier/fd_verifier.h"
+#include "algorithms/fd/pfdtane/pfdtane.h"
+#include "all_csv_configs.h"
+#include "config/indices/type.h"
+#include "config/names.h"
+#include "config/thread_number/type.h"
+#include "csv_config_util.h"
+#include "model/table/column_layout_relation_data.h"
+
+namespace tests {
+
+namespace {
+using algos::fd_verifier::AfdErrorCalculator, algos::fd_verifier::AfdErrors;
+namespace onam = config::names;
+
+using PLIPtr = std::shared_ptr<model::PLI const>;
+
+PLIPtr IntersectColumns(ColumnLayoutRelationData const& relation,
+                        config::IndicesType const& indices, PLIPtr pli = nullptr) {
+    for (config::IndexType index : indices) {
+        PLIPtr column_pli = relation.GetColumnData(index).GetPliOwnership();
+        pli = pli == nullptr ? column_pli : pli->Intersect(column_pli.get());
+    }
+    return pli;
+}
+
+void TestErrors(CSVConfig const& csv_config, config::FdsIndicesType const& fds,
+                config::ThreadNumType threads) {
+    auto calculator = algos::CreateAndLoadAlgorithm<AfdErrorCalculator>(
+            algos::StdParamsMap{{onam::kCsvConfig, csv_config},
+                                {onam::kFdsIndices, fds},
+                                {onam::kEqualNulls, true},
+                                {onam::kThreads, threads}});
+    calculator->Execute();
+    ASSERT_EQ(calculator->GetNumFDs(), fds.size());
+
+    auto relation = ColumnLayoutRelationData::CreateFrom(*MakeInputTable(csv_config), true);
+    for (std::size_t i = 0; i < fds.size(); ++i) {
+        auto const& [lhs, rhs] = fds[i];
+        auto verifier = algos::CreateAndLoadAlgorithm<algos::fd_verifier::FDVerifier>(
+                algos::StdParamsMap{{onam::kCsvConfig, csv_config},
+                                    {onam::kLhsIndices, lhs},
+                                    {onam::kRhsIndices, rhs},
+                                    {onam::kEqualNulls, true}});
+        verifier->Execute();
+        PLIPtr lhs_pli = IntersectColumns(*relation, lhs);
+        PLIPtr joint_pli = IntersectColumns(*relation, rhs, lhs_pli);
+
+        AfdErrors const& errors = calculator->GetErrors(i);
+        EXPECT_DOUBLE_EQ(errors.g1, verifier->GetError()) << i;
+        EXPECT_DOUBLE_EQ(errors.g3,
+                         algos::PFDTane::CalculateFdError(lhs_pli.get(), joint_pli.get(),
+                                                          +algos::ErrorMeasure::per_tuple))
+                << i;
+        EXPECT_DOUBLE_EQ(errors.per_value,
+                         algos::PFDTane::CalculateFdError(lhs_pli.get(), joint_pli.get(),
+                                                          +algos::ErrorMeasure::per_value))
+                << i;
+    }
+}
+}  // namespace
+
+TEST(AfdErrorCalculatorTest, MatchesReferenceErrors) {
+    // clang-format off
+    config::FdsIndicesType const fds{
+            {{1}, {0}},
+            {{2, 3}, {5}},
+            {{0, 1, 2, 3, 4}, {5}},
+            {{5}, {0, 1, 2, 3, 4}},
+            {{2, 3}, {0, 1, 4, 5}},
+            {{4}, {3}},
+            {{0}, {1}},
+            {{1, 3}, {5}},
+            {{0, 1}, {1, 4}},
+            {{1, 4}, {2, 3, 5}},
+            {{4}, {3}}};
+    // clang-format on
+    TestErrors(kTestFD, fds, 1);
+    TestErrors(kTestFD, fds, 4);
+}
+
+TEST(AfdErrorCalculatorTest, SharedPrefixesOnLargerTable) {
+    config::FdsIndicesType fds;
+    for (config::IndexType rhs = 0; rhs < 5; ++rhs) {
+        for (config::IndexType lhs = 5; lhs < 9; ++lhs) {
+            fds.push_back({{lhs}, {rhs}});
+            fds.push_back({{0, lhs, 10}, {rhs}});
+            fds.push_back({{0, 1, lhs}, {rhs, 12}});
+        }
+    }
+    TestErrors(kCIPublicHighway700, fds, 4);
+}
+
+TEST(AfdErrorCalculatorTest, ReusesPLIsBetweenBatches) {
+    config::FdsIndicesType const first_batch{{{0, 1}, {2}}, {{0, 1, 3}, {4}}};
+    auto calculator = algos::CreateAndLoadAlgorithm<AfdErrorCalculator>(algos::StdParamsMap{
+            {onam::kCsvConfig, kTestFD}, {onam::kFdsIndices, first_batch}});
+    std::size_t const num_columns = 6;
+    EXPECT_EQ(calculator->GetNumCachedPLIs(), num_columns);
+    calculator->Execute();
+    // {0, 1}, {0, 1, 2}, {0, 1, 3} and {0, 1, 3, 4}
+    EXPECT_EQ(calculator->GetNumCachedPLIs(), num_columns + 4);
+    std::vector<AfdErrors> const first_errors = calculator->GetErrors();
+
+    algos::ConfigureFromMap(*calculator, algos::StdParamsMap{{onam::kFdsIndices, first_batch}});
+    calculator->Execute();
+    EXPECT_EQ(calculator->GetNumCachedPLIs(), num_columns + 4);
+    for (std::size_t i = 0; i < first_batch.size(); ++i) {
+        EXPECT_DOUBLE_EQ(calculator->GetErrors(i).g1, first_errors[i].g1);
+        EXPECT_DOUBLE_EQ(calculator->GetErrors(i).g3, first_errors[i].g3);
+    }
+
+    algos::ConfigureFromMap(*calculator,
+                            algos::StdParamsMap{{onam::kFdsIndices,
+                                                 config::FdsIndicesType{{{0, 1}, {5}}}}});
+    calculator->Execute();
+    // only {0, 1, 5} is new
+    EXPECT_EQ(calculator->GetNumCachedPLIs(), num_columns + 5);
+    EXPECT_EQ(calculator->GetNumFDs(), 1);
+}
+
+TEST(AfdErrorCalculatorTest, DropsIntersectionsOverCacheBound) {
+    // every triple of the first 12 columns, far more intersections than the cache keeps
+    config::FdsIndicesType triples;
+    for (config::IndexType first = 0; first < 12; ++first) {
+        for (config::IndexType second = first + 1; second < 12; ++second) {
+            for (config::IndexType third = second + 1; third < 12; ++third) {
+                triples.push_back({{first, second}, {third}});
+            }
+        }
+    }
+    auto calculator = algos::CreateAndLoadAlgorithm<AfdErrorCalculator>(algos::StdParamsMap{
+            {onam::kCsvConfig, kCIPublicHighway700}, {onam::kFdsIndices, triples}});
+    std::size_t const num_columns = calculator->GetNumCachedPLIs();
+    calculator->Execute();
+    EXPECT_EQ(calculator->GetNumFDs(), triples.size());
+    EXPECT_EQ(calculator->GetNumCachedPLIs(), num_columns);
+
+    // the next batch intersects its column sets anew
+    config::FdsIndicesType const fds{{{0, 1}, {2}}, {{3, 4, 5}, {6, 7}}};
+    algos::ConfigureFromMap(*calculator, algos::StdParamsMap{{onam::kFdsIndices, fds}});
+    calculator->Execute();
+    // {0, 1}, {0, 1, 2}, {3, 4}, {3, 4, 5}, {3, 4, 5, 6} and {3, 4, 5, 6, 7}
+    EXPECT_EQ(calculator->GetNumCachedPLIs(), num_columns + 6);
+    TestErrors(kCIPublicHighway700, fds, 1);
+}
+
+}  // namespace tests
@@ -0,0 +1,68 @@
+#include <list>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "algorithms/algo_factory.h"
+#include "algorithms/fd/pyro/pyro.h"
+#include "algorithms/fd/tane/tane.h"
+#include "all_csv_configs.h"
+#include "config/error/type.h"
+#include "config/error_thresholds/type.h"
+#include "config/names.h"
+#include "csv_config_util.h"
+
+namespace tests {
+
+namespace {
+namespace onam = config::names;
+using algos::FDAlgorithm;
+
+template <typename AlgorithmType>
+std::unique_ptr<AlgorithmType> CreateAfdAlgorithm(CSVConfig const& csv_config,
+                                                  config::ErrorType error,
+                                                  config::ErrorThresholdsType thresholds = {}) {
+    return algos::CreateAndLoadAlgorithm<AlgorithmType>(
+            algos::StdParamsMap{{onam::kCsvConfig, csv_config},
+                                {onam::kError, error},
+                                {onam::kErrorThresholds, std::move(thresholds)}});
+}
+
+// FDs mined for each threshold in a single run are the same as the ones of separate runs
+template <typename AlgorithmType>
+void TestSingleRunMatchesSeparateRuns(CSVConfig const& csv_config) {
+    config::ErrorType const error = 0.01;
+    config::ErrorThresholdsType const thresholds = {0.3, 0.01, 0.05, 0.1};
+    auto multi_threshold = CreateAfdAlgorithm<AlgorithmType>(csv_config, error, thresholds);
+    multi_threshold->Execute();
+
+    auto single_threshold = CreateAfdAlgorithm<AlgorithmType>(csv_config, error);
+    single_threshold->Execute();
+    EXPECT_EQ(FDAlgorithm::FDsToJson(multi_threshold->FdList()),
+              FDAlgorithm::FDsToJson(single_threshold->FdList()))
+            << csv_config.path.filename();
+
+    algos::FdsPerThreshold const& fds_per_threshold = multi_threshold->GetFdsPerThreshold();
+    ASSERT_EQ(fds_per_threshold.size(), 4u);
+    for (auto const& [threshold, fds] : fds_per_threshold) {
+        auto separate_run = CreateAfdAlgorithm<AlgorithmType>(csv_config, threshold);
+        separate_run->Execute();
+        EXPECT_EQ(FDAlgorithm::FDsToJson(fds), FDAlgorithm::FDsToJson(separate_run->FdList()))
+                << csv_config.path.filename() << ", threshold " << threshold;
+    }
+}
+}  // namespace
+
+TEST(AfdThresholdsTest, TaneSingleRunMatchesSeparateRuns) {
+    for (CSVConfig const& csv_config : {kTestFD, kCIPublicHighway700, kWdcSatellites}) {
+        TestSingleRunMatchesSeparateRuns<algos::Tane>(csv_config);
+    }
+}
+
+TEST(AfdThresholdsTest, PyroSingleRunMatchesSeparateRuns) {
+    for (CSVConfig const& csv_config : {kTestFD, kCIPublicHighway700, kWdcSatellites}) {
+        TestSingleRunMatchesSeparateRuns<algos::Pyro>(csv_config);
+    }
+}
+
+}  // namespace tests
@@ -0,0 +1,98 @@
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "algorithms/algo_factory.h"
+#include "algorithms/fd/fd_verifier/batch_fd_verifier.h"
+#include "algorithms/fd/fd_verifier/fd_verifier.h"
+#include "all_csv_configs.h"
+#include "config/indices/type.h"
+#include "config/names.h"
+#include "config/thread_number/type.h"
+#include "csv_config_util.h"
+
+namespace tests {
+
+namespace {
+using algos::fd_verifier::BatchFDVerifier, algos::fd_verifier::FDVerifier;
+namespace onam = config::names;
+
+std::unique_ptr<FDVerifier> VerifyOne(CSVConfig const& csv_config,
+                                      config::FdIndicesType const& fd) {
+    auto verifier = algos::CreateAndLoadAlgorithm<FDVerifier>(
+            algos::StdParamsMap{{onam::kCsvConfig, csv_config},
+                                {onam::kLhsIndices, fd.first},
+                                {onam::kRhsIndices, fd.second},
+                                {onam::kEqualNulls, true}});
+    verifier->Execute();
+    return verifier;
+}
+
+void TestMatchesFDVerifier(CSVConfig const& csv_config, config::FdsIndicesType const& fds,
+                           config::ThreadNumType threads) {
+    auto batch_verifier = algos::CreateAndLoadAlgorithm<BatchFDVerifier>(
+            algos::StdParamsMap{{onam::kCsvConfig, csv_config},
+                                {onam::kFdsIndices, fds},
+                                {onam::kEqualNulls, true},
+                                {onam::kThreads, threads}});
+    batch_verifier->Execute();
+    ASSERT_EQ(batch_verifier->GetNumFDs(), fds.size());
+
+    std::vector<std::size_t> violated;
+    for (std::size_t i = 0; i < fds.size(); ++i) {
+        auto verifier = VerifyOne(csv_config, fds[i]);
+        EXPECT_EQ(batch_verifier->FDHolds(i), verifier->FDHolds()) << i;
+        EXPECT_DOUBLE_EQ(batch_verifier->GetError(i), verifier->GetError()) << i;
+        EXPECT_EQ(batch_verifier->GetNumErrorClusters(i), verifier->GetNumErrorClusters()) << i;
+        EXPECT_EQ(batch_verifier->GetNumErrorRows(i), verifier->GetNumErrorRows()) << i;
+        if (!verifier->FDHolds()) violated.push_back(i);
+
+        auto const& highlights = batch_verifier->GetHighlights(i);
+        auto const& expected_highlights = verifier->GetHighlights();
+        ASSERT_EQ(highlights.size(), expected_highlights.size()) << i;
+        for (std::size_t j = 0; j < highlights.size(); ++j) {
+            EXPECT_EQ(highlights[j].GetCluster(), expected_highlights[j].GetCluster());
+        }
+    }
+    EXPECT_EQ(batch_verifier->GetViolatedFDIndices(), violated);
+}
+}  // namespace
+
+TEST(BatchFDVerifierTest, MatchesFDVerifier) {
+    // clang-format off
+    config::FdsIndicesType const fds{
+            {{1}, {0}},
+            {{2, 3}, {5}},
+            {{0, 1, 2, 3, 4}, {5}},
+            {{5}, {0, 1, 2, 3, 4}},
+            {{2, 3}, {0, 1, 4, 5}},
+            {{4}, {3}},
+            {{3}, {4}},
+            {{0}, {1}},
+            {{1}, {2, 3}},
+            {{1, 3}, {5}},
+            {{1, 2}, {0, 3}},
+            {{3, 4}, {1, 2}},
+            {{0, 1}, {1, 4}},
+            {{1, 4}, {2, 3, 5}},
+            {{4}, {3}}};
+    // clang-format on
+    TestMatchesFDVerifier(kTestFD, fds, 1);
+    TestMatchesFDVerifier(kTestFD, fds, 4);
+}
+
+TEST(BatchFDVerifierTest, SharedPrefixesOnLargerTable) {
+    config::FdsIndicesType fds;
+    for (config::IndexType rhs = 0; rhs < 5; ++rhs) {
+        for (config::IndexType lhs = 5; lhs < 9; ++lhs) {
+            fds.push_back({{lhs}, {rhs}});
+            fds.push_back({{0, lhs, 10}, {rhs}});
+            fds.push_back({{0, 1, lhs}, {rhs, 12}});
+        }
+    }
+    TestMatchesFDVerifier(kCIPublicHighway700, fds, 4);
+}
+
+}  // namespace tests
@@ -0,0 +1,85 @@
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "algorithms/algo_factory.h"
+#include "algorithms/ucc/ucc_verifier/batch_ucc_verifier.h"
+#include "algorithms/ucc/ucc_verifier/ucc_verifier.h"
+#include "all_csv_configs.h"
+#include "config/indices/type.h"
+#include "config/names.h"
+#include "config/thread_number/type.h"
+#include "csv_config_util.h"
+
+namespace tests {
+
+namespace {
+using algos::BatchUCCVerifier, algos::UCCVerifier;
+namespace onam = config::names;
+
+std::unique_ptr<UCCVerifier> VerifyOne(CSVConfig const& csv_config,
+                                       config::IndicesType const& ucc) {
+    auto verifier = algos::CreateAndLoadAlgorithm<UCCVerifier>(algos::StdParamsMap{
+            {onam::kCsvConfig, csv_config}, {onam::kUCCIndices, ucc}, {onam::kEqualNulls, true}});
+    verifier->Execute();
+    return verifier;
+}
+
+void TestMatchesUCCVerifier(CSVConfig const& csv_config, config::UCCsIndicesType const& uccs,
+                            config::ThreadNumType threads, bool collect_violations) {
+    auto batch_verifier = algos::CreateAndLoadAlgorithm<BatchUCCVerifier>(
+            algos::StdParamsMap{{onam::kCsvConfig, csv_config},
+                                {onam::kUCCsIndices, uccs},
+                                {onam::kEqualNulls, true},
+                                {onam::kThreads, threads},
+                                {onam::kCollectViolations, collect_violations}});
+    batch_verifier->Execute();
+    ASSERT_EQ(batch_verifier->GetNumUCCs(), uccs.size());
+
+    std::vector<std::size_t> violated;
+    for (std::size_t i = 0; i < uccs.size(); ++i) {
+        auto verifier = VerifyOne(csv_config, uccs[i]);
+        EXPECT_EQ(batch_verifier->UCCHolds(i), verifier->UCCHolds()) << i;
+        if (!verifier->UCCHolds()) violated.push_back(i);
+        if (!collect_violations) continue;
+
+        EXPECT_EQ(batch_verifier->GetNumClustersViolatingUCC(i),
+                  verifier->GetNumClustersViolatingUCC())
+                << i;
+        EXPECT_EQ(batch_verifier->GetNumRowsViolatingUCC(i), verifier->GetNumRowsViolatingUCC())
+                << i;
+        EXPECT_EQ(batch_verifier->GetClustersViolatingUCC(i), verifier->GetClustersViolatingUCC())
+                << i;
+        EXPECT_DOUBLE_EQ(batch_verifier->GetError(i), verifier->GetError()) << i;
+    }
+    EXPECT_EQ(batch_verifier->GetViolatedUCCIndices(), violated);
+}
+}  // namespace
+
+TEST(BatchUCCVerifierTest, MatchesUCCVerifier) {
+    config::UCCsIndicesType const uccs{{0},          {0, 1},    {0, 1, 2}, {0, 1, 2, 3, 4, 5},
+                                       {5},          {4, 5},    {1, 3},    {2, 3, 4},
+                                       {0, 1, 2, 3}, {3, 2, 1}, {1, 1, 4}, {0, 1}};
+    for (bool collect_violations : {true, false}) {
+        TestMatchesUCCVerifier(kTestFD, uccs, 1, collect_violations);
+        TestMatchesUCCVerifier(kTestFD, uccs, 4, collect_violations);
+    }
+}
+
+TEST(BatchUCCVerifierTest, SharedPrefixesOnLargerTable) {
+    config::UCCsIndicesType uccs;
+    for (config::IndexType first = 0; first < 4; ++first) {
+        for (config::IndexType last = 5; last < 13; ++last) {
+            uccs.push_back({first, last});
+            uccs.push_back({first, 4, last});
+            uccs.push_back({first, 4, last, 13});
+        }
+    }
+    for (bool collect_violations : {true, false}) {
+        TestMatchesUCCVerifier(kCIPublicHighway700, uccs, 4, collect_violations);
+    }
+}
+
+}  // namespace tests
@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <optional>
+#include <random>
+#include <set>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "model/table/dynamic_position_list_index.h"
+
+namespace tests {
+
+namespace {
+using model::DynPLI;
+using Records = std::vector<std::optional<DynPLI::ClusterValue>>;
+
+/* Clusters of the live records, grouped by value, in a form independent of cluster ids */
+std::set<std::set<int>> GroupRecords(Records const& records) {
+    std::map<DynPLI::ClusterValue, std::set<int>> groups;
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (records[i].has_value()) groups[*records[i]].insert(i);
+    }
+    std::set<std::set<int>> clusters;
+    for (auto& [value, rows] : groups) clusters.insert(std::move(rows));
+    return clusters;
+}
+
+void ExpectMatches(DynPLI const& pli, Records const& records) {
+    std::set<std::set<int>> clusters;
+    for (DynPLI::Cluster const& cluster : pli.GetClusters()) {
+        if (!cluster.empty()) clusters.emplace(cluster.begin(), cluster.end());
+    }
+    EXPECT_EQ(clusters, GroupRecords(records));
+    EXPECT_EQ(pli.GetNumCluster(), clusters.size());
+    ASSERT_EQ(pli.GetRelationSize(), records.size());
+
+    size_t live_records = 0;
+    for (size_t i = 0; i < records.size(); ++i) {
+        EXPECT_EQ(pli.IsRecordDeleted(i), !records[i].has_value()) << i;
+        if (!records[i].has_value()) continue;
+        ++live_records;
+        DynPLI::ClusterId const id = pli.GetProbingTable()[i];
+        EXPECT_EQ(pli.GetClusterValue(id), *records[i]) << i;
+        EXPECT_EQ(pli.FindCluster(*records[i]), id) << i;
+    }
+    EXPECT_EQ(pli.GetSize(), live_records);
+}
+}  // namespace
+
+TEST(DynamicPLITest, MatchesGroupingUnderRandomBatches) {
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<int> value_dist(0, 6);
+    auto random_value = [&]() {
+        return DynPLI::ClusterValue{value_dist(gen), value_dist(gen) % 2};
+    };
+
+    std::vector<DynPLI::ClusterValue> initial;
+    for (int i = 0; i < 50; ++i) initial.push_back(random_value());
+    Records records(initial.begin(), initial.end());
+    std::unique_ptr<DynPLI> pli = DynPLI::CreateFor(initial);
+    ExpectMatches(*pli, records);
+
+    for (int batch = 0; batch < 100; ++batch) {
+        std::vector<size_t> live;
+        for (size_t i = 0; i < records.size(); ++i) {
+            if (records[i].has_value()) live.push_back(i);
+        }
+        std::shuffle(live.begin(), live.end(), gen);
+        size_t const deletes_num = std::min<size_t>(batch % 7, live.size());
+        size_t const updates_num = std::min<size_t>(batch % 5, live.size() - deletes_num);
+
+        std::unordered_set<size_t> deleted;
+        std::vector<std::pair<std::optional<size_t>, DynPLI::ClusterValue>> inserted;
+        for (size_t i = 0; i < deletes_num + updates_num; ++i) {
+            deleted.insert(live[i]);
+            records[live[i]].reset();
+        }
+        for (size_t i = deletes_num; i < deletes_num + updates_num; ++i) {
+            records[live[i]] = random_value();
+            inserted.emplace_back(live[i], *records[live[i]]);
+        }
+        for (int i = 0; i < batch % 6; ++i) {
+            records.push_back(random_value());
+            inserted.emplace_back(std::nullopt, *records.back());
+        }
+        pli->UpdateWith(inserted, deleted);
+        ExpectMatches(*pli, records);
+    }
+}
+
+TEST(DynamicPLITest, IntersectGroupsByBothKeys) {
+    std::vector<DynPLI::ClusterValue> first{{1}, {1}, {2}, {2}, {1}, {3}};
+    std::vector<DynPLI::ClusterValue> second{{7}, {8}, {7}, {7}, {7}, {8}};
+    std::unique_ptr<DynPLI> first_pli = DynPLI::CreateFor(first);
+    std::unique_ptr<DynPLI> second_pli = DynPLI::CreateFor(second);
+    first_pli->UpdateWith({{std::nullopt, {1}}}, {3});
+    second_pli->UpdateWith({{std::nullopt, {8}}}, {3});
+
+    Records expected;
+    for (size_t i = 0; i < first.size(); ++i) {
+        expected.push_back(DynPLI::ClusterValue{first[i][0], second[i][0]});
+    }
+    expected[3].reset();
+    expected.push_back(DynPLI::ClusterValue{1, 8});
+    ExpectMatches(*first_pli->Intersect(second_pli.get()), expected);
+}
+
+TEST(DynamicPLITest, HashSeparatesPermutedKeys) {
+    model::ClusterValueHash const hash;
+    EXPECT_NE(hash({1, 2}), hash({2, 1}));
+    EXPECT_NE(hash({0}), hash({0, 0}));
+    EXPECT_NE(hash({1, 0}), hash({0, 1}));
+}
+
+}  // namespace tests
@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "algorithms/algo_factory.h"
+#include "algorithms/fd/dynfd/dynfd.h"
+#include "algorithms/fd/hyfd/hyfd.h"
+#include "all_csv_configs.h"
+#include "config/names.h"
+#include "config/thread_number/type.h"
+#include "csv_config_util.h"
+#include "dynamic_table_util.h"
+#include "model/table/idataset_stream.h"
+
+namespace tests {
+
+namespace {
+namespace onam = config::names;
+using Rows = std::vector<model::IDatasetStream::Row>;
+using FDSet = std::set<std::pair<std::vector<model::ColumnIndex>, model::ColumnIndex>>;
+
+FDSet GetFDs(algos::FDAlgorithm const& algorithm) {
+    FDSet fds;
+    for (FD const& fd : algorithm.FdList()) {
+        fds.emplace(fd.GetLhsIndices(), fd.GetRhsIndex());
+    }
+    return fds;
+}
+
+FDSet MineWithHyFD(config::InputTable const& table, bool is_null_equal_null = true) {
+    auto hyfd = algos::CreateAndLoadAlgorithm<algos::hyfd::HyFD>(
+            algos::StdParamsMap{{onam::kTable, table}, {onam::kEqualNulls, is_null_equal_null}});
+    hyfd->Execute();
+    return GetFDs(*hyfd);
+}
+
+model::IDatasetStream::Row RandomRow(size_t num_columns, std::mt19937& gen) {
+    // small domains keep FDs appearing and disappearing
+    std::uniform_int_distribution<int> value_dist(0, 3);
+    model::IDatasetStream::Row row;
+    for (size_t i = 0; i < num_columns; ++i) {
+        int const value = value_dist(gen) % (i + 2);
+        row.push_back(value == 0 && i % 3 == 0 ? "" : std::to_string(value));
+    }
+    return row;
+}
+
+class DynFDRandomBatchesTest : public ::testing::TestWithParam<bool> {};
+}  // namespace
+
+TEST(DynFDTest, InitialCoverMatchesHyFD) {
+    for (CSVConfig const& csv_config : {kTestDynamicFDInit, kTestFD}) {
+        auto dynfd = algos::CreateAndLoadAlgorithm<algos::dynfd::DynFD>(
+                algos::StdParamsMap{{onam::kCsvConfig, csv_config}});
+        dynfd->Execute();
+        EXPECT_EQ(GetFDs(*dynfd), MineWithHyFD(MakeInputTable(csv_config))) << csv_config.path;
+    }
+}
+
+TEST(DynFDTest, GrowsFromEmptyTable) {
+    auto dynfd = algos::CreateAndLoadAlgorithm<algos::dynfd::DynFD>(
+            algos::StdParamsMap{{onam::kCsvConfig, kTestDynamicFDEmpty}});
+    dynfd->Execute();
+    // every column is constant on an empty table
+    FDSet empty_lhs_fds;
+    for (model::ColumnIndex column = 0; column < 6; ++column) {
+        empty_lhs_fds.emplace(std::vector<model::ColumnIndex>{}, column);
+    }
+    EXPECT_EQ(GetFDs(*dynfd), empty_lhs_fds);
+
+    algos::ConfigureFromMap(*dynfd, algos::StdParamsMap{{onam::kInsertStatements,
+                                                         MakeInputTable(kTestDynamicFDInsert)}});
+    dynfd->Execute();
+    EXPECT_EQ(GetFDs(*dynfd), MineWithHyFD(MakeInputTable(kTestDynamicFDInsert)));
+}
+
+TEST(DynFDTest, MaintainsCoverUnderTestBatches) {
+    auto dynfd = algos::CreateAndLoadAlgorithm<algos::dynfd::DynFD>(algos::StdParamsMap{
+            {onam::kCsvConfig, kTestDynamicFDInit},
+            {onam::kInsertStatements, MakeInputTable(kTestDynamicFDInsert)},
+            {onam::kUpdateStatements, MakeInputTable(kTestDynamicFDUpdate)},
+            {onam::kDeleteStatements, std::unordered_set<size_t>{1, 6, 3}}});
+    dynfd->Execute();
+
+    // the same changes applied to the table by hand
+    Rows rows;
+    config::InputTable init_table = MakeInputTable(kTestDynamicFDInit);
+    while (init_table->HasNextRow()) rows.push_back(init_table->GetNextRow());
+    rows[0] = {"2", "1", "1", "999", "-", "10"};
+    rows[4] = {"1", "2", "2", "hjkl", "444", "5"};
+    config::InputTable insert_table = MakeInputTable(kTestDynamicFDInsert);
+    while (insert_table->HasNextRow()) rows.push_back(insert_table->GetNextRow());
+    for (size_t index : {6, 3, 1}) rows.erase(rows.begin() + index);
+    std::vector<std::string> column_names;
+    for (size_t i = 0; i < init_table->GetNumberOfColumns(); ++i) {
+        column_names.push_back(init_table->GetColumnName(i));
+    }
+    EXPECT_EQ(GetFDs(*dynfd),
+              MineWithHyFD(std::make_shared<RowsStream>(column_names, std::move(rows))));
+}
+
+TEST_P(DynFDRandomBatchesTest, MaintainsCover) {
+    bool const is_null_equal_null = GetParam();
+    std::mt19937 gen(17);
+    size_t const num_columns = 6;
+    std::vector<std::string> column_names;
+    for (size_t i = 0; i < num_columns; ++i) {
+        column_names.push_back("Col" + std::to_string(i));
+    }
+    TableMirror mirror(column_names);
+    Rows initial_rows;
+    for (int i = 0; i < 40; ++i) {
+        initial_rows.push_back(RandomRow(num_columns, gen));
+        mirror.Insert(initial_rows.back());
+    }
+    config::InputTable initial_table =
+            std::make_shared<RowsStream>(column_names, std::move(initial_rows));
+    auto dynfd = algos::CreateAndLoadAlgorithm<algos::dynfd::DynFD>(
+            algos::StdParamsMap{{onam::kTable, initial_table},
+                                {onam::kEqualNulls, is_null_equal_null},
+                                {onam::kThreads, static_cast<config::ThreadNumType>(2)}});
+    dynfd->Execute();
+    ASSERT_EQ(GetFDs(*dynfd), MineWithHyFD(mirror.MakeTable(), is_null_equal_null));
+
+    for (int batch = 0; batch < 30; ++batch) {
+        std::vector<size_t> row_indices = mirror.GetRowIndices();
+        std::shuffle(row_indices.begin(), row_indices.end(), gen);
+        std::uniform_int_distribution<size_t> ops_dist(0, 3);
+        size_t const deletes_num = std::min(ops_dist(gen), row_indices.size());
+        size_t const updates_num = std::min(ops_dist(gen), row_indices.size() - deletes_num);
+        size_t const inserts_num = ops_dist(gen);
+
+        std::unordered_set<size_t> deletes;
+        for (size_t i = 0; i < deletes_num; ++i) {
+            deletes.insert(row_indices[i]);
+            mirror.Delete(row_indices[i]);
+        }
+        std::vector<std::string> update_column_names{"_id"};
+        update_column_names.insert(update_column_names.end(), column_names.begin(),
+                                   column_names.end());
+        Rows updates;
+        for (size_t i = deletes_num; i < deletes_num + updates_num; ++i) {
+            model::IDatasetStream::Row row = RandomRow(num_columns, gen);
+            mirror.Update(row_indices[i], row);
+            row.insert(row.begin(), std::to_string(row_indices[i]));
+            updates.push_back(std::move(row));
+        }
+        Rows inserts;
+        for (size_t i = 0; i < inserts_num; ++i) {
+            inserts.push_back(RandomRow(num_columns, gen));
+            mirror.Insert(inserts.back());
+        }
+
+        config::InputTable update_table =
+                std::make_shared<RowsStream>(update_column_names, std::move(updates));
+        config::InputTable insert_table =
+                std::make_shared<RowsStream>(column_names, std::move(inserts));
+        algos::ConfigureFromMap(*dynfd,
+                                algos::StdParamsMap{{onam::kDeleteStatements, deletes},
+                                                    {onam::kUpdateStatements, update_table},
+                                                    {onam::kInsertStatements, insert_table}});
+        dynfd->Execute();
+        ASSERT_EQ(GetFDs(*dynfd), MineWithHyFD(mirror.MakeTable(), is_null_equal_null))
+                << "batch " << batch;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(DynFDTestSuite, DynFDRandomBatchesTest, ::testing::Values(true, false));
+
+}  // namespace tests
@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <easylogging++.h>
+#include <gtest/gtest.h>
+
+#include "algorithms/algo_factory.h"
+#include "algorithms/ucc/dynucc/dynucc.h"
+#include "algorithms/ucc/hyucc/hyucc.h"
+#include "all_csv_configs.h"
+#include "config/names.h"
+#include "config/thread_number/type.h"
+#include "csv_config_util.h"
+#include "dynamic_table_util.h"
+#include "model/table/idataset_stream.h"
+
+namespace tests {
+
+namespace {
+namespace onam = config::names;
+using Rows = std::vector<model::IDatasetStream::Row>;
+using UCCSet = std::set<std::vector<model::ColumnIndex>>;
+
+UCCSet GetUCCs(algos::UCCAlgorithm const& algorithm) {
+    UCCSet uccs;
+    for (model::UCC const& ucc : algorithm.UCCList()) {
+        uccs.insert(ucc.GetColumnIndicesAsVector());
+    }
+    return uccs;
+}
+
+UCCSet MineWithHyUCC(config::InputTable const& table, bool is_null_equal_null) {
+    auto hyucc = algos::CreateAndLoadAlgorithm<algos::HyUCC>(
+            algos::StdParamsMap{{onam::kTable, table}, {onam::kEqualNulls, is_null_equal_null}});
+    hyucc->Execute();
+    return GetUCCs(*hyucc);
+}
+
+std::vector<std::string> MakeColumnNames(size_t num_columns) {
+    std::vector<std::string> column_names;
+    for (size_t i = 0; i < num_columns; ++i) {
+        column_names.push_back("Col" + std::to_string(i));
+    }
+    return column_names;
+}
+
+model::IDatasetStream::Row RandomRow(size_t num_columns, std::mt19937& gen) {
+    // domains of different sizes make some single columns and some pairs nearly unique
+    model::IDatasetStream::Row row;
+    for (size_t i = 0; i < num_columns; ++i) {
+        std::uniform_int_distribution<int> value_dist(0, static_cast<int>(2 + 4 * i));
+        int const value = value_dist(gen);
+        row.push_back(value == 0 && i % 2 == 1 ? "" : std::to_string(value));
+    }
+    return row;
+}
+
+class DynUCCRandomBatchesTest : public ::testing::TestWithParam<bool> {};
+}  // namespace
+
+TEST(DynUCCTest, InitialUCCsMatchHyUCC) {
+    for (CSVConfig const& csv_config : {kTestDynamicFDInit, kTestFD, kTestWide}) {
+        auto dynucc = algos::CreateAndLoadAlgorithm<algos::dynucc::DynUCC>(
+                algos::StdParamsMap{{onam::kCsvConfig, csv_config}});
+        dynucc->Execute();
+        EXPECT_EQ(GetUCCs(*dynucc), MineWithHyUCC(MakeInputTable(csv_config), true))
+                << csv_config.path;
+    }
+}
+
+TEST(DynUCCTest, GrowsFromEmptyTable) {
+    auto dynucc = algos::CreateAndLoadAlgorithm<algos::dynucc::DynUCC>(
+            algos::StdParamsMap{{onam::kCsvConfig, kTestDynamicFDEmpty}});
+    dynucc->Execute();
+    // every single column is unique on an empty table
+    UCCSet single_columns;
+    for (model::ColumnIndex column = 0; column < 6; ++column) {
+        single_columns.insert({column});
+    }
+    EXPECT_EQ(GetUCCs(*dynucc), single_columns);
+
+    algos::ConfigureFromMap(*dynucc, algos::StdParamsMap{{onam::kInsertStatements,
+                                                          MakeInputTable(kTestDynamicFDInsert)}});
+    dynucc->Execute();
+    EXPECT_EQ(GetUCCs(*dynucc), MineWithHyUCC(MakeInputTable(kTestDynamicFDInsert), true));
+}
+
+TEST_P(DynUCCRandomBatchesTest, MaintainsUCCs) {
+    bool const is_null_equal_null = GetParam();
+    std::mt19937 gen(23);
+    size_t const num_columns = 6;
+    TableMirror mirror(MakeColumnNames(num_columns));
+    Rows initial_rows;
+    for (int i = 0; i < 30; ++i) {
+        initial_rows.push_back(RandomRow(num_columns, gen));
+        mirror.Insert(initial_rows.back());
+    }
+    config::InputTable initial_table =
+            std::make_shared<RowsStream>(mirror.GetColumnNames(), std::move(initial_rows));
+    auto dynucc = algos::CreateAndLoadAlgorithm<algos::dynucc::DynUCC>(
+            algos::StdParamsMap{{onam::kTable, initial_table},
+                                {onam::kEqualNulls, is_null_equal_null},
+                                {onam::kThreads, static_cast<config::ThreadNumType>(2)}});
+    dynucc->Execute();
+    ASSERT_EQ(GetUCCs(*dynucc), MineWithHyUCC(mirror.MakeTable(), is_null_equal_null));
+
+    for (int batch = 0; batch < 40; ++batch) {
+        std::vector<size_t> row_indices = mirror.GetRowIndices();
+        std::shuffle(row_indices.begin(), row_indices.end(), gen);
+        // deletes outweigh inserts in the first half and inserts outweigh deletes in the second,
+        // a few rows are always left, HyUCC does not take empty tables
+        std::uniform_int_distribution<size_t> small_dist(0, 2);
+        std::uniform_int_distribution<size_t> large_dist(0, 5);
+        size_t const deletes_num = std::min(batch < 20 ? large_dist(gen) : small_dist(gen),
+                                            row_indices.size() - std::min<size_t>(
+                                                                         row_indices.size(), 5));
+        size_t const updates_num = std::min(small_dist(gen), row_indices.size() - deletes_num);
+        size_t const inserts_num = batch < 20 ? small_dist(gen) : large_dist(gen);
+
+        std::unordered_set<size_t> deletes;
+        for (size_t i = 0; i < deletes_num; ++i) {
+            deletes.insert(row_indices[i]);
+            mirror.Delete(row_indices[i]);
+        }
+        std::vector<std::string> update_column_names{"_id"};
+        update_column_names.insert(update_column_names.end(), mirror.GetColumnNames().begin(),
+                                   mirror.GetColumnNames().end());
+        Rows updates;
+        for (size_t i = deletes_num; i < deletes_num + updates_num; ++i) {
+            model::IDatasetStream::Row row = RandomRow(num_columns, gen);
+            mirror.Update(row_indices[i], row);
+            row.insert(row.begin(), std::to_string(row_indices[i]));
+            updates.push_back(std::move(row));
+        }
+        Rows inserts;
+        for (size_t i = 0; i < inserts_num; ++i) {
+            inserts.push_back(RandomRow(num_columns, gen));
+            mirror.Insert(inserts.back());
+        }
+
+        config::InputTable update_table =
+                std::make_shared<RowsStream>(update_column_names, std::move(updates));
+        config::InputTable insert_table =
+                std::make_shared<RowsStream>(mirror.GetColumnNames(), std::move(inserts));
+        algos::ConfigureFromMap(*dynucc,
+                                algos::StdParamsMap{{onam::kDeleteStatements, deletes},
+                                                    {onam::kUpdateStatements, update_table},
+                                                    {onam::kInsertStatements, insert_table}});
+        dynucc->Execute();
+        ASSERT_EQ(GetUCCs(*dynucc), MineWithHyUCC(mirror.MakeTable(), is_null_equal_null))
+                << "batch " << batch;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(DynUCCTestSuite, DynUCCRandomBatchesTest, ::testing::Values(true, false));
+
+// To measure the throughput of batches of different sizes, run with
+// --gtest_also_run_disabled_tests
+TEST(DynUCCTest, DISABLED_BatchThroughput) {
+    size_t const num_columns = 10;
+    size_t const initial_rows_num = 100'000;
+    std::vector<std::string> const column_names = MakeColumnNames(num_columns);
+    auto random_table = [&column_names](size_t rows_num, std::mt19937& gen) {
+        // wide domains leave UCCs of two and three columns
+        Rows rows;
+        for (size_t i = 0; i < rows_num; ++i) {
+            model::IDatasetStream::Row row;
+            for (size_t column = 0; column < column_names.size(); ++column) {
+                std::uniform_int_distribution<int> value_dist(0, 10 << column);
+                row.push_back(std::to_string(value_dist(gen)));
+            }
+            rows.push_back(std::move(row));
+        }
+        return config::InputTable{std::make_shared<RowsStream>(column_names, std::move(rows))};
+    };
+
+    for (size_t batch_size : {1, 10, 100, 1'000, 10'000, 100'000}) {
+        std::mt19937 gen(batch_size);
+        auto dynucc = algos::CreateAndLoadAlgorithm<algos::dynucc::DynUCC>(algos::StdParamsMap{
+                {onam::kTable, random_table(initial_rows_num, gen)},
+                {onam::kThreads, static_cast<config::ThreadNumType>(4)}});
+        dynucc->Execute();
+
+        algos::ConfigureFromMap(*dynucc, algos::StdParamsMap{{onam::kInsertStatements,
+                                                              random_table(batch_size, gen)}});
+        unsigned long long const insert_time = dynucc->Execute();
+
+        std::unordered_set<size_t> deletes;
+        std::uniform_int_distribution<size_t> row_dist(0, initial_rows_num - 1);
+        while (deletes.size() < batch_size) deletes.insert(row_dist(gen));
+        algos::ConfigureFromMap(*dynucc, algos::StdParamsMap{{onam::kDeleteStatements, deletes}});
+        unsigned long long const delete_time = dynucc->Execute();
+
+        LOG(INFO) << "batch of " << batch_size << " rows: inserted in " << insert_time
+                  << " ms, deleted in " << delete_time << " ms, " << dynucc->UCCList().size()
+                  << " UCCs";
+    }
+}
+
+}  // namespace tests
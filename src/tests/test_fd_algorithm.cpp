@@ -3,15 +3,18 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "algorithms/fd/aidfd/aid.h"
 #include "algorithms/fd/depminer/depminer.h"
 #include "algorithms/fd/dfd/dfd.h"
 #include "algorithms/fd/fastfds/fastfds.h"
+#include "algorithms/fd/fd_mine/fd_mine.h"
 #include "algorithms/fd/fdep/fdep.h"
 #include "algorithms/fd/fun/fun.h"
 #include "algorithms/fd/hyfd/hyfd.h"
 #include "algorithms/fd/pfdtane/pfdtane.h"
 #include "algorithms/fd/pyro/pyro.h"
 #include "algorithms/fd/tane/tane.h"
+#include "config/thread_number/type.h"
 #include "model/table/relational_schema.h"
 #include "test_fd_util.h"
 
@@ -161,4 +164,28 @@ using Algorithms =
                          algos::FDep, algos::FUN, algos::hyfd::HyFD, algos::PFDTane>;
 INSTANTIATE_TYPED_TEST_SUITE_P(AlgorithmTest, AlgorithmTest, Algorithms);
 
+template <typename T>
+class ParallelAlgorithmTest : public AlgorithmTest<T> {};
+
+using ParallelAlgorithms = ::testing::Types<algos::Aid, algos::DFD, algos::FdMine, algos::FDep,
+                                            algos::FUN, algos::PFDTane>;
+TYPED_TEST_SUITE(ParallelAlgorithmTest, ParallelAlgorithms);
+
+// The work is split between the threads, the result must not depend on their number
+TYPED_TEST(ParallelAlgorithmTest, ParallelGivesSameResult) {
+    for (CSVConfig const& csv_config : {kCIPublicHighway700, kWdcSatellites, kTestFD}) {
+        algos::StdParamsMap params = TestFixture::GetParamMap(csv_config);
+        params[config::names::kThreads] = config::ThreadNumType{1};
+        auto single_threaded = algos::CreateAndLoadAlgorithm<TypeParam>(params);
+        single_threaded->Execute();
+        params[config::names::kThreads] = config::ThreadNumType{4};
+        auto multi_threaded = algos::CreateAndLoadAlgorithm<TypeParam>(params);
+        multi_threaded->Execute();
+        EXPECT_EQ(single_threaded->Fletcher16(), multi_threaded->Fletcher16())
+                << csv_config.path.filename();
+        EXPECT_EQ(single_threaded->FdList().size(), multi_threaded->FdList().size())
+                << csv_config.path.filename();
+    }
+}
+
 }  // namespace tests
@@ -0,0 +1,155 @@
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "algorithms/algo_factory.h"
+#include "algorithms/fd/aidfd/aid.h"
+#include "algorithms/fd/fd_verifier/afd_error_calculator.h"
+#include "algorithms/fd/fdep/fdep.h"
+#include "algorithms/fd/hyfd/hyfd.h"
+#include "config/indices/type.h"
+#include "config/names.h"
+#include "config/thread_number/type.h"
+#include "dynamic_table_util.h"
+#include "model/table/column_layout_relation_data.h"
+#include "model/table/idataset_stream.h"
+
+namespace tests {
+
+namespace {
+namespace onam = config::names;
+using Rows = std::vector<model::IDatasetStream::Row>;
+
+std::vector<std::string> const kColumnNames{"A", "B", "C", "D", "E"};
+
+// Rows drawn from a few distinct ones, so most of them are duplicates
+config::InputTable MakeTableWithDuplicates(unsigned seed) {
+    std::mt19937 gen(seed);
+    Rows distinct_rows;
+    for (int i = 0; i < 12; ++i) {
+        model::IDatasetStream::Row row;
+        for (size_t column = 0; column < kColumnNames.size(); ++column) {
+            std::uniform_int_distribution<int> value_dist(0, static_cast<int>(1 + column));
+            int const value = value_dist(gen);
+            row.push_back(value == 0 && column % 2 == 1 ? "" : std::to_string(value));
+        }
+        distinct_rows.push_back(std::move(row));
+    }
+    std::uniform_int_distribution<size_t> row_dist(0, distinct_rows.size() - 1);
+    Rows rows;
+    for (int i = 0; i < 200; ++i) {
+        rows.push_back(distinct_rows[row_dist(gen)]);
+    }
+    return std::make_shared<RowsStream>(kColumnNames, std::move(rows));
+}
+
+// the rows are deduplicated by several threads, the algorithms take the option on load then
+config::ThreadNumType const kThreads = 4;
+
+template <typename Algorithm>
+std::set<std::string> MineFDs(config::InputTable const& table, bool deduplicate_rows) {
+    table->Reset();
+    auto algorithm = algos::CreateAndLoadAlgorithm<Algorithm>(
+            algos::StdParamsMap{{onam::kTable, table},
+                                {onam::kDeduplicateRows, deduplicate_rows},
+                                {onam::kThreads, kThreads}});
+    algorithm->Execute();
+    std::set<std::string> fds;
+    for (FD const& fd : algorithm->FdList()) {
+        fds.insert(fd.ToLongString());
+    }
+    return fds;
+}
+
+std::vector<algos::fd_verifier::AfdErrors> CalculateErrors(config::InputTable const& table,
+                                                           config::FdsIndicesType const& fds,
+                                                           bool is_null_equal_null,
+                                                           bool deduplicate_rows) {
+    table->Reset();
+    auto calculator = algos::CreateAndLoadAlgorithm<algos::fd_verifier::AfdErrorCalculator>(
+            algos::StdParamsMap{{onam::kTable, table},
+                                {onam::kFdsIndices, fds},
+                                {onam::kEqualNulls, is_null_equal_null},
+                                {onam::kDeduplicateRows, deduplicate_rows},
+                                {onam::kThreads, kThreads}});
+    calculator->Execute();
+    return calculator->GetErrors();
+}
+}  // namespace
+
+TEST(FdRowDeduplicationTest, RelationKeepsDistinctRowsWithWeights) {
+    Rows const rows{{"1", "a"}, {"2", ""}, {"1", "a"}, {"2", ""}, {"1", "a"}, {"3", "b"}};
+    for (bool is_null_equal_null : {true, false}) {
+        RowsStream stream({"X", "Y"}, rows);
+        auto relation = ColumnLayoutRelationData::CreateFrom(stream, is_null_equal_null, true, 2);
+        ASSERT_TRUE(relation->IsDeduplicated());
+        EXPECT_EQ(relation->GetNumOriginalRows(), rows.size());
+        // the rows holding a NULL agree only if NULLs are equal
+        std::vector<size_t> const expected_weights =
+                is_null_equal_null ? std::vector<size_t>{3, 2, 1} : std::vector<size_t>{3, 1, 1, 1};
+        EXPECT_EQ(relation->GetRowWeights(), expected_weights);
+        EXPECT_EQ(relation->GetNumRows(), expected_weights.size());
+
+        RowsStream original_stream({"X", "Y"}, rows);
+        auto original = ColumnLayoutRelationData::CreateFrom(original_stream, is_null_equal_null);
+        EXPECT_FALSE(original->IsDeduplicated());
+        for (size_t column = 0; column < 2; ++column) {
+            EXPECT_EQ(relation->GetNumAgreeingTuplePairs(
+                              *relation->GetColumnData(column).GetPositionListIndex()),
+                      original->GetColumnData(column).GetPositionListIndex()->GetNepAsLong());
+        }
+    }
+}
+
+TEST(FdRowDeduplicationTest, ExactMinersFindSameFDs) {
+    for (unsigned seed : {1, 2, 3}) {
+        config::InputTable const table = MakeTableWithDuplicates(seed);
+        std::set<std::string> const fds = MineFDs<algos::hyfd::HyFD>(table, false);
+        EXPECT_EQ(MineFDs<algos::hyfd::HyFD>(table, true), fds) << seed;
+        EXPECT_EQ(MineFDs<algos::Aid>(table, true), MineFDs<algos::Aid>(table, false)) << seed;
+        EXPECT_EQ(MineFDs<algos::FDep>(table, true), MineFDs<algos::FDep>(table, false)) << seed;
+    }
+}
+
+TEST(FdRowDeduplicationTest, ThreadsAreNeededOnLoadOnlyWithDeduplication) {
+    for (bool deduplicate_rows : {false, true}) {
+        algos::fd_verifier::AfdErrorCalculator calculator;
+        calculator.SetOption(onam::kDeduplicateRows, deduplicate_rows);
+        EXPECT_EQ(calculator.GetNeededOptions().contains(onam::kThreads), deduplicate_rows);
+        algos::Aid aid;
+        aid.SetOption(onam::kDeduplicateRows, deduplicate_rows);
+        EXPECT_EQ(aid.GetNeededOptions().contains(onam::kThreads), deduplicate_rows);
+    }
+}
+
+TEST(FdRowDeduplicationTest, ErrorsDoNotDependOnDeduplication) {
+    config::FdsIndicesType fds;
+    for (config::IndexType rhs = 0; rhs < kColumnNames.size(); ++rhs) {
+        for (config::IndexType lhs = 0; lhs < kColumnNames.size(); ++lhs) {
+            if (lhs == rhs) continue;
+            fds.push_back({{lhs}, {rhs}});
+            fds.push_back({{lhs, (lhs + 1) % 5}, {rhs}});
+        }
+    }
+    for (bool is_null_equal_null : {true, false}) {
+        config::InputTable const table = MakeTableWithDuplicates(4);
+        std::vector<algos::fd_verifier::AfdErrors> const errors =
+                CalculateErrors(table, fds, is_null_equal_null, false);
+        std::vector<algos::fd_verifier::AfdErrors> const deduplicated_errors =
+                CalculateErrors(table, fds, is_null_equal_null, true);
+        ASSERT_EQ(deduplicated_errors.size(), errors.size());
+        for (size_t i = 0; i < errors.size(); ++i) {
+            EXPECT_DOUBLE_EQ(deduplicated_errors[i].g1, errors[i].g1) << i;
+            EXPECT_DOUBLE_EQ(deduplicated_errors[i].g3, errors[i].g3) << i;
+            EXPECT_DOUBLE_EQ(deduplicated_errors[i].per_value, errors[i].per_value) << i;
+        }
+    }
+}
+
+}  // namespace tests
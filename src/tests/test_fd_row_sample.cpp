@@ -0,0 +1,70 @@
+#include <list>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "algorithms/algo_factory.h"
+#include "algorithms/fd/tane/tane.h"
+#include "all_csv_configs.h"
+#include "config/names.h"
+#include "csv_config_util.h"
+
+namespace tests {
+
+namespace {
+std::unique_ptr<algos::Tane> CreateTane(CSVConfig const& csv_config, unsigned int sample_size) {
+    using namespace config::names;
+    return algos::CreateAndLoadAlgorithm<algos::Tane>(algos::StdParamsMap{
+            {kCsvConfig, csv_config}, {kRowSampleSize, sample_size}, {kRowSampleSeed, 7}});
+}
+
+std::set<std::string> ToStrings(std::list<FD> const& fds) {
+    std::set<std::string> strings;
+    for (FD const& fd : fds) {
+        strings.insert(fd.ToLongString());
+    }
+    return strings;
+}
+}  // namespace
+
+TEST(FdRowSampleTest, SampleOfAllRowsGivesSameResult) {
+    auto full_run = CreateTane(kCIPublicHighway700, 0);
+    full_run->Execute();
+    auto sampled = CreateTane(kCIPublicHighway700, 100000);
+    sampled->Execute();
+
+    EXPECT_FALSE(full_run->IsSampled());
+    EXPECT_TRUE(sampled->IsSampled());
+    EXPECT_EQ(sampled->GetTableRowsNum(), full_run->GetTableRowsNum());
+    EXPECT_EQ(ToStrings(sampled->FdList()), ToStrings(full_run->FdList()));
+}
+
+TEST(FdRowSampleTest, CandidatesAreValidatedOnFullData) {
+    auto full_run = CreateTane(kCIPublicHighway700, 0);
+    full_run->Execute();
+    std::set<std::string> const full_fds = ToStrings(full_run->FdList());
+
+    auto sampled = CreateTane(kCIPublicHighway700, 200);
+    sampled->Execute();
+    std::vector<model::ConfidenceInterval> const intervals = sampled->GetFdErrorIntervals(0.9);
+    std::vector<config::ErrorType> const full_errors = sampled->CalculateFullDataErrors();
+    ASSERT_EQ(intervals.size(), sampled->FdList().size());
+    ASSERT_EQ(full_errors.size(), sampled->FdList().size());
+
+    auto fd_it = sampled->FdList().begin();
+    for (size_t i = 0; i < intervals.size(); ++i, ++fd_it) {
+        // exact FDs are mined, so they hold on the sample
+        EXPECT_EQ(intervals[i].GetMean(), 0);
+        EXPECT_LE(intervals[i].GetMin(), intervals[i].GetMean());
+        EXPECT_GT(intervals[i].GetMax(), intervals[i].GetMean());
+        // a minimal FD of the sample that holds on the whole table is minimal there as well
+        if (full_errors[i] == 0) {
+            EXPECT_TRUE(full_fds.contains(fd_it->ToLongString())) << fd_it->ToLongString();
+        }
+    }
+}
+
+}  // namespace tests
@@ -1,5 +1,7 @@
 #include <algorithm>
 #include <memory>
+#include <tuple>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -123,4 +125,44 @@ INSTANTIATE_TEST_SUITE_P(
             ));
 // clang-format on
 
+TEST(FDVerifierHighlightsTest, PagesMatchSortedHighlights) {
+    for (auto const& [csv_config, lhs, rhs] :
+         {std::tuple{kTestFD, config::IndicesType{1}, config::IndicesType{2}},
+          std::tuple{kTestFD, config::IndicesType{3, 4}, config::IndicesType{1, 2}},
+          std::tuple{kCIPublicHighway700, config::IndicesType{1}, config::IndicesType{3}}}) {
+        auto verifier = algos::CreateAndLoadAlgorithm<FDVerifier>(
+                algos::StdParamsMap{{onam::kCsvConfig, csv_config},
+                                    {onam::kLhsIndices, lhs},
+                                    {onam::kRhsIndices, rhs},
+                                    {onam::kEqualNulls, true}});
+        verifier->Execute();
+        // the pages are selected before the highlights are sorted as a whole
+        size_t const page_size = 3;
+        std::vector<Highlight> paged;
+        for (size_t offset = 0;; offset += page_size) {
+            std::vector<Highlight> page = verifier->GetHighlights(offset, page_size);
+            if (page.empty()) break;
+            ASSERT_LE(page.size(), page_size);
+            paged.insert(paged.end(), page.begin(), page.end());
+        }
+
+        auto const& highlights = verifier->GetHighlights();
+        ASSERT_FALSE(highlights.empty());
+        ASSERT_EQ(paged.size(), verifier->GetNumErrorClusters());
+        ASSERT_EQ(paged.size(), highlights.size());
+        for (size_t i = 0; i < highlights.size(); ++i) {
+            EXPECT_EQ(paged[i].GetCluster(), highlights[i].GetCluster());
+            EXPECT_EQ(verifier->GetHighlightRhsValues(paged[i]).size(),
+                      paged[i].GetCluster().size());
+        }
+
+        verifier->SortHighlightsBySizeAscending();
+        std::vector<Highlight> page = verifier->GetHighlights(1, page_size);
+        ASSERT_EQ(page.size(), std::min(page_size, highlights.size() - 1));
+        for (size_t i = 0; i < page.size(); ++i) {
+            EXPECT_EQ(page[i].GetCluster(), highlights[i + 1].GetCluster());
+        }
+    }
+}
+
 }  // namespace tests
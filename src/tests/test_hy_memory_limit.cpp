@@ -0,0 +1,83 @@
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "algorithms/algo_factory.h"
+#include "algorithms/fd/hyfd/hyfd.h"
+#include "algorithms/ucc/hyucc/hyucc.h"
+#include "all_csv_configs.h"
+#include "config/mem_limit/type.h"
+#include "config/names.h"
+#include "csv_config_util.h"
+#include "dynamic_table_util.h"
+
+namespace tests {
+
+namespace {
+namespace onam = config::names;
+
+template <typename Algorithm>
+std::unique_ptr<Algorithm> Run(config::InputTable const& table, algos::StdParamsMap params) {
+    table->Reset();
+    params.emplace(onam::kTable, table);
+    auto algorithm = algos::CreateAndLoadAlgorithm<Algorithm>(params);
+    algorithm->Execute();
+    return algorithm;
+}
+
+std::vector<std::string> GetFDs(algos::hyfd::HyFD const& hyfd) {
+    std::vector<std::string> fds;
+    for (FD const& fd : hyfd.FdList()) {
+        fds.push_back(fd.ToLongString());
+    }
+    return fds;
+}
+
+std::vector<std::string> GetUCCs(algos::HyUCC const& hyucc) {
+    std::vector<std::string> uccs;
+    for (model::UCC const& ucc : hyucc.UCCList()) {
+        uccs.push_back(ucc.ToIndicesString());
+    }
+    return uccs;
+}
+}  // namespace
+
+TEST(HyMemoryLimitTest, NoLimitByDefault) {
+    config::MemLimitMBType const large_limit = 1u << 20;
+    for (CSVConfig const& csv_config : {kCIPublicHighway700, kWdcSatellites, kTestFD}) {
+        config::InputTable const table = MakeInputTable(csv_config);
+        auto hyfd = Run<algos::hyfd::HyFD>(table, {});
+        auto limited_hyfd = Run<algos::hyfd::HyFD>(table, {{onam::kMemLimitMB, large_limit}});
+        EXPECT_FALSE(hyfd->IsResultTruncated());
+        EXPECT_EQ(GetFDs(*hyfd), GetFDs(*limited_hyfd));
+
+        auto hyucc = Run<algos::HyUCC>(table, {});
+        auto limited_hyucc = Run<algos::HyUCC>(table, {{onam::kMemLimitMB, large_limit}});
+        EXPECT_FALSE(hyucc->IsResultTruncated());
+        EXPECT_EQ(GetUCCs(*hyucc), GetUCCs(*limited_hyucc));
+    }
+}
+
+TEST(HyMemoryLimitTest, ExceededLimitTruncatesResult) {
+    // the PLIs and the compressed records of the table alone take more than the smallest limit
+    config::InputTable const table = MakeModuloTable(250000);
+    config::MemLimitMBType const small_limit = 16;
+
+    auto hyfd = Run<algos::hyfd::HyFD>(table, {});
+    auto limited_hyfd = Run<algos::hyfd::HyFD>(table, {{onam::kMemLimitMB, small_limit}});
+    EXPECT_FALSE(hyfd->IsResultTruncated());
+    EXPECT_TRUE(limited_hyfd->IsResultTruncated());
+    EXPECT_NE(GetFDs(*hyfd), GetFDs(*limited_hyfd));
+
+    auto hyucc = Run<algos::HyUCC>(table, {});
+    auto limited_hyucc = Run<algos::HyUCC>(table, {{onam::kMemLimitMB, small_limit}});
+    EXPECT_FALSE(hyucc->IsResultTruncated());
+    EXPECT_TRUE(limited_hyucc->IsResultTruncated());
+    EXPECT_NE(GetUCCs(*hyucc), GetUCCs(*limited_hyucc));
+}
+
+}  // namespace tests
@@ -166,6 +166,32 @@ INSTANTIATE_TEST_SUITE_P(
                 MetricVerifyingParams(kTestMetric, Metric::euclidean, 6.0091679956547, {0},
                                       {13, 14, 15})));
 
+TEST_P(TestHighlights, PagesMatchSortedHighlights) {
+    auto verifier = CreateMetricVerifier(GetParam().params);
+    verifier->Execute();
+    // the pages are selected before the highlights are sorted as a whole
+    size_t const page_size = 4;
+    std::vector<std::vector<algos::metric::Highlight>> paged(
+            verifier->GetNumHighlightedClusters());
+    for (size_t i = 0; i < paged.size(); ++i) {
+        for (size_t offset = 0;; offset += page_size) {
+            auto page = verifier->GetHighlights(i, offset, page_size);
+            if (page.empty()) break;
+            ASSERT_LE(page.size(), page_size);
+            paged[i].insert(paged[i].end(), page.begin(), page.end());
+        }
+    }
+
+    auto const& highlights = verifier->GetHighlights();
+    ASSERT_EQ(paged.size(), highlights.size());
+    for (size_t i = 0; i < highlights.size(); ++i) {
+        ASSERT_EQ(paged[i].size(), highlights[i].size());
+        for (size_t j = 0; j < highlights[i].size(); ++j) {
+            EXPECT_EQ(paged[i][j].ToTuple(), highlights[i][j].ToTuple());
+        }
+    }
+}
+
 constexpr long double kInf = std::numeric_limits<long double>::infinity();
 
 INSTANTIATE_TEST_SUITE_P(
@@ -0,0 +1,30 @@
+#include <gtest/gtest.h>
+
+#include "algorithms/fd/dfd/partition_storage/partition_storage.h"
+#include "all_csv_configs.h"
+#include "csv_config_util.h"
+#include "model/table/column_layout_relation_data.h"
+
+namespace tests {
+
+TEST(PartitionStorageTest, EvictsUnderMemoryBudget) {
+    auto relation =
+            ColumnLayoutRelationData::CreateFrom(*MakeInputTable(kCIPublicHighway700), true);
+    RelationalSchema const* schema = relation->GetSchema();
+    size_t const num_columns = schema->GetNumColumns();
+    // every cached multi-column PLI exceeds the budget
+    PartitionStorage storage(relation.get(), CachingMethod::kAllCaching,
+                             CacheEvictionMethod::kMedainUsage, 0);
+
+    for (size_t i = 0; i < num_columns; ++i) {
+        for (size_t j = i + 1; j < num_columns; ++j) {
+            Vertical const pair = Vertical(*schema->GetColumn(i)).Union(*schema->GetColumn(j));
+            auto const expected = relation->GetColumnData(i).GetPositionListIndex()->Intersect(
+                    relation->GetColumnData(j).GetPositionListIndex());
+            EXPECT_EQ(storage.GetOrCreateFor(pair)->GetNepAsLong(), expected->GetNepAsLong());
+        }
+    }
+    EXPECT_GT(storage.GetEvictionsNum(), 0u);
+}
+
+}  // namespace tests
@@ -0,0 +1,204 @@
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "algorithms/algo_factory.h"
+#include "algorithms/fd/fd.h"
+#include "algorithms/fd/dfd/dfd.h"
+#include "algorithms/fd/fdep/fdep.h"
+#include "algorithms/fd/hyfd/hyfd.h"
+#include "algorithms/fd/tane/tane.h"
+#include "algorithms/ucc/hyucc/hyucc.h"
+#include "all_csv_configs.h"
+#include "config/exceptions.h"
+#include "config/names.h"
+#include "config/time_limit/type.h"
+#include "csv_config_util.h"
+#include "dynamic_table_util.h"
+#include "model/table/column_layout_relation_data.h"
+#include "util/bounded_spsc_queue.h"
+
+namespace tests {
+
+namespace {
+algos::StdParamsMap GetParamMap(CSVConfig const& csv_config) {
+    return {{config::names::kCsvConfig, csv_config}};
+}
+
+std::unique_ptr<algos::Tane> CreateTane(CSVConfig const& csv_config) {
+    return algos::CreateAndLoadAlgorithm<algos::Tane>(GetParamMap(csv_config));
+}
+
+template <typename Algorithm>
+std::unique_ptr<Algorithm> RunForASecond(config::InputTable const& table) {
+    table->Reset();
+    config::TimeLimitSecondsType const time_limit = 1;
+    auto algorithm = algos::CreateAndLoadAlgorithm<Algorithm>(algos::StdParamsMap{
+            {config::names::kTable, table}, {config::names::kTimeLimitSeconds, time_limit}});
+    algorithm->Execute();
+    return algorithm;
+}
+
+// the rows agreeing on every column of the set are the ones in the same cluster of its PLI
+unsigned long long CountAgreeingPairs(ColumnLayoutRelationData const& relation,
+                                      std::vector<unsigned> const& indices) {
+    if (indices.empty()) return relation.GetNumTuplePairs();
+    model::PLI const* pli = relation.GetColumnData(indices.front()).GetPositionListIndex();
+    std::unique_ptr<model::PLI> intersection;
+    for (std::size_t i = 1; i < indices.size(); ++i) {
+        intersection = pli->Intersect(relation.GetColumnData(indices[i]).GetPositionListIndex());
+        pli = intersection.get();
+    }
+    return pli->GetNepAsLong();
+}
+
+// the FDs found until the stop hold on the whole table
+void ExpectValidFDs(std::list<FD> const& fds, ColumnLayoutRelationData const& relation) {
+    for (FD const& fd : fds) {
+        std::vector<unsigned> indices = fd.GetLhs().GetColumnIndicesAsVector();
+        unsigned long long const lhs_pairs = CountAgreeingPairs(relation, indices);
+        indices.push_back(fd.GetRhsIndex());
+        EXPECT_EQ(CountAgreeingPairs(relation, indices), lhs_pairs) << fd.ToLongString();
+    }
+}
+
+// stops the algorithm once it has registered the given number of FDs
+template <typename Algorithm>
+void TestConsumerStopKeepsValidFDs(config::InputTable const& table,
+                                   ColumnLayoutRelationData const& relation) {
+    table->Reset();
+    auto full_run = algos::CreateAndLoadAlgorithm<Algorithm>(
+            algos::StdParamsMap{{config::names::kTable, table}});
+    full_run->Execute();
+
+    table->Reset();
+    auto algorithm = algos::CreateAndLoadAlgorithm<Algorithm>(
+            algos::StdParamsMap{{config::names::kTable, table}});
+    std::size_t constexpr kWantedFdsNum = 2;
+    std::size_t consumed_num = 0;
+    algorithm->SetFdConsumer([&consumed_num](FD const&) { return ++consumed_num < kWantedFdsNum; });
+    algorithm->Execute();
+    EXPECT_TRUE(algorithm->IsResultIncomplete());
+    EXPECT_EQ(consumed_num, kWantedFdsNum);
+    EXPECT_LT(algorithm->FdList().size(), full_run->FdList().size());
+    ExpectValidFDs(algorithm->FdList(), relation);
+}
+}  // namespace
+
+TEST(BoundedSpscQueueTest, PassesElementsInOrder) {
+    util::BoundedSpscQueue<int> queue(4);
+    constexpr int kElementsNum = 10000;
+    std::thread producer([&queue]() {
+        for (int i = 0; i < kElementsNum; ++i) {
+            ASSERT_TRUE(queue.Push(i));
+        }
+        queue.Close();
+    });
+
+    std::vector<int> popped;
+    while (std::optional<int> element = queue.Pop()) {
+        popped.push_back(*element);
+    }
+    producer.join();
+
+    ASSERT_EQ(popped.size(), static_cast<std::size_t>(kElementsNum));
+    for (int i = 0; i < kElementsNum; ++i) {
+        EXPECT_EQ(popped[i], i);
+    }
+}
+
+TEST(BoundedSpscQueueTest, CloseUnblocksProducer) {
+    util::BoundedSpscQueue<int> queue(1);
+    ASSERT_TRUE(queue.Push(0));
+    std::thread producer([&queue]() { EXPECT_FALSE(queue.Push(1)); });
+    queue.Close();
+    producer.join();
+    EXPECT_EQ(queue.Pop(), 0);
+    EXPECT_EQ(queue.Pop(), std::nullopt);
+}
+
+TEST(PrimitiveStreamTest, ConsumerReceivesEveryFd) {
+    auto algorithm = CreateTane(kCIPublicHighway700);
+    std::list<FD> consumed;
+    algorithm->SetFdConsumer([&consumed](FD const& fd) {
+        consumed.push_back(fd);
+        return true;
+    });
+    algorithm->Execute();
+    EXPECT_FALSE(algorithm->IsStopRequested());
+    EXPECT_EQ(algos::FDAlgorithm::FDsToJson(consumed),
+              algos::FDAlgorithm::FDsToJson(algorithm->FdList()));
+}
+
+TEST(PrimitiveStreamTest, ConsumerStopsExecution) {
+    auto full_run = CreateTane(kCIPublicHighway700);
+    full_run->Execute();
+
+    auto algorithm = CreateTane(kCIPublicHighway700);
+    std::size_t constexpr kWantedFdsNum = 3;
+    std::size_t consumed_num = 0;
+    algorithm->SetFdConsumer([&consumed_num](FD const&) { return ++consumed_num < kWantedFdsNum; });
+    algorithm->Execute();
+    EXPECT_TRUE(algorithm->IsStopRequested());
+    EXPECT_TRUE(algorithm->IsResultIncomplete());
+    EXPECT_EQ(consumed_num, kWantedFdsNum);
+    EXPECT_LT(algorithm->FdList().size(), full_run->FdList().size());
+
+    // the request is cleared by the next execution
+    algorithm->SetFdConsumer(nullptr);
+    algos::ConfigureFromMap(*algorithm, GetParamMap(kCIPublicHighway700));
+    algorithm->Execute();
+    EXPECT_FALSE(algorithm->IsStopRequested());
+    EXPECT_FALSE(algorithm->IsResultIncomplete());
+    EXPECT_EQ(algorithm->FdList().size(), full_run->FdList().size());
+}
+
+TEST(PrimitiveStreamTest, LongTimeLimitKeepsFullResult) {
+    auto full_run = CreateTane(kCIPublicHighway700);
+    full_run->Execute();
+
+    algos::StdParamsMap params = GetParamMap(kCIPublicHighway700);
+    params.emplace(config::names::kTimeLimitSeconds, config::TimeLimitSecondsType{3600});
+    auto algorithm = algos::CreateAndLoadAlgorithm<algos::Tane>(params);
+    EXPECT_TRUE(algorithm->GetPossibleOptions().contains(config::names::kTimeLimitSeconds));
+    algorithm->Execute();
+    EXPECT_FALSE(algorithm->IsResultIncomplete());
+    EXPECT_EQ(algos::FDAlgorithm::FDsToJson(algorithm->FdList()),
+              algos::FDAlgorithm::FDsToJson(full_run->FdList()));
+}
+
+TEST(PrimitiveStreamTest, TimeLimitIsRejectedWithoutCheckpoints) {
+    auto algorithm = algos::CreateAndLoadAlgorithm<algos::FDep>(GetParamMap(kCIPublicHighway700));
+    EXPECT_FALSE(algorithm->GetPossibleOptions().contains(config::names::kTimeLimitSeconds));
+    EXPECT_THROW(algorithm->SetOption(config::names::kTimeLimitSeconds,
+                                      config::TimeLimitSecondsType{1}),
+                 config::ConfigurationError);
+}
+
+TEST(PrimitiveStreamTest, ConsumerStopKeepsValidResults) {
+    config::InputTable const table = MakeModuloTable(1000);
+    auto const relation = ColumnLayoutRelationData::CreateFrom(*table, true);
+    TestConsumerStopKeepsValidFDs<algos::DFD>(table, *relation);
+    TestConsumerStopKeepsValidFDs<algos::Tane>(table, *relation);
+}
+
+// HyFD and HyUCC register their results once the search is over, whether the deadline comes
+// before that depends on the machine, so only the validity of the results is checked
+TEST(PrimitiveStreamTest, DeadlineKeepsValidResults) {
+    config::InputTable const table = MakeModuloTable(250000);
+    auto const relation = ColumnLayoutRelationData::CreateFrom(*table, true);
+    ExpectValidFDs(RunForASecond<algos::hyfd::HyFD>(table)->FdList(), *relation);
+
+    auto hyucc = RunForASecond<algos::HyUCC>(table);
+    for (model::UCC const& ucc : hyucc->UCCList()) {
+        EXPECT_EQ(CountAgreeingPairs(*relation, ucc.GetColumnIndicesAsVector()), 0u)
+                << ucc.ToIndicesString();
+    }
+}
+
+}  // namespace tests
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "algorithms/algo_factory.h"
+#include "algorithms/fd/pyro/pyro.h"
+#include "algorithms/ucc/ucc.h"
+#include "all_csv_configs.h"
+#include "config/error/type.h"
+#include "config/names.h"
+#include "config/thread_number/type.h"
+#include "csv_config_util.h"
+#include "dynamic_table_util.h"
+#include "model/table/idataset_stream.h"
+
+namespace tests {
+
+namespace {
+namespace onam = config::names;
+
+/* The search spaces of the first columns are trivial: a key determines them at once. The other
+ * columns have small random domains, so their lattices are deep, and the work of the launch pads
+ * is spread very unevenly among the search spaces */
+config::InputTable MakeSkewedTable() {
+    std::mt19937 gen(5);
+    size_t const num_columns = 12;
+    std::vector<std::string> column_names;
+    for (size_t i = 0; i < num_columns; ++i) {
+        column_names.push_back("Col" + std::to_string(i));
+    }
+    std::vector<model::IDatasetStream::Row> rows;
+    for (int row_num = 0; row_num < 400; ++row_num) {
+        model::IDatasetStream::Row row{std::to_string(row_num), std::to_string(row_num % 7),
+                                       std::to_string(row_num % 11)};
+        for (size_t i = row.size(); i < num_columns; ++i) {
+            std::uniform_int_distribution<int> value_dist(0, static_cast<int>(1 + i % 4));
+            row.push_back(std::to_string(value_dist(gen)));
+        }
+        rows.push_back(std::move(row));
+    }
+    return std::make_shared<RowsStream>(std::move(column_names), std::move(rows));
+}
+
+std::vector<std::vector<unsigned>> ToIndices(std::list<model::UCC> const& uccs) {
+    std::vector<std::vector<unsigned>> indices;
+    for (model::UCC const& ucc : uccs) {
+        indices.push_back(ucc.GetColumnIndicesAsVector());
+    }
+    std::sort(indices.begin(), indices.end());
+    return indices;
+}
+
+std::unique_ptr<algos::Pyro> RunPyro(config::InputTable const& table, config::ErrorType error,
+                                     config::ThreadNumType threads) {
+    table->Reset();
+    auto pyro = algos::CreateAndLoadAlgorithm<algos::Pyro>(
+            algos::StdParamsMap{{onam::kTable, table},
+                                {onam::kError, error},
+                                {onam::kThreads, threads},
+                                {onam::kFindUccs, true}});
+    pyro->Execute();
+    return pyro;
+}
+}  // namespace
+
+// Launch pads are stolen by idle threads from the search spaces of other columns, which must not
+// change the result even if the search spaces differ a lot in size
+TEST(PyroParallelTest, WorkStealingGivesSameResultOnSkewedData) {
+    std::vector<config::InputTable> const tables{MakeSkewedTable(),
+                                                 MakeInputTable(kCIPublicHighway700)};
+    for (config::InputTable const& table : tables) {
+        for (config::ErrorType error : {0.0, 0.01}) {
+            std::unique_ptr<algos::Pyro> const single_threaded = RunPyro(table, error, 1);
+            std::string const fds = algos::FDAlgorithm::FDsToJson(single_threaded->FdList());
+            std::vector<std::vector<unsigned>> const uccs = ToIndices(single_threaded->UCCList());
+            ASSERT_FALSE(single_threaded->FdList().empty());
+            for (config::ThreadNumType threads : {2, 4, 8}) {
+                std::unique_ptr<algos::Pyro> const multi_threaded = RunPyro(table, error, threads);
+                EXPECT_EQ(algos::FDAlgorithm::FDsToJson(multi_threaded->FdList()), fds)
+                        << table->GetRelationName() << ", error " << error << ", threads "
+                        << threads;
+                EXPECT_EQ(ToIndices(multi_threaded->UCCList()), uccs)
+                        << table->GetRelationName() << ", error " << error << ", threads "
+                        << threads;
+            }
+        }
+    }
+}
+
+}  // namespace tests
@@ -1,13 +1,18 @@
+#include <algorithm>
+#include <list>
 #include <memory>
 #include <ostream>
 #include <string>
+#include <vector>
 
 #include <boost/dynamic_bitset.hpp>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "algorithms/algo_factory.h"
+#include "algorithms/fd/pyro/pyro.h"
 #include "algorithms/ucc/hyucc/hyucc.h"
+#include "algorithms/ucc/pyroucc/pyroucc.h"
 #include "algorithms/ucc/ucc.h"
 #include "algorithms/ucc/ucc_algorithm.h"
 #include "all_csv_configs.h"
@@ -150,4 +155,37 @@ REGISTER_TYPED_TEST_SUITE_P(UCCAlgorithmTest, ConsistentHashOnLightDatasets,
 using Algorithms = ::testing::Types<algos::HyUCC, algos::PyroUCC>;
 INSTANTIATE_TYPED_TEST_SUITE_P(UCCAlgorithmTest, UCCAlgorithmTest, Algorithms);
 
+// The UCCs that Pyro mines along with the FDs are the ones PyroUCC mines alone, and the FDs are
+// the same as without the UCC discovery
+TEST(PyroCombinedPassTest, MatchesSeparateRuns) {
+    using namespace config::names;
+    auto to_indices = [](std::list<model::UCC> const& uccs) {
+        std::vector<std::vector<unsigned>> indices;
+        for (model::UCC const& ucc : uccs) {
+            indices.push_back(ucc.GetColumnIndicesAsVector());
+        }
+        std::sort(indices.begin(), indices.end());
+        return indices;
+    };
+    for (CSVConfig const& csv_config : {kTestFD, kCIPublicHighway700, kWdcSatellites}) {
+        for (config::ThreadNumType threads : {1, 4}) {
+            auto combined = algos::CreateAndLoadAlgorithm<algos::Pyro>(algos::StdParamsMap{
+                    {kCsvConfig, csv_config}, {kThreads, threads}, {kFindUccs, true}});
+            combined->Execute();
+            auto fds_only = algos::CreateAndLoadAlgorithm<algos::Pyro>(
+                    algos::StdParamsMap{{kCsvConfig, csv_config}, {kThreads, threads}});
+            fds_only->Execute();
+            auto uccs_only = algos::CreateAndLoadAlgorithm<algos::PyroUCC>(
+                    algos::StdParamsMap{{kCsvConfig, csv_config}, {kThreads, threads}});
+            uccs_only->Execute();
+
+            EXPECT_EQ(to_indices(combined->UCCList()), to_indices(uccs_only->UCCList()))
+                    << csv_config.path.filename() << ", threads " << threads;
+            EXPECT_EQ(algos::FDAlgorithm::FDsToJson(combined->FdList()),
+                      algos::FDAlgorithm::FDsToJson(fds_only->FdList()))
+                    << csv_config.path.filename() << ", threads " << threads;
+        }
+    }
+}
+
 }  // namespace tests
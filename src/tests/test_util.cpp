@@ -1,5 +1,10 @@
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <iostream>
+#include <stdexcept>
 #include <thread>
+#include <utility>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -11,6 +16,8 @@
 #include "model/table/agree_set_factory.h"
 #include "model/table/column_layout_relation_data.h"
 #include "model/table/identifier_set.h"
+#include "util/sorted_page.h"
+#include "util/work_stealing_pool.h"
 
 namespace tests {
 
@@ -170,6 +177,18 @@ TEST(AgreeSetFactoryTest, UsingMapOfIDSets) {
     TestAgreeSetFactory(c);
 }
 
+TEST(AgreeSetFactoryTest, UsingVectorOfIDSetsParallel) {
+    AgreeSetFactory::Configuration c(AgreeSetsGenMethod::kUsingVectorOfIDSets,
+                                     MCGenMethod::kUsingCalculateSupersets, 4);
+    TestAgreeSetFactory(c);
+}
+
+TEST(AgreeSetFactoryTest, UsingMapOfIDSetsParallel) {
+    AgreeSetFactory::Configuration c(AgreeSetsGenMethod::kUsingMapOfIDSets,
+                                     MCGenMethod::kUsingCalculateSupersets, 4);
+    TestAgreeSetFactory(c);
+}
+
 TEST(AgreeSetFactoryTest, UsingGetAgreeSet) {
     AgreeSetFactory::Configuration c(AgreeSetsGenMethod::kUsingGetAgreeSet);
     TestAgreeSetFactory(c);
@@ -204,6 +223,53 @@ TEST(AgreeSetFactoryTest, MCGenParallel) {
 }
 #endif
 
+TEST(SortedPageTest, MatchesStableSort) {
+    std::vector<std::pair<int, int>> elements;
+    for (int i = 0; i < 100; ++i) {
+        elements.emplace_back((i * 37) % 11, i);
+    }
+    auto const compare = [](auto const& a, auto const& b) { return a.first < b.first; };
+    std::vector<std::pair<int, int>> sorted = elements;
+    std::stable_sort(sorted.begin(), sorted.end(), compare);
+
+    for (size_t limit : {1, 7, 100}) {
+        std::vector<std::pair<int, int>> paged;
+        for (size_t offset = 0; offset < elements.size(); offset += limit) {
+            auto page = util::GetSortedPage(elements, compare, offset, limit);
+            paged.insert(paged.end(), page.begin(), page.end());
+        }
+        EXPECT_EQ(paged, sorted);
+    }
+    EXPECT_TRUE(util::GetSortedPage(elements, compare, elements.size(), 10).empty());
+}
+
+TEST(WorkStealingPoolTest, RunsNestedTasks) {
+    std::atomic<unsigned> counter = 0;
+    util::WorkStealingPool pool(4);
+    std::function<void(unsigned)> spawn = [&](unsigned depth) {
+        counter++;
+        if (depth == 0) return;
+        for (int i = 0; i < 2; ++i) {
+            pool.Submit([&spawn, depth]() { spawn(depth - 1); });
+        }
+    };
+    pool.Submit([&spawn]() { spawn(10); });
+    pool.Wait();
+    ASSERT_EQ(counter, (1U << 11) - 1);
+}
+
+TEST(WorkStealingPoolTest, RethrowsException) {
+    util::WorkStealingPool pool(2);
+    for (int i = 0; i < 8; ++i) {
+        pool.Submit([i]() {
+            if (i == 5) throw std::runtime_error("task failed");
+        });
+    }
+    ASSERT_THROW(pool.Wait(), std::runtime_error);
+    pool.Submit([]() {});
+    ASSERT_NO_THROW(pool.Wait());
+}
+
 struct TestLevenshteinParam {
     std::string l;
     std::string r;
@@ -0,0 +1,93 @@
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#include <gtest/gtest.h>
+
+#include "model/table/relational_schema.h"
+#include "model/table/vertical.h"
+#include "util/custom_hashes.h"
+
+namespace tests {
+
+namespace {
+std::unique_ptr<RelationalSchema> MakeSchema(std::size_t columns_num) {
+    auto schema = std::make_unique<RelationalSchema>("schema");
+    for (std::size_t i = 0; i < columns_num; ++i) {
+        schema->AppendColumn(std::to_string(i));
+    }
+    schema->Init();
+    return schema;
+}
+
+boost::dynamic_bitset<> RandomBitset(std::size_t size, std::mt19937& gen) {
+    std::bernoulli_distribution dist(0.3);
+    boost::dynamic_bitset<> bitset(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        bitset[i] = dist(gen);
+    }
+    return bitset;
+}
+
+std::vector<std::size_t> Indices(boost::dynamic_bitset<> const& bitset) {
+    std::vector<std::size_t> indices;
+    for (std::size_t i = bitset.find_first(); i != boost::dynamic_bitset<>::npos;
+         i = bitset.find_next(i)) {
+        indices.push_back(i);
+    }
+    return indices;
+}
+
+std::vector<std::size_t> Indices(Vertical const& vertical) {
+    std::vector<std::size_t> indices;
+    vertical.ForEachColumnIndex([&indices](std::size_t index) { indices.push_back(index); });
+    return indices;
+}
+}  // namespace
+
+class VerticalTest : public ::testing::TestWithParam<std::size_t> {};
+
+TEST_P(VerticalTest, MatchesBitsetOperations) {
+    std::size_t const columns_num = GetParam();
+    auto const schema_ptr = MakeSchema(columns_num);
+    RelationalSchema const& schema = *schema_ptr;
+    std::mt19937 gen(columns_num);
+    std::hash<Vertical> hasher;
+    for (int i = 0; i < 100; ++i) {
+        boost::dynamic_bitset<> const lhs_bits = RandomBitset(columns_num, gen);
+        boost::dynamic_bitset<> const rhs_bits = RandomBitset(columns_num, gen);
+        Vertical const lhs = schema.GetVertical(lhs_bits);
+        Vertical const rhs = schema.GetVertical(rhs_bits);
+        Column const& column = *schema.GetColumn(gen() % columns_num);
+
+        EXPECT_EQ(lhs.GetColumnIndices(), lhs_bits);
+        EXPECT_EQ(lhs.GetArity(), lhs_bits.count());
+        EXPECT_EQ(Indices(lhs), Indices(lhs_bits));
+        EXPECT_EQ(lhs.Contains(column), lhs_bits.test(column.GetIndex()));
+        EXPECT_EQ(lhs.Contains(rhs), rhs_bits.is_subset_of(lhs_bits));
+        EXPECT_TRUE(lhs.Contains(lhs.Project(rhs)));
+        EXPECT_EQ(lhs.Intersects(rhs), lhs_bits.intersects(rhs_bits));
+        EXPECT_EQ(lhs.Union(rhs).GetColumnIndices(), lhs_bits | rhs_bits);
+        EXPECT_EQ(lhs.Project(rhs).GetColumnIndices(), lhs_bits & rhs_bits);
+        EXPECT_EQ(lhs.Without(rhs).GetColumnIndices(), lhs_bits - rhs_bits);
+        EXPECT_EQ(lhs.Invert().GetColumnIndices(), ~lhs_bits);
+        EXPECT_EQ(lhs.Invert(rhs).GetColumnIndices(), lhs_bits ^ rhs_bits);
+        EXPECT_TRUE(lhs.Union(column).Contains(column));
+        EXPECT_FALSE(lhs.Without(column).Contains(column));
+
+        Vertical const copy = schema.GetVertical(lhs_bits);
+        EXPECT_EQ(copy, lhs);
+        EXPECT_EQ(hasher(copy), hasher(lhs));
+        EXPECT_EQ(lhs == rhs, lhs_bits == rhs_bits);
+        EXPECT_NE(lhs < rhs, rhs < lhs || lhs == rhs);
+    }
+}
+
+// The first schema fits the inline storage, the other one does not
+INSTANTIATE_TEST_SUITE_P(VerticalStorage, VerticalTest,
+                         ::testing::Values(std::size_t{100}, Vertical::kMaxInlineColumns + 44));
+
+}  // namespace tests
@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#include <gtest/gtest.h>
+
+#include "model/table/relational_schema.h"
+#include "model/table/vertical.h"
+#include "model/table/vertical_map.h"
+#include "model/table/vertical_set_trie.h"
+
+namespace tests {
+
+namespace {
+constexpr std::size_t kColumnsNum = 12;
+
+std::unique_ptr<RelationalSchema> MakeSchema() {
+    auto schema = std::make_unique<RelationalSchema>("schema");
+    for (std::size_t i = 0; i < kColumnsNum; ++i) {
+        schema->AppendColumn(std::to_string(i));
+    }
+    schema->Init();
+    return schema;
+}
+
+Vertical MakeVertical(RelationalSchema const& schema, unsigned long mask) {
+    return schema.GetVertical(boost::dynamic_bitset<>(kColumnsNum, mask));
+}
+
+std::vector<Vertical> SortedKeys(std::vector<model::VerticalMap<Vertical>::Entry> const& entries) {
+    std::vector<Vertical> keys;
+    for (auto const& [key, value] : entries) {
+        EXPECT_EQ(*value, key);
+        keys.push_back(key);
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+}  // namespace
+
+TEST(VerticalMapTest, SubsetAndSupersetQueriesMatchBruteForce) {
+    auto const schema_ptr = MakeSchema();
+    RelationalSchema const& schema = *schema_ptr;
+    model::VerticalMap<Vertical> map(&schema);
+    std::vector<unsigned long> inserted_masks;
+    std::mt19937 gen(0);
+    for (int i = 0; i < 300; ++i) {
+        unsigned long const mask = gen() % (1ul << kColumnsNum);
+        if (map.Put(MakeVertical(schema, mask),
+                    std::make_shared<Vertical>(MakeVertical(schema, mask))) == nullptr) {
+            inserted_masks.push_back(mask);
+        }
+    }
+    // removed keys must disappear together with the nodes left empty
+    std::vector<unsigned long> masks;
+    for (std::size_t i = 0; i < inserted_masks.size(); ++i) {
+        if (i % 3 == 0) {
+            EXPECT_NE(map.Remove(MakeVertical(schema, inserted_masks[i])), nullptr);
+        } else {
+            masks.push_back(inserted_masks[i]);
+        }
+    }
+    ASSERT_EQ(map.GetSize(), masks.size());
+
+    for (int i = 0; i < 50; ++i) {
+        unsigned long const query = gen() % (1ul << kColumnsNum);
+        unsigned long const exclusion = gen() % (1ul << kColumnsNum) & ~query;
+        std::vector<Vertical> subsets, supersets, restricted_supersets;
+        for (unsigned long mask : masks) {
+            if ((mask & ~query) == 0) subsets.push_back(MakeVertical(schema, mask));
+            if ((query & ~mask) == 0) {
+                supersets.push_back(MakeVertical(schema, mask));
+                if ((mask & exclusion) == 0) {
+                    restricted_supersets.push_back(MakeVertical(schema, mask));
+                }
+            }
+        }
+        std::sort(subsets.begin(), subsets.end());
+        std::sort(supersets.begin(), supersets.end());
+        std::sort(restricted_supersets.begin(), restricted_supersets.end());
+
+        Vertical const query_vertical = MakeVertical(schema, query);
+        EXPECT_EQ(SortedKeys(map.GetSubsetEntries(query_vertical)), subsets);
+        EXPECT_EQ(SortedKeys(map.GetSupersetEntries(query_vertical)), supersets);
+        EXPECT_EQ(SortedKeys(map.GetRestrictedSupersetEntries(query_vertical,
+                                                              MakeVertical(schema, exclusion))),
+                  restricted_supersets);
+        EXPECT_EQ(map.GetAnySubsetEntry(query_vertical).second == nullptr, subsets.empty());
+    }
+}
+
+TEST(VerticalMapTest, ReadersRunAlongsideWriter) {
+    auto const schema_ptr = MakeSchema();
+    RelationalSchema const& schema = *schema_ptr;
+    model::BlockingVerticalMap<Vertical> map(&schema);
+    // the full set is never removed, every reader has to find it
+    Vertical const full = MakeVertical(schema, (1ul << kColumnsNum) - 1);
+    map.Put(full, std::make_shared<Vertical>(full));
+
+    std::atomic<bool> done = false;
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; ++i) {
+        readers.emplace_back([&map, &schema, &full, &done, i]() {
+            std::mt19937 gen(i);
+            while (!done.load()) {
+                Vertical const query = MakeVertical(schema, gen() % (1ul << kColumnsNum));
+                for (auto const& [key, value] : map.GetSubsetEntries(full)) {
+                    ASSERT_EQ(*value, key);
+                }
+                ASSERT_NE(map.GetAnySupersetEntry(query).second, nullptr);
+            }
+        });
+    }
+    std::mt19937 gen(42);
+    for (int i = 0; i < 20000; ++i) {
+        Vertical const key = MakeVertical(schema, gen() % ((1ul << kColumnsNum) - 1));
+        if (gen() % 2 == 0) {
+            map.Put(key, std::make_shared<Vertical>(key));
+        } else {
+            map.Remove(key);
+        }
+    }
+    done.store(true);
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(map.Get(full)->GetArity(), kColumnsNum);
+}
+
+TEST(VerticalMapTest, UnlinkedNodesWaitOnlyForEarlierReaders) {
+    auto const schema_ptr = MakeSchema();
+    RelationalSchema const& schema = *schema_ptr;
+    model::VerticalSetTrie<Vertical> trie(&schema);
+    auto put = [&trie, &schema](unsigned long mask) {
+        Vertical const key = MakeVertical(schema, mask);
+        trie.Associate(key, std::make_shared<Vertical>(key));
+    };
+    // the reader stays in the trie until it is released
+    auto start_reader = [&trie](std::future<void> release) {
+        std::promise<void> entered;
+        std::future<void> entered_future = entered.get_future();
+        std::thread reader([&trie, &entered, release = std::move(release)]() mutable {
+            trie.ForEachEntry([&](Vertical const&, auto const&) {
+                entered.set_value();
+                release.wait();
+                return false;
+            });
+        });
+        entered_future.wait();
+        return reader;
+    };
+    // every key below is kept in a node of its own under the root
+    put(0b1000);
+
+    std::promise<void> release_first;
+    std::thread first_reader = start_reader(release_first.get_future());
+    put(0b10);
+    trie.Remove(MakeVertical(schema, 0b10));
+    // the second reader enters after the node of {1} is unlinked, it cannot hold it
+    std::promise<void> release_second;
+    std::thread second_reader = start_reader(release_second.get_future());
+    release_first.set_value();
+    first_reader.join();
+
+    put(0b100);
+    trie.Remove(MakeVertical(schema, 0b100));
+    std::size_t const nodes_num = trie.GetNumAllocatedNodes();
+    // takes the node of {1}
+    put(0b1);
+    EXPECT_EQ(trie.GetNumAllocatedNodes(), nodes_num);
+
+    release_second.set_value();
+    second_reader.join();
+}
+
+TEST(VerticalMapTest, ReadersEnterWhileNodesAreReclaimed) {
+    auto const schema_ptr = MakeSchema();
+    RelationalSchema const& schema = *schema_ptr;
+    model::VerticalSetTrie<Vertical> trie(&schema);
+    Vertical const full = MakeVertical(schema, (1ul << kColumnsNum) - 1);
+    trie.Associate(full, std::make_shared<Vertical>(full));
+
+    // every removal ends an epoch and frees the nodes of the previous one, short reads keep
+    // entering around it, a reader standing on a reused node would see a foreign key or value
+    std::atomic<bool> done = false;
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&trie, &full, &done]() {
+            while (!done.load()) {
+                bool found_full = false;
+                trie.ForEachEntry([&](Vertical const& key, auto const& value) {
+                    EXPECT_EQ(*value, key);
+                    found_full |= key == full;
+                    return true;
+                });
+                ASSERT_TRUE(found_full);
+            }
+        });
+    }
+    std::mt19937 gen(42);
+    for (int i = 0; i < 50000; ++i) {
+        Vertical const key = MakeVertical(schema, gen() % ((1ul << kColumnsNum) - 1));
+        trie.Associate(key, std::make_shared<Vertical>(key));
+        trie.Remove(key);
+    }
+    done.store(true);
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(*trie.Get(full), full);
+}
+
+}  // namespace tests